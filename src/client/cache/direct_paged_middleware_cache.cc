@@ -41,10 +41,21 @@ void DirectPagedMiddlewareCache::initialize()
     openFileCounts_ = createOpenFileMap();
 }
 
+void DirectPagedMiddlewareCache::finish()
+{
+    PagedCache::finish();
+
+    // Record replacement policy statistics
+    recordScalar("SPFS MWare Cache Ghost Hits", lruCache_->getNumGhostHits());
+    recordScalar("SPFS MWare Cache Ghost Entries",
+                 lruCache_->getNumGhostEntries());
+}
+
 DirectPagedMiddlewareCache::FileDataPageCache*
 DirectPagedMiddlewareCache::createFileDataPageCache(size_t cacheSize)
 {
-    return new FileDataPageCache(cacheSize);
+    return new FileDataPageCache(cacheSize,
+                                 par("replacementPolicy").stringValue());
 }
 
 DirectPagedMiddlewareCache::RequestMap*
@@ -455,12 +466,12 @@ void DirectPagedMiddlewareCache::beginWritebackEvictions(
 
         // Accumulate the pages for each file and issue a writeback
         set<FilePageId> pages;
-        Filename currentName = writebackPages.begin()->filename;
+        Filename currentName = writebackPages.begin()->filename();
         set<PagedCache::Key>::iterator iter;
         for (iter = writebackPages.begin(); iter != writebackPages.end(); ++iter)
         {
             // TODO: need to ensure that pages are stably sorted by current name
-            if (currentName == iter->filename)
+            if (currentName == iter->filename())
             {
                 pages.insert(iter->key);
             }
@@ -472,7 +483,7 @@ void DirectPagedMiddlewareCache::beginWritebackEvictions(
                 send(writebackRequest, fsOutGateId());
                 // Reset the loop state and append the page to the new set
                 pages.clear();
-                currentName = iter->filename;
+                currentName = iter->filename();
                 pages.insert(iter->key);
             }
         }
@@ -493,11 +504,11 @@ void DirectPagedMiddlewareCache::beginRead(
     // Collect the page ids
     set<PagedCache::Key>::iterator iter = readPages.begin();
     set<PagedCache::Key>::iterator end = readPages.end();
-    Filename filename = iter->filename;
+    Filename filename = iter->filename();
     set<FilePageId> pages;
     while (iter != end)
     {
-        assert(filename == iter->filename);
+        assert(filename == iter->filename());
         pages.insert(iter->key);
         ++iter;
     }
@@ -511,7 +522,7 @@ void DirectPagedMiddlewareCache::beginRead(
 set<PagedCache::Key> DirectPagedMiddlewareCache::lookupDirtyPagesInCache(const Filename& filename) const
 {
         DirtyPageFilter filter(filename);
-        return lruCache_->getFilteredEntries(filter);
+        return lruCache_->getFilteredDirtyEntries(filter);
 }
 
 void DirectPagedMiddlewareCache::lookupPagesInCache(set<PagedCache::Key>& requestPages)
@@ -520,11 +531,11 @@ void DirectPagedMiddlewareCache::lookupPagesInCache(set<PagedCache::Key>& reques
     set<PagedCache::Key>::iterator end = requestPages.end();
     while (iter != end)
     {
-        try
+        if (0 != lruCache_->find(*iter))
         {
-            lruCache_->lookup(*iter);
             requestPages.erase(iter++);
-        } catch (NoSuchEntry& e)
+        }
+        else
         {
             // Lookup failed, increment to next entry
             iter++;
@@ -540,36 +551,36 @@ void DirectPagedMiddlewareCache::updateCache(set<PagedCache::Key>& updatePages,
     set<PagedCache::Key>::const_iterator iter;
     for (iter = updatePages.begin(); iter != updatePages.end(); iter++)
     {
-        try {
-            // If the updates are dirty, then insert them into the cache
-            // otherwise, if an existing entry isn't already dirty then
-            //   insert the entry into the cache
-            PagedCache::Key evictedKey(Filename("/"), 0);
-            FilePageId evictedValue = 0;
-            bool isEvictedDirty = false;
-            if (updatesDirty)
-            {
-                // Insert dirty entries
-                lruCache_->insertAndRecall(*iter, iter->key, true,
-                                           evictedKey, evictedValue, isEvictedDirty);
-            }
-            else if (!lruCache_->exists(*iter) ||
-                     false == lruCache_->getDirtyBit(*iter))
-            {
-                // Insert clean entries that don't conflict with an existing
-                // dirty entry
-                lruCache_->insertAndRecall(*iter, iter->key, false,
-                                           evictedKey, evictedValue, isEvictedDirty);
-            }
+        // If the updates are dirty, then insert them into the cache
+        // otherwise, if an existing entry isn't already dirty then
+        //   insert the entry into the cache
+        PagedCache::Key evictedKey(*iter);
+        FilePageId evictedValue = 0;
+        bool isEvicted = false;
+        bool isEvictedDirty = false;
+        if (updatesDirty)
+        {
+            // Insert dirty entries
+            isEvicted = lruCache_->insertAndRecall(*iter, iter->key, true,
+                                                   evictedKey,
+                                                   evictedValue,
+                                                   isEvictedDirty);
+        }
+        else if (!lruCache_->exists(*iter) ||
+                 false == lruCache_->getDirtyBit(*iter))
+        {
+            // Insert clean entries that don't conflict with an existing
+            // dirty entry
+            isEvicted = lruCache_->insertAndRecall(*iter, iter->key, false,
+                                                   evictedKey,
+                                                   evictedValue,
+                                                   isEvictedDirty);
+        }
 
-            // Only add writeback if the eviction is dirty
-            if (isEvictedDirty)
-            {
-                outWriteBacks.insert(evictedKey);
-            }
-        } catch (const NoSuchEntry& e)
+        // Only add writeback if the eviction is dirty
+        if (isEvicted && isEvictedDirty)
         {
-            // No eviction was necessary
+            outWriteBacks.insert(evictedKey);
         }
     }
 }
@@ -593,7 +604,7 @@ void DirectPagedMiddlewareCache::flushCache(const Filename& flushName)
             {
                 cerr << __FILE__ << ":" << __LINE__ << ":"
                      << "No such entry while flushing a file from the cache: "
-                     << begin->filename << " " << begin->key << endl;
+                     << begin->filename() << " " << begin->key << endl;
                 assert(0);
             }
         }
@@ -769,6 +780,7 @@ set<PagedCache::Key> DirectPagedMiddlewareCache::trimPendingWritePages(const set
 
 bool DirectPagedMiddlewareCache::hasPendingPages(const Filename& filename) const
 {
+    FileId fileId = FileIdRegistry::instance().intern(filename);
     RequestMap::const_iterator requestIter;
     RequestMap::const_iterator requestMapEnd = pendingPages_->end();;
     for (requestIter = pendingPages_->begin(); requestIter != requestMapEnd; requestIter++)
@@ -778,7 +790,7 @@ bool DirectPagedMiddlewareCache::hasPendingPages(const Filename& filename) const
         set<PagedCache::Key>::const_iterator end = pendingReads.end();
         while (iter != end)
         {
-            if (filename == iter->filename)
+            if (fileId == iter->fileId)
             {
                 return true;
             }
@@ -790,7 +802,7 @@ bool DirectPagedMiddlewareCache::hasPendingPages(const Filename& filename) const
         end = pendingWrites.end();
         while (iter != end)
         {
-            if (filename == iter->filename)
+            if (fileId == iter->fileId)
             {
                 return true;
             }
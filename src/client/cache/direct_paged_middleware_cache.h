@@ -15,8 +15,8 @@
 #include "basic_types.h"
 #include "file_page.h"
 #include "filename.h"
-#include "lru_cache.h"
 #include "paged_cache.h"
+#include "replacement_cache.h"
 class spfsMPIFileCloseRequest;
 class spfsMPIFileOpenRequest;
 class spfsMPIFileReadAtRequest;
@@ -29,7 +29,9 @@ class spfsMPIFileWriteAtResponse;
  * cache page will lead to incoherent page data as the old data will be
  * written to store.  IE.  this cache simply reads the page locally and
  * then updates until an evict or close forces the page out of cache.  No
- * attempts are made to prevent false sharing to unwritten page regions
+ * attempts are made to prevent false sharing to unwritten page regions.
+ * Pages are replaced using the policy named by the replacementPolicy
+ * parameter.
  */
 class DirectPagedMiddlewareCache : public PagedCache
 {
@@ -39,7 +41,7 @@ public:
 
 protected:
     /** Typedef of the type used to store file data internally */
-    typedef LRUCache<PagedCache::Key, FilePageId> FileDataPageCache;
+    typedef ReplacementCache<PagedCache::Key, FilePageId> FileDataPageCache;
 
     /** Typedef mapping a pending request to its pending cache pages */
     typedef std::map<spfsMPIFileRequest*, PagedCache::InProcessPages> RequestMap;
@@ -50,6 +52,9 @@ protected:
     /** Perform module initialization */
     virtual void initialize();
 
+    /** Perform module finalization */
+    virtual void finish();
+
     /** @return the file data page cache for this middleware */
     virtual FileDataPageCache* createFileDataPageCache(size_t cacheSize);
 
@@ -165,7 +170,7 @@ private:
     bool hasPendingPages(const Filename& filename) const;
 
     /** Data structure for holding the cached data */
-    LRUCache<PagedCache::Key, FilePageId>* lruCache_;
+    FileDataPageCache* lruCache_;
 
     /** Map of request to the total pending pages */
     RequestMap* pendingPages_;
@@ -15,18 +15,19 @@ class FilePageFilter : public LRUCache<PagedCache::Key, FilePageId>::FilterFunct
 {
 public:
     /** Constructor */
-    FilePageFilter(const Filename& filename) : filename_(filename) {};
+    FilePageFilter(const Filename& filename)
+        : fileId_(FileIdRegistry::instance().intern(filename)) {};
 
     /** @return true if the page belongs to this file */
     virtual bool filter(const PagedCache::Key& key,
                         const FilePageId& pageId,
                         bool isDirty) const
     {
-        return (key.filename == filename_);
+        return (key.fileId == fileId_);
     }
 
 private:
-    Filename filename_;
+    FileId fileId_;
 };
 
 /** Functor for finding dirty pages for a cached file */
@@ -34,18 +35,19 @@ class DirtyPageFilter : public LRUCache<PagedCache::Key, FilePageId>::FilterFunc
 {
 public:
     /** Constructor */
-    DirtyPageFilter(const Filename& filename) : filename_(filename) {};
+    DirtyPageFilter(const Filename& filename)
+        : fileId_(FileIdRegistry::instance().intern(filename)) {};
 
     /** @return true if the page belongs to this file and is dirty */
     virtual bool filter(const PagedCache::Key& key,
                         const FilePageId& pageId,
                         bool isDirty) const
     {
-        return ((key.filename == filename_) && isDirty);
+        return ((key.fileId == fileId_) && isDirty);
     }
 
 private:
-    Filename filename_;
+    FileId fileId_;
 };
 
 
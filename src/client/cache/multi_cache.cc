@@ -13,13 +13,13 @@ using namespace std;
 
 bool operator<(const MultiCache::Key& lhs, const MultiCache::Key& rhs)
 {
-    if (lhs.filename == rhs.filename)
+    if (lhs.fileId == rhs.fileId)
     {
         return (lhs.key < rhs.key);
     }
     else
     {
-        return (lhs.filename < rhs.filename);
+        return (lhs.fileId < rhs.fileId);
     }
 }
 
@@ -376,7 +376,7 @@ void MultiCache::print(ostream& ost) const
     while (iter != last)
     {
         ost << "\t";
-        ost << "[" << iter->first.filename << "," << iter->first.key;
+        ost << "[" << iter->first.filename() << "," << iter->first.key;
         ost << " -> ";
         ost << "[" << iter->second->page->id << "," << iter->second->isDirty << "]";
         ost << endl;
@@ -14,6 +14,7 @@
 #include <list>
 #include <map>
 #include <vector>
+#include "file_id_registry.h"
 #include "file_page.h"
 #include "file_region_set.h"
 #include "filename.h"
@@ -31,10 +32,16 @@ public:
     {
     public:
         /** Constructor */
-        Key(const Filename& fn, std::size_t k) : filename(fn), key(k) {};
+        Key(FileId id, std::size_t k) : fileId(id), key(k) {};
 
-        /** Filename to store data in cache for */
-        Filename filename;
+        /** @return the filename to store data in cache for */
+        const Filename& filename() const
+        {
+            return FileIdRegistry::instance().getFilename(fileId);
+        };
+
+        /** Interned id of the file to store data in cache for */
+        FileId fileId;
 
         /** Key to identify a page (usually just the page id) */
         std::size_t key;
@@ -79,7 +79,7 @@ SinglePageAccessMixin::createCacheReadExclusiveRequests(
     while (iter != end)
     {
         // Create the file descriptor
-        Filename name = iter->filename;
+        Filename name = iter->filename();
         FilePageId page = iter->key;
         static DataType* byteType = new ByteDataType();
         FileDescriptor* fd = FileBuilder::instance().getDescriptor(name);
@@ -120,7 +120,7 @@ SinglePageAccessMixin::createCacheReadSharedRequests(
     while (iter != end)
     {
         // Create the file descriptor
-        Filename name = iter->filename;
+        Filename name = iter->filename();
         FilePageId page = iter->key;
         static DataType* byteType = new ByteDataType();
         FileDescriptor* fd = FileBuilder::instance().getDescriptor(name);
@@ -160,7 +160,7 @@ SinglePageAccessMixin::createPFSReadRequests(
     while (iter != end)
     {
         // Create the file descriptor
-        Filename name = iter->filename;
+        Filename name = iter->filename();
         FilePageId page = iter->key;
         static DataType* byteType = new ByteDataType();
         FileDescriptor* fd = FileBuilder::instance().getDescriptor(name);
@@ -193,7 +193,7 @@ SinglePageAccessMixin::createPFSWriteRequests(
     while (iter != end)
     {
         // Create the file descriptor
-        Filename name = iter->filename;
+        Filename name = iter->filename();
         FilePageId page = iter->key;
         static DataType* byteType = new ByteDataType();
         FileDescriptor* fd = FileBuilder::instance().getDescriptor(name);
@@ -241,7 +241,7 @@ void BlockIndexedPageAccessMixin::groupPagesByFilename(
     set<PagedCache::Key>::const_iterator last = pageKeys.end();
     while (iter != last)
     {
-        set<FilePageId>& pages = outPageGroups[iter->filename];
+        set<FilePageId>& pages = outPageGroups[iter->filename()];
         pages.insert(iter->key);
         ++iter;
     }
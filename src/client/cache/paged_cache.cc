@@ -23,11 +23,12 @@ set<PagedCache::Key> PagedCache::convertPagesToCacheKeys(const Filename& filenam
                                                          set<FilePageId> pageIds)
 {
     set<PagedCache::Key> keys;
+    FileId fileId = FileIdRegistry::instance().intern(filename);
     set<FilePageId>::const_iterator iter = pageIds.begin();
     set<FilePageId>::const_iterator end = pageIds.end();
     while (iter != end)
     {
-        PagedCache::Key key(filename, *iter);
+        PagedCache::Key key(fileId, *iter);
         keys.insert(key);
         iter++;
     }
@@ -39,11 +40,12 @@ set<FilePageId> PagedCache::convertCacheKeysToPages(const Filename& filename,
                                                     set<PagedCache::Key> keys)
 {
     set<FilePageId> pages;
+    FileId fileId = FileIdRegistry::instance().intern(filename);
     set<PagedCache::Key>::const_iterator iter = keys.begin();
     set<PagedCache::Key>::const_iterator end = keys.end();
     while (iter != end)
     {
-        if (filename == iter->filename)
+        if (fileId == iter->fileId)
         {
             pages.insert(iter->key);
         }
@@ -176,7 +178,7 @@ bool operator<(const PagedCache::Key& lhs, const PagedCache::Key& rhs)
 {
     if (lhs.key == rhs.key)
     {
-        return (lhs.filename < rhs.filename);
+        return (lhs.fileId < rhs.fileId);
     }
     else
     {
@@ -192,7 +194,7 @@ std::ostream& operator<<(std::ostream& ost, const std::set<PagedCache::Key>& key
     ost << "{";
     while (first != last)
     {
-        ost << " [" << first->filename << "," << first->key << "]";
+        ost << " [" << first->filename() << "," << first->key << "]";
         ++first;
     }
     ost << "}";
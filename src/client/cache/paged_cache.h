@@ -11,8 +11,10 @@
 #include <cstddef>
 #include <set>
 #include "basic_data_type.h"
+#include "file_id_registry.h"
 #include "file_page.h"
 #include "filename.h"
+#include "lru_cache.h"
 #include "middleware_cache.h"
 class FileDescriptor;
 class FileRegionSet;
@@ -30,10 +32,16 @@ public:
     {
     public:
         /** Constructor */
-        Key(const Filename& fn, std::size_t k) : filename(fn), key(k) {};
+        Key(FileId id, std::size_t k) : fileId(id), key(k) {};
 
-        /** Filename to store data in cache for */
-        Filename filename;
+        /** @return the filename to store data in cache for */
+        const Filename& filename() const
+        {
+            return FileIdRegistry::instance().getFilename(fileId);
+        };
+
+        /** Interned id of the file to store data in cache for */
+        FileId fileId;
 
         /** Key to identify a page (usually just the page id) */
         std::size_t key;
@@ -143,6 +151,17 @@ bool operator<(const PagedCache::Key& lhs, const PagedCache::Key& rhs);
 /** Print set of paged cache keys */
 std::ostream& operator<<(std::ostream& ost, const std::set<PagedCache::Key>& keys);
 
+/** Hash function for LRU caches of pages */
+template <>
+struct LRUCacheHash<PagedCache::Key>
+{
+    std::size_t operator()(const PagedCache::Key& key) const
+    {
+        uint64_t packed = (uint64_t(key.fileId) << 32) ^ uint64_t(key.key);
+        return std::size_t(packed * 2654435761u);
+    }
+};
+
 #endif /* PAGED_CACHE_H_ */
 
 /*
@@ -14,6 +14,7 @@
 #include "client_cache_directory.h"
 #include "comm_man.h"
 #include "file_builder.h"
+#include "file_id_registry.h"
 #include "mpi_proto_m.h"
 using namespace std;
 
@@ -29,19 +30,20 @@ class MesiModifiedPageFilter : public LRUMesiCache<PagedCache::Key,
 {
 public:
     /** Constructor */
-    MesiModifiedPageFilter(const Filename& filename) : filename_(filename) {};
+    MesiModifiedPageFilter(const Filename& filename)
+        : fileId_(FileIdRegistry::instance().intern(filename)) {};
 
     /** @return true if the page belongs to this file and is dirty */
     virtual bool filter(const PagedCache::Key& key,
                         const FilePageId& entry,
                         MesiCacheType::State state) const
     {
-        return ((key.filename == filename_) &&
+        return ((key.fileId == fileId_) &&
                 (MesiCacheType::MODIFIED == state));
     };
 
 private:
-    Filename filename_;
+    FileId fileId_;
 };
 
 /** Functor for finding dirty pages for a cached file */
@@ -50,18 +52,19 @@ class MesiFilePageFilter : public LRUMesiCache<PagedCache::Key,
 {
 public:
     /** Constructor */
-    MesiFilePageFilter(const Filename& filename) : filename_(filename) {};
+    MesiFilePageFilter(const Filename& filename)
+        : fileId_(FileIdRegistry::instance().intern(filename)) {};
 
     /** @return true if the page belongs to this file and is dirty */
     virtual bool filter(const PagedCache::Key& key,
                         const FilePageId& entry,
                         MesiCacheType::State state) const
     {
-        return (key.filename == filename_);
+        return (key.fileId == fileId_);
     };
 
 private:
-    Filename filename_;
+    FileId fileId_;
 };
 
 /** Name used for writeback messages */
@@ -529,11 +532,12 @@ void PagedMiddlewareCacheMesi::getResponsePages(
 {
     assert(0 != response);
     size_t numPages = response->getPageIdsArraySize();
-    Filename filename(response->getFilename());
+    FileId fileId =
+        FileIdRegistry::instance().intern(Filename(response->getFilename()));
     for (size_t i = 0; i < numPages; i++)
     {
         FilePageId pageId = response->getPageIds(i);
-        PagedCache::Key key(filename, pageId);
+        PagedCache::Key key(fileId, pageId);
         readPages.insert(key);
     }
 }
@@ -600,7 +604,7 @@ set<PagedCache::Key>
 PagedMiddlewareCacheMesi::lookupModifiedPagesInCache(const Filename& filename) const
 {
     MesiModifiedPageFilter filter(filename);
-    return lruCache_->getFilteredKeys(filter);
+    return lruCache_->getFilteredModifiedKeys(filter);
 }
 
 set<PagedCache::Key>
@@ -611,13 +615,12 @@ PagedMiddlewareCacheMesi::lookupPagesInCache(set<PagedCache::Key>& requestPages)
     set<PagedCache::Key>::iterator end = requestPages.end();
     while (iter != end)
     {
-        try
+        if (0 != lruCache_->find(*iter))
         {
-            PagedCache::Key key(iter->filename, iter->key);
-            lruCache_->lookup(key);
             cachedPages.insert(*iter);
             requestPages.erase(iter++);
-        } catch (NoSuchEntry& e)
+        }
+        else
         {
             // Lookup failed, increment to next entry
             iter++;
@@ -634,25 +637,18 @@ void PagedMiddlewareCacheMesi::trimExclusiveCachePages(
     set<PagedCache::Key>::iterator end = requestPages.end();
     while (iter != end)
     {
-        try
+        const MesiCacheType::EntryType* entry = lruCache_->find(*iter);
+        if (0 != entry &&
+            (MesiCacheType::EXCLUSIVE == entry->state ||
+             MesiCacheType::MODIFIED == entry->state))
         {
-            PagedCache::Key key(iter->filename, iter->key);
-            MesiCacheType::State state = lruCache_->lookupState(key);
-
-            if (MesiCacheType::EXCLUSIVE == state ||
-                MesiCacheType::MODIFIED == state)
-            {
-                exclusivePages.insert(*iter);
-                requestPages.erase(iter++);
-            }
-            else
-            {
-                ++iter;
-            }
-        } catch (NoSuchEntry& e)
+            exclusivePages.insert(*iter);
+            requestPages.erase(iter++);
+        }
+        else
         {
-            // Lookup failed, increment to next entry
-            iter++;
+            // Lookup failed or the page is shared, increment to next entry
+            ++iter;
         }
     }
 }
@@ -666,7 +662,7 @@ void PagedMiddlewareCacheMesi::updateCacheExclusivePages(
     {
         try
         {
-            PagedCache::Key key(iter->filename, iter->key);
+            PagedCache::Key key(iter->fileId, iter->key);
             lruCache_->setState(key, MesiCacheType::MODIFIED);
             ++iter;
         } catch (NoSuchEntry& e)
@@ -685,25 +681,21 @@ void PagedMiddlewareCacheMesi::updateCacheWithReadPages(set<PagedCache::Key>& up
     set<PagedCache::Key>::const_iterator iter;
     for (iter = updatePages.begin(); iter != updatePages.end(); iter++)
     {
-        try {
-            // Create an entry for the clean page even if the dirty page
-            // already exists
-            PagedCache::Key evictedKey(Filename("/"), 0);
-            FilePageId evictedPage = 0;
-            MesiCacheType::State evictedState = MesiCacheType::NULL_STATE;
+        // Create an entry for the clean page even if the dirty page
+        // already exists
+        PagedCache::Key evictedKey(*iter);
+        FilePageId evictedPage = 0;
+        MesiCacheType::State evictedState = MesiCacheType::NULL_STATE;
+        bool isEvicted =
             lruCache_->insertAndRecall(*iter, iter->key, MesiCacheType::SHARED,
                                        evictedKey,
                                        evictedPage,
                                        evictedState);
 
-            // Only add writeback if the eviction is dirty
-            if (MesiCacheType::MODIFIED == evictedState)
-            {
-                outWriteBacks.insert(evictedKey);
-            }
-        } catch (const NoSuchEntry& e)
+        // Only add writeback if the eviction is dirty
+        if (isEvicted && MesiCacheType::MODIFIED == evictedState)
         {
-            // No eviction was necessary
+            outWriteBacks.insert(evictedKey);
         }
     }
 }
@@ -715,25 +707,21 @@ void PagedMiddlewareCacheMesi::updateCacheWithWritePages(set<PagedCache::Key>& u
     set<PagedCache::Key>::const_iterator iter;
     for (iter = updatePages.begin(); iter != updatePages.end(); iter++)
     {
-        try {
-            // Create an entry for the clean page even if the dirty page
-            // already exists
-            PagedCache::Key evictedKey(Filename("/"), 0);
-            FilePageId evictedPage = 0;
-            MesiCacheType::State evictedState = MesiCacheType::NULL_STATE;
+        // Create an entry for the clean page even if the dirty page
+        // already exists
+        PagedCache::Key evictedKey(*iter);
+        FilePageId evictedPage = 0;
+        MesiCacheType::State evictedState = MesiCacheType::NULL_STATE;
+        bool isEvicted =
             lruCache_->insertAndRecall(*iter, iter->key, MesiCacheType::MODIFIED,
                                        evictedKey,
                                        evictedPage,
                                        evictedState);
 
-            // Only add writeback if the eviction is dirty
-            if (MesiCacheType::MODIFIED == evictedState)
-            {
-                outWriteBacks.insert(evictedKey);
-            }
-        } catch (const NoSuchEntry& e)
+        // Only add writeback if the eviction is dirty
+        if (isEvicted && MesiCacheType::MODIFIED == evictedState)
         {
-            // No eviction was necessary
+            outWriteBacks.insert(evictedKey);
         }
     }
 }
@@ -805,7 +793,7 @@ void PagedMiddlewareCacheMesi::clearDirectoryEntries(const set<PagedCache::Key>&
     while (iter != last)
     {
         directory.removeClientCacheEntryByRank(getRank(),
-                                               iter->filename,
+                                               iter->filename(),
                                                iter->key);
         iter++;
     }
@@ -967,6 +955,7 @@ set<PagedCache::Key> PagedMiddlewareCacheMesi::trimPendingWritePages(const set<P
 
 bool PagedMiddlewareCacheMesi::hasPendingPages(const Filename& filename) const
 {
+    FileId fileId = FileIdRegistry::instance().intern(filename);
     assert(0 != pendingPages_);
     RequestMap::const_iterator requestIter;
     RequestMap::const_iterator requestMapEnd = pendingPages_->end();;
@@ -977,7 +966,7 @@ bool PagedMiddlewareCacheMesi::hasPendingPages(const Filename& filename) const
         set<PagedCache::Key>::const_iterator end = pendingReads.end();
         while (iter != end)
         {
-            if (filename == iter->filename)
+            if (fileId == iter->fileId)
             {
                 return true;
             }
@@ -989,7 +978,7 @@ bool PagedMiddlewareCacheMesi::hasPendingPages(const Filename& filename) const
         end = pendingWrites.end();
         while (iter != end)
         {
-            if (filename == iter->filename)
+            if (fileId == iter->fileId)
             {
                 return true;
             }
@@ -12,6 +12,7 @@
 #include <functional>
 #include "comm_man.h"
 #include "file_builder.h"
+#include "file_id_registry.h"
 #include "mpi_proto_m.h"
 using namespace std;
 
@@ -20,18 +21,19 @@ class FilePageFilter : public MultiCache::FilterFunctor
 {
 public:
     /** Constructor */
-    FilePageFilter(const Filename& filename) : filename_(filename) {};
+    FilePageFilter(const Filename& filename)
+        : fileId_(FileIdRegistry::instance().intern(filename)) {};
 
     /** @return true if the page belongs to this file */
     virtual bool filter(const MultiCache::Key& key,
                         const MultiCache::Page& pageId,
                         bool isDirty) const
     {
-        return (key.filename == filename_);
+        return (key.fileId == fileId_);
     }
 
 private:
-    Filename filename_;
+    FileId fileId_;
 };
 
 /** Functor for finding dirty pages for a cached file */
@@ -39,18 +41,19 @@ class DirtyPageFilter : public MultiCache::FilterFunctor
 {
 public:
     /** Constructor */
-    DirtyPageFilter(const Filename& filename) : filename_(filename) {};
+    DirtyPageFilter(const Filename& filename)
+        : fileId_(FileIdRegistry::instance().intern(filename)) {};
 
     /** @return true if the page belongs to this file and is dirty */
     virtual bool filter(const MultiCache::Key& key,
                         const MultiCache::Page& value,
                         bool isDirty) const
     {
-        return ((key.filename == filename_) && isDirty);
+        return ((key.fileId == fileId_) && isDirty);
     }
 
 private:
-    Filename filename_;
+    FileId fileId_;
 };
 
 // OMNet Registration Method
@@ -652,7 +655,7 @@ void PagedMiddlewareCacheWithTwin::beginWritebackEvictions(
             assert(0 != page);
             if (0 == dynamic_cast<MultiCache::PartialPage*>(page))
             {
-                Filename filename = writebackPages[i].first.filename;
+                Filename filename = writebackPages[i].first.filename();
                 FilePageId pageId = page->id;
                 fullPagesMap[filename].insert(pageId);
                 delete page;
@@ -666,7 +669,7 @@ void PagedMiddlewareCacheWithTwin::beginWritebackEvictions(
         // Create and send the requests for the partial pages
         for (size_t i = 0; i < partialPages.size(); i++)
         {
-            Filename filename = partialPages[i].first.filename;
+            Filename filename = partialPages[i].first.filename();
             MultiCache::PartialPage* page =
                 static_cast<MultiCache::PartialPage*>(partialPages[i].second);
             FileRegionSet::iterator regIter = page->regions.begin();
@@ -721,11 +724,11 @@ void PagedMiddlewareCacheWithTwin::beginRead(
     // Collect the page ids
     set<PagedCache::Key>::iterator iter = readPages.begin();
     set<PagedCache::Key>::iterator end = readPages.end();
-    Filename filename = iter->filename;
+    Filename filename = iter->filename();
     set<FilePageId> pages;
     while (iter != end)
     {
-        assert(filename == iter->filename);
+        assert(filename == iter->filename());
         pages.insert(iter->key);
         ++iter;
     }
@@ -742,6 +745,7 @@ PagedMiddlewareCacheWithTwin::lookupDirtyPagesInCache(const Filename& filename)
     vector<CacheEntry> dirtyEntries;
     DirtyPageFilter filter(filename);
     vector<MultiCache::Page*> dirtyPages = lruCache_->getFilteredEntries(filter);
+    FileId fileId = FileIdRegistry::instance().intern(filename);
     for (size_t i = 0; i < dirtyPages.size(); i++)
     {
         // Copy the pages
@@ -757,7 +761,7 @@ PagedMiddlewareCacheWithTwin::lookupDirtyPagesInCache(const Filename& filename)
             pageCopy = new MultiCache::PartialPage(*partial);
         }
 
-        MultiCache::Key key(filename, pageCopy->id);
+        MultiCache::Key key(fileId, pageCopy->id);
         dirtyEntries.push_back(make_pair(key, pageCopy));
     }
     return dirtyEntries;
@@ -772,7 +776,7 @@ set<PagedCache::Key>PagedMiddlewareCacheWithTwin::lookupPagesInCache(set<PagedCa
     {
         try
         {
-            MultiCache::Key key(iter->filename, iter->key);
+            MultiCache::Key key(iter->fileId, iter->key);
             lruCache_->lookup(key);
             cachedPages.insert(*iter);
             requestPages.erase(iter++);
@@ -795,11 +799,11 @@ void PagedMiddlewareCacheWithTwin::updateCacheWithReadPages(set<PagedCache::Key>
         try {
             // Create an entry for the clean page even if the dirty page
             // already exists
-            MultiCache::Key key(iter->filename, iter->key);
+            MultiCache::Key key(iter->fileId, iter->key);
             MultiCache::Page page;
             page.id = iter->key;
 
-            MultiCache::Key evictedKey(Filename("/"), 0);
+            MultiCache::Key evictedKey(key);
             MultiCache::Page* evictedPage = 0;
             bool isEvictedDirty = false;
             lruCache_->insertFullPageAndRecall(key, page, false,
@@ -830,7 +834,8 @@ void PagedMiddlewareCacheWithTwin::updateCacheWithReadPageUpdates(
     getRequestCachePages(writeAt, fullPages, partialPages);
 
     // Find the partial pages updated by this request
-    Filename filename = writeAt->getFileDes()->getFilename();
+    FileId fileId = FileIdRegistry::instance().intern(
+        writeAt->getFileDes()->getFilename());
     set<PagedCache::Key>::const_iterator iter = requestPages.begin();
     set<PagedCache::Key>::const_iterator end = requestPages.end();
     while (iter != end)
@@ -845,8 +850,8 @@ void PagedMiddlewareCacheWithTwin::updateCacheWithReadPageUpdates(
 
                 // Now perform the cache update
                 try {
-                    MultiCache::Key key(filename, partialPages[i].id);
-                    MultiCache::Key evictedKey(Filename("/"), 0);
+                    MultiCache::Key key(fileId, partialPages[i].id);
+                    MultiCache::Key evictedKey(key);
                     MultiCache::Page* evictedPage = 0;
                     bool isEvictedDirty = false;
                     lruCache_->insertDirtyPartialPageAndRecall(key, partialPages[i],
@@ -886,10 +891,11 @@ void PagedMiddlewareCacheWithTwin::updateCacheWithWritePages(
     vector<CacheEntry>& outWritebacks)
 {
     // Update the cache with full pages and accumulate any writebacks
+    FileId fileId = FileIdRegistry::instance().intern(filename);
     for (size_t i = 0; i < fullPages.size(); i++)
     {
-        MultiCache::Key key(filename, fullPages[i].id);
-        MultiCache::Key evictedKey(Filename("/"), 0);
+        MultiCache::Key key(fileId, fullPages[i].id);
+        MultiCache::Key evictedKey(key);
         MultiCache::Page* evictedPage = 0;
         bool isEvictedDirty = false;
         try {
@@ -913,8 +919,8 @@ void PagedMiddlewareCacheWithTwin::updateCacheWithWritePages(
     // Update the cache with partial pages
     for (size_t i = 0; i < partialPages.size(); i++)
     {
-        MultiCache::Key key(filename, partialPages[i].id);
-        MultiCache::Key evictedKey(Filename("/"), 0);
+        MultiCache::Key key(fileId, partialPages[i].id);
+        MultiCache::Key evictedKey(key);
         MultiCache::Page* evictedPage = 0;
         bool isEvictedDirty = false;
         try {
@@ -954,11 +960,12 @@ void PagedMiddlewareCacheWithTwin::flushCache(const Filename& flushName)
             begin++;
         }
 
+        FileId fileId = FileIdRegistry::instance().intern(flushName);
         set<FilePageId>::const_iterator pageBegin = pageIds.begin();
         set<FilePageId>::const_iterator pageEnd = pageIds.end();
         while (pageBegin != pageEnd)
         {
-            MultiCache::Key removeKey(flushName, *pageBegin);
+            MultiCache::Key removeKey(fileId, *pageBegin);
             lruCache_->remove(removeKey);
             pageBegin++;
         }
@@ -1021,7 +1028,7 @@ void PagedMiddlewareCacheWithTwin::registerPendingWritePages(spfsMPIFileRequest*
         if (0 == dynamic_cast<MultiCache::PartialPage*>(page))
         {
             // Add the full pages to the in process list
-            PagedCache::Key writePage(pendingWrites[i].first.filename, page->id);
+            PagedCache::Key writePage(pendingWrites[i].first.fileId, page->id);
             inProcess.writePages.insert(writePage);
         }
         else
@@ -1074,9 +1081,10 @@ void PagedMiddlewareCacheWithTwin::resolvePendingReadPages(const Filename& filen
                                                            const vector<MultiCache::Page>& readPages)
 {
     set<PagedCache::Key> readKeys;
+    FileId fileId = FileIdRegistry::instance().intern(filename);
     for (size_t i = 0; i < readPages.size(); i++)
     {
-        PagedCache::Key key(filename, readPages[i].id);
+        PagedCache::Key key(fileId, readPages[i].id);
         readKeys.insert(key);
     }
     resolvePendingReadPages(readKeys);
@@ -1205,6 +1213,7 @@ set<PagedCache::Key> PagedMiddlewareCacheWithTwin::trimPendingWritePages(const s
 
 bool PagedMiddlewareCacheWithTwin::hasPendingPages(const Filename& filename) const
 {
+    FileId fileId = FileIdRegistry::instance().intern(filename);
     RequestMap::const_iterator requestIter;
     RequestMap::const_iterator requestMapEnd = pendingPages_->end();;
     for (requestIter = pendingPages_->begin(); requestIter != requestMapEnd; requestIter++)
@@ -1214,7 +1223,7 @@ bool PagedMiddlewareCacheWithTwin::hasPendingPages(const Filename& filename) con
         set<PagedCache::Key>::const_iterator end = pendingReads.end();
         while (iter != end)
         {
-            if (filename == iter->filename)
+            if (fileId == iter->fileId)
             {
                 return true;
             }
@@ -1226,7 +1235,7 @@ bool PagedMiddlewareCacheWithTwin::hasPendingPages(const Filename& filename) con
         end = pendingWrites.end();
         while (iter != end)
         {
-            if (filename == iter->filename)
+            if (fileId == iter->fileId)
             {
                 return true;
             }
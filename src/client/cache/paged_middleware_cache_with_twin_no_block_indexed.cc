@@ -12,6 +12,7 @@
 #include <functional>
 #include "comm_man.h"
 #include "file_builder.h"
+#include "file_id_registry.h"
 #include "mpi_proto_m.h"
 using namespace std;
 
@@ -20,18 +21,19 @@ class FilePageFilter : public MultiCache::FilterFunctor
 {
 public:
     /** Constructor */
-    FilePageFilter(const Filename& filename) : filename_(filename) {};
+    FilePageFilter(const Filename& filename)
+        : fileId_(FileIdRegistry::instance().intern(filename)) {};
 
     /** @return true if the page belongs to this file */
     virtual bool filter(const MultiCache::Key& key,
                         const MultiCache::Page& pageId,
                         bool isDirty) const
     {
-        return (key.filename == filename_);
+        return (key.fileId == fileId_);
     }
 
 private:
-    Filename filename_;
+    FileId fileId_;
 };
 
 /** Functor for finding dirty pages for a cached file */
@@ -39,18 +41,19 @@ class DirtyPageFilter : public MultiCache::FilterFunctor
 {
 public:
     /** Constructor */
-    DirtyPageFilter(const Filename& filename) : filename_(filename) {};
+    DirtyPageFilter(const Filename& filename)
+        : fileId_(FileIdRegistry::instance().intern(filename)) {};
 
     /** @return true if the page belongs to this file and is dirty */
     virtual bool filter(const MultiCache::Key& key,
                         const MultiCache::Page& value,
                         bool isDirty) const
     {
-        return ((key.filename == filename_) && isDirty);
+        return ((key.fileId == fileId_) && isDirty);
     }
 
 private:
-    Filename filename_;
+    FileId fileId_;
 };
 
 // OMNet Registration Method
@@ -692,7 +695,7 @@ void PagedMiddlewareCacheWithTwinNoBlockIndexed::beginWritebackEvictions(
             assert(0 != page);
             if (0 == dynamic_cast<MultiCache::PartialPage*>(page))
             {
-                Filename filename = writebackPages[i].first.filename;
+                Filename filename = writebackPages[i].first.filename();
                 FilePageId pageId = page->id;
                 fullPagesMap[filename].insert(pageId);
                 delete page;
@@ -706,7 +709,7 @@ void PagedMiddlewareCacheWithTwinNoBlockIndexed::beginWritebackEvictions(
         // Create and send the requests for the partial pages
         for (size_t i = 0; i < partialPages.size(); i++)
         {
-            Filename filename = partialPages[i].first.filename;
+            Filename filename = partialPages[i].first.filename();
             MultiCache::PartialPage* page =
                 static_cast<MultiCache::PartialPage*>(partialPages[i].second);
             FileRegionSet::iterator regIter = page->regions.begin();
@@ -775,12 +778,12 @@ void PagedMiddlewareCacheWithTwinNoBlockIndexed::beginRead(
     // Collect the page ids
     set<PagedCache::Key>::iterator iter = readPages.begin();
     set<PagedCache::Key>::iterator end = readPages.end();
-    Filename filename = iter->filename;
+    Filename filename = iter->filename();
     set<FilePageId> pages;
     while (iter != end)
     {
         // Create the file descriptor
-        Filename name = iter->filename;
+        Filename name = iter->filename();
         FilePageId page = iter->key;
         static DataType* byteType = new ByteDataType();
         FileDescriptor* fd = FileBuilder::instance().getDescriptor(name);
@@ -803,6 +806,7 @@ PagedMiddlewareCacheWithTwinNoBlockIndexed::lookupDirtyPagesInCache(const Filena
     vector<CacheEntry> dirtyEntries;
     DirtyPageFilter filter(filename);
     vector<MultiCache::Page*> dirtyPages = lruCache_->getFilteredEntries(filter);
+    FileId fileId = FileIdRegistry::instance().intern(filename);
     for (size_t i = 0; i < dirtyPages.size(); i++)
     {
         // Copy the pages
@@ -818,7 +822,7 @@ PagedMiddlewareCacheWithTwinNoBlockIndexed::lookupDirtyPagesInCache(const Filena
             pageCopy = new MultiCache::PartialPage(*partial);
         }
 
-        MultiCache::Key key(filename, pageCopy->id);
+        MultiCache::Key key(fileId, pageCopy->id);
         dirtyEntries.push_back(make_pair(key, pageCopy));
     }
     return dirtyEntries;
@@ -833,7 +837,7 @@ set<PagedCache::Key> PagedMiddlewareCacheWithTwinNoBlockIndexed::lookupPagesInCa
     {
         try
         {
-            MultiCache::Key key(iter->filename, iter->key);
+            MultiCache::Key key(iter->fileId, iter->key);
             lruCache_->lookup(key);
             foundPages.insert(*iter);
             requestPages.erase(iter++);
@@ -856,11 +860,11 @@ void PagedMiddlewareCacheWithTwinNoBlockIndexed::updateCacheWithReadPages(set<Pa
         try {
             // Create an entry for the clean page even if the dirty page
             // already exists
-            MultiCache::Key key(iter->filename, iter->key);
+            MultiCache::Key key(iter->fileId, iter->key);
             MultiCache::Page page;
             page.id = iter->key;
 
-            MultiCache::Key evictedKey(Filename("/"), 0);
+            MultiCache::Key evictedKey(key);
             MultiCache::Page* evictedPage = 0;
             bool isEvictedDirty = false;
             lruCache_->insertFullPageAndRecall(key, page, false,
@@ -890,7 +894,8 @@ void PagedMiddlewareCacheWithTwinNoBlockIndexed::updateCacheWithReadPageUpdates(
     getRequestCachePages(writeAt, fullPages, partialPages);
 
     // Find the partial pages updated by this request
-    Filename filename = writeAt->getFileDes()->getFilename();
+    FileId fileId = FileIdRegistry::instance().intern(
+        writeAt->getFileDes()->getFilename());
     set<PagedCache::Key>::const_iterator iter = requestPages.begin();
     set<PagedCache::Key>::const_iterator end = requestPages.end();
     while (iter != end)
@@ -905,8 +910,8 @@ void PagedMiddlewareCacheWithTwinNoBlockIndexed::updateCacheWithReadPageUpdates(
 
                 // Now perform the cache update
                 try {
-                    MultiCache::Key key(filename, partialPages[i].id);
-                    MultiCache::Key evictedKey(Filename("/"), 0);
+                    MultiCache::Key key(fileId, partialPages[i].id);
+                    MultiCache::Key evictedKey(key);
                     MultiCache::Page* evictedPage = 0;
                     bool isEvictedDirty = false;
                      lruCache_->insertDirtyPartialPageAndRecall(key, partialPages[i],
@@ -938,10 +943,11 @@ void PagedMiddlewareCacheWithTwinNoBlockIndexed::updateCacheWithWritePages(
     vector<CacheEntry>& outWritebacks)
 {
     // Update the cache with full pages and accumulate any writebacks
+    FileId fileId = FileIdRegistry::instance().intern(filename);
     for (size_t i = 0; i < fullPages.size(); i++)
     {
-        MultiCache::Key key(filename, fullPages[i].id);
-        MultiCache::Key evictedKey(Filename("/"), 0);
+        MultiCache::Key key(fileId, fullPages[i].id);
+        MultiCache::Key evictedKey(key);
         MultiCache::Page* evictedPage = 0;
         bool isEvictedDirty = false;
         try {
@@ -965,8 +971,8 @@ void PagedMiddlewareCacheWithTwinNoBlockIndexed::updateCacheWithWritePages(
     // Update the cache with partial pages
     for (size_t i = 0; i < partialPages.size(); i++)
     {
-        MultiCache::Key key(filename, partialPages[i].id);
-        MultiCache::Key evictedKey(Filename("/"), 0);
+        MultiCache::Key key(fileId, partialPages[i].id);
+        MultiCache::Key evictedKey(key);
         MultiCache::Page* evictedPage = 0;
         bool isEvictedDirty = false;
         try {
@@ -1006,11 +1012,12 @@ void PagedMiddlewareCacheWithTwinNoBlockIndexed::flushCache(const Filename& flus
             begin++;
         }
 
+        FileId fileId = FileIdRegistry::instance().intern(flushName);
         set<FilePageId>::const_iterator pageBegin = pageIds.begin();
         set<FilePageId>::const_iterator pageEnd = pageIds.end();
         while (pageBegin != pageEnd)
         {
-            MultiCache::Key removeKey(flushName, *pageBegin);
+            MultiCache::Key removeKey(fileId, *pageBegin);
             lruCache_->remove(removeKey);
             pageBegin++;
         }
@@ -1073,7 +1080,7 @@ void PagedMiddlewareCacheWithTwinNoBlockIndexed::registerPendingWritePages(spfsM
         if (0 == dynamic_cast<MultiCache::PartialPage*>(page))
         {
             // Add the full pages to the in process list
-            PagedCache::Key writePage(pendingWrites[i].first.filename, page->id);
+            PagedCache::Key writePage(pendingWrites[i].first.fileId, page->id);
             inProcess.writePages.insert(writePage);
         }
         else
@@ -1126,9 +1133,10 @@ void PagedMiddlewareCacheWithTwinNoBlockIndexed::resolvePendingReadPages(const F
                                                            const vector<MultiCache::Page>& readPages)
 {
     set<PagedCache::Key> readKeys;
+    FileId fileId = FileIdRegistry::instance().intern(filename);
     for (size_t i = 0; i < readPages.size(); i++)
     {
-        PagedCache::Key key(filename, readPages[i].id);
+        PagedCache::Key key(fileId, readPages[i].id);
         readKeys.insert(key);
     }
     resolvePendingReadPages(readKeys);
@@ -1257,6 +1265,7 @@ set<PagedCache::Key> PagedMiddlewareCacheWithTwinNoBlockIndexed::trimPendingWrit
 
 bool PagedMiddlewareCacheWithTwinNoBlockIndexed::hasPendingPages(const Filename& filename) const
 {
+    FileId fileId = FileIdRegistry::instance().intern(filename);
     RequestMap::const_iterator requestIter;
     RequestMap::const_iterator requestMapEnd = pendingPages_->end();;
     for (requestIter = pendingPages_->begin(); requestIter != requestMapEnd; requestIter++)
@@ -1266,7 +1275,7 @@ bool PagedMiddlewareCacheWithTwinNoBlockIndexed::hasPendingPages(const Filename&
         set<PagedCache::Key>::const_iterator end = pendingReads.end();
         while (iter != end)
         {
-            if (filename == iter->filename)
+            if (fileId == iter->fileId)
             {
                 return true;
             }
@@ -1278,7 +1287,7 @@ bool PagedMiddlewareCacheWithTwinNoBlockIndexed::hasPendingPages(const Filename&
         end = pendingWrites.end();
         while (iter != end)
         {
-            if (filename == iter->filename)
+            if (fileId == iter->fileId)
             {
                 return true;
             }
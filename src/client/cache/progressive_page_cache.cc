@@ -13,13 +13,13 @@ using namespace std;
 
 bool operator<(const ProgressivePageCache::Key& lhs, const ProgressivePageCache::Key& rhs)
 {
-    if (lhs.filename == rhs.filename)
+    if (lhs.fileId == rhs.fileId)
     {
         return (lhs.key < rhs.key);
     }
     else
     {
-        return (lhs.filename < rhs.filename);
+        return (lhs.fileId < rhs.fileId);
     }
 }
 
@@ -277,7 +277,7 @@ void ProgressivePageCache::print(ostream& ost) const
     while (iter != last)
     {
         ost << "\t"
-            << "[" << iter->first.filename << "," << iter->first.key
+            << "[" << iter->first.filename() << "," << iter->first.key
             << " -> "
             << "[" << iter->second->page->id << ","
             << "[" << iter->second->page->regions << ","
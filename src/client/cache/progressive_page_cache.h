@@ -14,8 +14,9 @@
 #include <list>
 #include <map>
 #include <vector>
-#include "file_page.h"
 #include "dirty_file_region_set.h"
+#include "file_id_registry.h"
+#include "file_page.h"
 #include "filename.h"
 #include "spfs_exceptions.h"
 
@@ -31,10 +32,16 @@ public:
     {
     public:
         /** Constructor */
-        Key(const Filename& fn, std::size_t k) : filename(fn), key(k) {};
+        Key(FileId id, std::size_t k) : fileId(id), key(k) {};
+
+        /** @return the filename to store data in cache for */
+        const Filename& filename() const
+        {
+            return FileIdRegistry::instance().getFilename(fileId);
+        };
 
-        /** Filename to store data in cache for */
-        Filename filename;
+        /** Interned id of the file to store data in cache for */
+        FileId fileId;
 
         /** Key to identify a page (usually just the page id) */
         std::size_t key;
@@ -12,6 +12,7 @@
 #include <functional>
 #include "comm_man.h"
 #include "dirty_file_region_set.h"
+#include "file_id_registry.h"
 #include "file_page_utils.h"
 #include "mpi_proto_m.h"
 #include "page_access_mixin.h"
@@ -27,18 +28,19 @@ class DirtyPageFilter : public ProgressivePagedMiddlewareCache::FileDataPageCach
 {
 public:
     /** Constructor */
-    DirtyPageFilter(const Filename& filename) : filename_(filename) {};
+    DirtyPageFilter(const Filename& filename)
+        : fileId_(FileIdRegistry::instance().intern(filename)) {};
 
     /** @return true if the page belongs to this file and is dirty */
     virtual bool filter(const ProgressivePagedMiddlewareCache::Key& key,
                         const ProgressivePagedMiddlewareCache::ProgressivePage& entry,
                         bool isDirty) const
     {
-        return ((key.filename == filename_) && (isDirty));
+        return ((key.fileId == fileId_) && (isDirty));
     };
 
 private:
-    Filename filename_;
+    FileId fileId_;
 };
 
 /** Functor for finding all pages for a cached file */
@@ -46,18 +48,19 @@ class FilePageFilter : public ProgressivePagedMiddlewareCache::FileDataPageCache
 {
 public:
     /** Constructor */
-    FilePageFilter(const Filename& filename) : filename_(filename) {};
+    FilePageFilter(const Filename& filename)
+        : fileId_(FileIdRegistry::instance().intern(filename)) {};
 
     /** @return true if the page belongs to this file and is dirty */
     virtual bool filter(const ProgressivePagedMiddlewareCache::Key& key,
                         const ProgressivePagedMiddlewareCache::ProgressivePage& entry,
                         bool isDirty) const
     {
-        return (key.filename == filename_);
+        return (key.fileId == fileId_);
     };
 
 private:
-    Filename filename_;
+    FileId fileId_;
 };
 
 
@@ -444,11 +447,12 @@ void ProgressivePagedMiddlewareCache::getRequestCachePages(
                                                                fd->getFileView());
 
     // Convert file pages into cache keys
+    FileId fileId = FileIdRegistry::instance().intern(fd->getFilename());
     set<FilePageId>::const_iterator iter = requestPages.begin();
     set<FilePageId>::const_iterator end = requestPages.end();
     while (iter != end)
     {
-        Key k(fd->getFilename(), *(iter++));
+        Key k(fileId, *(iter++));
         outRequestPages.insert(k);
     }
 }
@@ -464,7 +468,7 @@ void ProgressivePagedMiddlewareCache::beginRead(const set<Key>& readPages,
     set<PagedCache::Key> pageKeys;
     while (iter != end)
     {
-        PagedCache::Key key(iter->filename, iter->key);
+        PagedCache::Key key(iter->fileId, iter->key);
         pageKeys.insert(key);
         ++iter;
     }
@@ -560,7 +564,7 @@ void ProgressivePagedMiddlewareCache::updateCache(const std::set<Key>& updatePag
             // If the updates are dirty, then insert them into the cache
             // otherwise, if an existing entry isn't already dirty then
             //   insert the entry into the cache
-            Key evictedKey(Filename("/"), 0);
+            Key evictedKey(*iter);
             ProgressivePage* evictedValue = 0;
             bool isEvictedDirty = false;
 
@@ -571,7 +575,7 @@ void ProgressivePagedMiddlewareCache::updateCache(const std::set<Key>& updatePag
             // Only add writeback if the eviction is dirty
             if (isEvictedDirty)
             {
-                WritebackPage w = {evictedKey.filename,
+                WritebackPage w = {evictedKey.filename(),
                                    evictedKey.key,
                                    evictedValue->regions};
                 outWriteBacks.push_back(w);
@@ -600,6 +604,7 @@ void ProgressivePagedMiddlewareCache::updateCache(spfsMPIFileWriteAtRequest* wri
                                                           size,
                                                           fd->getFileView());
 
+    FileId fileId = FileIdRegistry::instance().intern(fd->getFilename());
     set<FilePageId>::const_iterator end = pageIds.end();
     for (set<FilePageId>::const_iterator iter = pageIds.begin() ; iter != end; ++iter)
     {
@@ -612,13 +617,13 @@ void ProgressivePagedMiddlewareCache::updateCache(spfsMPIFileWriteAtRequest* wri
         assert(0 < dirtyRegions.size());
 
         // Create the cache entry
-        Key newKey(fd->getFilename(), *iter);
+        Key newKey(fileId, *iter);
         ProgressivePage newPage = {*iter, dirtyRegions};
         try {
             // If the updates are dirty, then insert them into the cache
             // otherwise, if an existing entry isn't already dirty then
             //   insert the entry into the cache
-            Key evictedKey(Filename("/"), 0);
+            Key evictedKey(newKey);
             ProgressivePage* evictedValue = 0;
             bool isEvictedDirty = false;
 
@@ -629,7 +634,7 @@ void ProgressivePagedMiddlewareCache::updateCache(spfsMPIFileWriteAtRequest* wri
             // Only add writeback if the eviction is dirty
             if (isEvictedDirty)
             {
-                WritebackPage w = {evictedKey.filename,
+                WritebackPage w = {evictedKey.filename(),
                                    evictedKey.key,
                                    evictedValue->regions};
                 outWriteBacks.push_back(w);
@@ -650,6 +655,7 @@ void ProgressivePagedMiddlewareCache::flushCache(const Filename& flushName)
     if (0 == (*openFileCounts_)[flushName])
     {
         FilePageFilter filter(flushName);
+        FileId fileId = FileIdRegistry::instance().intern(flushName);
         vector<ProgressivePage*> flushEntries = lruCache_->getFilteredEntries(filter);
         vector<ProgressivePage*>::const_iterator iter = flushEntries.begin();
         vector<ProgressivePage*>::const_iterator end = flushEntries.end();
@@ -657,7 +663,7 @@ void ProgressivePagedMiddlewareCache::flushCache(const Filename& flushName)
         {
             try
             {
-                Key removeKey(flushName, (*iter)->id);
+                Key removeKey(fileId, (*iter)->id);
                 lruCache_->remove(removeKey);
                 delete *iter;
                 iter++;
@@ -793,6 +799,7 @@ vector<spfsMPIFileRequest*> ProgressivePagedMiddlewareCache::popCompletedRequest
 
 bool ProgressivePagedMiddlewareCache::hasPendingData(const Filename& filename) const
 {
+    FileId fileId = FileIdRegistry::instance().intern(filename);
     RequestMap::const_iterator requestIter;
     RequestMap::const_iterator requestMapEnd = pendingRequests_->end();
     for (requestIter = pendingRequests_->begin(); requestIter != requestMapEnd; requestIter++)
@@ -802,7 +809,7 @@ bool ProgressivePagedMiddlewareCache::hasPendingData(const Filename& filename) c
         set<Key>::const_iterator end = pendingReads.end();
         while (iter != end)
         {
-            if (filename == iter->filename)
+            if (fileId == iter->fileId)
             {
                 return true;
             }
@@ -52,7 +52,8 @@ SharedDirectPagedMiddlewareCache::createFileDataPageCache(size_t cacheSize)
     }
     else
     {
-        cache = new DirectPagedMiddlewareCache::FileDataPageCache(cacheSize);
+        cache = new DirectPagedMiddlewareCache::FileDataPageCache(
+            cacheSize, par("replacementPolicy").stringValue());
         sharedCacheMap_[cpun] = cache;
     }
     return cache;
@@ -186,10 +186,10 @@ spfsReadRequest* FSClient::createReadRequest(const FSHandle& handle,
 {
     spfsReadRequest* read = new spfsReadRequest(0, SPFS_READ_REQUEST);
     read->setHandle(handle);
-    read->setView(new FileView(view));
+    read->setView(view);
     read->setOffset(offset);
     read->setDataSize(dataSize);
-    read->setDist(dist.clone());
+    read->setDist(&dist);
     read->setClientFlowBmiTag(simulation.getUniqueNumber());
     read->setServerFlowBmiTag(simulation.getUniqueNumber());
 
@@ -254,10 +254,10 @@ spfsWriteRequest* FSClient::createWriteRequest(const FSHandle& metaHandle,
     spfsWriteRequest* write = new spfsWriteRequest(0, SPFS_WRITE_REQUEST);
     write->setMetaHandle(metaHandle);
     write->setHandle(dataHandle);
-    write->setView(new FileView(view));
+    write->setView(view);
     write->setOffset(offset);
     write->setDataSize(dataSize);
-    write->setDist(dist.clone());
+    write->setDist(&dist);
     write->setClientFlowBmiTag(simulation.getUniqueNumber());
     write->setServerFlowBmiTag(simulation.getUniqueNumber());
 
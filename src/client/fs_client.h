@@ -81,7 +81,10 @@ public:
     static spfsReadDirRequest* createReadDirRequest(const FSHandle& handle,
                                                     std::size_t dirEntCount);
 
-    /** @return a new Read Request */
+    /**
+     * @return a new Read Request that shares view's data type and refers to
+     *   dist, which must outlive the request
+     */
     static spfsReadRequest* createReadRequest(const FSHandle& handle,
                                               const FileView& view,
                                               FSOffset offset,
@@ -100,7 +103,10 @@ public:
     static spfsSetAttrRequest* createSetAttrRequest(const FSHandle& handle,
                                                     FSObjectType objectType);
 
-    /** @return a new Write Request */
+    /**
+     * @return a new Write Request that shares view's data type and refers to
+     *   dist, which must outlive the request
+     */
     static spfsWriteRequest* createWriteRequest(const FSHandle& metaHandle,
                                                 const FSHandle& dataHandle,
                                                 const FileView& view,
@@ -9,6 +9,7 @@
 //#define FSM_DEBUG  // Enable FSM Debug output
 #include "fs_read_sm.h"
 #include <cassert>
+#include <vector>
 #include <omnetpp.h>
 #include "data_flow.h"
 #include "data_type_layout.h"
@@ -137,7 +138,20 @@ void FSReadSM::enterRead()
     read.setContextPointer(readRequest_);
     read.setMetaHandle(metaData->handle);
     read.setOffset(readRequest_->getOffset());
-    read.setView(new FileView(fd->getFileView()));
+    read.setView(fd->getFileView());
+
+    // Determine the data assigned to every server in a single pass
+    // (the write byte counts ensure the stream size won't limit the data
+    //  distribution, while the read byte counts are the actual data to send)
+    vector<DataTypeProcessor::ServerLayoutSummary> serverLayouts;
+    FSSize aggregateSize = DataTypeProcessor::createClientFileLayouts(
+        readRequest_->getOffset(),
+        *readRequest_->getDataType(),
+        readRequest_->getCount(),
+        read.getView(),
+        *metaData->dist,
+        metaData->bstreamSizes,
+        serverLayouts);
 
     // Send request to each server
     int numRequests = 0;
@@ -145,31 +159,12 @@ void FSReadSM::enterRead()
     int numServers = metaData->dataHandles.size();
     for (int i = 0; i < numServers; i++)
     {
-        // Process the data to determine if any data could be on this server
-        // (must use the client write processor to ensure the stream size won't
-        //  limit the data distribution)
-        metaData->dist->setObjectIdx(i);
-        FSSize aggregateSize = 0;
-        FSSize serverBytes = DataTypeProcessor::createClientFileLayoutForWrite(
-            readRequest_->getOffset(),
-            *readRequest_->getDataType(),
-            readRequest_->getCount(),
-            *read.getView(),
-            *metaData->dist,
-            aggregateSize);
+        // Determine if any data could be on this server
+        FSSize serverBytes = serverLayouts[i].writeBytes;
 
         if (0 != serverBytes)
         {
-            // Now re-process the data using the client read functionality
-            // to figure out the actual data to send to server
-            FSSize reqBytes = DataTypeProcessor::createClientFileLayoutForRead(
-                readRequest_->getOffset(),
-                *readRequest_->getDataType(),
-                readRequest_->getCount(),
-                *read.getView(),
-                *metaData->dist,
-                metaData->bstreamSizes[i],
-                aggregateSize);
+            FSSize reqBytes = serverLayouts[i].readBytes;
 
             // Create a request for the server
             spfsReadRequest* req = static_cast<spfsReadRequest*>(read.dup());
@@ -186,7 +181,7 @@ void FSReadSM::enterRead()
             if (0 != reqBytes)
             {
                 req->setAutoCleanup(false);
-                req->setDist(metaData->dist->clone());
+                req->setDist(metaData->dist->getObjectDistribution(i));
                 req->setClientFlowBmiTag(simulation.getUniqueNumber());
                 req->setServerFlowBmiTag(simulation.getUniqueNumber());
                 startFlow(req);
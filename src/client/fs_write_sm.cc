@@ -9,6 +9,7 @@
 #include "fs_write_sm.h"
 #include <cassert>
 #include <numeric>
+#include <vector>
 #include <omnetpp.h>
 #include "data_flow.h"
 #include "data_type_processor.h"
@@ -131,21 +132,23 @@ void FSWriteSM::beginWrite()
     FileDescriptor* fd = writeRequest_->getFileDes();
     const FSMetaData* metaData = fd->getMetaData();
 
+    // Process the data type once to determine the write size for each server
+    vector<DataTypeProcessor::ServerLayoutSummary> serverLayouts;
+    FSSize aggregateSize = DataTypeProcessor::createClientFileLayouts(
+        writeRequest_->getOffset(),
+        *writeRequest_->getDataType(),
+        writeRequest_->getCount(),
+        fd->getFileView(),
+        *metaData->dist,
+        metaData->bstreamSizes,
+        serverLayouts);
+
     // Send request to each server
     int numRequests = 0;
     int numServers = metaData->dataHandles.size();
     for (int i = 0; i < numServers; i++)
     {
-        // Process the data type to determine the write size
-        metaData->dist->setObjectIdx(i);
-        FSSize aggregateSize = 0;
-        FSSize reqBytes = DataTypeProcessor::createClientFileLayoutForWrite(
-            writeRequest_->getOffset(),
-            *writeRequest_->getDataType(),
-            writeRequest_->getCount(),
-            fd->getFileView(),
-            *metaData->dist,
-            aggregateSize);
+        FSSize reqBytes = serverLayouts[i].writeBytes;
 
         // Send write request if server hosts data
         if (0 != reqBytes)
@@ -156,7 +159,7 @@ void FSWriteSM::beginWrite()
                 fd->getFileView(),
                 writeRequest_->getOffset(),
                 aggregateSize,
-                *(metaData->dist));
+                *(metaData->dist->getObjectDistribution(i)));
             req->setContextPointer(writeRequest_);
 
             // Disable auto cleanup, this request receives several responses
@@ -229,8 +232,6 @@ void FSWriteSM::countCompletion(spfsWriteCompletionResponse* completionResponse)
     spfsWriteRequest* pfsReq =
         (spfsWriteRequest*)completionResponse->getContextPointer();
     pfsReq->setAutoCleanup(true);
-    delete pfsReq->getDist();
-    delete pfsReq->getView();
 }
 
 bool FSWriteSM::isWriteComplete()
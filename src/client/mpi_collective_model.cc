@@ -0,0 +1,194 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include "mpi_collective_model.h"
+#include <algorithm>
+#include <cassert>
+using namespace std;
+
+MPICollectiveModel::MPICollectiveModel(double latencySecs,
+                                       double bytesPerSec,
+                                       size_t ringThresholdBytes)
+    : latencySecs_(latencySecs),
+      bytesPerSec_(bytesPerSec),
+      ringThresholdBytes_(ringThresholdBytes)
+{
+    assert(0.0 <= latencySecs_);
+    assert(0.0 < bytesPerSec_);
+}
+
+MPICollectiveModel::AllReduceAlgorithm
+MPICollectiveModel::getAllReduceAlgorithm(size_t numBytes) const
+{
+    return (numBytes <= ringThresholdBytes_) ? RECURSIVE_DOUBLING : RING;
+}
+
+vector<double> MPICollectiveModel::barrier(
+    const vector<double>& arrivals) const
+{
+    // In the round with distance d, rank i signals rank i + d and waits
+    // for the signal from rank i - d
+    size_t numRanks = arrivals.size();
+    vector<double> times(arrivals);
+    for (size_t distance = 1; distance < numRanks; distance *= 2)
+    {
+        vector<double> next(numRanks);
+        for (size_t i = 0; i < numRanks; i++)
+        {
+            size_t from = (i + numRanks - distance) % numRanks;
+            next[i] = max(times[i], times[from] + getMessageSecs(0));
+        }
+        times.swap(next);
+    }
+    return times;
+}
+
+vector<double> MPICollectiveModel::bcast(const vector<double>& arrivals,
+                                         size_t root,
+                                         size_t numBytes) const
+{
+    size_t numRanks = arrivals.size();
+    assert(root < numRanks);
+
+    // Ranks are numbered relative to the root, so each rank receives from
+    // the rank with its lowest set bit cleared and then sends to the ranks
+    // below that bit in decreasing distance
+    vector<double> times(numRanks);
+    times[root] = arrivals[root];
+    size_t topMask = 1;
+    while (topMask < numRanks)
+    {
+        topMask *= 2;
+    }
+
+    double sendSecs = numBytes / bytesPerSec_;
+    for (size_t relRank = 0; relRank < numRanks; relRank++)
+    {
+        size_t rank = (relRank + root) % numRanks;
+        size_t mask = topMask;
+        if (0 != relRank)
+        {
+            mask = 1;
+            while (0 == (relRank & mask))
+            {
+                mask *= 2;
+            }
+        }
+
+        // The receive time was set by the parent
+        double sendStart = max(arrivals[rank], times[rank]);
+        for (mask /= 2; 0 < mask; mask /= 2)
+        {
+            if (relRank + mask < numRanks)
+            {
+                size_t child = (relRank + mask + root) % numRanks;
+                times[child] = sendStart + getMessageSecs(numBytes);
+                sendStart += sendSecs;
+            }
+        }
+        times[rank] = sendStart;
+    }
+    return times;
+}
+
+vector<double> MPICollectiveModel::allReduce(const vector<double>& arrivals,
+                                             size_t numBytes) const
+{
+    if (RECURSIVE_DOUBLING == getAllReduceAlgorithm(numBytes))
+    {
+        return recursiveDoubling(arrivals, numBytes);
+    }
+    return ring(arrivals, numBytes);
+}
+
+double MPICollectiveModel::getMessageSecs(double numBytes) const
+{
+    return latencySecs_ + numBytes / bytesPerSec_;
+}
+
+vector<double> MPICollectiveModel::recursiveDoubling(
+    const vector<double>& arrivals, size_t numBytes) const
+{
+    size_t numRanks = arrivals.size();
+    size_t pof2 = 1;
+    while (2 * pof2 <= numRanks)
+    {
+        pof2 *= 2;
+    }
+
+    // With a non power of two, the first 2 * rem ranks pair up and the
+    // even rank of each pair hands its data to the odd rank
+    size_t rem = numRanks - pof2;
+    vector<double> times(arrivals);
+    vector<size_t> members;
+    for (size_t i = 0; i < numRanks; i++)
+    {
+        if (i < 2 * rem && 0 == i % 2)
+        {
+            times[i + 1] = max(times[i + 1],
+                               times[i] + getMessageSecs(numBytes));
+        }
+        else
+        {
+            members.push_back(i);
+        }
+    }
+    assert(pof2 == members.size());
+
+    // Exchange with the partner at each doubling distance
+    for (size_t distance = 1; distance < pof2; distance *= 2)
+    {
+        vector<double> next(times);
+        for (size_t j = 0; j < pof2; j++)
+        {
+            size_t rank = members[j];
+            size_t partner = members[j ^ distance];
+            next[rank] = max(times[rank], times[partner]) +
+                getMessageSecs(numBytes);
+        }
+        times.swap(next);
+    }
+
+    // Return the result to the ranks that handed off their data
+    for (size_t i = 0; i < rem; i++)
+    {
+        times[2 * i] = times[2 * i + 1] + getMessageSecs(numBytes);
+    }
+    return times;
+}
+
+vector<double> MPICollectiveModel::ring(const vector<double>& arrivals,
+                                        size_t numBytes) const
+{
+    // Reduce-scatter then allgather: 2 * (p - 1) steps, each passing one
+    // chunk to the right neighbor
+    size_t numRanks = arrivals.size();
+    vector<double> times(arrivals);
+    double chunkSecs = getMessageSecs(double(numBytes) / numRanks);
+    for (size_t step = 0; step + 1 < 2 * numRanks - 1; step++)
+    {
+        vector<double> next(numRanks);
+        for (size_t i = 0; i < numRanks; i++)
+        {
+            size_t left = (i + numRanks - 1) % numRanks;
+            next[i] = max(times[i], times[left]) + chunkSecs;
+        }
+        times.swap(next);
+    }
+    return times;
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
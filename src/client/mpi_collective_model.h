@@ -0,0 +1,106 @@
+#ifndef MPI_COLLECTIVE_MODEL_H
+#define MPI_COLLECTIVE_MODEL_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstddef>
+#include <vector>
+
+/**
+ * Analytic model of the MPI collective algorithms.  Each point-to-point
+ * message of n bytes costs latency + n / bandwidth (the Hockney model),
+ * and a rank's sends are serialized on its link.  Given the time each
+ * rank enters the collective, the model replays the algorithm's message
+ * schedule and returns the time each rank leaves it.
+ *
+ * Barriers use the dissemination algorithm, bcasts use a binomial tree,
+ * and allreduces use recursive doubling up to ringThresholdBytes and a
+ * ring (reduce-scatter then allgather) above it.
+ */
+class MPICollectiveModel
+{
+public:
+    /** Allreduce algorithms */
+    enum AllReduceAlgorithm
+    {
+        RECURSIVE_DOUBLING = 0,
+        RING
+    };
+
+    /**
+     * Constructor
+     *
+     * @param latencySecs the latency of each message
+     * @param bytesPerSec the bandwidth of each rank's link
+     * @param ringThresholdBytes the largest allreduce using recursive
+     *   doubling
+     */
+    MPICollectiveModel(double latencySecs,
+                       double bytesPerSec,
+                       std::size_t ringThresholdBytes);
+
+    /** @return the algorithm used for an allreduce of numBytes */
+    AllReduceAlgorithm getAllReduceAlgorithm(std::size_t numBytes) const;
+
+    /**
+     * @param arrivals the time each rank enters the barrier, by rank
+     * @return the time each rank leaves the barrier
+     */
+    std::vector<double> barrier(const std::vector<double>& arrivals) const;
+
+    /**
+     * @param arrivals the time each rank enters the bcast, by rank
+     * @param root the rank broadcasting the data
+     * @param numBytes the amount of data broadcast
+     * @return the time each rank leaves the bcast
+     */
+    std::vector<double> bcast(const std::vector<double>& arrivals,
+                              std::size_t root,
+                              std::size_t numBytes) const;
+
+    /**
+     * @param arrivals the time each rank enters the allreduce, by rank
+     * @param numBytes the amount of data each rank contributes
+     * @return the time each rank leaves the allreduce
+     */
+    std::vector<double> allReduce(const std::vector<double>& arrivals,
+                                  std::size_t numBytes) const;
+
+private:
+    /** @return the time to deliver a message of numBytes */
+    double getMessageSecs(double numBytes) const;
+
+    /** @return the recursive doubling allreduce leave times */
+    std::vector<double> recursiveDoubling(const std::vector<double>& arrivals,
+                                          std::size_t numBytes) const;
+
+    /** @return the ring allreduce leave times */
+    std::vector<double> ring(const std::vector<double>& arrivals,
+                             std::size_t numBytes) const;
+
+    /** Message latency */
+    double latencySecs_;
+
+    /** Link bandwidth */
+    double bytesPerSec_;
+
+    /** Largest allreduce performed with recursive doubling */
+    std::size_t ringThresholdBytes_;
+};
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
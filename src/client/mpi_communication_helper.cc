@@ -9,6 +9,8 @@
 #include <cassert>
 #include "mpi_communication_helper.h"
 #include "comm_man.h"
+#include "message_kind.h"
+#include "mpi_collective_model.h"
 #include "mpi_proto_m.h"
 using namespace std;
 
@@ -17,11 +19,25 @@ MPICommunicationUserIF::~MPICommunicationUserIF()
 }
 
 MPICommunicationHelper::MPICommunicationHelper()
+    : collectiveModel_(0)
 {
 }
 
 MPICommunicationHelper::~MPICommunicationHelper()
 {
+    delete collectiveModel_;
+    collectiveModel_ = 0;
+}
+
+void MPICommunicationHelper::setCollectiveModel(
+    const MPICollectiveModel* model)
+{
+    delete collectiveModel_;
+    collectiveModel_ = 0;
+    if (0 != model)
+    {
+        collectiveModel_ = new MPICollectiveModel(*model);
+    }
 }
 
 void MPICommunicationHelper::performCommunication(
@@ -34,7 +50,7 @@ void MPICommunicationHelper::performCommunication(
 
     // TODO: This implementation is bogus.  It immediately completes all
     // MPI communications
-    commUser->completeCommunicationCB(request);
+    commUser->completeCommunicationCB(request, 0.0);
 }
 
 void MPICommunicationHelper::performCollective(
@@ -61,17 +77,22 @@ void MPICommunicationHelper::performCollective(
     numParticipantsByCommunicator_[commId] = numParticipants;
 
     // Add this callback to the callback list
-    callbacksByCommunicator_[commId].push_back(make_pair(commUser, request));
+    Participant participant;
+    participant.user = commUser;
+    participant.request = request;
+    participant.arrivalTime = simulation.getSimTime().dbl();
+    callbacksByCommunicator_[commId].push_back(participant);
 
     // If all members of the communicator have arrived, trigger callback
     if (numParticipants == CommMan::instance().commSize(commId))
     {
-        vector<UserCallback>& callbacks = callbacksByCommunicator_[commId];
+        vector<Participant>& callbacks = callbacksByCommunicator_[commId];
+        vector<double> delays = getCollectiveDelays(callbacks);
         for (size_t i = 0; i < callbacks.size(); i++)
         {
-            MPICommunicationUserIF* obj = callbacks[i].first;
-            spfsMPICollectiveRequest* data = callbacks[i].second;
-            obj->completeCommunicationCB(data);
+            MPICommunicationUserIF* obj = callbacks[i].user;
+            spfsMPICollectiveRequest* data = callbacks[i].request;
+            obj->completeCommunicationCB(data, delays[i]);
         }
 
         // Cleanup the maps
@@ -80,6 +101,66 @@ void MPICommunicationHelper::performCollective(
     }
 }
 
+vector<double> MPICommunicationHelper::getCollectiveDelays(
+    const vector<Participant>& participants) const
+{
+    vector<double> delays(participants.size(), 0.0);
+    if (0 == collectiveModel_)
+    {
+        return delays;
+    }
+
+    // Order the arrival times by communicator rank
+    size_t numRanks = participants.size();
+    vector<double> arrivals(numRanks, 0.0);
+    for (size_t i = 0; i < numRanks; i++)
+    {
+        int rank = participants[i].request->getRank();
+        assert(0 <= rank && size_t(rank) < numRanks);
+        arrivals[rank] = participants[i].arrivalTime;
+    }
+
+    // Replay the collective's algorithm
+    vector<double> departures;
+    spfsMPICollectiveRequest* request = participants[0].request;
+    switch (request->getKind())
+    {
+        case SPFS_MPI_BCAST_REQUEST:
+        {
+            spfsMPIBcastRequest* bcast =
+                kind_cast<spfsMPIBcastRequest>(request);
+            size_t root = bcast->getRoot();
+            assert(root < numRanks);
+            departures = collectiveModel_->bcast(arrivals,
+                                                 root,
+                                                 bcast->getByteLength());
+            break;
+        }
+        case SPFS_MPI_ALLREDUCE_REQUEST:
+        {
+            departures = collectiveModel_->allReduce(arrivals,
+                                                     request->getByteLength());
+            break;
+        }
+        default:
+        {
+            // Barriers and the collective file operations synchronize
+            departures = collectiveModel_->barrier(arrivals);
+            break;
+        }
+    }
+
+    // Ranks the algorithm would release before the last arrival are
+    // released now, as the helper only runs once all ranks have arrived
+    double now = simulation.getSimTime().dbl();
+    for (size_t i = 0; i < numRanks; i++)
+    {
+        double departure = departures[participants[i].request->getRank()];
+        delays[i] = (departure > now) ? departure - now : 0.0;
+    }
+    return delays;
+}
+
 /*
  * Local variables:
  *  indent-tabs-mode: nil
@@ -13,6 +13,7 @@
 #include "comm_man.h"
 #include "pfs_types.h"
 #include "singleton.h"
+class MPICollectiveModel;
 class spfsMPICollectiveRequest;
 class spfsMPIRequest;
 
@@ -29,8 +30,13 @@ public:
     /**
      * Callback invoked when the communication this collective user
      * invokes completes
+     *
+     * @param origRequest the request that began the communication
+     * @param delaySecs the time until the communication completes for
+     *   this user
      */
-    virtual void completeCommunicationCB(spfsMPIRequest* origRequest) = 0;
+    virtual void completeCommunicationCB(spfsMPIRequest* origRequest,
+                                         double delaySecs) = 0;
 };
 
 /**
@@ -52,6 +58,12 @@ public:
     void performCollective(MPICommunicationUserIF* commUser,
                            spfsMPICollectiveRequest* request);
 
+    /**
+     * Set the model used to time collectives.  Without a model (0), each
+     * collective completes as soon as the last participant arrives.
+     */
+    void setCollectiveModel(const MPICollectiveModel* model);
+
 protected:
     /** Constructor */
     MPICommunicationHelper();
@@ -60,15 +72,20 @@ protected:
     ~MPICommunicationHelper();
 
 private:
-    typedef std::pair<MPICommunicationUserIF*,
-                      spfsMPICollectiveRequest*> UserCallback;
+    /** A participant waiting for a collective to complete */
+    struct Participant
+    {
+        MPICommunicationUserIF* user;
+        spfsMPICollectiveRequest* request;
+        double arrivalTime;
+    };
 
     /** Map of the number of collective participants indexed by communicator */
     typedef std::map<Communicator, std::size_t> CollectiveCountMap;
 
     /** Map of the collective participants indexed by communicator */
     typedef std::map<Communicator,
-                     std::vector<UserCallback> > CollectiveCallbackMap;
+                     std::vector<Participant> > CollectiveCallbackMap;
 
     /** Disabled copy constructor */
     MPICommunicationHelper(const MPICommunicationHelper& other);
@@ -76,11 +93,21 @@ private:
     /** Disabled assignment operator */
     MPICommunicationHelper& operator=(const MPICommunicationHelper& other);
 
+    /**
+     * @return the time until the collective completes for each
+     *   participant, computed once all participants have arrived
+     */
+    std::vector<double> getCollectiveDelays(
+        const std::vector<Participant>& participants) const;
+
     /** Map of the number collective participants indexed by communicator */
     CollectiveCountMap numParticipantsByCommunicator_;
 
     /** Map of callbacks indexed by communicator */
     CollectiveCallbackMap callbacksByCommunicator_;
+
+    /** Model used to time the collectives, 0 if they are instant */
+    MPICollectiveModel* collectiveModel_;
 };
 
 #endif
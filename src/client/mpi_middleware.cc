@@ -10,6 +10,8 @@
 #include <cmath>
 #include <cassert>
 #include <iostream>
+#include "comm_man.h"
+#include "message_kind.h"
 #include "mpi_communication_helper.h"
 #include "mpi_proto_m.h"
 using namespace std;
@@ -35,7 +37,8 @@ int MpiMiddleware::rank() const
     return rank_;
 }
 
-void MpiMiddleware::completeCommunicationCB(spfsMPIRequest* request)
+void MpiMiddleware::completeCommunicationCB(spfsMPIRequest* request,
+                                            double delaySecs)
 {
     // Do some Omnet Magic to allow the simulation to resume right here
     Enter_Method("Complete MPI Communication");
@@ -46,16 +49,22 @@ void MpiMiddleware::completeCommunicationCB(spfsMPIRequest* request)
     // Create the response based on the message kind
     switch(request->getKind())
     {
+        case SPFS_MPI_ALLREDUCE_REQUEST:
+        {
+            response = createAllReduceResponse(
+                kind_cast<spfsMPIAllReduceRequest>(request));
+            break;
+        }
         case SPFS_MPI_BARRIER_REQUEST:
         {
             response = createBarrierResponse(
-                dynamic_cast<spfsMPIBarrierRequest*>(request));
+                kind_cast<spfsMPIBarrierRequest>(request));
             break;
         }
         case SPFS_MPI_BCAST_REQUEST:
         {
             response = createBcastResponse(
-                dynamic_cast<spfsMPIBcastRequest*>(request));
+                kind_cast<spfsMPIBcastRequest>(request));
             break;
         }
         default:
@@ -64,7 +73,7 @@ void MpiMiddleware::completeCommunicationCB(spfsMPIRequest* request)
                  << "Invalid MPI message kind: " << request->getKind() << endl;
         }
     }
-    double delay = uniform(0.0, randomDelayMean_ * 2);
+    double delay = delaySecs + uniform(0.0, randomDelayMean_ * 2);
     sendDelayed(response, delay, appOutGate_);
     assert(0 != response);
 }
@@ -92,22 +101,53 @@ void MpiMiddleware::handleMessage(cMessage* msg)
 {
     if (msg->getArrivalGateId() == appInGate_)
     {
-        if (spfsMPICollectiveRequest* coll =
-            dynamic_cast<spfsMPICollectiveRequest*>(msg))
-        {
-            MPICommunicationHelper::instance().performCollective(this, coll);
-        }
-        else if (spfsMPIRequest* req = dynamic_cast<spfsMPIRequest*>(msg))
-        {
-            MPICommunicationHelper::instance().performCommunication(this,
-                                                                    req,
-                                                                    0);
-        }
-        else
+        switch (msg->getKind())
         {
-            cerr << __FILE__ << ":" << __LINE__ << ":"
-                 << "Message type not supported." << endl;
-            assert(false);
+            case SPFS_MPI_FILE_DELETE_REQUEST:
+            case SPFS_MPI_DIRECTORY_CREATE_REQUEST:
+            case SPFS_MPI_DIRECTORY_REMOVE_REQUEST:
+            case SPFS_MPI_FILE_STAT_REQUEST:
+            case SPFS_MPI_FILE_UPDATE_TIME_REQUEST:
+            {
+                spfsMPIRequest* req = kind_cast<spfsMPIRequest>(msg);
+                MPICommunicationHelper::instance().performCommunication(this,
+                                                                        req,
+                                                                        0);
+                break;
+            }
+            case SPFS_MPI_SEND_REQUEST:
+            case SPFS_MPI_ALLREDUCE_REQUEST:
+            case SPFS_MPI_BARRIER_REQUEST:
+            case SPFS_MPI_BCAST_REQUEST:
+            case SPFS_MPI_FILE_OPEN_REQUEST:
+            case SPFS_MPI_FILE_CLOSE_REQUEST:
+            case SPFS_MPI_FILE_SET_SIZE_REQUEST:
+            case SPFS_MPI_FILE_PREALLOCATE_REQUEST:
+            case SPFS_MPI_FILE_GET_AMODE_REQUEST:
+            case SPFS_MPI_FILE_GET_SIZE_REQUEST:
+            case SPFS_MPI_FILE_GET_INFO_REQUEST:
+            case SPFS_MPI_FILE_SET_INFO_REQUEST:
+            case SPFS_MPI_FILE_READ_AT_REQUEST:
+            case SPFS_MPI_FILE_READ_REQUEST:
+            case SPFS_MPI_FILE_WRITE_AT_REQUEST:
+            case SPFS_MPI_FILE_WRITE_REQUEST:
+            case SPFS_MPI_DIRECTORY_READ_REQUEST:
+            {
+                // Record this process's rank within the communicator
+                spfsMPICollectiveRequest* coll =
+                    kind_cast<spfsMPICollectiveRequest>(msg);
+                Communicator comm = coll->getCommunicator();
+                coll->setRank(CommMan::instance().commRank(comm, rank()));
+                MPICommunicationHelper::instance().performCollective(this,
+                                                                     coll);
+                break;
+            }
+            default:
+            {
+                cerr << __FILE__ << ":" << __LINE__ << ":"
+                     << "Message type not supported." << endl;
+                assert(false);
+            }
         }
     }
     else if (msg->getArrivalGateId() == cacheInGate_)
@@ -129,6 +169,15 @@ void MpiMiddleware::handleMessage(cMessage* msg)
     }
 }
 
+spfsMPIAllReduceResponse* MpiMiddleware::createAllReduceResponse(
+    spfsMPIAllReduceRequest* request) const
+{
+    spfsMPIAllReduceResponse* resp =
+        new spfsMPIAllReduceResponse(0, SPFS_MPI_ALLREDUCE_RESPONSE);
+    resp->setContextPointer(request);
+    return resp;
+}
+
 spfsMPIBarrierResponse* MpiMiddleware::createBarrierResponse(
     spfsMPIBarrierRequest* request) const
 {
@@ -11,6 +11,8 @@
 #include <omnetpp.h>
 #include "mpi_communication_helper.h"
 class spfsCacheInvalidateRequest;
+class spfsMPIAllReduceRequest;
+class spfsMPIAllReduceResponse;
 class spfsMPIBarrierRequest;
 class spfsMPIBarrierResponse;
 class spfsMPIBcastRequest;
@@ -33,8 +35,8 @@ public:
     /** @return the rank of this node */
     int rank() const;
 
-    /** Callback for when a communication completes */
-    void completeCommunicationCB(spfsMPIRequest* request);
+    /** Callback for when a communication completes after delaySecs */
+    void completeCommunicationCB(spfsMPIRequest* request, double delaySecs);
 
 protected:
     /** Implementation of initialize */
@@ -47,6 +49,10 @@ protected:
     virtual void handleMessage(cMessage* msg);
 
 private:
+    /** @return the completion response for the allreduce */
+    spfsMPIAllReduceResponse* createAllReduceResponse(
+        spfsMPIAllReduceRequest* request) const;
+
     /** @return the completion response for the barrier */
     spfsMPIBarrierResponse* createBarrierResponse(
         spfsMPIBarrierRequest* request) const;
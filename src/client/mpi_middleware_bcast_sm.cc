@@ -159,7 +159,8 @@ void MPIMidBcastSM::enterBcast(spfsMPIMidBcastRequest* msg)
         int child_rank = (rank + (0x1 << i)) % (0x1 << steps);
         if(child_rank < size)
         {
-            spfsMPISendRequest* req = new spfsMPISendRequest();
+            spfsMPISendRequest* req =
+                new spfsMPISendRequest(0, SPFS_MPI_SEND_REQUEST);
             cMessage* dupMsg = static_cast<cMessage*>(msg->dup());
 
             dynamic_cast<spfsMPIMidBcastRequest*>(dupMsg)->setParent(rank);
@@ -198,7 +199,8 @@ void MPIMidBcastSM::enterRsp()
         // response to parent
         spfsMPIMidBcastResponse *msg = new spfsMPIMidBcastResponse("bcast rsp", SPFS_MPIMID_BCAST_RESPONSE);
 
-        spfsMPISendRequest* req = new spfsMPISendRequest();
+        spfsMPISendRequest* req =
+            new spfsMPISendRequest(0, SPFS_MPI_SEND_REQUEST);
 
         req->setRank(parentWRank_);
         req->encapsulate(static_cast<cMessage*>(msg));
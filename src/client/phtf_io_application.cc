@@ -717,15 +717,18 @@ void PHTFIOApplication::performTypeCreateSubarray(const PHTFEventRecord& createS
     //cerr << "Created new type: " << *dataType << endl;
 }
 
-spfsMPIBarrierRequest* PHTFIOApplication::createAllReduceMessage(
+spfsMPIAllReduceRequest* PHTFIOApplication::createAllReduceMessage(
     const PHTFEventRecord* allReduceRecord)
 {
+    size_t count = allReduceRecord->paramAsSizeT(2);
+    string dtId = allReduceRecord->paramAt(3);
     Communicator communicatorId = allReduceRecord->paramAsAddress(5);
 
-    spfsMPIBarrierRequest* barrier =
-        new spfsMPIBarrierRequest(0, SPFS_MPI_BARRIER_REQUEST);
-    barrier->setCommunicator(communicatorId);
-    return barrier;
+    spfsMPIAllReduceRequest* allReduce =
+        new spfsMPIAllReduceRequest(0, SPFS_MPI_ALLREDUCE_REQUEST);
+    allReduce->setCommunicator(communicatorId);
+    allReduce->setByteLength(getBufferBytes(count, dtId));
+    return allReduce;
 }
 
 spfsMPIBarrierRequest* PHTFIOApplication::createBarrierMessage(
@@ -742,11 +745,16 @@ spfsMPIBarrierRequest* PHTFIOApplication::createBarrierMessage(
 spfsMPIBcastRequest* PHTFIOApplication::createBcastMessage(
     const PHTFEventRecord* bcastRecord)
 {
+    size_t count = bcastRecord->paramAsSizeT(1);
+    string dtId = bcastRecord->paramAt(2);
+    int root = bcastRecord->paramAsSizeT(3);
     Communicator communicatorId = bcastRecord->paramAsAddress(4);
 
     spfsMPIBcastRequest* bcast =
         new spfsMPIBcastRequest(0, SPFS_MPI_BCAST_REQUEST);
     bcast->setCommunicator(communicatorId);
+    bcast->setRoot(root);
+    bcast->setByteLength(getBufferBytes(count, dtId));
     return bcast;
 }
 
@@ -1068,6 +1076,18 @@ DataType* PHTFIOApplication::getDataTypeById(const string& typeId)
     return dataType;
 }
 
+size_t PHTFIOApplication::getBufferBytes(size_t count, const string& typeId)
+{
+    // Types the trace does not define are assumed to be 8 bytes wide
+    // (e.g. MPI_DOUBLE in reductions)
+    if (dataTypeById_.end() == dataTypeById_.find(typeId) &&
+        PHTFTrace::instance().getFs()->consts(typeId).empty())
+    {
+        return count * 8;
+    }
+    return count * getDataTypeById(typeId)->getExtent();
+}
+
 /*
  * Local variables:
  *  indent-tabs-mode: nil
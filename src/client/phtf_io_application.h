@@ -17,6 +17,7 @@
 class FileDescriptor;
 class Filename;
 class spfsCacheInvalidateRequest;
+class spfsMPIAllReduceRequest;
 class spfsMPIBarrierRequest;
 class spfsMPIBcastRequest;
 class spfsMPIDirectoryCreateRequest;
@@ -130,7 +131,7 @@ private:
     void performTypeCreateSubarray(const PHTFEventRecord& createSubarray);
 
     /** @return a ALL_REDUCE request */
-    spfsMPIBarrierRequest* createAllReduceMessage(
+    spfsMPIAllReduceRequest* createAllReduceMessage(
         const PHTFEventRecord* allreduce);
 
     /** @return a BARRIER request */
@@ -215,6 +216,9 @@ private:
     /** retrieve Datatype from map, NULL if none found */
     DataType* getDataTypeById(const std::string& typeId);
 
+    /** @return the size of a message buffer of count typeId elements */
+    std::size_t getBufferBytes(std::size_t count, const std::string& typeId);
+
     /** Trace file location */
     std::string traceDirectory_;
 
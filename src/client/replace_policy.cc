@@ -1,18 +0,0 @@
-//
-// This file is part of Hecios
-//
-// Copyright (C)
-//
-// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
-// for details on this and other legal matters.
-//
-// File: replace_policy.cc
-
-//#include "replace_policy.h"
-
-
-/*ReplacePolicy::~ReplacePolicy()
-{
-
-
-}*/
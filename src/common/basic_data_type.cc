@@ -39,13 +39,13 @@ size_t BasicDataType<widthInBytes>::getRepresentationByteLength() const
 }
 
 template<std::size_t widthInBytes>
-std::vector<FileRegion> BasicDataType<widthInBytes>::getRegionsByBytes(
+void BasicDataType<widthInBytes>::visitRegionsByBytes(
     const FSOffset& byteOffset,
-    size_t numBytes) const
+    size_t numBytes,
+    FileRegionVisitor& visitor) const
 {
     FileRegion fr = {byteOffset, numBytes};
-    std::vector<FileRegion> v(1, fr);
-    return v;
+    visitor.visitRegion(fr);
 }
 
 template<std::size_t widthInBytes>
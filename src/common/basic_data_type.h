@@ -69,12 +69,14 @@ public:
     virtual std::size_t getRepresentationByteLength() const;
 
     /**
-     * @return the *data* regions for numBytes of data in this DataType.
-     * Note that the DataType may contain empty holes, thus leading to
-     * numBytes of data corresponding to a much larger DataType extent.
+     * Pass each *data* region for numBytes of data in this DataType to
+     * the visitor.  Note that the DataType may contain empty holes, thus
+     * leading to numBytes of data corresponding to a much larger DataType
+     * extent.
      */
-    virtual std::vector<FileRegion> getRegionsByBytes(
-        const FSOffset& byteOffset, std::size_t numBytes) const;
+    virtual void visitRegionsByBytes(const FSOffset& byteOffset,
+                                     std::size_t numBytes,
+                                     FileRegionVisitor& visitor) const;
 
     /**
      * @return the data regions for count of this DataType.
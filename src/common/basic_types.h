@@ -29,6 +29,9 @@ typedef int64_t LogicalBlockAddress;
 /** BMI Connection Id */
 typedef uint64_t ConnectionId;
 
+/** Dense integer identifier interned for a file or directory name */
+typedef uint32_t FileId;
+
 /** A contiguous region of a file, i.e. an offset and an extent */
 struct FileRegion
 {
@@ -51,10 +51,11 @@ ClientCacheDirectory::getClientsNeedingInvalidate(const Filename& filename,
 
     // Determine the caches containing these pages
     InvalidationMap invalidations;
+    FileId fileId = FileIdRegistry::instance().intern(filename);
     set<FilePageId>::iterator iter = pageIds.begin();
     while (iter != pageIds.end())
     {
-        Entry entry = {filename, *(iter++)};
+        Entry entry = {fileId, *(iter++)};
         pair<CacheEntryToClientMap::const_iterator,
              CacheEntryToClientMap::const_iterator> range;
         range = clientCacheEntries_.equal_range(entry);
@@ -73,7 +74,8 @@ void ClientCacheDirectory::addClientCacheEntry(const ClientCache& client,
                                                const FilePageId& pageId,
                                                State state)
 {
-    const Entry entry = {filename, pageId, state};
+    FileId fileId = FileIdRegistry::instance().intern(filename);
+    const Entry entry = {fileId, pageId, state};
     clientCacheEntries_.insert(make_pair(entry, client));
 }
 
@@ -82,7 +84,8 @@ void ClientCacheDirectory::removeClientCacheEntry(const ClientCache& client,
                                                   const FilePageId& pageId)
 {
     pair<CacheEntryToClientMap::iterator, CacheEntryToClientMap::iterator> range;
-    const Entry entry = {filename, pageId};
+    FileId fileId = FileIdRegistry::instance().intern(filename);
+    const Entry entry = {fileId, pageId};
     range = clientCacheEntries_.equal_range(entry);
 
     CacheEntryToClientMap::iterator iter = range.first;
@@ -104,7 +107,8 @@ void ClientCacheDirectory::removeClientCacheEntryByRank(int rank,
                                                         const FilePageId& pageId)
 {
     pair<CacheEntryToClientMap::iterator, CacheEntryToClientMap::iterator> range;
-    const Entry entry = {filename, pageId};
+    FileId fileId = FileIdRegistry::instance().intern(filename);
+    const Entry entry = {fileId, pageId};
     range = clientCacheEntries_.equal_range(entry);
 
     CacheEntryToClientMap::iterator iter = range.first;
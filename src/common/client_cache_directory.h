@@ -14,6 +14,7 @@
 #include <map>
 #include <set>
 #include "basic_types.h"
+#include "file_id_registry.h"
 #include "file_page.h"
 #include "filename.h"
 #include "singleton.h"
@@ -49,7 +50,7 @@ public:
     /** Entries stored in client caches */
     struct Entry
     {
-        Filename filename;
+        FileId fileId;
         FilePageId pageId;
         State state;
     };
@@ -124,11 +125,11 @@ inline int compare(const ClientCacheDirectory::Entry& lhs,
     int cmpValue = 1;
     if (lhs.pageId == rhs.pageId)
     {
-        if (lhs.filename == rhs.filename)
+        if (lhs.fileId == rhs.fileId)
         {
             cmpValue = 0;
         }
-        else if (lhs.filename < rhs.filename)
+        else if (lhs.fileId < rhs.fileId)
         {
             cmpValue = -1;
         }
@@ -171,7 +172,8 @@ inline bool operator<(const ClientCacheDirectory::Entry& lhs,
 inline std::ostream& operator<<(std::ostream& ost,
                                 const ClientCacheDirectory::Entry& entry)
 {
-    ost << entry.filename << " " << entry.pageId;
+    ost << FileIdRegistry::instance().getFilename(entry.fileId) << " "
+        << entry.pageId;
     return ost;
 }
 
@@ -40,11 +40,12 @@ size_t ContiguousDataType::getRepresentationByteLength() const
     return 4 + oldType_->getRepresentationByteLength();
 }
 
-vector<FileRegion> ContiguousDataType::getRegionsByBytes(
+void ContiguousDataType::visitRegionsByBytes(
     const FSOffset& byteOffset,
-    size_t numBytes) const
+    size_t numBytes,
+    FileRegionVisitor& visitor) const
 {
-    return oldType_->getRegionsByBytes(byteOffset, numBytes);
+    oldType_->visitRegionsByBytes(byteOffset, numBytes, visitor);
 }
 
 /*
@@ -68,6 +68,33 @@ void DataType::resize(int lowerBound, size_t extent)
     extent_ = lowerBound + extent;
 }
 
+/** Visitor that collects the visited regions into a vector */
+class FileRegionCollector : public FileRegionVisitor
+{
+public:
+    /** Constructor */
+    FileRegionCollector(vector<FileRegion>& outRegions)
+        : regions_(outRegions) {};
+
+    /** Append the region to the collected regions */
+    virtual void visitRegion(const FileRegion& region)
+    {
+        regions_.push_back(region);
+    };
+
+private:
+    vector<FileRegion>& regions_;
+};
+
+vector<FileRegion> DataType::getRegionsByBytes(const FSOffset& byteOffset,
+                                               size_t numBytes) const
+{
+    vector<FileRegion> regions;
+    FileRegionCollector collector(regions);
+    visitRegionsByBytes(byteOffset, numBytes, collector);
+    return regions;
+}
+
 ostream& DataType::print(ostream& ost) const
 {
     ost << "Not Implemented for this data type.";
@@ -13,6 +13,20 @@
 #include <vector>
 #include "basic_types.h"
 
+/**
+ * Callback interface for receiving the data regions of a DataType one at
+ * a time as the type is flattened
+ */
+class FileRegionVisitor
+{
+public:
+    /** Destructor */
+    virtual ~FileRegionVisitor() {};
+
+    /** Process the next data region in file order */
+    virtual void visitRegion(const FileRegion& region) = 0;
+};
+
 /**
  * An abstract file view data type (analogous to MPI data types)
  */
@@ -51,8 +65,18 @@ public:
      * Note that the DataType may contain empty holes, thus leading to
      * numBytes of data corresponding to a much larger DataType extent.
      */
-    virtual std::vector<FileRegion> getRegionsByBytes(
-        const FSOffset& byteOffset, std::size_t numBytes) const = 0;
+    std::vector<FileRegion> getRegionsByBytes(const FSOffset& byteOffset,
+                                              std::size_t numBytes) const;
+
+    /**
+     * Pass each *data* region for numBytes of data in this DataType to the
+     * visitor without materializing the region list.  Nested types are
+     * flattened on the fly, so memory use is independent of the number of
+     * regions.
+     */
+    virtual void visitRegionsByBytes(const FSOffset& byteOffset,
+                                     std::size_t numBytes,
+                                     FileRegionVisitor& visitor) const = 0;
 
     virtual std::ostream& print(std::ostream& ost) const;
 
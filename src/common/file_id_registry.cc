@@ -0,0 +1,61 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include "file_id_registry.h"
+#include <cassert>
+using namespace std;
+
+FileIdRegistry::FileIdRegistry()
+{
+}
+
+FileIdRegistry::~FileIdRegistry()
+{
+}
+
+FileId FileIdRegistry::intern(const Filename& filename)
+{
+    map<string, FileId>::const_iterator iter = ids_.find(filename.str());
+    if (ids_.end() != iter)
+    {
+        return iter->second;
+    }
+
+    FileId id = FileId(filenames_.size());
+    assert(size_t(id) == filenames_.size());
+    ids_.insert(make_pair(filename.str(), id));
+    filenames_.push_back(filename);
+    return id;
+}
+
+bool FileIdRegistry::find(const Filename& filename, FileId& outId) const
+{
+    map<string, FileId>::const_iterator iter = ids_.find(filename.str());
+    if (ids_.end() != iter)
+    {
+        outId = iter->second;
+        return true;
+    }
+    return false;
+}
+
+const Filename& FileIdRegistry::getFilename(FileId id) const
+{
+    assert(id < filenames_.size());
+    return filenames_[id];
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,78 @@
+#ifndef FILE_ID_REGISTRY_H
+#define FILE_ID_REGISTRY_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+#include "basic_types.h"
+#include "filename.h"
+#include "singleton.h"
+
+/**
+ * Interns file and directory names as dense integer ids so that cache and
+ * layout keys compare and hash integers rather than path strings.  Ids
+ * are assigned in interning order beginning at 0 and are never reused.
+ * The FileBuilder interns the pre-existing file system, and files created
+ * during the simulation are interned on first use.
+ */
+class FileIdRegistry : public Singleton<FileIdRegistry>
+{
+public:
+    /** Enable singleton construction */
+    friend class Singleton<FileIdRegistry>;
+
+    /** @return the id for filename, assigning the next id on first use */
+    FileId intern(const Filename& filename);
+
+    /**
+     * Set outId to the id of filename if it has been interned
+     *
+     * @return true if filename has been interned
+     */
+    bool find(const Filename& filename, FileId& outId) const;
+
+    /** @return the filename interned as id */
+    const Filename& getFilename(FileId id) const;
+
+    /** @return the number of interned filenames */
+    std::size_t getNumFiles() const { return filenames_.size(); };
+
+private:
+    /** Private constructor */
+    FileIdRegistry();
+
+    /** Private destructor */
+    ~FileIdRegistry();
+
+    /** Hidden copy constructor */
+    FileIdRegistry(const FileIdRegistry& other);
+
+    /** Hidden assignment operator */
+    FileIdRegistry& operator=(const FileIdRegistry& other);
+
+    /** Map of paths to ids */
+    std::map<std::string, FileId> ids_;
+
+    /** Filenames indexed by id */
+    std::vector<Filename> filenames_;
+};
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
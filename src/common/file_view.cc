@@ -11,21 +11,43 @@
 #include "data_type.h"
 using namespace std;
 
+FileView::FileView()
+    : displacement_(0),
+      dataType_(0),
+      refCount_(0)
+{
+}
+
 FileView::FileView(const FSOffset& displacement, DataType* dataType)
     : displacement_(displacement),
-      dataType_(dataType)
+      dataType_(dataType),
+      refCount_(0)
 {
+    if (0 != dataType_)
+    {
+        refCount_ = new size_t(1);
+    }
 }
 
 FileView::FileView( const FileView& other)
     : displacement_(other.displacement_),
-      dataType_(other.dataType_->clone())
+      dataType_(other.dataType_),
+      refCount_(other.refCount_)
 {
+    if (0 != refCount_)
+    {
+        ++(*refCount_);
+    }
 }
 
 FileView::~FileView()
 {
-    delete dataType_;
+    // Delete the data type with the last view that shares it
+    if (0 != refCount_ && 0 == --(*refCount_))
+    {
+        delete dataType_;
+        delete refCount_;
+    }
 }
 
 FileView& FileView::operator=(const FileView& other)
@@ -41,11 +63,17 @@ void FileView::swap(FileView& other)
     // Swap the contents of this and other piecemeal
     std::swap(displacement_, other.displacement_);
     std::swap(dataType_, other.dataType_);
+    std::swap(refCount_, other.refCount_);
 }
 
 std::size_t FileView::getRepresentationByteLength() const
 {
-    return 8 + dataType_->getRepresentationByteLength();
+    size_t typeLength = 0;
+    if (0 != dataType_)
+    {
+        typeLength = dataType_->getRepresentationByteLength();
+    }
+    return 8 + typeLength;
 }
 
 bool FileView::operator ==(const FileView& other) const
@@ -14,11 +14,16 @@
 class DataType;
 
 /**
- * A file view
+ * A file view.  The data type is immutable once the view is constructed,
+ * so copies of a view share a single reference counted data type rather
+ * than cloning it.
  */
 class FileView
 {
 public:
+    /** Default constructor, an empty view with no data type */
+    FileView();
+
     /**
      * Constructor
      *
@@ -27,7 +32,7 @@ public:
      */
     FileView(const FSOffset& displacement, DataType* dataType);
 
-    /** Copy constructor */
+    /** Copy constructor, shares the data type with other */
     FileView(const FileView& other);
 
     /** Destructor */
@@ -54,7 +59,10 @@ private:
 
     FSOffset displacement_;
 
-    DataType* dataType_;
+    const DataType* dataType_;
+
+    /** Number of views sharing dataType_, 0 if there is no data type */
+    std::size_t* refCount_;
 };
 
 /** @return Output stream containg the file view */
@@ -61,13 +61,11 @@ size_t IndexedDataType::getRepresentationByteLength() const
     return length;
 }
 
-vector<FileRegion> IndexedDataType::getRegionsByBytes(
+void IndexedDataType::visitRegionsByBytes(
     const FSOffset& byteOffset,
-    size_t numBytes) const
+    size_t numBytes,
+    FileRegionVisitor& visitor) const
 {
-    // The total regions produced
-    vector<FileRegion> vectorRegions;
-
     // Construct the regions required to map numBytes of data to data regions
     size_t bytesProcessed = 0;
     size_t typeDataSize = getDataSize();
@@ -96,14 +94,7 @@ vector<FileRegion> IndexedDataType::getRegionsByBytes(
                FSOffset beginOff = typeBegin +
                     (typeOffset - elementsProcessedSize) +
                     (displacements_[i] * oldType_.getTrueExtent());
-                vector<FileRegion> elementRegions =
-                    oldType_.getRegionsByBytes(beginOff,
-                                               dataLength);
-
-                // Add regions to the total regions vector
-                copy(elementRegions.begin(),
-                     elementRegions.end(),
-                     back_inserter(vectorRegions));
+                oldType_.visitRegionsByBytes(beginOff, dataLength, visitor);
 
                 // Update the number of bytes processed
                 bytesProcessed += dataLength;
@@ -114,14 +105,7 @@ vector<FileRegion> IndexedDataType::getRegionsByBytes(
                     (displacements_[i] * oldType_.getTrueExtent());
                 FSSize dataLength = min(nextElementsSize,
                                         numBytes - bytesProcessed);
-                vector<FileRegion> elementRegions =
-                    oldType_.getRegionsByBytes(beginOff,
-                                               dataLength);
-
-                // Add regions to the total regions vector
-                copy(elementRegions.begin(),
-                     elementRegions.end(),
-                     back_inserter(vectorRegions));
+                oldType_.visitRegionsByBytes(beginOff, dataLength, visitor);
 
                 // Update the number of bytes processed
                 bytesProcessed += dataLength;
@@ -136,7 +120,6 @@ vector<FileRegion> IndexedDataType::getRegionsByBytes(
         currentOffset = typeBegin;
     }
     assert(bytesProcessed == numBytes);
-    return vectorRegions;
 }
 
 size_t IndexedDataType::getDataSize() const
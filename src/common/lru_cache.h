@@ -9,21 +9,59 @@
 // for details on this and other legal matters.
 //
 #include <cassert>
+#include <cstddef>
 #include <functional>
-#include <list>
-#include <map>
+#include <set>
+#include <string>
 #include <utility>
 #include <vector>
 #include "spfs_exceptions.h"
 
 /**
- * A helper class for filtering LRUCache entries
+ * Hash function for LRUCache keys.  Integral keys hash to their value;
+ * other key types provide a specialization.
  */
+template <class KeyType>
+struct LRUCacheHash
+{
+    std::size_t operator()(const KeyType& key) const
+    {
+        return std::size_t(key);
+    }
+};
+
+/** Hash function for string LRUCache keys */
+template <>
+struct LRUCacheHash<std::string>
+{
+    std::size_t operator()(const std::string& key) const
+    {
+        return hashBytes(key.data(), key.size());
+    }
+
+    /** @return the FNV-1a hash of length bytes */
+    static std::size_t hashBytes(const char* bytes, std::size_t length)
+    {
+        std::size_t hash = 2166136261u;
+        for (std::size_t i = 0; i < length; i++)
+        {
+            hash = (hash ^ (unsigned char)bytes[i]) * 16777619u;
+        }
+        return hash;
+    }
+};
 
 /**
  * A simple fixed size cache using LRU replacement.
+ *
+ * Entries are located with a chained hash index and ordered by an
+ * intrusive LRU list.  Dirty entries are also linked on a dirty list in
+ * the order they became dirty, so that writeback need not scan the clean
+ * entries.  Entry nodes are recycled rather than freed on eviction.
+ * Keys must provide operator< and a LRUCacheHash specialization.
  */
-template <class KeyType, class ValueType>
+template <class KeyType, class ValueType,
+          class HashType = LRUCacheHash<KeyType> >
 class LRUCache
 {
 public:
@@ -35,7 +73,6 @@ public:
     {
         ValueType data;
         bool isDirty;
-        typename std::list<KeyType>::iterator lruRef;
     };
 
     /**
@@ -51,12 +88,6 @@ public:
         virtual bool filter(const KeyType& key, const ValueType& val, bool isDirty) const = 0;
     };
 
-    /** Convenience typedef of the key-value map */
-    typedef std::map<KeyType, EntryType*> MapType;
-
-    /** Convenience typedef of the lru list */
-    typedef std::list<KeyType> LRUListType;
-
     /**
      * Constructor
      */
@@ -82,9 +113,10 @@ public:
      * Perform the cache insertion and set the evicted value and dirty bit
      * in the outbound parameters.
      *
-     * @throw NoSuchEntry if no eviction occurs
+     * @return true if an entry was evicted, otherwise the outbound
+     *   parameters are not modified
      */
-    void insertAndRecall(const KeyType& key,
+    bool insertAndRecall(const KeyType& key,
                          const ValueType& value,
                          bool isDirty,
                          KeyType& outEvictedKey,
@@ -98,6 +130,16 @@ public:
      */
     void remove(const KeyType& key);
 
+    /**
+     * Remove the value for key from the cache and set the removed value
+     * and dirty bit in the outbound parameters
+     *
+     * @throw NoSuchEntry if no entry exists for the key
+     */
+    void removeAndRecall(const KeyType& key,
+                         ValueType& outValue,
+                         bool& outDirtyBit);
+
     /**
      * Set the dirty-bit for the cache key in question without updating
      * the LRU status
@@ -113,6 +155,24 @@ public:
      */
     ValueType lookup(const KeyType& key);
 
+    /**
+     * @return a pointer to the value for key and update the LRU ordering,
+     *   or 0 if no entry exists for the key
+     */
+    ValueType* find(const KeyType& key);
+
+    /**
+     * @return a pointer to the value for key without updating the LRU
+     *   ordering, or 0 if no entry exists for the key
+     */
+    ValueType* peek(const KeyType& key);
+
+    /**
+     * @return a pointer to the value for key without updating the LRU
+     *   ordering, or 0 if no entry exists for the key
+     */
+    const ValueType* peek(const KeyType& key) const;
+
     /**
      * Check if an entry exists without modifying its LRU status
      *
@@ -128,8 +188,8 @@ public:
     bool getDirtyBit(const KeyType& key) const;
 
     /**
-     * @return a vector of all the dirty cache values.  Does not update
-     *         the LRU status
+     * @return a vector of all the dirty cache values in the order they
+     *         became dirty.  Does not update the LRU status
      */
     std::vector<KeyType> getDirtyEntries() const;
 
@@ -139,6 +199,12 @@ public:
      */
     std::set<KeyType> getFilteredEntries(const FilterFunctor& filter) const;
 
+    /**
+     * @return the dirty cache values that the filter returns true for.
+     *   Only the dirty entries are examined.
+     */
+    std::set<KeyType> getFilteredDirtyEntries(const FilterFunctor& filter) const;
+
     /**
      * @return the next entry that will be evicted on a new insertion
      *
@@ -161,310 +227,287 @@ public:
 
 private:
 
-    std::map<KeyType, EntryType*> keyEntryMap_;
-    std::list<KeyType> lruList_;
-
-    const std::size_t maxEntries_;
-    std::size_t numDirtyEntries_;
-    std::size_t numEntries_;
-};
-
-template <class KeyType, class ValueType>
-LRUCache<KeyType,ValueType>::LRUCache(int capacity)
-    : maxEntries_(capacity),
-      numDirtyEntries_(0),
-      numEntries_(0)
-{
-    assert(0 < maxEntries_);
-}
-
-template <class KeyType, class ValueType>
-LRUCache<KeyType,ValueType>::~LRUCache()
-{
-    // Delete any EntryTypes still contained in the map
-    typename std::map<KeyType, EntryType*>::iterator iter;
-    for (iter = keyEntryMap_.begin(); iter != keyEntryMap_.end(); ++iter)
+    /** An entry linked into the hash index, LRU list and dirty list */
+    struct Node
     {
-        delete iter->second;
-    }
+        Node(const KeyType& k, const EntryType& e)
+            : key(k), entry(e), hashNext(0),
+              lruPrev(0), lruNext(0), dirtyPrev(0), dirtyNext(0) {};
+
+        KeyType key;
+        EntryType entry;
+        Node* hashNext;
+        Node* lruPrev;
+        Node* lruNext;
+        Node* dirtyPrev;
+        Node* dirtyNext;
+    };
 
-    // Clear containers
-    lruList_.clear();
-    keyEntryMap_.clear();
-}
+    /** Copy constructor hidden */
+    LRUCache(const LRUCache& other);
 
+    /** Assignment operator hidden */
+    LRUCache& operator=(const LRUCache& other);
 
-template<class KeyType, class ValueType>
-void LRUCache<KeyType,ValueType>::insert(const KeyType& key,
-                                         const ValueType& value,
-                                         bool isDirty)
-{
-    // Check to see if the entry already exists
-    typename std::map<KeyType, EntryType*>::iterator pos;
-    pos = keyEntryMap_.find(key);
-    if (pos != keyEntryMap_.end())
-    {
-        // Update the number of dirty entries if necessary
-        if (isDirty && !pos->second->isDirty)
-        {
-            numDirtyEntries_++;
-        }
+    /**
+     * Insert or update the entry for key, and set the outbound parameters
+     * to the evicted entry if they are not null
+     *
+     * @return true if an entry was evicted
+     */
+    bool insertEntry(const KeyType& key,
+                     const ValueType& value,
+                     bool isDirty,
+                     KeyType* outEvictedKey,
+                     ValueType* outEvictedValue,
+                     bool* outEvictedDirtyBit);
 
-        // Entry already exists, update it
-        pos->second->data = value;
-        pos->second->isDirty = isDirty;
+    /** @return the hash bucket for key */
+    std::size_t bucket(const KeyType& key) const;
 
-        // Update the LRU data
-        lruList_.erase(pos->second->lruRef);
-        lruList_.push_front(key);
-        pos->second->lruRef = lruList_.begin();
-    }
-    else
-    {
-        // If the cache is full, evict an item according to LRU policy
-        if (numEntries_ == maxEntries_)
-        {
-            KeyType lruKey = *(lruList_.rbegin());
-            this->remove(lruKey);
-        }
+    /** @return the node for key or 0 */
+    Node* findNode(const KeyType& key) const;
 
-        // Fill out the Cache entry data
-        EntryType* entry = new EntryType();
-        entry->data = value;
-        entry->isDirty = isDirty;
+    /** @return a node from the pool filled with key and value */
+    Node* allocateNode(const KeyType& key,
+                       const ValueType& value,
+                       bool isDirty);
 
-        // Add to the LRU list
-        lruList_.push_front(key);
-        entry->lruRef = lruList_.begin();
+    /** Unlink the node from the cache and return it to the pool */
+    void releaseNode(Node* node);
 
-        // Insert the cache entry
-        keyEntryMap_.insert(std::make_pair(key, entry));
-        numEntries_++;
+    /** Link the node at the most recently used end of the LRU list */
+    void pushFront(Node* node);
 
-        // Update the number of dirty entries if necessary
-        if (isDirty)
-        {
-            numDirtyEntries_++;
-        }
-    }
-}
+    /** Unlink the node from the LRU list */
+    void unlinkLRU(Node* node);
 
-template<class KeyType, class ValueType>
-void LRUCache<KeyType,ValueType>::insertAndRecall(const KeyType& key,
-                                                  const ValueType& value,
-                                                  bool isDirty,
-                                                  KeyType& outEvictedKey,
-                                                  ValueType& outEvictedValue,
-                                                  bool& outEvictedDirtyBit)
-{
-    bool hasEviction = false;
+    /** Set the node's dirty bit and update the dirty list */
+    void setDirty(Node* node, bool isDirty);
 
-    // Check to see if the entry already exists
-    typename std::map<KeyType, EntryType*>::iterator pos;
-    pos = keyEntryMap_.find(key);
-    if (pos != keyEntryMap_.end())
-    {
-        // Update the number of dirty entries if necessary
-        if (isDirty && !pos->second->isDirty)
-        {
-            numDirtyEntries_++;
-        }
+    /** Hash index buckets */
+    std::vector<Node*> buckets_;
 
-        // Entry already exists, update it
-        pos->second->data = value;
-        pos->second->isDirty = isDirty;
+    /** Most and least recently used entries */
+    Node* lruHead_;
+    Node* lruTail_;
 
-        // Update the LRU data
-        lruList_.erase(pos->second->lruRef);
-        lruList_.push_front(key);
-        pos->second->lruRef = lruList_.begin();
-    }
-    else
-    {
-        // If the cache is full, retrieve and perform the next eviction
-        if (numEntries_ == maxEntries_)
-        {
-            KeyType lruKey = *(lruList_.rbegin());
-
-            // Set the outbound parameters
-            typename std::map<KeyType, EntryType*>::iterator evictee;
-            evictee = keyEntryMap_.find(lruKey);
-            assert(evictee != keyEntryMap_.end());
-            outEvictedKey = evictee->first;
-            outEvictedValue = evictee->second->data;
-            outEvictedDirtyBit = evictee->second->isDirty;
+    /** Oldest and newest dirty entries */
+    Node* dirtyHead_;
+    Node* dirtyTail_;
 
-            // Remove the entry
-            this->remove(lruKey);
+    /** Unused nodes available for reuse */
+    std::vector<Node*> freeNodes_;
 
-            // Indicate an eviction occurred
-            hasEviction = true;
-        }
-        // Fill out the Cache entry data
-        EntryType* entry = new EntryType();
-        entry->data = value;
-        entry->isDirty = isDirty;
+    /** Hash function */
+    HashType hash_;
 
-        // Add to the LRU list
-        lruList_.push_front(key);
-        entry->lruRef = lruList_.begin();
+    const std::size_t maxEntries_;
+    std::size_t numDirtyEntries_;
+    std::size_t numEntries_;
+};
 
-        // Insert the cache entry
-        keyEntryMap_.insert(std::make_pair(key, entry));
-        numEntries_++;
+template <class KeyType, class ValueType, class HashType>
+LRUCache<KeyType,ValueType,HashType>::LRUCache(int capacity)
+    : buckets_(2 * capacity + 1, (Node*)0),
+      lruHead_(0),
+      lruTail_(0),
+      dirtyHead_(0),
+      dirtyTail_(0),
+      maxEntries_(capacity),
+      numDirtyEntries_(0),
+      numEntries_(0)
+{
+    assert(0 < maxEntries_);
+}
 
-        // Update the number of dirty entries if necessary
-        if (isDirty)
-        {
-            numDirtyEntries_++;
-        }
+template <class KeyType, class ValueType, class HashType>
+LRUCache<KeyType,ValueType,HashType>::~LRUCache()
+{
+    // Delete the cached and pooled nodes
+    while (0 != lruHead_)
+    {
+        Node* next = lruHead_->lruNext;
+        delete lruHead_;
+        lruHead_ = next;
     }
-
-    if (!hasEviction)
+    for (std::size_t i = 0; i < freeNodes_.size(); i++)
     {
-        NoSuchEntry e;
-        throw e;
+        delete freeNodes_[i];
     }
 }
 
-template<class KeyType, class ValueType>
-void LRUCache<KeyType,ValueType>::remove(const KeyType& key)
+template<class KeyType, class ValueType, class HashType>
+void LRUCache<KeyType,ValueType,HashType>::insert(const KeyType& key,
+                                                  const ValueType& value,
+                                                  bool isDirty)
 {
-    typename std::map<KeyType, EntryType*>::iterator pos;
-    pos = keyEntryMap_.find(key);
-    if (pos != keyEntryMap_.end())
-    {
-        // Cleanup the lru list
-        lruList_.erase(pos->second->lruRef);
-
-        // Update bookkeeping
-        numEntries_--;
-        if (getDirtyBit(key))
-        {
-            numDirtyEntries_--;
-        }
+    insertEntry(key, value, isDirty, 0, 0, 0);
+}
 
-        // Cleanup the EntryType memory
-        delete pos->second;
+template<class KeyType, class ValueType, class HashType>
+bool LRUCache<KeyType,ValueType,HashType>::insertAndRecall(
+    const KeyType& key,
+    const ValueType& value,
+    bool isDirty,
+    KeyType& outEvictedKey,
+    ValueType& outEvictedValue,
+    bool& outEvictedDirtyBit)
+{
+    return insertEntry(key, value, isDirty,
+                       &outEvictedKey, &outEvictedValue, &outEvictedDirtyBit);
+}
 
-        // Remove from the map
-        keyEntryMap_.erase(pos);
-    }
-    else
+template<class KeyType, class ValueType, class HashType>
+void LRUCache<KeyType,ValueType,HashType>::remove(const KeyType& key)
+{
+    Node* node = findNode(key);
+    if (0 == node)
     {
         NoSuchEntry e;
         throw e;
     }
+    releaseNode(node);
 }
 
-template<class KeyType, class ValueType>
-void LRUCache<KeyType,ValueType>::setDirtyBit(const KeyType& key, bool dirtyValue)
+template<class KeyType, class ValueType, class HashType>
+void LRUCache<KeyType,ValueType,HashType>::removeAndRecall(
+    const KeyType& key,
+    ValueType& outValue,
+    bool& outDirtyBit)
 {
-    typename std::map<KeyType, EntryType*>::iterator pos;
-
-    // Search the map for key
-    pos = keyEntryMap_.find(key);
-    if (pos == keyEntryMap_.end())
+    Node* node = findNode(key);
+    if (0 == node)
     {
         NoSuchEntry e;
         throw e;
     }
-    pos->second->isDirty = dirtyValue;
+    outValue = node->entry.data;
+    outDirtyBit = node->entry.isDirty;
+    releaseNode(node);
 }
 
-template<class KeyType, class ValueType>
-bool LRUCache<KeyType,ValueType>::exists(const KeyType& key) const
+template<class KeyType, class ValueType, class HashType>
+void LRUCache<KeyType,ValueType,HashType>::setDirtyBit(const KeyType& key,
+                                                       bool dirtyValue)
 {
-    typename std::map<KeyType, EntryType*>::const_iterator pos;
-
-    // Search the map for key
-    pos = keyEntryMap_.find(key);
-    if (pos != keyEntryMap_.end())
+    Node* node = findNode(key);
+    if (0 == node)
     {
-        return true;
+        NoSuchEntry e;
+        throw e;
     }
-    return false;
+    setDirty(node, dirtyValue);
 }
 
-template<class KeyType, class ValueType>
-ValueType LRUCache<KeyType,ValueType>::lookup(const KeyType& key)
+template<class KeyType, class ValueType, class HashType>
+bool LRUCache<KeyType,ValueType,HashType>::exists(const KeyType& key) const
 {
-    EntryType* entry = 0;
-    typename std::map<KeyType, EntryType*>::iterator pos;
+    return (0 != findNode(key));
+}
 
-    // Search the map for key
-    pos = keyEntryMap_.find(key);
-    if (pos == keyEntryMap_.end())
+template<class KeyType, class ValueType, class HashType>
+ValueType LRUCache<KeyType,ValueType,HashType>::lookup(const KeyType& key)
+{
+    ValueType* value = find(key);
+    if (0 == value)
     {
         NoSuchEntry e;
         throw e;
     }
+    return *value;
+}
 
-    entry = pos->second;
+template<class KeyType, class ValueType, class HashType>
+ValueType* LRUCache<KeyType,ValueType,HashType>::find(const KeyType& key)
+{
+    Node* node = findNode(key);
+    if (0 == node)
+    {
+        return 0;
+    }
 
     // Refresh the LRU list
-    lruList_.erase(entry->lruRef);
-    lruList_.push_front(key);
-    entry->lruRef = lruList_.begin();
-    return entry->data;
+    unlinkLRU(node);
+    pushFront(node);
+    return &(node->entry.data);
+}
+
+template<class KeyType, class ValueType, class HashType>
+ValueType* LRUCache<KeyType,ValueType,HashType>::peek(const KeyType& key)
+{
+    Node* node = findNode(key);
+    return (0 == node) ? 0 : &(node->entry.data);
+}
+
+template<class KeyType, class ValueType, class HashType>
+const ValueType* LRUCache<KeyType,ValueType,HashType>::peek(
+    const KeyType& key) const
+{
+    Node* node = findNode(key);
+    return (0 == node) ? 0 : &(node->entry.data);
 }
 
-template<class KeyType, class ValueType>
-bool LRUCache<KeyType,ValueType>::getDirtyBit(const KeyType& key) const
+template<class KeyType, class ValueType, class HashType>
+bool LRUCache<KeyType,ValueType,HashType>::getDirtyBit(
+    const KeyType& key) const
 {
-    // Search the map for key
-    typename std::map<KeyType, EntryType*>::const_iterator pos;
-    pos = keyEntryMap_.find(key);
-    if (pos == keyEntryMap_.end())
+    Node* node = findNode(key);
+    if (0 == node)
     {
         NoSuchEntry e;
         throw e;
-     }
-
-    return pos->second->isDirty;
+    }
+    return node->entry.isDirty;
 }
 
-template<class KeyType, class ValueType>
-std::vector<KeyType> LRUCache<KeyType,ValueType>::getDirtyEntries() const
+template<class KeyType, class ValueType, class HashType>
+std::vector<KeyType>
+LRUCache<KeyType,ValueType,HashType>::getDirtyEntries() const
 {
     std::vector<KeyType> dirtyEntries;
+    dirtyEntries.reserve(numDirtyEntries_);
+    for (Node* node = dirtyHead_; 0 != node; node = node->dirtyNext)
+    {
+        dirtyEntries.push_back(node->key);
+    }
+    return dirtyEntries;
+}
 
-    // Loop thru the map to find all of the dirty entries
-    typename MapType::const_iterator mapEnd = keyEntryMap_.end();
-    typename MapType::const_iterator mapIter;
-    for (mapIter = keyEntryMap_.begin(); mapIter != mapEnd; mapIter++)
+template<class KeyType, class ValueType, class HashType>
+std::set<KeyType> LRUCache<KeyType,ValueType,HashType>::getFilteredEntries(
+    const FilterFunctor& filterFunc) const
+{
+    std::set<KeyType> filteredEntries;
+    for (Node* node = lruHead_; 0 != node; node = node->lruNext)
     {
-        if (mapIter->second->isDirty)
+        if (filterFunc(node->key, node->entry))
         {
-            dirtyEntries.push_back(mapIter->first);
+            filteredEntries.insert(node->key);
         }
     }
-
-    return dirtyEntries;
+    return filteredEntries;
 }
 
-template<class KeyType, class ValueType>
-std::set<KeyType> LRUCache<KeyType,ValueType>::getFilteredEntries(
-    const LRUCache<KeyType,ValueType>::FilterFunctor& filterFunc) const
+template<class KeyType, class ValueType, class HashType>
+std::set<KeyType>
+LRUCache<KeyType,ValueType,HashType>::getFilteredDirtyEntries(
+    const FilterFunctor& filterFunc) const
 {
     std::set<KeyType> filteredEntries;
-
-    // Loop thru the map to find all of the dirty entries
-    typename MapType::const_iterator mapEnd = keyEntryMap_.end();
-    typename MapType::const_iterator mapIter;
-    for (mapIter = keyEntryMap_.begin(); mapIter != mapEnd; mapIter++)
+    for (Node* node = dirtyHead_; 0 != node; node = node->dirtyNext)
     {
-        if (filterFunc(mapIter->first, *mapIter->second))
+        if (filterFunc(node->key, node->entry))
         {
-            filteredEntries.insert(mapIter->first);
+            filteredEntries.insert(node->key);
         }
     }
-
     return filteredEntries;
 }
 
-template<class KeyType, class ValueType>
-std::pair<KeyType, ValueType> LRUCache<KeyType,ValueType>::getLRU() const
+template<class KeyType, class ValueType, class HashType>
+std::pair<KeyType, ValueType>
+LRUCache<KeyType,ValueType,HashType>::getLRU() const
 {
     // Throw an exception if the cache is empty
     if (0 == numEntries_)
@@ -473,42 +516,233 @@ std::pair<KeyType, ValueType> LRUCache<KeyType,ValueType>::getLRU() const
         throw e;
     }
 
-    // Locate the LRU entry
-    assert(0 != lruList_.size());
-    typename LRUListType::const_iterator lruIter = lruList_.end();
-    typename MapType::const_iterator mapIter = keyEntryMap_.find(*(--lruIter));
-
-    // Create a pair containing the LRU key and value
-    KeyType lruKey = mapIter->first;
-    ValueType lruValue = mapIter->second->data;
-    return make_pair(lruKey, lruValue);
+    assert(0 != lruTail_);
+    return std::make_pair(lruTail_->key, lruTail_->entry.data);
 }
 
-template<class KeyType, class ValueType>
-std::size_t LRUCache<KeyType,ValueType>::capacity() const
+template<class KeyType, class ValueType, class HashType>
+std::size_t LRUCache<KeyType,ValueType,HashType>::capacity() const
 {
     return maxEntries_;
 }
 
-template<class KeyType, class ValueType>
-std::size_t LRUCache<KeyType,ValueType>::size() const
+template<class KeyType, class ValueType, class HashType>
+std::size_t LRUCache<KeyType,ValueType,HashType>::size() const
 {
-    assert(lruList_.size() == keyEntryMap_.size());
-    assert(lruList_.size() == numEntries_);
+    assert(numEntries_ <= maxEntries_);
     return numEntries_;
 }
 
-template<class KeyType, class ValueType>
-double LRUCache<KeyType,ValueType>::percentDirty() const
+template<class KeyType, class ValueType, class HashType>
+double LRUCache<KeyType,ValueType,HashType>::percentDirty() const
 {
     assert(numDirtyEntries_ <= maxEntries_);
     assert(numDirtyEntries_ <= numEntries_);
-    //std::cerr << __FILE__ << ":" << __LINE__ << ":"
-    //          << "Num Dirty: " << numDirtyEntries_ << " Max: " << maxEntries_ << endl;
     double percentDirty = double(numDirtyEntries_) / double(maxEntries_);
     return percentDirty;
 }
 
+template<class KeyType, class ValueType, class HashType>
+bool LRUCache<KeyType,ValueType,HashType>::insertEntry(
+    const KeyType& key,
+    const ValueType& value,
+    bool isDirty,
+    KeyType* outEvictedKey,
+    ValueType* outEvictedValue,
+    bool* outEvictedDirtyBit)
+{
+    // If the entry already exists, update it
+    Node* node = findNode(key);
+    if (0 != node)
+    {
+        node->entry.data = value;
+        setDirty(node, isDirty);
+        unlinkLRU(node);
+        pushFront(node);
+        return false;
+    }
+
+    // If the cache is full, evict the least recently used entry
+    bool hasEviction = false;
+    if (numEntries_ == maxEntries_)
+    {
+        Node* evictee = lruTail_;
+        assert(0 != evictee);
+        if (0 != outEvictedKey)
+        {
+            *outEvictedKey = evictee->key;
+            *outEvictedValue = evictee->entry.data;
+            *outEvictedDirtyBit = evictee->entry.isDirty;
+        }
+        releaseNode(evictee);
+        hasEviction = true;
+    }
+
+    // Link the new entry into the index and lists
+    node = allocateNode(key, value, isDirty);
+    std::size_t b = bucket(key);
+    node->hashNext = buckets_[b];
+    buckets_[b] = node;
+    pushFront(node);
+    numEntries_++;
+    return hasEviction;
+}
+
+template<class KeyType, class ValueType, class HashType>
+std::size_t LRUCache<KeyType,ValueType,HashType>::bucket(
+    const KeyType& key) const
+{
+    return hash_(key) % buckets_.size();
+}
+
+template<class KeyType, class ValueType, class HashType>
+typename LRUCache<KeyType,ValueType,HashType>::Node*
+LRUCache<KeyType,ValueType,HashType>::findNode(const KeyType& key) const
+{
+    // Keys are equivalent if neither orders before the other
+    Node* node = buckets_[bucket(key)];
+    while (0 != node && (node->key < key || key < node->key))
+    {
+        node = node->hashNext;
+    }
+    return node;
+}
+
+template<class KeyType, class ValueType, class HashType>
+typename LRUCache<KeyType,ValueType,HashType>::Node*
+LRUCache<KeyType,ValueType,HashType>::allocateNode(const KeyType& key,
+                                                   const ValueType& value,
+                                                   bool isDirty)
+{
+    EntryType entry = {value, false};
+    Node* node = 0;
+    if (freeNodes_.empty())
+    {
+        node = new Node(key, entry);
+    }
+    else
+    {
+        node = freeNodes_.back();
+        freeNodes_.pop_back();
+        node->key = key;
+        node->entry = entry;
+    }
+    setDirty(node, isDirty);
+    return node;
+}
+
+template<class KeyType, class ValueType, class HashType>
+void LRUCache<KeyType,ValueType,HashType>::releaseNode(Node* node)
+{
+    // Unlink from the hash chain
+    Node** link = &buckets_[bucket(node->key)];
+    while (*link != node)
+    {
+        assert(0 != *link);
+        link = &((*link)->hashNext);
+    }
+    *link = node->hashNext;
+    node->hashNext = 0;
+
+    // Unlink from the lists and return to the pool
+    setDirty(node, false);
+    unlinkLRU(node);
+    numEntries_--;
+    freeNodes_.push_back(node);
+}
+
+template<class KeyType, class ValueType, class HashType>
+void LRUCache<KeyType,ValueType,HashType>::pushFront(Node* node)
+{
+    node->lruPrev = 0;
+    node->lruNext = lruHead_;
+    if (0 != lruHead_)
+    {
+        lruHead_->lruPrev = node;
+    }
+    else
+    {
+        lruTail_ = node;
+    }
+    lruHead_ = node;
+}
+
+template<class KeyType, class ValueType, class HashType>
+void LRUCache<KeyType,ValueType,HashType>::unlinkLRU(Node* node)
+{
+    if (0 != node->lruPrev)
+    {
+        node->lruPrev->lruNext = node->lruNext;
+    }
+    else
+    {
+        lruHead_ = node->lruNext;
+    }
+
+    if (0 != node->lruNext)
+    {
+        node->lruNext->lruPrev = node->lruPrev;
+    }
+    else
+    {
+        lruTail_ = node->lruPrev;
+    }
+    node->lruPrev = 0;
+    node->lruNext = 0;
+}
+
+template<class KeyType, class ValueType, class HashType>
+void LRUCache<KeyType,ValueType,HashType>::setDirty(Node* node,
+                                                    bool isDirty)
+{
+    if (isDirty == node->entry.isDirty)
+    {
+        return;
+    }
+
+    if (isDirty)
+    {
+        // Append to the dirty list
+        node->dirtyPrev = dirtyTail_;
+        node->dirtyNext = 0;
+        if (0 != dirtyTail_)
+        {
+            dirtyTail_->dirtyNext = node;
+        }
+        else
+        {
+            dirtyHead_ = node;
+        }
+        dirtyTail_ = node;
+        numDirtyEntries_++;
+    }
+    else
+    {
+        // Unlink from the dirty list
+        if (0 != node->dirtyPrev)
+        {
+            node->dirtyPrev->dirtyNext = node->dirtyNext;
+        }
+        else
+        {
+            dirtyHead_ = node->dirtyNext;
+        }
+
+        if (0 != node->dirtyNext)
+        {
+            node->dirtyNext->dirtyPrev = node->dirtyPrev;
+        }
+        else
+        {
+            dirtyTail_ = node->dirtyPrev;
+        }
+        node->dirtyPrev = 0;
+        node->dirtyNext = 0;
+        numDirtyEntries_--;
+    }
+    node->entry.isDirty = isDirty;
+}
+
 #endif
 
 /*
@@ -10,20 +10,19 @@
 //
 #include <cassert>
 #include <functional>
-#include <list>
-#include <map>
+#include <set>
 #include <utility>
 #include <vector>
+#include "lru_cache.h"
 #include "spfs_exceptions.h"
 
 /**
- * A helper class for filtering LRUCache entries
+ * A simple fixed size cache using LRU replacement that tracks the MESI
+ * coherence state of each entry.  Modified entries are tracked as the
+ * dirty entries of the underlying LRUCache.
  */
-
-/**
- * A simple fixed size cache using LRU replacement.
- */
-template <class KeyType, class ValueType>
+template <class KeyType, class ValueType,
+          class HashType = LRUCacheHash<KeyType> >
 class LRUMesiCache
 {
 public:
@@ -36,7 +35,6 @@ public:
     {
         ValueType data;
         State state;
-        typename std::list<KeyType>::iterator lruRef;
     };
 
     /**
@@ -52,20 +50,11 @@ public:
         virtual bool filter(const KeyType& key, const ValueType& val, State state) const = 0;
     };
 
-    /** Convenience typedef of the key-value map */
-    typedef std::map<KeyType, EntryType*> MapType;
-
-    /** Convenience typedef of the lru list */
-    typedef std::list<KeyType> LRUListType;
-
     /**
      * Constructor
      */
     LRUMesiCache(int capacity);
 
-    /** Destructor */
-    ~LRUMesiCache();
-
     /**
      * Insert a Key-Value pair into the cache.  If the cache already
      * contains more entries than the maximum size, evict the least
@@ -73,19 +62,20 @@ public:
      *
      * @param key the cache lookup key
      * @param value the cached value
-     * @param isDirty the cached value's dirty bit
+     * @param state the cached value's state
      */
     void insert(const KeyType& key,
                 const ValueType& value,
                 State state = SHARED);
 
     /**
-     * Perform the cache insertion and set the evicted value and dirty bit
+     * Perform the cache insertion and set the evicted value and state
      * in the outbound parameters.
      *
-     * @throw NoSuchEntry if no eviction occurs
+     * @return true if an entry was evicted, otherwise the outbound
+     *   parameters are not modified
      */
-    void insertAndRecall(const KeyType& key,
+    bool insertAndRecall(const KeyType& key,
                          const ValueType& value,
                          State state,
                          KeyType& outEvictedKey,
@@ -121,6 +111,12 @@ public:
      */
     State lookupState(const KeyType& key);
 
+    /**
+     * @return a pointer to the entry for key and update the LRU ordering,
+     *   or 0 if no entry exists for the key
+     */
+    const EntryType* find(const KeyType& key);
+
     /**
      * Check if an entry exists without modifying its LRU status
      *
@@ -129,7 +125,7 @@ public:
     bool exists(const KeyType& key) const;
 
     /**
-     * @return the dirty bit for key
+     * @return the state for key
      *
      * @throw NoSuchENtry if no entry exists for the key
      */
@@ -153,6 +149,12 @@ public:
      */
     std::set<KeyType> getFilteredKeys(const FilterFunctor& filter) const;
 
+    /**
+     * @return the modified cache keys that the filter returns true for.
+     *   Only the modified entries are examined.
+     */
+    std::set<KeyType> getFilteredModifiedKeys(const FilterFunctor& filter) const;
+
     /**
      * @return the next entry that will be evicted on a new insertion
      *
@@ -175,410 +177,187 @@ public:
 
 private:
 
-    std::map<KeyType, EntryType*> keyEntryMap_;
-    std::list<KeyType> lruList_;
-
-    const std::size_t maxEntries_;
-    std::size_t numModifiedEntries_;
-    std::size_t numEntries_;
-};
-
-template <class KeyType, class ValueType>
-LRUMesiCache<KeyType,ValueType>::LRUMesiCache(int capacity)
-    : maxEntries_(capacity),
-      numModifiedEntries_(0),
-      numEntries_(0)
-{
-    assert(0 < maxEntries_);
-}
-
-template <class KeyType, class ValueType>
-LRUMesiCache<KeyType,ValueType>::~LRUMesiCache()
-{
-    // Delete any EntryTypes still contained in the map
-    typename std::map<KeyType, EntryType*>::iterator iter;
-    for (iter = keyEntryMap_.begin(); iter != keyEntryMap_.end(); ++iter)
-    {
-        delete iter->second;
-    }
-
-    // Clear containers
-    lruList_.clear();
-    keyEntryMap_.clear();
-}
-
+    /** Convenience typedef of the underlying cache */
+    typedef LRUCache<KeyType, EntryType, HashType> CacheType;
 
-template<class KeyType, class ValueType>
-void LRUMesiCache<KeyType,ValueType>::insert(const KeyType& key,
-                                             const ValueType& value,
-                                             State state)
-{
-    // Check to see if the entry already exists
-    typename std::map<KeyType, EntryType*>::iterator pos;
-    pos = keyEntryMap_.find(key);
-    if (pos != keyEntryMap_.end())
+    /** Applies a MESI filter to the underlying cache's entries */
+    struct FilterAdapter : public CacheType::FilterFunctor
     {
-        // Update the number of dirty entries if necessary
-        if (MODIFIED == state &&
-            MODIFIED != pos->second->state)
-        {
-            numModifiedEntries_++;
-        }
-
-        // Entry already exists, update it
-        pos->second->data = value;
-        pos->second->state = state;
+        FilterAdapter(const FilterFunctor& f) : mesiFilter(f) {};
 
-        // Update the LRU data
-        lruList_.erase(pos->second->lruRef);
-        lruList_.push_front(key);
-        pos->second->lruRef = lruList_.begin();
-    }
-    else
-    {
-        // If the cache is full, evict an item according to LRU policy
-        if (numEntries_ == maxEntries_)
+        virtual bool filter(const KeyType& key,
+                            const EntryType& entry,
+                            bool isDirty) const
         {
-            KeyType lruKey = *(lruList_.rbegin());
-            this->remove(lruKey);
+            return mesiFilter(key, entry);
         }
 
-        // Fill out the Cache entry data
-        EntryType* entry = new EntryType();
-        entry->data = value;
-        entry->state = state;
-
-        // Add to the LRU list
-        lruList_.push_front(key);
-        entry->lruRef = lruList_.begin();
+        const FilterFunctor& mesiFilter;
+    };
 
-        // Insert the cache entry
-        keyEntryMap_.insert(std::make_pair(key, entry));
-        numEntries_++;
+    /** The underlying LRU cache */
+    CacheType cache_;
+};
 
-        // Update the number of dirty entries if necessary
-        if (MODIFIED == state)
-        {
-            numModifiedEntries_++;
-        }
-    }
+template <class KeyType, class ValueType, class HashType>
+LRUMesiCache<KeyType,ValueType,HashType>::LRUMesiCache(int capacity)
+    : cache_(capacity)
+{
 }
 
-template<class KeyType, class ValueType>
-void LRUMesiCache<KeyType,ValueType>::insertAndRecall(const KeyType& key,
-                                                  const ValueType& value,
-                                                  State state,
-                                                  KeyType& outEvictedKey,
-                                                  ValueType& outEvictedValue,
-                                                  State& outEvictedState)
+template<class KeyType, class ValueType, class HashType>
+void LRUMesiCache<KeyType,ValueType,HashType>::insert(const KeyType& key,
+                                                      const ValueType& value,
+                                                      State state)
 {
-    bool hasEviction = false;
-
-    // Check to see if the entry already exists
-    typename std::map<KeyType, EntryType*>::iterator pos;
-    pos = keyEntryMap_.find(key);
-    if (pos != keyEntryMap_.end())
-    {
-        // Update the number of dirty entries if necessary
-        if (MODIFIED == state &&
-            MODIFIED != pos->second->state)
-        {
-            numModifiedEntries_++;
-        }
-
-        // Entry already exists, update it
-        pos->second->data = value;
-        pos->second->state = state;
-
-        // Update the LRU data
-        lruList_.erase(pos->second->lruRef);
-        lruList_.push_front(key);
-        pos->second->lruRef = lruList_.begin();
-    }
-    else
-    {
-        // If the cache is full, retrieve and perform the next eviction
-        if (numEntries_ == maxEntries_)
-        {
-            KeyType lruKey = *(lruList_.rbegin());
-
-            // Set the outbound parameters
-            typename std::map<KeyType, EntryType*>::iterator evictee;
-            evictee = keyEntryMap_.find(lruKey);
-            assert(evictee != keyEntryMap_.end());
-            outEvictedKey = evictee->first;
-            outEvictedValue = evictee->second->data;
-            outEvictedState = evictee->second->state;
-
-            // Remove the entry
-            this->remove(lruKey);
-
-            // Indicate an eviction occurred
-            hasEviction = true;
-        }
-        // Fill out the Cache entry data
-        EntryType* entry = new EntryType();
-        entry->data = value;
-        entry->state = state;
-
-        // Add to the LRU list
-        lruList_.push_front(key);
-        entry->lruRef = lruList_.begin();
-
-        // Insert the cache entry
-        keyEntryMap_.insert(std::make_pair(key, entry));
-        numEntries_++;
-
-        // Update the number of dirty entries if necessary
-        if (MODIFIED == state)
-        {
-            numModifiedEntries_++;
-        }
-    }
-
-    if (!hasEviction)
-    {
-        NoSuchEntry e;
-        throw e;
-    }
+    EntryType entry = {value, state};
+    cache_.insert(key, entry, MODIFIED == state);
 }
 
-template<class KeyType, class ValueType>
-void LRUMesiCache<KeyType,ValueType>::remove(const KeyType& key)
+template<class KeyType, class ValueType, class HashType>
+bool LRUMesiCache<KeyType,ValueType,HashType>::insertAndRecall(
+    const KeyType& key,
+    const ValueType& value,
+    State state,
+    KeyType& outEvictedKey,
+    ValueType& outEvictedValue,
+    State& outEvictedState)
 {
-    typename std::map<KeyType, EntryType*>::iterator pos;
-    pos = keyEntryMap_.find(key);
-    if (pos != keyEntryMap_.end())
-    {
-        // Cleanup the lru list
-        lruList_.erase(pos->second->lruRef);
-
-        // Update bookkeeping
-        numEntries_--;
-        if (MODIFIED == getState(key))
-        {
-            numModifiedEntries_--;
-        }
-
-        // Cleanup the EntryType memory
-        delete pos->second;
-
-        // Remove from the map
-        keyEntryMap_.erase(pos);
-    }
-    else
+    EntryType entry = {value, state};
+    EntryType evicted = entry;
+    bool evictedDirtyBit = false;
+    if (cache_.insertAndRecall(key, entry, MODIFIED == state,
+                               outEvictedKey, evicted, evictedDirtyBit))
     {
-        NoSuchEntry e;
-        throw e;
+        outEvictedValue = evicted.data;
+        outEvictedState = evicted.state;
+        return true;
     }
+    return false;
 }
 
-template<class KeyType, class ValueType>
-void LRUMesiCache<KeyType,ValueType>::setState(const KeyType& key, State stateValue)
+template<class KeyType, class ValueType, class HashType>
+void LRUMesiCache<KeyType,ValueType,HashType>::remove(const KeyType& key)
 {
-    typename std::map<KeyType, EntryType*>::iterator pos;
+    cache_.remove(key);
+}
 
-    // Search the map for key
-    pos = keyEntryMap_.find(key);
-    if (pos == keyEntryMap_.end())
+template<class KeyType, class ValueType, class HashType>
+void LRUMesiCache<KeyType,ValueType,HashType>::setState(const KeyType& key,
+                                                        State stateValue)
+{
+    EntryType* entry = cache_.peek(key);
+    if (0 == entry)
     {
         NoSuchEntry e;
         throw e;
     }
-
-    // Adjust the number of modified entries if needed
-    if (MODIFIED == pos->second->state)
-    {
-        numModifiedEntries_--;
-    }
-    if (MODIFIED == stateValue)
-    {
-        numModifiedEntries_++;
-    }
-
-    pos->second->state = stateValue;
+    entry->state = stateValue;
+    cache_.setDirtyBit(key, MODIFIED == stateValue);
 }
 
-template<class KeyType, class ValueType>
-bool LRUMesiCache<KeyType,ValueType>::exists(const KeyType& key) const
+template<class KeyType, class ValueType, class HashType>
+bool LRUMesiCache<KeyType,ValueType,HashType>::exists(
+    const KeyType& key) const
 {
-    typename std::map<KeyType, EntryType*>::const_iterator pos;
-
-    // Search the map for key
-    pos = keyEntryMap_.find(key);
-    if (pos != keyEntryMap_.end())
-    {
-        return true;
-    }
-    return false;
+    return cache_.exists(key);
 }
 
-template<class KeyType, class ValueType>
-ValueType LRUMesiCache<KeyType,ValueType>::lookup(const KeyType& key)
+template<class KeyType, class ValueType, class HashType>
+ValueType LRUMesiCache<KeyType,ValueType,HashType>::lookup(
+    const KeyType& key)
 {
-    EntryType* entry = 0;
-    typename std::map<KeyType, EntryType*>::iterator pos;
-
-    // Search the map for key
-    pos = keyEntryMap_.find(key);
-    if (pos == keyEntryMap_.end())
-    {
-        NoSuchEntry e;
-        throw e;
-    }
-
-    entry = pos->second;
-
-    // Refresh the LRU list
-    lruList_.erase(entry->lruRef);
-    lruList_.push_front(key);
-    entry->lruRef = lruList_.begin();
-    return entry->data;
+    return cache_.lookup(key).data;
 }
 
-template<class KeyType, class ValueType>
-typename LRUMesiCache<KeyType,ValueType>::State
-LRUMesiCache<KeyType,ValueType>::lookupState(const KeyType& key)
+template<class KeyType, class ValueType, class HashType>
+typename LRUMesiCache<KeyType,ValueType,HashType>::State
+LRUMesiCache<KeyType,ValueType,HashType>::lookupState(const KeyType& key)
 {
-    EntryType* entry = 0;
-    typename std::map<KeyType, EntryType*>::iterator pos;
-
-    // Search the map for key
-    pos = keyEntryMap_.find(key);
-    if (pos == keyEntryMap_.end())
-    {
-        NoSuchEntry e;
-        throw e;
-    }
-
-    entry = pos->second;
+    return cache_.lookup(key).state;
+}
 
-    // Refresh the LRU list
-    lruList_.erase(entry->lruRef);
-    lruList_.push_front(key);
-    entry->lruRef = lruList_.begin();
-    return entry->state;
+template<class KeyType, class ValueType, class HashType>
+const typename LRUMesiCache<KeyType,ValueType,HashType>::EntryType*
+LRUMesiCache<KeyType,ValueType,HashType>::find(const KeyType& key)
+{
+    return cache_.find(key);
 }
 
-template<class KeyType, class ValueType>
-typename LRUMesiCache<KeyType,ValueType>::State
-LRUMesiCache<KeyType,ValueType>::getState(const KeyType& key) const
+template<class KeyType, class ValueType, class HashType>
+typename LRUMesiCache<KeyType,ValueType,HashType>::State
+LRUMesiCache<KeyType,ValueType,HashType>::getState(const KeyType& key) const
 {
-    // Search the map for key
-    typename std::map<KeyType, EntryType*>::const_iterator pos;
-    pos = keyEntryMap_.find(key);
-    if (pos == keyEntryMap_.end())
+    const EntryType* entry = cache_.peek(key);
+    if (0 == entry)
     {
         NoSuchEntry e;
         throw e;
-     }
-
-    return pos->second->state;
+    }
+    return entry->state;
 }
 
-template<class KeyType, class ValueType>
-std::vector<KeyType> LRUMesiCache<KeyType,ValueType>::getModifiedEntries() const
+template<class KeyType, class ValueType, class HashType>
+std::vector<KeyType>
+LRUMesiCache<KeyType,ValueType,HashType>::getModifiedEntries() const
 {
-    std::vector<KeyType> dirtyEntries;
-
-    // Loop thru the map to find all of the dirty entries
-    typename MapType::const_iterator mapEnd = keyEntryMap_.end();
-    typename MapType::const_iterator mapIter;
-    for (mapIter = keyEntryMap_.begin(); mapIter != mapEnd; mapIter++)
-    {
-        if (MODIFIED == mapIter->second->state)
-        {
-            dirtyEntries.push_back(mapIter->first);
-        }
-    }
-
-    return dirtyEntries;
+    return cache_.getDirtyEntries();
 }
 
-template<class KeyType, class ValueType>
-std::set<ValueType> LRUMesiCache<KeyType,ValueType>::getFilteredEntries(
-    const LRUMesiCache<KeyType,ValueType>::FilterFunctor& filterFunc) const
+template<class KeyType, class ValueType, class HashType>
+std::set<ValueType>
+LRUMesiCache<KeyType,ValueType,HashType>::getFilteredEntries(
+    const FilterFunctor& filterFunc) const
 {
+    std::set<KeyType> keys = getFilteredKeys(filterFunc);
     std::set<ValueType> filteredEntries;
-
-    // Loop thru the map to find all of the dirty entries
-    typename MapType::const_iterator mapEnd = keyEntryMap_.end();
-    typename MapType::const_iterator mapIter;
-    for (mapIter = keyEntryMap_.begin(); mapIter != mapEnd; mapIter++)
+    typename std::set<KeyType>::const_iterator iter;
+    for (iter = keys.begin(); iter != keys.end(); ++iter)
     {
-        if (filterFunc(mapIter->first, *mapIter->second))
-        {
-            filteredEntries.insert(mapIter->second->data);
-        }
+        filteredEntries.insert(cache_.peek(*iter)->data);
     }
-
     return filteredEntries;
 }
 
-template<class KeyType, class ValueType>
-std::set<KeyType> LRUMesiCache<KeyType,ValueType>::getFilteredKeys(
-    const LRUMesiCache<KeyType,ValueType>::FilterFunctor& filterFunc) const
+template<class KeyType, class ValueType, class HashType>
+std::set<KeyType> LRUMesiCache<KeyType,ValueType,HashType>::getFilteredKeys(
+    const FilterFunctor& filterFunc) const
 {
-    std::set<KeyType> filteredEntries;
-
-    // Loop thru the map to find all of the dirty entries
-    typename MapType::const_iterator mapEnd = keyEntryMap_.end();
-    typename MapType::const_iterator mapIter;
-    for (mapIter = keyEntryMap_.begin(); mapIter != mapEnd; mapIter++)
-    {
-        if (filterFunc(mapIter->first, *mapIter->second))
-        {
-            filteredEntries.insert(mapIter->first);
-        }
-    }
-
-    return filteredEntries;
+    return cache_.getFilteredEntries(FilterAdapter(filterFunc));
 }
 
-template<class KeyType, class ValueType>
-std::pair<KeyType, ValueType> LRUMesiCache<KeyType,ValueType>::getLRU() const
+template<class KeyType, class ValueType, class HashType>
+std::set<KeyType>
+LRUMesiCache<KeyType,ValueType,HashType>::getFilteredModifiedKeys(
+    const FilterFunctor& filterFunc) const
 {
-    // Throw an exception if the cache is empty
-    if (0 == numEntries_)
-    {
-        NoSuchEntry e;
-        throw e;
-    }
-
-    // Locate the LRU entry
-    assert(0 != lruList_.size());
-    typename LRUListType::const_iterator lruIter = lruList_.end();
-    typename MapType::const_iterator mapIter = keyEntryMap_.find(*(--lruIter));
+    return cache_.getFilteredDirtyEntries(FilterAdapter(filterFunc));
+}
 
-    // Create a pair containing the LRU key and value
-    KeyType lruKey = mapIter->first;
-    ValueType lruValue = mapIter->second->data;
-    return make_pair(lruKey, lruValue);
+template<class KeyType, class ValueType, class HashType>
+std::pair<KeyType, ValueType>
+LRUMesiCache<KeyType,ValueType,HashType>::getLRU() const
+{
+    std::pair<KeyType, EntryType> lru = cache_.getLRU();
+    return std::make_pair(lru.first, lru.second.data);
 }
 
-template<class KeyType, class ValueType>
-std::size_t LRUMesiCache<KeyType,ValueType>::capacity() const
+template<class KeyType, class ValueType, class HashType>
+std::size_t LRUMesiCache<KeyType,ValueType,HashType>::capacity() const
 {
-    return maxEntries_;
+    return cache_.capacity();
 }
 
-template<class KeyType, class ValueType>
-std::size_t LRUMesiCache<KeyType,ValueType>::size() const
+template<class KeyType, class ValueType, class HashType>
+std::size_t LRUMesiCache<KeyType,ValueType,HashType>::size() const
 {
-    assert(lruList_.size() == keyEntryMap_.size());
-    assert(lruList_.size() == numEntries_);
-    return numEntries_;
+    return cache_.size();
 }
 
-template<class KeyType, class ValueType>
-double LRUMesiCache<KeyType,ValueType>::percentModified() const
+template<class KeyType, class ValueType, class HashType>
+double LRUMesiCache<KeyType,ValueType,HashType>::percentModified() const
 {
-    assert(numModifiedEntries_ <= maxEntries_);
-    assert(numModifiedEntries_ <= numEntries_);
-    //std::cerr << __FILE__ << ":" << __LINE__ << ":"
-    //          << "Num Dirty: " << numDirtyEntries_ << " Max: " << maxEntries_ << endl;
-    double percentModified = double(numModifiedEntries_) / double(maxEntries_);
-    return percentModified;
+    return cache_.percentDirty();
 }
 
 #endif
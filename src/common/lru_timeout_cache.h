@@ -9,11 +9,8 @@
 // for details on this and other legal matters.
 //
 #include <cassert>
-#include <iostream>
-#include <list>
-#include <map>
-#include <utility>
 #include <omnetpp.h>
+#include "lru_cache.h"
 
 /**
  * A CacheEntry wrapper that includes a simulation timestamp
@@ -23,11 +20,11 @@ struct LRUTimeoutCacheEntry
 {
     ValueType data;
     double timeStamp;
-    typename std::list<KeyType>::iterator lruRef;
 };
 
 /**
- *
+ * A fixed size LRU cache that records the simulation time each entry was
+ * inserted
  */
 template <class KeyType, class ValueType>
 class LRUTimeoutCache
@@ -37,17 +34,11 @@ public:
     /** Convenience typedef of cache entries */
     typedef LRUTimeoutCacheEntry<KeyType,ValueType> EntryType;
 
-    /** Convencience typedef of the key-value map */
-    typedef std::map<KeyType,EntryType*> MapType;
-
     /**
      * Constructor
      */
     LRUTimeoutCache(int capacity, double timeOut);
 
-    /** Destructor */
-    ~LRUTimeoutCache();
-
     /**
      * Insert a Key-Value pair into the cache.  If the cache already
      * contains more entries than the maximum size, evict the least
@@ -72,100 +63,35 @@ public:
 
 private:
 
-    std::map<KeyType, EntryType*> keyEntryMap_;
-    std::list<KeyType> lruList_;
+    /** The underlying LRU cache */
+    LRUCache<KeyType, EntryType> cache_;
 
-    const size_t maxEntries_;
     const double maxTime_;
-    size_t numEntries_;
 };
 
 template <class KeyType, class ValueType>
 LRUTimeoutCache<KeyType,ValueType>::LRUTimeoutCache(
     int capacity, double timeOut) :
-    maxEntries_(capacity),
-    maxTime_(timeOut),
-    numEntries_(0)
+    cache_(capacity),
+    maxTime_(timeOut)
 {
-    assert(0 < maxEntries_);
     assert(0.0 < maxTime_);
 }
 
-template <class KeyType, class ValueType>
-LRUTimeoutCache<KeyType,ValueType>::~LRUTimeoutCache()
-{
-    // Delete any EntryTypes still contained in the map
-    typename std::map<KeyType, EntryType*>::iterator iter;
-    for (iter = keyEntryMap_.begin(); iter != keyEntryMap_.end(); ++iter)
-    {
-        //std::cerr << "Want to delete" << iter->first << endl;
-        delete iter->second;
-    }
-
-    // Clear containers
-    lruList_.clear();
-    keyEntryMap_.clear();
-}
-
-
 template<class KeyType, class ValueType>
 void LRUTimeoutCache<KeyType,ValueType>::insert(const KeyType& key,
                                                 const ValueType& value)
 {
-    // Check to see if the entry already exists
-    typename std::map<KeyType, EntryType*>::iterator pos;
-    pos = keyEntryMap_.find(key);
-    if (pos != keyEntryMap_.end())
-    {
-        // Entry already exists, update it
-        pos->second->data = value;
-        pos->second->timeStamp = simulation.getSimTime().dbl();
-
-        // Update the LRU data
-        lruList_.erase(pos->second->lruRef);
-        lruList_.push_front(key);
-        pos->second->lruRef = lruList_.begin();
-    }
-    else
-    {
-        // If the cache is full, evict an item according to LRU policy
-        if (numEntries_ == maxEntries_)
-        {
-            KeyType key = *(lruList_.rbegin());
-            this->remove(key);
-        }
-
-        // Fill out the Cache entry data
-        EntryType* entry = new EntryType();
-        entry->data = value;
-        entry->timeStamp = simulation.getSimTime().dbl();
-
-        // Add to the LRU list
-        lruList_.push_front(key);
-        entry->lruRef = lruList_.begin();
-
-        // Insert the cache entry
-        keyEntryMap_.insert(std::make_pair(key, entry));
-        numEntries_++;
-    }
+    EntryType entry = {value, simulation.getSimTime().dbl()};
+    cache_.insert(key, entry);
 }
 
 template<class KeyType, class ValueType>
 void LRUTimeoutCache<KeyType,ValueType>::remove(const KeyType& key)
 {
-    typename std::map<KeyType, EntryType*>::iterator pos;
-    pos = keyEntryMap_.find(key);
-    if (pos != keyEntryMap_.end())
+    if (cache_.exists(key))
     {
-        // Cleanup the lru list
-        lruList_.erase(pos->second->lruRef);
-
-        // Cleanup the EntryType memory
-        delete pos->second;
-
-        // Remove from the map
-        keyEntryMap_.erase(pos);
-        numEntries_--;
+        cache_.remove(key);
     }
 }
 
@@ -173,29 +99,13 @@ template<class KeyType, class ValueType>
 typename LRUTimeoutCache<KeyType,ValueType>::EntryType*
 LRUTimeoutCache<KeyType,ValueType>::lookup(const KeyType& key)
 {
-    EntryType* entry = 0;
-    typename std::map<KeyType, EntryType*>::iterator pos;
-
-    // Search the map for key
-    pos = keyEntryMap_.find(key);
-    if (pos != keyEntryMap_.end())
-    {
-        entry = pos->second;
-
-        // Refresh the LRU list
-        lruList_.erase(entry->lruRef);
-        lruList_.push_front(key);
-        entry->lruRef = lruList_.begin();
-    }
-    return entry;
+    return cache_.find(key);
 }
 
 template<class KeyType, class ValueType>
 int LRUTimeoutCache<KeyType,ValueType>::size() const
 {
-    assert(lruList_.size() == keyEntryMap_.size());
-    assert(lruList_.size() == numEntries_);
-    return numEntries_;
+    return int(cache_.size());
 }
 #endif
 
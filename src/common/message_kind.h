@@ -0,0 +1,62 @@
+#ifndef MESSAGE_KIND_H
+#define MESSAGE_KIND_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cassert>
+#include <omnetpp.h>
+
+/**
+ * Message dispatch by kind.  Every SPFS message is created with the kind
+ * from its protocol enum (e.g. SPFS_OS_READ_DEVICE_REQUEST), so modules
+ * dispatch by switching on cMessage::getKind() and convert the message
+ * with kind_cast rather than testing a chain of dynamic_casts.
+ *
+ * E.g.
+ *
+ * switch (msg->getKind())
+ * {
+ *     case SPFS_OS_READ_DEVICE_REQUEST:
+ *     {
+ *         handleRead(kind_cast<spfsOSReadDeviceRequest>(msg));
+ *         break;
+ *     }
+ *     ...
+ * }
+ */
+
+/**
+ * @return msg converted to the message type implied by its kind.  Debug
+ *   builds verify that the kind matches the dynamic type of the message.
+ */
+template<class MessageType>
+inline MessageType* kind_cast(cMessage* msg)
+{
+    assert(0 != dynamic_cast<MessageType*>(msg));
+    return static_cast<MessageType*>(msg);
+}
+
+/** @return const msg converted to the message type implied by its kind */
+template<class MessageType>
+inline const MessageType* kind_cast(const cMessage* msg)
+{
+    assert(0 != dynamic_cast<const MessageType*>(msg));
+    return static_cast<const MessageType*>(msg);
+}
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
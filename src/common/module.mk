@@ -10,6 +10,7 @@ SIM_SRC += $(DIR)/block_indexed_data_type.cc \
 	$(DIR)/data_type.cc \
 	$(DIR)/dirty_file_region_set.cc \
 	$(DIR)/file_descriptor.cc \
+	$(DIR)/file_id_registry.cc \
 	$(DIR)/file_page_utils.cc \
 	$(DIR)/file_region_set.cc \
 	$(DIR)/file_view.cc \
@@ -0,0 +1,405 @@
+#ifndef REPLACEMENT_CACHE_H
+#define REPLACEMENT_CACHE_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cassert>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+#include "lru_cache.h"
+#include "replacement_policy.h"
+#include "spfs_exceptions.h"
+
+/**
+ * A fixed size cache with a replacement policy selected by name.  Entries
+ * and dirty bits are stored in an LRUCache of the same capacity.  For LRU
+ * replacement the LRUCache's own ordering selects every victim.  For the
+ * other policies the LRUCache never evicts on its own; each stored value
+ * carries its ReplacementPolicy entry, and the policy chooses every
+ * victim.  Lookups through find are counted as hits or misses.
+ */
+template <class KeyType, class ValueType,
+          class HashType = LRUCacheHash<KeyType> >
+class ReplacementCache
+{
+public:
+
+    /** Function object that filter cache entries, shared with LRUCache */
+    typedef typename LRUCache<KeyType, ValueType, HashType>::FilterFunctor
+        FilterFunctor;
+
+    /**
+     * Constructor
+     *
+     * @param capacity the maximum number of entries
+     * @param policyName the replacement policy: LRU, ARC, 2Q or CLOCK-Pro
+     */
+    ReplacementCache(int capacity, const std::string& policyName = "LRU");
+
+    /** Destructor */
+    ~ReplacementCache();
+
+    /**
+     * Insert a Key-Value pair into the cache.  If the cache is full, the
+     * replacement policy selects an entry to evict
+     */
+    void insert(const KeyType& key,
+                const ValueType& value,
+                bool isDirty = false);
+
+    /**
+     * Perform the cache insertion and set the evicted value and dirty bit
+     * in the outbound parameters.
+     *
+     * @return true if an entry was evicted, otherwise the outbound
+     *   parameters are not modified
+     */
+    bool insertAndRecall(const KeyType& key,
+                         const ValueType& value,
+                         bool isDirty,
+                         KeyType& outEvictedKey,
+                         ValueType& outEvictedValue,
+                         bool& outEvictedDirtyBit);
+
+    /**
+     * Remove the value for key from the cache
+     *
+     * @throw NoSuchEntry if no entry exists for the key
+     */
+    void remove(const KeyType& key);
+
+    /**
+     * Set the dirty-bit for the cache key without a policy reference
+     *
+     * @throw NoSuchEntry if no entry exists for the key
+     */
+    void setDirtyBit(const KeyType& key, bool dirtyValue);
+
+    /**
+     * @return The value for key and register a policy reference
+     *
+     * @throw NoSuchEntry if no entry exists for the key
+     */
+    ValueType lookup(const KeyType& key);
+
+    /**
+     * @return a pointer to the value for key and register a policy
+     *   reference, or 0 if no entry exists for the key
+     */
+    ValueType* find(const KeyType& key);
+
+    /** @return true if a value exists for key without a policy reference */
+    bool exists(const KeyType& key) const;
+
+    /**
+     * @return the dirty bit for key
+     *
+     * @throw NoSuchEntry if no entry exists for the key
+     */
+    bool getDirtyBit(const KeyType& key) const;
+
+    /** @return the dirty cache keys in the order they became dirty */
+    std::vector<KeyType> getDirtyEntries() const;
+
+    /** @return the cache keys that the filter returns true for */
+    std::set<KeyType> getFilteredEntries(const FilterFunctor& filter) const;
+
+    /** @return the dirty cache keys that the filter returns true for */
+    std::set<KeyType> getFilteredDirtyEntries(const FilterFunctor& filter) const;
+
+    /** @return the cache capacity */
+    std::size_t capacity() const;
+
+    /** @return the number of entries in the cache */
+    std::size_t size() const;
+
+    /** @return the percentage of the cache capacity that is dirty */
+    double percentDirty() const;
+
+    /** @return the name of the replacement policy */
+    std::string getPolicyName() const {return policyName_;};
+
+    /** @return the number of finds that located an entry */
+    std::size_t getNumHits() const {return numHits_;};
+
+    /** @return the number of finds that did not locate an entry */
+    std::size_t getNumMisses() const {return numMisses_;};
+
+    /** @return the fraction of finds that located an entry */
+    double getHitRatio() const;
+
+    /** @return the number of insertions of a key in a ghost list */
+    std::size_t getNumGhostHits() const
+    {
+        return (0 == policy_) ? 0 : policy_->getNumGhostHits();
+    };
+
+    /** @return the number of keys currently in the ghost lists */
+    std::size_t getNumGhostEntries() const
+    {
+        return (0 == policy_) ? 0 : policy_->getNumGhostEntries();
+    };
+
+private:
+    /** Convenience typedef of the replacement policy */
+    typedef ReplacementPolicy<KeyType, HashType> PolicyType;
+
+    /** A cached value and its replacement policy entry */
+    struct Slot
+    {
+        ValueType value;
+        typename PolicyType::Entry* policyEntry;
+    };
+
+    /** Convenience typedef of the entry storage */
+    typedef LRUCache<KeyType, Slot, HashType> StorageType;
+
+    /** Applies a value filter to the stored slots */
+    struct SlotFilter : public StorageType::FilterFunctor
+    {
+        SlotFilter(const FilterFunctor& valueFilter)
+            : valueFilter_(valueFilter) {};
+
+        virtual bool filter(const KeyType& key,
+                            const Slot& slot,
+                            bool isDirty) const
+        {
+            return valueFilter_.filter(key, slot.value, isDirty);
+        }
+
+        const FilterFunctor& valueFilter_;
+    };
+
+    /** Copy constructor hidden */
+    ReplacementCache(const ReplacementCache& other);
+
+    /** Assignment operator hidden */
+    ReplacementCache& operator=(const ReplacementCache& other);
+
+    /** Entry storage */
+    StorageType entries_;
+
+    /** Replacement policy, or 0 for LRU replacement */
+    PolicyType* policy_;
+
+    std::string policyName_;
+    std::size_t numHits_;
+    std::size_t numMisses_;
+};
+
+template <class KeyType, class ValueType, class HashType>
+ReplacementCache<KeyType,ValueType,HashType>::ReplacementCache(
+    int capacity, const std::string& policyName)
+    : entries_(capacity),
+      policy_(PolicyType::create(policyName, capacity)),
+      policyName_(policyName),
+      numHits_(0),
+      numMisses_(0)
+{
+}
+
+template <class KeyType, class ValueType, class HashType>
+ReplacementCache<KeyType,ValueType,HashType>::~ReplacementCache()
+{
+    delete policy_;
+    policy_ = 0;
+}
+
+template <class KeyType, class ValueType, class HashType>
+void ReplacementCache<KeyType,ValueType,HashType>::insert(
+    const KeyType& key, const ValueType& value, bool isDirty)
+{
+    KeyType evictedKey(key);
+    ValueType evictedValue(value);
+    bool evictedDirtyBit = false;
+    insertAndRecall(key, value, isDirty,
+                    evictedKey, evictedValue, evictedDirtyBit);
+}
+
+template <class KeyType, class ValueType, class HashType>
+bool ReplacementCache<KeyType,ValueType,HashType>::insertAndRecall(
+    const KeyType& key,
+    const ValueType& value,
+    bool isDirty,
+    KeyType& outEvictedKey,
+    ValueType& outEvictedValue,
+    bool& outEvictedDirtyBit)
+{
+    // Without a policy the storage's LRU ordering selects the victim
+    Slot slot = {value, 0};
+    if (0 == policy_)
+    {
+        Slot evicted(slot);
+        bool isEvicted = entries_.insertAndRecall(key, slot, isDirty,
+                                                  outEvictedKey, evicted,
+                                                  outEvictedDirtyBit);
+        if (isEvicted)
+        {
+            outEvictedValue = evicted.value;
+        }
+        return isEvicted;
+    }
+
+    // If the entry already exists, update it
+    Slot* existing = entries_.peek(key);
+    if (0 != existing)
+    {
+        existing->value = value;
+        entries_.setDirtyBit(key, isDirty);
+        policy_->access(existing->policyEntry);
+        return false;
+    }
+
+    // Remove the policy's victim from storage
+    KeyType victim(key);
+    bool isEvicted = policy_->insert(key, slot.policyEntry, victim);
+    if (isEvicted)
+    {
+        Slot evicted(slot);
+        entries_.removeAndRecall(victim, evicted, outEvictedDirtyBit);
+        outEvictedKey = victim;
+        outEvictedValue = evicted.value;
+    }
+    entries_.insert(key, slot, isDirty);
+    return isEvicted;
+}
+
+template <class KeyType, class ValueType, class HashType>
+void ReplacementCache<KeyType,ValueType,HashType>::remove(const KeyType& key)
+{
+    if (0 != policy_)
+    {
+        Slot* slot = entries_.peek(key);
+        if (0 == slot)
+        {
+            NoSuchEntry e;
+            throw e;
+        }
+        policy_->remove(slot->policyEntry);
+    }
+    entries_.remove(key);
+}
+
+template <class KeyType, class ValueType, class HashType>
+void ReplacementCache<KeyType,ValueType,HashType>::setDirtyBit(
+    const KeyType& key, bool dirtyValue)
+{
+    entries_.setDirtyBit(key, dirtyValue);
+}
+
+template <class KeyType, class ValueType, class HashType>
+ValueType ReplacementCache<KeyType,ValueType,HashType>::lookup(
+    const KeyType& key)
+{
+    ValueType* value = find(key);
+    if (0 == value)
+    {
+        NoSuchEntry e;
+        throw e;
+    }
+    return *value;
+}
+
+template <class KeyType, class ValueType, class HashType>
+ValueType* ReplacementCache<KeyType,ValueType,HashType>::find(
+    const KeyType& key)
+{
+    // Without a policy the storage's find refreshes the LRU ordering
+    Slot* slot = (0 == policy_) ? entries_.find(key) : entries_.peek(key);
+    if (0 == slot)
+    {
+        numMisses_++;
+        return 0;
+    }
+    numHits_++;
+    if (0 != policy_)
+    {
+        policy_->access(slot->policyEntry);
+    }
+    return &(slot->value);
+}
+
+template <class KeyType, class ValueType, class HashType>
+bool ReplacementCache<KeyType,ValueType,HashType>::exists(
+    const KeyType& key) const
+{
+    return entries_.exists(key);
+}
+
+template <class KeyType, class ValueType, class HashType>
+bool ReplacementCache<KeyType,ValueType,HashType>::getDirtyBit(
+    const KeyType& key) const
+{
+    return entries_.getDirtyBit(key);
+}
+
+template <class KeyType, class ValueType, class HashType>
+std::vector<KeyType>
+ReplacementCache<KeyType,ValueType,HashType>::getDirtyEntries() const
+{
+    return entries_.getDirtyEntries();
+}
+
+template <class KeyType, class ValueType, class HashType>
+std::set<KeyType>
+ReplacementCache<KeyType,ValueType,HashType>::getFilteredEntries(
+    const FilterFunctor& filterFunc) const
+{
+    return entries_.getFilteredEntries(SlotFilter(filterFunc));
+}
+
+template <class KeyType, class ValueType, class HashType>
+std::set<KeyType>
+ReplacementCache<KeyType,ValueType,HashType>::getFilteredDirtyEntries(
+    const FilterFunctor& filterFunc) const
+{
+    return entries_.getFilteredDirtyEntries(SlotFilter(filterFunc));
+}
+
+template <class KeyType, class ValueType, class HashType>
+std::size_t ReplacementCache<KeyType,ValueType,HashType>::capacity() const
+{
+    return entries_.capacity();
+}
+
+template <class KeyType, class ValueType, class HashType>
+std::size_t ReplacementCache<KeyType,ValueType,HashType>::size() const
+{
+    return entries_.size();
+}
+
+template <class KeyType, class ValueType, class HashType>
+double ReplacementCache<KeyType,ValueType,HashType>::percentDirty() const
+{
+    return entries_.percentDirty();
+}
+
+template <class KeyType, class ValueType, class HashType>
+double ReplacementCache<KeyType,ValueType,HashType>::getHitRatio() const
+{
+    std::size_t numFinds = numHits_ + numMisses_;
+    if (0 == numFinds)
+    {
+        return 0.0;
+    }
+    return double(numHits_) / double(numFinds);
+}
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,990 @@
+#ifndef REPLACEMENT_POLICY_H
+#define REPLACEMENT_POLICY_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "lru_cache.h"
+
+/**
+ * Abstract cache replacement policy.  A policy orders the keys resident
+ * in a cache of fixed capacity and selects the victim when a new key is
+ * admitted to a full cache.  Each key's list links and state are kept in
+ * an Entry that the cache stores beside the key's value, so references to
+ * resident keys require no lookup.  Policies that remember recently
+ * evicted keys (ghost entries) index them by hash and count the
+ * insertions that hit a ghost entry.
+ *
+ * LRU replacement needs no policy, LRUCache implements it directly.
+ * Keys must provide operator< and a LRUCacheHash specialization.
+ */
+template <class KeyType, class HashType = LRUCacheHash<KeyType> >
+class ReplacementPolicy
+{
+public:
+    /** A key's position and state in the policy */
+    struct Entry
+    {
+        Entry(const KeyType& k)
+            : key(k), prev(0), next(0), hashNext(0), list(0),
+              isResident(true), isHot(false), isReferenced(false),
+              isTest(false) {};
+
+        KeyType key;
+        Entry* prev;
+        Entry* next;
+        Entry* hashNext;
+        int list;
+        bool isResident;
+        bool isHot;
+        bool isReferenced;
+        bool isTest;
+    };
+
+    /**
+     * @return a new policy for the name ARC, 2Q or CLOCK-Pro, or 0 for
+     *   LRU
+     */
+    static ReplacementPolicy* create(const std::string& name,
+                                     std::size_t capacity);
+
+    /** Constructor */
+    ReplacementPolicy(std::size_t capacity);
+
+    /** Destructor */
+    virtual ~ReplacementPolicy();
+
+    /**
+     * Admit a key that is not resident, evicting a resident key if the
+     * cache is full.  The key's entry remains valid until the key is
+     * evicted or removed.
+     *
+     * @return true if a key was evicted, otherwise outVictim is not
+     *   modified
+     * @side sets outEntry to the admitted key's entry
+     */
+    virtual bool insert(const KeyType& key,
+                        Entry*& outEntry,
+                        KeyType& outVictim) = 0;
+
+    /** Register a reference to a resident key's entry */
+    virtual void access(Entry* entry) = 0;
+
+    /** Remove a resident key's entry without remembering the key */
+    virtual void remove(Entry* entry) = 0;
+
+    /** @return the cache capacity */
+    std::size_t capacity() const {return capacity_;};
+
+    /** @return the number of insertions that hit a ghost entry */
+    std::size_t getNumGhostHits() const {return numGhostHits_;};
+
+    /** @return the number of ghost entries currently remembered */
+    std::size_t getNumGhostEntries() const {return numGhostEntries_;};
+
+protected:
+    /** Register an insertion of a remembered key */
+    void registerGhostHit() {numGhostHits_++;};
+
+    /** @return an unlinked resident entry for key */
+    Entry* allocateEntry(const KeyType& key);
+
+    /** Forget the entry if it is a ghost and return it to the pool */
+    void releaseEntry(Entry* entry);
+
+    /** @return the ghost entry for key, or 0 if key is not remembered */
+    Entry* findGhost(const KeyType& key) const;
+
+    /** Mark a resident entry non-resident and remember its key */
+    void addGhost(Entry* entry);
+
+    /** Forget a ghost entry's key and mark the entry resident */
+    void removeGhost(Entry* entry);
+
+private:
+    /** Copy constructor hidden */
+    ReplacementPolicy(const ReplacementPolicy& other);
+
+    /** Assignment operator hidden */
+    ReplacementPolicy& operator=(const ReplacementPolicy& other);
+
+    /** @return the ghost index bucket for key */
+    std::size_t bucket(const KeyType& key) const;
+
+    /** Ghost index buckets */
+    std::vector<Entry*> buckets_;
+
+    /** Every entry allocated by the policy */
+    std::vector<Entry*> entries_;
+
+    /** Unused entries available for reuse */
+    std::vector<Entry*> freeEntries_;
+
+    /** Hash function */
+    HashType hash_;
+
+    const std::size_t capacity_;
+    std::size_t numGhostHits_;
+    std::size_t numGhostEntries_;
+};
+
+/**
+ * Base class for policies built from a fixed number of recency lists.
+ * The front of each list is the most recently used end.
+ */
+template <class KeyType, class HashType = LRUCacheHash<KeyType> >
+class ListReplacementPolicy : public ReplacementPolicy<KeyType, HashType>
+{
+public:
+    typedef typename ReplacementPolicy<KeyType, HashType>::Entry Entry;
+
+    /** Constructor */
+    ListReplacementPolicy(std::size_t capacity, int numLists)
+        : ReplacementPolicy<KeyType, HashType>(capacity),
+          lists_(numLists) {};
+
+    /** Remove the entry from its list and release it */
+    virtual void remove(Entry* entry);
+
+protected:
+    /** @return the number of entries in the list */
+    std::size_t listSize(int list) const {return lists_[list].size;};
+
+    /** @return the entry at the least recently used end of the list */
+    Entry* back(int list) const {return lists_[list].tail;};
+
+    /** Add an unlinked entry to the front of the list */
+    void pushFront(int list, Entry* entry);
+
+    /** Move entry from its current list to the front of list */
+    void moveToFront(int list, Entry* entry);
+
+    /** Release the entry at the back of the list and return its key */
+    KeyType popBack(int list);
+
+private:
+    /** An intrusive list of entries */
+    struct List
+    {
+        Entry* head;
+        Entry* tail;
+        std::size_t size;
+    };
+
+    /** Unlink the entry from its list */
+    void unlink(Entry* entry);
+
+    std::vector<List> lists_;
+};
+
+/**
+ * Adaptive Replacement Cache (Megiddo and Modha, FAST 2003).  Resident
+ * keys are split between T1, keys referenced once, and T2, keys
+ * referenced at least twice.  The ghost lists B1 and B2 remember keys
+ * evicted from T1 and T2, and ghost hits adapt the target size of T1.
+ */
+template <class KeyType, class HashType = LRUCacheHash<KeyType> >
+class ARCReplacementPolicy : public ListReplacementPolicy<KeyType, HashType>
+{
+public:
+    typedef typename ListReplacementPolicy<KeyType, HashType>::Entry Entry;
+
+    /** Constructor */
+    ARCReplacementPolicy(std::size_t capacity)
+        : ListReplacementPolicy<KeyType, HashType>(capacity, 4),
+          target_(0) {};
+
+    /** Admit key, adapting the T1 target on a ghost hit */
+    virtual bool insert(const KeyType& key,
+                        Entry*& outEntry,
+                        KeyType& outVictim);
+
+    /** Move entry to the most recently used position of T2 */
+    virtual void access(Entry* entry);
+
+    /** @return the current target size of T1 */
+    std::size_t getTarget() const {return target_;};
+
+private:
+    enum List {T1 = 0, T2, B1, B2};
+
+    /** Evict from T1 or T2 to the matching ghost list */
+    KeyType replace(bool isB2Hit);
+
+    std::size_t target_;
+};
+
+/**
+ * Full 2Q replacement (Johnson and Shasha, VLDB 1994).  New keys enter
+ * the FIFO A1in, keys evicted from A1in are remembered in the ghost FIFO
+ * A1out, and only keys referenced again while in A1out are admitted to
+ * the LRU list Am.  A single sequential scan therefore never displaces
+ * Am.
+ */
+template <class KeyType, class HashType = LRUCacheHash<KeyType> >
+class TwoQueueReplacementPolicy
+    : public ListReplacementPolicy<KeyType, HashType>
+{
+public:
+    typedef typename ListReplacementPolicy<KeyType, HashType>::Entry Entry;
+
+    /** Constructor using the recommended Kin of 25% and Kout of 50% */
+    TwoQueueReplacementPolicy(std::size_t capacity)
+        : ListReplacementPolicy<KeyType, HashType>(capacity, 3),
+          maxIn_(std::max(std::size_t(1), capacity / 4)),
+          maxOut_(std::max(std::size_t(1), capacity / 2)) {};
+
+    /** Admit key to A1in, or to Am if it is remembered in A1out */
+    virtual bool insert(const KeyType& key,
+                        Entry*& outEntry,
+                        KeyType& outVictim);
+
+    /** Move entry to the most recently used position if it is in Am */
+    virtual void access(Entry* entry);
+
+private:
+    enum List {AM = 0, A1IN, A1OUT};
+
+    /** Evict from A1in or Am */
+    KeyType reclaim();
+
+    const std::size_t maxIn_;
+    const std::size_t maxOut_;
+};
+
+/**
+ * CLOCK-Pro replacement (Jiang, Chen and Zhang, USENIX 2005).  Resident
+ * keys are hot or cold and share a single clock with non-resident cold
+ * keys still in their test period.  A cold key referenced during its test
+ * period is promoted to hot, and the number of resident cold keys adapts
+ * to the ghost hits.  Three hands sweep the clock: the cold hand selects
+ * victims, the hot hand demotes hot keys, and the test hand ends the test
+ * periods of non-resident keys.  The cold target starts at a single key.
+ */
+template <class KeyType, class HashType = LRUCacheHash<KeyType> >
+class ClockProReplacementPolicy : public ReplacementPolicy<KeyType, HashType>
+{
+public:
+    typedef typename ReplacementPolicy<KeyType, HashType>::Entry Entry;
+
+    /** Constructor */
+    ClockProReplacementPolicy(std::size_t capacity);
+
+    /** Admit key as cold, or as hot if it is in its test period */
+    virtual bool insert(const KeyType& key,
+                        Entry*& outEntry,
+                        KeyType& outVictim);
+
+    /** Set the reference bit for the entry */
+    virtual void access(Entry* entry);
+
+    /** Remove the entry from the clock */
+    virtual void remove(Entry* entry);
+
+    /** @return the current target number of resident cold keys */
+    std::size_t getColdTarget() const {return coldTarget_;};
+
+private:
+    /** Move the hand to the next page in the clock */
+    void advance(Entry*& hand) {hand = hand->next;};
+
+    /** Link an unlinked page into the clock before position */
+    void linkBefore(Entry* position, Entry* page);
+
+    /** Unlink the page from the clock without moving the hands */
+    void unlink(Entry* page);
+
+    /** Insert a page at the head of the clock, behind the hot hand */
+    void insertAtHead(Entry* page);
+
+    /** Erase the page from the clock, moving any hands past it */
+    void erasePage(Entry* page);
+
+    /** Run the cold hand until a resident cold page is evicted */
+    KeyType runColdHand();
+
+    /** Run the hot hand until a hot page is demoted to cold */
+    void runHotHand();
+
+    /** Run the test hand until a non-resident page is removed */
+    void runTestHand();
+
+    /** End the test period for a cold page */
+    void endTestPeriod(Entry* page);
+
+    /** Demote hot pages until the hot target is met */
+    void balanceHotPages();
+
+    /** Adjust the cold target by delta within its bounds */
+    void adjustColdTarget(int delta);
+
+    Entry* hotHand_;
+    Entry* coldHand_;
+    Entry* testHand_;
+
+    std::size_t coldTarget_;
+    std::size_t numHot_;
+    std::size_t numResident_;
+};
+
+template <class KeyType, class HashType>
+ReplacementPolicy<KeyType,HashType>*
+ReplacementPolicy<KeyType,HashType>::create(const std::string& name,
+                                            std::size_t capacity)
+{
+    if ("ARC" == name)
+    {
+        return new ARCReplacementPolicy<KeyType,HashType>(capacity);
+    }
+    else if ("2Q" == name)
+    {
+        return new TwoQueueReplacementPolicy<KeyType,HashType>(capacity);
+    }
+    else if ("CLOCK-Pro" == name)
+    {
+        return new ClockProReplacementPolicy<KeyType,HashType>(capacity);
+    }
+    assert("LRU" == name);
+    return 0;
+}
+
+template <class KeyType, class HashType>
+ReplacementPolicy<KeyType,HashType>::ReplacementPolicy(std::size_t capacity)
+    : buckets_(2 * capacity + 1, (Entry*)0),
+      capacity_(capacity),
+      numGhostHits_(0),
+      numGhostEntries_(0)
+{
+    assert(0 < capacity_);
+}
+
+template <class KeyType, class HashType>
+ReplacementPolicy<KeyType,HashType>::~ReplacementPolicy()
+{
+    for (std::size_t i = 0; i < entries_.size(); i++)
+    {
+        delete entries_[i];
+    }
+}
+
+template <class KeyType, class HashType>
+typename ReplacementPolicy<KeyType,HashType>::Entry*
+ReplacementPolicy<KeyType,HashType>::allocateEntry(const KeyType& key)
+{
+    if (freeEntries_.empty())
+    {
+        Entry* entry = new Entry(key);
+        entries_.push_back(entry);
+        return entry;
+    }
+
+    Entry* entry = freeEntries_.back();
+    freeEntries_.pop_back();
+    *entry = Entry(key);
+    return entry;
+}
+
+template <class KeyType, class HashType>
+void ReplacementPolicy<KeyType,HashType>::releaseEntry(Entry* entry)
+{
+    if (!entry->isResident)
+    {
+        removeGhost(entry);
+    }
+    freeEntries_.push_back(entry);
+}
+
+template <class KeyType, class HashType>
+typename ReplacementPolicy<KeyType,HashType>::Entry*
+ReplacementPolicy<KeyType,HashType>::findGhost(const KeyType& key) const
+{
+    // Keys are equivalent if neither orders before the other
+    Entry* entry = buckets_[bucket(key)];
+    while (0 != entry && (entry->key < key || key < entry->key))
+    {
+        entry = entry->hashNext;
+    }
+    return entry;
+}
+
+template <class KeyType, class HashType>
+void ReplacementPolicy<KeyType,HashType>::addGhost(Entry* entry)
+{
+    assert(entry->isResident);
+    std::size_t b = bucket(entry->key);
+    entry->hashNext = buckets_[b];
+    buckets_[b] = entry;
+    entry->isResident = false;
+    numGhostEntries_++;
+}
+
+template <class KeyType, class HashType>
+void ReplacementPolicy<KeyType,HashType>::removeGhost(Entry* entry)
+{
+    assert(!entry->isResident);
+    Entry** link = &buckets_[bucket(entry->key)];
+    while (*link != entry)
+    {
+        assert(0 != *link);
+        link = &((*link)->hashNext);
+    }
+    *link = entry->hashNext;
+    entry->hashNext = 0;
+    entry->isResident = true;
+    numGhostEntries_--;
+}
+
+template <class KeyType, class HashType>
+std::size_t ReplacementPolicy<KeyType,HashType>::bucket(
+    const KeyType& key) const
+{
+    return hash_(key) % buckets_.size();
+}
+
+template <class KeyType, class HashType>
+void ListReplacementPolicy<KeyType,HashType>::remove(Entry* entry)
+{
+    unlink(entry);
+    this->releaseEntry(entry);
+}
+
+template <class KeyType, class HashType>
+void ListReplacementPolicy<KeyType,HashType>::pushFront(int list,
+                                                        Entry* entry)
+{
+    List& l = lists_[list];
+    entry->list = list;
+    entry->prev = 0;
+    entry->next = l.head;
+    if (0 != l.head)
+    {
+        l.head->prev = entry;
+    }
+    else
+    {
+        l.tail = entry;
+    }
+    l.head = entry;
+    l.size++;
+}
+
+template <class KeyType, class HashType>
+void ListReplacementPolicy<KeyType,HashType>::moveToFront(int list,
+                                                          Entry* entry)
+{
+    unlink(entry);
+    pushFront(list, entry);
+}
+
+template <class KeyType, class HashType>
+KeyType ListReplacementPolicy<KeyType,HashType>::popBack(int list)
+{
+    Entry* entry = lists_[list].tail;
+    assert(0 != entry);
+    KeyType key = entry->key;
+    unlink(entry);
+    this->releaseEntry(entry);
+    return key;
+}
+
+template <class KeyType, class HashType>
+void ListReplacementPolicy<KeyType,HashType>::unlink(Entry* entry)
+{
+    List& l = lists_[entry->list];
+    if (0 != entry->prev)
+    {
+        entry->prev->next = entry->next;
+    }
+    else
+    {
+        l.head = entry->next;
+    }
+
+    if (0 != entry->next)
+    {
+        entry->next->prev = entry->prev;
+    }
+    else
+    {
+        l.tail = entry->prev;
+    }
+    entry->prev = 0;
+    entry->next = 0;
+    l.size--;
+}
+
+template <class KeyType, class HashType>
+bool ARCReplacementPolicy<KeyType,HashType>::insert(const KeyType& key,
+                                                    Entry*& outEntry,
+                                                    KeyType& outVictim)
+{
+    std::size_t c = this->capacity();
+    std::size_t t1 = this->listSize(T1);
+    std::size_t b1 = this->listSize(B1);
+    std::size_t b2 = this->listSize(B2);
+    bool isFull = (t1 + this->listSize(T2) >= c);
+    bool isEvicted = false;
+
+    Entry* ghost = this->findGhost(key);
+    if (0 != ghost && B1 == ghost->list)
+    {
+        // Favor recency by growing the T1 target
+        this->registerGhostHit();
+        target_ = std::min(c, target_ + std::max(b2 / b1, std::size_t(1)));
+        if (isFull)
+        {
+            outVictim = replace(false);
+            isEvicted = true;
+        }
+        this->removeGhost(ghost);
+        this->moveToFront(T2, ghost);
+        outEntry = ghost;
+    }
+    else if (0 != ghost)
+    {
+        // Favor frequency by shrinking the T1 target
+        assert(B2 == ghost->list);
+        this->registerGhostHit();
+        std::size_t delta = std::max(b1 / b2, std::size_t(1));
+        target_ = (delta < target_) ? target_ - delta : 0;
+        if (isFull)
+        {
+            outVictim = replace(true);
+            isEvicted = true;
+        }
+        this->removeGhost(ghost);
+        this->moveToFront(T2, ghost);
+        outEntry = ghost;
+    }
+    else
+    {
+        // Keep the directory within twice the capacity
+        if (t1 + b1 >= c)
+        {
+            if (t1 < c)
+            {
+                this->popBack(B1);
+                if (isFull)
+                {
+                    outVictim = replace(false);
+                    isEvicted = true;
+                }
+            }
+            else
+            {
+                outVictim = this->popBack(T1);
+                isEvicted = true;
+            }
+        }
+        else if (t1 + b1 + this->listSize(T2) + b2 >= c)
+        {
+            if (t1 + b1 + this->listSize(T2) + b2 >= 2 * c)
+            {
+                this->popBack(B2);
+            }
+            if (isFull)
+            {
+                outVictim = replace(false);
+                isEvicted = true;
+            }
+        }
+        outEntry = this->allocateEntry(key);
+        this->pushFront(T1, outEntry);
+    }
+    return isEvicted;
+}
+
+template <class KeyType, class HashType>
+void ARCReplacementPolicy<KeyType,HashType>::access(Entry* entry)
+{
+    assert(T1 == entry->list || T2 == entry->list);
+    this->moveToFront(T2, entry);
+}
+
+template <class KeyType, class HashType>
+KeyType ARCReplacementPolicy<KeyType,HashType>::replace(bool isB2Hit)
+{
+    std::size_t t1 = this->listSize(T1);
+    if (0 == this->listSize(T2) ||
+        (0 != t1 && (t1 > target_ || (isB2Hit && t1 == target_))))
+    {
+        Entry* victim = this->back(T1);
+        this->moveToFront(B1, victim);
+        this->addGhost(victim);
+        return victim->key;
+    }
+    Entry* victim = this->back(T2);
+    this->moveToFront(B2, victim);
+    this->addGhost(victim);
+    return victim->key;
+}
+
+template <class KeyType, class HashType>
+bool TwoQueueReplacementPolicy<KeyType,HashType>::insert(
+    const KeyType& key, Entry*& outEntry, KeyType& outVictim)
+{
+    // Forget a remembered key before reclaiming so that trimming A1out
+    // cannot discard it
+    Entry* ghost = this->findGhost(key);
+    bool isGhostHit = (0 != ghost);
+    if (isGhostHit)
+    {
+        assert(A1OUT == ghost->list);
+        this->registerGhostHit();
+        ListReplacementPolicy<KeyType,HashType>::remove(ghost);
+    }
+
+    bool isEvicted = false;
+    if (this->listSize(AM) + this->listSize(A1IN) >= this->capacity())
+    {
+        outVictim = reclaim();
+        isEvicted = true;
+    }
+    outEntry = this->allocateEntry(key);
+    this->pushFront(isGhostHit ? AM : A1IN, outEntry);
+    return isEvicted;
+}
+
+template <class KeyType, class HashType>
+void TwoQueueReplacementPolicy<KeyType,HashType>::access(Entry* entry)
+{
+    // References to keys in A1in are correlated and ignored
+    if (AM == entry->list)
+    {
+        this->moveToFront(AM, entry);
+    }
+}
+
+template <class KeyType, class HashType>
+KeyType TwoQueueReplacementPolicy<KeyType,HashType>::reclaim()
+{
+    if (this->listSize(A1IN) > maxIn_ || 0 == this->listSize(AM))
+    {
+        Entry* victim = this->back(A1IN);
+        KeyType victimKey = victim->key;
+        this->moveToFront(A1OUT, victim);
+        this->addGhost(victim);
+        if (this->listSize(A1OUT) > maxOut_)
+        {
+            this->popBack(A1OUT);
+        }
+        return victimKey;
+    }
+    return this->popBack(AM);
+}
+
+template <class KeyType, class HashType>
+ClockProReplacementPolicy<KeyType,HashType>::ClockProReplacementPolicy(
+    std::size_t capacity)
+    : ReplacementPolicy<KeyType, HashType>(capacity),
+      hotHand_(0),
+      coldHand_(0),
+      testHand_(0),
+      coldTarget_(1),
+      numHot_(0),
+      numResident_(0)
+{
+}
+
+template <class KeyType, class HashType>
+bool ClockProReplacementPolicy<KeyType,HashType>::insert(const KeyType& key,
+                                                         Entry*& outEntry,
+                                                         KeyType& outVictim)
+{
+    bool isEvicted = false;
+    if (numResident_ >= this->capacity())
+    {
+        outVictim = runColdHand();
+        isEvicted = true;
+    }
+
+    // The cold hand may have ended the key's test period, so search after
+    // the eviction
+    Entry* ghost = this->findGhost(key);
+    if (0 != ghost)
+    {
+        // A reuse distance shorter than the test period makes the key hot
+        this->registerGhostHit();
+        adjustColdTarget(1);
+        erasePage(ghost);
+        this->releaseEntry(ghost);
+
+        outEntry = this->allocateEntry(key);
+        outEntry->isHot = true;
+        insertAtHead(outEntry);
+        numHot_++;
+        numResident_++;
+        balanceHotPages();
+    }
+    else
+    {
+        outEntry = this->allocateEntry(key);
+        outEntry->isTest = true;
+        insertAtHead(outEntry);
+        numResident_++;
+    }
+    return isEvicted;
+}
+
+template <class KeyType, class HashType>
+void ClockProReplacementPolicy<KeyType,HashType>::access(Entry* entry)
+{
+    assert(entry->isResident);
+    entry->isReferenced = true;
+}
+
+template <class KeyType, class HashType>
+void ClockProReplacementPolicy<KeyType,HashType>::remove(Entry* entry)
+{
+    assert(entry->isResident);
+    numResident_--;
+    if (entry->isHot)
+    {
+        numHot_--;
+    }
+    erasePage(entry);
+    this->releaseEntry(entry);
+}
+
+template <class KeyType, class HashType>
+void ClockProReplacementPolicy<KeyType,HashType>::linkBefore(Entry* position,
+                                                             Entry* page)
+{
+    page->next = position;
+    page->prev = position->prev;
+    position->prev->next = page;
+    position->prev = page;
+}
+
+template <class KeyType, class HashType>
+void ClockProReplacementPolicy<KeyType,HashType>::unlink(Entry* page)
+{
+    page->prev->next = page->next;
+    page->next->prev = page->prev;
+    page->prev = 0;
+    page->next = 0;
+}
+
+template <class KeyType, class HashType>
+void ClockProReplacementPolicy<KeyType,HashType>::insertAtHead(Entry* page)
+{
+    if (0 == hotHand_)
+    {
+        page->prev = page;
+        page->next = page;
+        hotHand_ = page;
+        coldHand_ = page;
+        testHand_ = page;
+    }
+    else
+    {
+        linkBefore(hotHand_, page);
+    }
+}
+
+template <class KeyType, class HashType>
+void ClockProReplacementPolicy<KeyType,HashType>::erasePage(Entry* page)
+{
+    if (page == page->next)
+    {
+        page->prev = 0;
+        page->next = 0;
+        hotHand_ = coldHand_ = testHand_ = 0;
+        return;
+    }
+
+    if (hotHand_ == page)
+    {
+        advance(hotHand_);
+    }
+    if (coldHand_ == page)
+    {
+        advance(coldHand_);
+    }
+    if (testHand_ == page)
+    {
+        advance(testHand_);
+    }
+    unlink(page);
+}
+
+template <class KeyType, class HashType>
+KeyType ClockProReplacementPolicy<KeyType,HashType>::runColdHand()
+{
+    assert(0 < numResident_);
+    while (true)
+    {
+        // Demote a hot page if no resident cold pages remain
+        if (numHot_ == numResident_)
+        {
+            runHotHand();
+        }
+
+        Entry* page = coldHand_;
+        if (!page->isResident || page->isHot)
+        {
+            advance(coldHand_);
+        }
+        else if (page->isReferenced && page->isTest)
+        {
+            // Referenced within its test period, promote to hot
+            page->isReferenced = false;
+            page->isHot = true;
+            page->isTest = false;
+            numHot_++;
+            advance(coldHand_);
+            balanceHotPages();
+        }
+        else if (page->isReferenced)
+        {
+            // Start a new test period at the head of the clock
+            page->isReferenced = false;
+            page->isTest = true;
+            advance(coldHand_);
+            if (page != hotHand_)
+            {
+                unlink(page);
+                linkBefore(hotHand_, page);
+            }
+        }
+        else
+        {
+            // Evict the page, remembering it during its test period
+            KeyType victim = page->key;
+            numResident_--;
+            if (page->isTest)
+            {
+                this->addGhost(page);
+                advance(coldHand_);
+                while (this->getNumGhostEntries() > this->capacity())
+                {
+                    runTestHand();
+                }
+            }
+            else
+            {
+                advance(coldHand_);
+                erasePage(page);
+                this->releaseEntry(page);
+            }
+            return victim;
+        }
+    }
+}
+
+template <class KeyType, class HashType>
+void ClockProReplacementPolicy<KeyType,HashType>::runHotHand()
+{
+    assert(0 < numHot_);
+    while (true)
+    {
+        Entry* page = hotHand_;
+        if (page->isHot && page->isReferenced)
+        {
+            page->isReferenced = false;
+            advance(hotHand_);
+        }
+        else if (page->isHot)
+        {
+            page->isHot = false;
+            numHot_--;
+            advance(hotHand_);
+            return;
+        }
+        else if (!page->isResident)
+        {
+            // Test periods end as the hot hand passes
+            endTestPeriod(page);
+            advance(hotHand_);
+            erasePage(page);
+            this->releaseEntry(page);
+        }
+        else
+        {
+            endTestPeriod(page);
+            advance(hotHand_);
+        }
+    }
+}
+
+template <class KeyType, class HashType>
+void ClockProReplacementPolicy<KeyType,HashType>::runTestHand()
+{
+    assert(0 < this->getNumGhostEntries());
+    while (true)
+    {
+        Entry* page = testHand_;
+        if (!page->isHot)
+        {
+            endTestPeriod(page);
+        }
+
+        if (!page->isResident)
+        {
+            advance(testHand_);
+            erasePage(page);
+            this->releaseEntry(page);
+            return;
+        }
+        advance(testHand_);
+    }
+}
+
+template <class KeyType, class HashType>
+void ClockProReplacementPolicy<KeyType,HashType>::endTestPeriod(Entry* page)
+{
+    // An expired test period without a reference favors hot pages
+    if (page->isTest)
+    {
+        page->isTest = false;
+        adjustColdTarget(-1);
+    }
+}
+
+template <class KeyType, class HashType>
+void ClockProReplacementPolicy<KeyType,HashType>::balanceHotPages()
+{
+    std::size_t hotTarget = (this->capacity() > coldTarget_) ?
+        this->capacity() - coldTarget_ : 0;
+    while (numHot_ > hotTarget)
+    {
+        runHotHand();
+    }
+}
+
+template <class KeyType, class HashType>
+void ClockProReplacementPolicy<KeyType,HashType>::adjustColdTarget(int delta)
+{
+    std::size_t maxTarget = std::max(std::size_t(1), this->capacity() - 1);
+    if (0 > delta)
+    {
+        std::size_t decrease = std::size_t(-delta);
+        coldTarget_ = (decrease < coldTarget_) ? coldTarget_ - decrease : 1;
+    }
+    else
+    {
+        coldTarget_ = std::min(maxTarget, coldTarget_ + std::size_t(delta));
+    }
+    coldTarget_ = std::max(std::size_t(1), coldTarget_);
+}
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -68,12 +68,10 @@ size_t StructDataType::getRepresentationByteLength() const
     return length;
 }
 
-vector<FileRegion> StructDataType::getRegionsByBytes(const FSOffset& byteOffset,
-                                                     size_t numBytes) const
+void StructDataType::visitRegionsByBytes(const FSOffset& byteOffset,
+                                         size_t numBytes,
+                                         FileRegionVisitor& visitor) const
 {
-    // The total regions produced
-    vector<FileRegion> vectorRegions;
-
     // Construct the regions required to map numBytes of data to data regions
     size_t bytesProcessed = 0;
     FSOffset structBegin = (byteOffset / getTrueExtent()) * getTrueExtent();
@@ -94,13 +92,9 @@ vector<FileRegion> StructDataType::getRegionsByBytes(const FSOffset& byteOffset,
                     min(blockLengths_[i] * types_[i]->getExtent() - offsetDiff,
                         numBytes - bytesProcessed);
 
-                vector<FileRegion> elementRegions =
-                    types_[i]->getRegionsByBytes(currentOffset, dataLength);
-
-                // Add regions to the total regions vector
-                copy(elementRegions.begin(),
-                     elementRegions.end(),
-                     back_inserter(vectorRegions));
+                types_[i]->visitRegionsByBytes(currentOffset,
+                                               dataLength,
+                                               visitor);
 
                 // Update the number of bytes processed
                 bytesProcessed += dataLength;
@@ -109,14 +103,9 @@ vector<FileRegion> StructDataType::getRegionsByBytes(const FSOffset& byteOffset,
             {
                 FSSize dataLength = min(blockLengths_[i] * types_[i]->getExtent(),
                                         numBytes - bytesProcessed);
-                vector<FileRegion> elementRegions =
-                    types_[i]->getRegionsByBytes(structBegin + displacements_[i],
-                                                 dataLength);
-
-                // Add regions to the total regions vector
-                copy(elementRegions.begin(),
-                     elementRegions.end(),
-                     back_inserter(vectorRegions));
+                types_[i]->visitRegionsByBytes(structBegin + displacements_[i],
+                                               dataLength,
+                                               visitor);
 
                 // Update the number of bytes processed
                 bytesProcessed += dataLength;
@@ -128,7 +117,6 @@ vector<FileRegion> StructDataType::getRegionsByBytes(const FSOffset& byteOffset,
         currentOffset = structBegin;
     }
     assert(bytesProcessed == numBytes);
-    return vectorRegions;
 }
 
 /*
@@ -70,13 +70,13 @@ size_t SubarrayDataType::getRepresentationByteLength() const
         1 + oldType_.getRepresentationByteLength();
 }
 
-vector<FileRegion> SubarrayDataType::getRegionsByBytes(const FSOffset& byteOffset,
-                                                       size_t numBytes) const
+void SubarrayDataType::visitRegionsByBytes(const FSOffset& byteOffset,
+                                           size_t numBytes,
+                                           FileRegionVisitor& visitor) const
 {
     assert(0 != getTrueExtent());
 
     //cerr << "Offset: " << byteOffset << " Size: " << numBytes << endl;
-    vector<FileRegion> regions;
 
     // Determine the size of the contiguous data type region
     size_t contigCount = getSubarrayContiguousCount();
@@ -114,15 +114,10 @@ vector<FileRegion> SubarrayDataType::getRegionsByBytes(const FSOffset& byteOffse
             // Trim the data length if the entire length isn't needed
             dataLength = min(dataLength, numBytes - bytesProcessed);
 
-            // Get region data
-            vector<FileRegion> elementRegions =
-                oldType_.getRegionsByBytes(fullArrayOffset + regionOffset,
-                                           dataLength);
-
-            // Add regions to the total regions vector
-            copy(elementRegions.begin(),
-                 elementRegions.end(),
-                 back_inserter(regions));
+            // Visit region data
+            oldType_.visitRegionsByBytes(fullArrayOffset + regionOffset,
+                                         dataLength,
+                                         visitor);
 
             // Update the number of bytes processed
             bytesProcessed += dataLength;
@@ -135,7 +130,6 @@ vector<FileRegion> SubarrayDataType::getRegionsByBytes(const FSOffset& byteOffse
         subArrayOffset = 0;
         //cerr << " New array offset: " << fullArrayOffset << endl;
     }
-    return regions;
 }
 
 vector<FileRegion> SubarrayDataType::getRegionsByCount(const FSOffset& byteOffset,
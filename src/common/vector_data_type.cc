@@ -46,12 +46,10 @@ size_t VectorDataType::getRepresentationByteLength() const
     return 4 + 4 + 4 + oldType_.getRepresentationByteLength();
 }
 
-vector<FileRegion> VectorDataType::getRegionsByBytes(const FSOffset& byteOffset,
-                                                     size_t numBytes) const
+void VectorDataType::visitRegionsByBytes(const FSOffset& byteOffset,
+                                         size_t numBytes,
+                                         FileRegionVisitor& visitor) const
 {
-    // The total regions produced
-    vector<FileRegion> vectorRegions;
-
     // Calculate the stride in bytes
     size_t strideLength = stride_ * oldType_.getTrueExtent();
 
@@ -84,14 +82,8 @@ vector<FileRegion> VectorDataType::getRegionsByBytes(const FSOffset& byteOffset,
         // Trim the data size to the requested size if neccesary
         dataLength = min(dataLength, numBytes - bytesProcessed);
 
-        // Retrieve the regions for the embedded type
-        vector<FileRegion> elementRegions =
-        oldType_.getRegionsByBytes(currentOffset, dataLength);
-
-        // Add regions to the total regions vector
-        copy(elementRegions.begin(),
-             elementRegions.end(),
-             back_inserter(vectorRegions));
+        // Visit the regions for the embedded type
+        oldType_.visitRegionsByBytes(currentOffset, dataLength, visitor);
 
         // Update bytes processed, and set the offset to the beginning of the
         // next vector beginning
@@ -99,7 +91,6 @@ vector<FileRegion> VectorDataType::getRegionsByBytes(const FSOffset& byteOffset,
         currentOffset = ((currentOffset / strideLength) + 1) * strideLength;
     }
     assert(bytesProcessed == numBytes);
-    return vectorRegions;
 }
 
 /*
@@ -16,6 +16,8 @@
 #include "io_application.h"
 #include "middleware_aggregator.h"
 #include "middleware_cache.h"
+#include "mpi_collective_model.h"
+#include "mpi_communication_helper.h"
 #include "mpi_middleware.h"
 #include "pfs_types.h"
 #include "pfs_utils.h"
@@ -102,6 +104,22 @@ void MPIConfigurator::initialize(int stage)
         nextProcessRank_ = 0;
         totalProcessCount_ = 0;
 
+        // Set the collective timing model
+        string collectiveModel = par("collectiveModel").stringValue();
+        if ("analytic" == collectiveModel)
+        {
+            MPICollectiveModel model(
+                par("collectiveLatencySecs").doubleValue(),
+                par("collectiveBytesPerSec").doubleValue(),
+                par("allReduceRingThresholdBytes").longValue());
+            MPICommunicationHelper::instance().setCollectiveModel(&model);
+        }
+        else
+        {
+            assert("instant" == collectiveModel);
+            MPICommunicationHelper::instance().setCollectiveModel(0);
+        }
+
         // Set the listen ports for the servers
         cModule* cluster = getParentModule();
         assert(0 != cluster);
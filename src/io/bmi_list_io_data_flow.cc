@@ -12,6 +12,7 @@
 #include "bmi_proto_m.h"
 #include "data_flow_registry.h"
 #include "file_builder.h"
+#include "message_kind.h"
 #include "os_proto_m.h"
 #include "pfs_types.h"
 #include "pvfs_proto_m.h"
@@ -29,7 +30,8 @@ BMIListIODataFlow::BMIListIODataFlow(const spfsDataFlowStart& flowStart,
       pullSubregionOffset_(0),
       pushSubregionOffset_(0),
       pfsMetaData_(0),
-      bstreamSizeIdx_(0)
+      bstreamSizeIdx_(0),
+      numFreeBuffers_(numBuffers)
 {
     // Really only need this stuff for writes
     const spfsServerDataFlowStart& serverFlow =
@@ -50,8 +52,8 @@ void BMIListIODataFlow::startTransfer()
 {
     if (READ_MODE == getMode())
     {
-        // Request the data from storage
-        pullDataFromStorage(getBufferSize());
+        // Request the data from storage into each free buffer
+        fillBuffersFromStorage();
     }
     else if (WRITE_MODE == getMode())
     {
@@ -61,32 +63,31 @@ void BMIListIODataFlow::startTransfer()
 
 void BMIListIODataFlow::processDataFlowMessage(cMessage* msg)
 {
-    if (0 != dynamic_cast<spfsBMIPushDataRequest*>(msg))
+    if (SPFS_BMI_PUSH_DATA_REQUEST == msg->getKind())
     {
         spfsBMIPushDataRequest* pushRequest =
-            static_cast<spfsBMIPushDataRequest*>(msg);
+            kind_cast<spfsBMIPushDataRequest>(msg);
         FSSize dataSize = pushRequest->getDataSize();
         addNetworkProgress(dataSize);
 
-        // Send the data successfully received acknowledgement
-        sendPushAck(dataSize);
-
-        // Perform the next processing step
-        pushDataToStorage(dataSize);
+        // Acknowledge and write the data once a buffer is available
+        pendingNetworkData_.push_back(dataSize);
+        drainBuffersToStorage();
     }
-    else if (0 != dynamic_cast<spfsBMIPushDataResponse*>(msg))
+    else if (SPFS_BMI_PUSH_DATA_RESPONSE == msg->getKind())
     {
         spfsBMIPushDataResponse* pushResp =
-            static_cast<spfsBMIPushDataResponse*>(msg);
+            kind_cast<spfsBMIPushDataResponse>(msg);
         addNetworkProgress(pushResp->getReceivedSize());
 
-        // Perform the next processing step
-        pullDataFromStorage(getBufferSize());
+        // Release the sent buffer and refill it from storage
+        numFreeBuffers_++;
+        fillBuffersFromStorage();
     }
-    else if (0 != dynamic_cast<spfsOSFileReadResponse*>(msg))
+    else if (SPFS_OS_FILE_READ_RESPONSE == msg->getKind())
     {
         spfsOSFileReadResponse* readResp =
-            static_cast<spfsOSFileReadResponse*>(msg);
+            kind_cast<spfsOSFileReadResponse>(msg);
         FSSize bytesRead = readResp->getBytesRead();
         addStorageProgress(bytesRead);
 
@@ -99,10 +100,10 @@ void BMIListIODataFlow::processDataFlowMessage(cMessage* msg)
         // Cleanup the originating request
         delete static_cast<cMessage*>(msg->getContextPointer());
     }
-    else if (0 != dynamic_cast<spfsOSFileWriteResponse*>(msg))
+    else if (SPFS_OS_FILE_WRITE_RESPONSE == msg->getKind())
     {
         spfsOSFileWriteResponse* writeResp =
-            static_cast<spfsOSFileWriteResponse*>(msg);
+            kind_cast<spfsOSFileWriteResponse>(msg);
         addStorageProgress(writeResp->getBytesWritten());
 
         // Perform data collection for flow progress
@@ -110,6 +111,10 @@ void BMIListIODataFlow::processDataFlowMessage(cMessage* msg)
 
         // Cleanup the originating request
         delete static_cast<cMessage*>(msg->getContextPointer());
+
+        // Release the written buffer for any waiting network data
+        numFreeBuffers_++;
+        drainBuffersToStorage();
     }
 
     // If this is the last flow message response, send the final response
@@ -135,7 +140,8 @@ void BMIListIODataFlow::pullDataFromNetwork(FSSize pullSize)
 
 void BMIListIODataFlow::pushDataToNetwork(FSSize pushSize)
 {
-    spfsBMIPushDataRequest* pushRequest = new spfsBMIPushDataRequest();
+    spfsBMIPushDataRequest* pushRequest =
+        new spfsBMIPushDataRequest(0, SPFS_BMI_PUSH_DATA_REQUEST);
     spfsDataFlowStart* startMsg = getOriginatingMessage();
     pushRequest->setContextPointer(startMsg);
 
@@ -163,8 +169,8 @@ void BMIListIODataFlow::pullDataFromStorage(FSSize pullSize)
         // Extract the regions to process
         FSSize bufferSize = min(getSize() - pullSubregionOffset_,
                                 pullSize);
-        vector<FileRegion> regions = layout_.getSubRegions(pullSubregionOffset_,
-                                                           bufferSize);
+        layout_.getSubRegions(pullSubregionOffset_, bufferSize, subRegions_);
+        const vector<FileRegion>& regions = subRegions_;
         pullSubregionOffset_ += bufferSize;
 
         // Construct the list i/o request
@@ -197,8 +203,8 @@ void BMIListIODataFlow::pullDataFromStorage(FSSize pullSize)
 void BMIListIODataFlow::pushDataToStorage(FSSize pushSize)
 {
     // Extract the regions to process
-    vector<FileRegion> regions = layout_.getSubRegions(pushSubregionOffset_,
-                                                       pushSize);
+    layout_.getSubRegions(pushSubregionOffset_, pushSize, subRegions_);
+    const vector<FileRegion>& regions = subRegions_;
     pushSubregionOffset_ += pushSize;
 
     // Construct the list I/O request
@@ -225,7 +231,8 @@ void BMIListIODataFlow::pushDataToStorage(FSSize pushSize)
 void BMIListIODataFlow::sendPushAck(FSSize amountRecvd)
 {
     // Send the push acknowedgement, allowing the sender to continue
-    spfsBMIPushDataResponse* pushResponse = new spfsBMIPushDataResponse();
+    spfsBMIPushDataResponse* pushResponse =
+        new spfsBMIPushDataResponse(0, SPFS_BMI_PUSH_DATA_RESPONSE);
     spfsDataFlowStart* startMsg = getOriginatingMessage();
     pushResponse->setContextPointer(startMsg);
     pushResponse->setConnectionId(bmiConnectionId_);
@@ -245,6 +252,31 @@ void BMIListIODataFlow::sendPushAck(FSSize amountRecvd)
     parentModule()->sendDirect(pushResponse, 0.0, 0.0, partnerModule, "directIn");
 }
 
+void BMIListIODataFlow::fillBuffersFromStorage()
+{
+    while (0 < numFreeBuffers_ && FSSize(pullSubregionOffset_) < getSize())
+    {
+        numFreeBuffers_--;
+        pullDataFromStorage(getBufferSize());
+    }
+}
+
+void BMIListIODataFlow::drainBuffersToStorage()
+{
+    while (0 < numFreeBuffers_ && !pendingNetworkData_.empty())
+    {
+        FSSize dataSize = pendingNetworkData_.front();
+        pendingNetworkData_.pop_front();
+        numFreeBuffers_--;
+
+        // Send the data successfully received acknowledgement
+        sendPushAck(dataSize);
+
+        // Perform the next processing step
+        pushDataToStorage(dataSize);
+    }
+}
+
 void BMIListIODataFlow::updateBstreamSize(FSSize lastByteOffset)
 {
     assert(0 != pfsMetaData_);
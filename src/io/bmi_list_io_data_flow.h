@@ -8,6 +8,9 @@
 // This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
 // for details on this and other legal matters.
 //
+#include <deque>
+#include <vector>
+#include "basic_types.h"
 #include "data_flow.h"
 #include "filename.h"
 class spfsDataFlowStart;
@@ -15,7 +18,17 @@ class cSimpleModule;
 class cMessage;
 class FSMetaData;
 
-/** A data flow using ListIO system calls to read and write data */
+/**
+ * A data flow using ListIO system calls to read and write data
+ *
+ * The flow owns numBuffers buffers of bufferSize bytes.  For reads, every
+ * free buffer is filled from storage and pushed to the network as soon as
+ * the storage read completes; a buffer is refilled once the network
+ * acknowledges it.  For writes, each arriving network chunk is acknowledged
+ * only after it is assigned a free buffer, and the buffer is released when
+ * the storage write completes, so that disk and network overlap while the
+ * sender is throttled to the server's buffering capacity.
+ */
 class BMIListIODataFlow : public DataFlow
 {
 public:
@@ -57,6 +70,12 @@ private:
     /** Send data receipt acknowledgement */
     void sendPushAck(FSSize amountRecvd);
 
+    /** Begin storage reads into each free buffer while data remains */
+    void fillBuffersFromStorage();
+
+    /** Assign received network data to free buffers and write it */
+    void drainBuffersToStorage();
+
     /** Update the bstream size to include the final byte */
     void updateBstreamSize(FSSize lastByteOffset);
 
@@ -83,6 +102,15 @@ private:
 
     /** The index into the metadata bstreamSize field */
     std::size_t bstreamSizeIdx_;
+
+    /** The number of flow buffers not currently holding data */
+    std::size_t numFreeBuffers_;
+
+    /** Sizes of received network data waiting for a free buffer */
+    std::deque<FSSize> pendingNetworkData_;
+
+    /** Reusable storage for the layout sub regions of each buffer */
+    std::vector<FileRegion> subRegions_;
 };
 
 #endif
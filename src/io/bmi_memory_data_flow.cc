@@ -11,6 +11,7 @@
 #include <vector>
 #include "bmi_proto_m.h"
 #include "data_flow_registry.h"
+#include "message_kind.h"
 #include "os_proto_m.h"
 #include "pvfs_proto_m.h"
 using namespace std;
@@ -51,10 +52,10 @@ void BMIMemoryDataFlow::startTransfer()
 
 void BMIMemoryDataFlow::processDataFlowMessage(cMessage* msg)
 {
-    if (0 != dynamic_cast<spfsBMIPushDataRequest*>(msg))
+    if (SPFS_BMI_PUSH_DATA_REQUEST == msg->getKind())
     {
         spfsBMIPushDataRequest* pushRequest =
-            static_cast<spfsBMIPushDataRequest*>(msg);
+            kind_cast<spfsBMIPushDataRequest>(msg);
         sendPushAck(pushRequest);
         addNetworkProgress(pushRequest->getDataSize());
         addStorageProgress(pushRequest->getDataSize());
@@ -62,10 +63,10 @@ void BMIMemoryDataFlow::processDataFlowMessage(cMessage* msg)
         // Perform data collection for flow progress
         collectTransferFromNetworkDelay(pushRequest);
     }
-    else if (0 != dynamic_cast<spfsBMIPushDataResponse*>(msg))
+    else if (SPFS_BMI_PUSH_DATA_RESPONSE == msg->getKind())
     {
         spfsBMIPushDataResponse* pushResp =
-            static_cast<spfsBMIPushDataResponse*>(msg);
+            kind_cast<spfsBMIPushDataResponse>(msg);
         addNetworkProgress(pushResp->getReceivedSize());
         addStorageProgress(pushResp->getReceivedSize());
 
@@ -104,7 +105,8 @@ void BMIMemoryDataFlow::pullDataFromNetwork(FSSize pullSize)
 void BMIMemoryDataFlow::pushDataToNetwork(FSSize pushSize)
 {
     assert(0 < pushSize);
-    spfsBMIPushDataRequest* pushRequest = new spfsBMIPushDataRequest();
+    spfsBMIPushDataRequest* pushRequest =
+        new spfsBMIPushDataRequest(0, SPFS_BMI_PUSH_DATA_REQUEST);
     spfsDataFlowStart* startMsg = getOriginatingMessage();
     pushRequest->setContextPointer(startMsg);
     pushRequest->setConnectionId(bmiConnectionId_);
@@ -133,7 +135,8 @@ void BMIMemoryDataFlow::pushDataToStorage(FSSize pushSize)
 void BMIMemoryDataFlow::sendPushAck(spfsBMIPushDataRequest* request)
 {
     // Send the push acknowedgement, allowing the sender to continue
-    spfsBMIPushDataResponse* pushResponse = new spfsBMIPushDataResponse();
+    spfsBMIPushDataResponse* pushResponse =
+        new spfsBMIPushDataResponse(0, SPFS_BMI_PUSH_DATA_RESPONSE);
     spfsDataFlowStart* startMsg = getOriginatingMessage();
     pushResponse->setContextPointer(startMsg);
     pushResponse->setConnectionId(bmiConnectionId_);
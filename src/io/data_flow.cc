@@ -147,7 +147,7 @@ void DataFlow::initClientFlow()
             clientFlow->getOffset(),
             *(clientFlow->getDataType()),
             clientFlow->getCount(),
-            *(clientFlow->getView()),
+            clientFlow->getView(),
             *(clientFlow->getDist()),
             clientFlow->getBstreamSize(),
             aggregateSize);
@@ -158,7 +158,7 @@ void DataFlow::initClientFlow()
             clientFlow->getOffset(),
             *(clientFlow->getDataType()),
             clientFlow->getCount(),
-            *(clientFlow->getView()),
+            clientFlow->getView(),
             *(clientFlow->getDist()),
             aggregateSize);
     }
@@ -175,7 +175,7 @@ void DataFlow::initServerFlow()
         flowSize_ = DataTypeProcessor::createServerFileLayoutForRead(
             serverFlow->getOffset(),
             serverFlow->getDataSize(),
-            *(serverFlow->getView()),
+            serverFlow->getView(),
             *(serverFlow->getDist()),
             serverFlow->getBstreamSize(),
             layout_);
@@ -185,7 +185,7 @@ void DataFlow::initServerFlow()
         flowSize_ = DataTypeProcessor::createServerFileLayoutForWrite(
             serverFlow->getOffset(),
             serverFlow->getDataSize(),
-            *(serverFlow->getView()),
+            serverFlow->getView(),
             *(serverFlow->getDist()),
             layout_);
     }
@@ -14,6 +14,8 @@
 #include "bmi_proto_m.h"
 #include "data_flow.h"
 #include "data_flow_registry.h"
+#include "message_kind.h"
+#include "os_proto_m.h"
 #include "pvfs_proto_m.h"
 using namespace std;
 
@@ -129,8 +131,8 @@ void JobManager::handleMessage(cMessage* msg)
 void JobManager::handleSelfMessage(cMessage* msg)
 {
     // Locate the flow for this flow finish message
-    spfsDataFlowFinish* flowFinish = dynamic_cast<spfsDataFlowFinish*>(msg);
-    assert(0 != flowFinish);
+    assert(SPFS_DATA_FLOW_FINISH == msg->getKind());
+    spfsDataFlowFinish* flowFinish = kind_cast<spfsDataFlowFinish>(msg);
     int flowId = flowFinish->getFlowId();
     DataFlow* flow = lookupDataFlow(flowId);
     assert(0 != flow);
@@ -153,16 +155,23 @@ void JobManager::handleNetworkMessage(cMessage* msg)
     assert(0 != msg);
     //cerr << name() << ": Received network message\n";
     // Route message to the pfs or a flow depending on its message type
-    if (spfsBMIFlowMessage* flowMsg = dynamic_cast<spfsBMIFlowMessage*>(msg))
+    switch (msg->getKind())
     {
-        int bmiTag = flowMsg->getTag();
-        DataFlow* flow = getSubscribedDataFlow(bmiTag);
-        assert(0 != flow);
-        flow->handleServerMessage(flowMsg);
-    }
-    else
-    {
-        send(msg, pfsOutGateId_);
+        case SPFS_BMI_PUSH_DATA_REQUEST:
+        case SPFS_BMI_PUSH_DATA_RESPONSE:
+        {
+            spfsBMIFlowMessage* flowMsg = kind_cast<spfsBMIFlowMessage>(msg);
+            int bmiTag = flowMsg->getTag();
+            DataFlow* flow = getSubscribedDataFlow(bmiTag);
+            assert(0 != flow);
+            flow->handleServerMessage(flowMsg);
+            break;
+        }
+        default:
+        {
+            send(msg, pfsOutGateId_);
+            break;
+        }
     }
 }
 
@@ -170,30 +179,41 @@ void JobManager::handlePFSMessage(cMessage* msg)
 {
     // Determine if the message starts a flow, or should be routed to
     // either the storage or network subssytems
-    if (spfsDataFlowStart* flowStart = dynamic_cast<spfsDataFlowStart*>(msg))
-    {
-        // Create the flow
-        DataFlow* flow = createDataFlow(flowStart);
-        assert(0 != flow);
-
-        // Register the flow
-        int flowId = registerDataFlow(flow);
-        flowStart->setFlowId(flowId);
-
-        // Subscribe the flow to a BMI tag
-        subscribeDataFlowToTag(flow, flowStart->getInboundBmiTag());
-
-        // Start the flow
-        flow->initialize();
-    }
-    else if (0 != dynamic_cast<spfsResponse*>(msg) ||
-             0 != dynamic_cast<spfsRequest*>(msg))
-    {
-        send(msg, netOutGateId_);
-    }
-    else
+    switch (msg->getKind())
     {
-        send(msg, storageOutGateId_);
+        case SPFS_DATA_FLOW_START:
+        {
+            spfsDataFlowStart* flowStart = kind_cast<spfsDataFlowStart>(msg);
+
+            // Create the flow
+            DataFlow* flow = createDataFlow(flowStart);
+            assert(0 != flow);
+
+            // Register the flow
+            int flowId = registerDataFlow(flow);
+            flowStart->setFlowId(flowId);
+
+            // Subscribe the flow to a BMI tag
+            subscribeDataFlowToTag(flow, flowStart->getInboundBmiTag());
+
+            // Start the flow
+            flow->initialize();
+            break;
+        }
+        case SPFS_OS_FILE_OPEN_REQUEST:
+        case SPFS_OS_FILE_READ_REQUEST:
+        case SPFS_OS_FILE_WRITE_REQUEST:
+        case SPFS_OS_FILE_SYNC_REQUEST:
+        case SPFS_OS_FILE_UNLINK_REQUEST:
+        {
+            send(msg, storageOutGateId_);
+            break;
+        }
+        default:
+        {
+            send(msg, netOutGateId_);
+            break;
+        }
     }
 }
 
@@ -205,8 +225,9 @@ void JobManager::handleStorageMessage(cMessage* msg)
     // Route message to the flow or PFS depending on its originator
     cMessage* request = static_cast<cMessage*>(msg->getContextPointer());
     cMessage* origReq = static_cast<cMessage*>(request->getContextPointer());
-    if (spfsDataFlowStart* flowStart = dynamic_cast<spfsDataFlowStart*>(origReq))
+    if (SPFS_DATA_FLOW_START == origReq->getKind())
     {
+        spfsDataFlowStart* flowStart = kind_cast<spfsDataFlowStart>(origReq);
         int flowId = flowStart->getFlowId();
         DataFlow* flow = lookupDataFlow(flowId);
         assert(0 != flow);
@@ -7,20 +7,24 @@
 // for details on this and other legal matters.
 //
 #include "data_type_layout.h"
+#include <algorithm>
 #include <cassert>
 using namespace std;
 
 DataTypeLayout::DataTypeLayout()
+    : cursorIdx_(0)
 {
 }
 
 DataTypeLayout::DataTypeLayout(const FSOffset& offset, const FSSize& extent)
+    : cursorIdx_(0)
 {
     addRegion(offset, extent);
 }
 
 DataTypeLayout::DataTypeLayout(const vector<FSOffset>& offsets,
                                const vector<FSSize>& extents)
+    : cursorIdx_(0)
 {
     addRegions(offsets, extents);
 }
@@ -29,6 +33,7 @@ void DataTypeLayout::addRegion(const FSOffset& offset, const FSSize& extent)
 {
     FileRegion fr = {offset, extent};
     fileRegions_.push_back(fr);
+    regionEnds_.push_back(getLength() + extent);
 }
 
 void DataTypeLayout::addRegions(const vector<FSOffset>& offsets,
@@ -36,7 +41,8 @@ void DataTypeLayout::addRegions(const vector<FSOffset>& offsets,
 {
     assert(offsets.size() == extents.size());
     size_t numRegions = offsets.size();
-    fileRegions_.reserve(numRegions);
+    fileRegions_.reserve(fileRegions_.size() + numRegions);
+    regionEnds_.reserve(regionEnds_.size() + numRegions);
     for (size_t i = 0; i < numRegions; i++)
     {
         addRegion(offsets[i], extents[i]);
@@ -57,9 +63,9 @@ FileRegion DataTypeLayout::getRegion(std::size_t idx) const
 FSSize DataTypeLayout::getLength() const
 {
     FSSize length = 0;
-    for (size_t i = 0; i < fileRegions_.size(); i++)
+    if (!regionEnds_.empty())
     {
-        length += fileRegions_[i].extent;
+        length = regionEnds_.back();
     }
     return length;
 }
@@ -67,53 +73,71 @@ FSSize DataTypeLayout::getLength() const
 vector<FileRegion> DataTypeLayout::getSubRegions(const FSOffset& byteOffset,
                                                  const FSSize& byteLength) const
 {
-    //cerr << __FILE__ << ":" << __LINE__ << ":"
-    //     << byteOffset << " " << byteLength << " " << getLength() << endl;
-    //for(size_t i = 0; i < fileRegions_.size(); i++)
-    //{
-    //    cerr << "Off: " << fileRegions_[i].offset << " "
-    //         << "Ext: " << fileRegions_[i].extent << endl;
-    //}
+    vector<FileRegion> subRegions;
+    getSubRegions(byteOffset, byteLength, subRegions);
+    return subRegions;
+}
+
+void DataTypeLayout::getSubRegions(const FSOffset& byteOffset,
+                                   const FSSize& byteLength,
+                                   vector<FileRegion>& outRegions) const
+{
     assert(0 < fileRegions_.size());
     assert(FSSize(byteOffset) < getLength());
     assert((byteOffset + byteLength) <= getLength());
-
-    vector<FileRegion> subRegions;
+    outRegions.clear();
 
     // Find the first region the sub region is contained in
-    size_t regionIdx = 0;
-    FSSize processedBytes = fileRegions_[0].extent;
-    while (FSSize(byteOffset) >= processedBytes)
-    {
-        regionIdx++;
-        processedBytes += fileRegions_[regionIdx].extent;
-    }
+    size_t regionIdx = findRegionIndex(byteOffset);
 
     // Extract the first sub region
-    FSOffset firstOffset = fileRegions_[regionIdx].offset +
-        byteOffset - (processedBytes - fileRegions_[regionIdx].extent);
-    FSSize firstExtent = min(fileRegions_[regionIdx].extent, byteLength);
+    FSSize regionBegin = regionEnds_[regionIdx] - fileRegions_[regionIdx].extent;
+    FSOffset firstOffset =
+        fileRegions_[regionIdx].offset + (byteOffset - regionBegin);
+    FSSize firstExtent = min(regionEnds_[regionIdx] - byteOffset, byteLength);
     FileRegion firstRegion = {firstOffset, firstExtent};
-    subRegions.push_back(firstRegion);
+    outRegions.push_back(firstRegion);
 
     // Extract any remaining sub regions
-    regionIdx++;
     FSSize assignedBytes = firstExtent;
     while (assignedBytes < byteLength)
     {
+        regionIdx++;
         FSOffset offset = fileRegions_[regionIdx].offset;
         FSSize length = min(fileRegions_[regionIdx].extent,
                             byteLength - assignedBytes);
         FileRegion fr = {offset, length};
-        subRegions.push_back(fr);
+        outRegions.push_back(fr);
 
         // Bookkeeping
         assignedBytes += length;
-        regionIdx++;
     }
     assert(assignedBytes == byteLength);
 
-    return subRegions;
+    // Remember where this extraction ended for the next sequential call
+    cursorIdx_ = regionIdx;
+}
+
+size_t DataTypeLayout::findRegionIndex(const FSOffset& byteOffset) const
+{
+    // Sequential slicing resumes in the cursor region or its successor
+    for (size_t idx = cursorIdx_;
+         idx < regionEnds_.size() && idx <= cursorIdx_ + 1;
+         idx++)
+    {
+        FSSize regionBegin = regionEnds_[idx] - fileRegions_[idx].extent;
+        if (regionBegin <= FSSize(byteOffset) &&
+            FSSize(byteOffset) < regionEnds_[idx])
+        {
+            return idx;
+        }
+    }
+
+    // Otherwise binary search for the first region ending after the offset
+    vector<FSSize>::const_iterator end =
+        upper_bound(regionEnds_.begin(), regionEnds_.end(), FSSize(byteOffset));
+    assert(regionEnds_.end() != end);
+    return end - regionEnds_.begin();
 }
 
 /*
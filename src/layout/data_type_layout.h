@@ -15,6 +15,12 @@
 
 /**
  * File layout for an I/O request's data type, count, and extent
+ *
+ * The layout maintains the running byte total at the end of each region so
+ * that the region containing any byte offset may be located by binary
+ * search.  Sub region extraction additionally remembers the region where the
+ * previous extraction ended, so that slicing the layout into consecutive
+ * buffers visits each region only once.
  */
 class DataTypeLayout
 {
@@ -54,10 +60,30 @@ public:
     std::vector<FileRegion> getSubRegions(const FSOffset& byteOffset,
                                           const FSSize& byteLength) const;
 
+    /**
+     * Extract the file regions in the request layout from
+     * [byteOffset, byteOffset + byteLength]
+     *
+     * @side outRegions is cleared and filled with the sub regions, allowing
+     *   the caller to reuse its storage across calls
+     */
+    void getSubRegions(const FSOffset& byteOffset,
+                       const FSSize& byteLength,
+                       std::vector<FileRegion>& outRegions) const;
+
 private:
+    /** @return the index of the region containing the byte offset */
+    std::size_t findRegionIndex(const FSOffset& byteOffset) const;
+
     /** The list of contiguous regions described in this layout */
     std::vector<FileRegion> fileRegions_;
 
+    /** The layout byte offset at the end of each region (prefix sums) */
+    std::vector<FSSize> regionEnds_;
+
+    /** The region index the most recent sub region extraction ended in */
+    mutable std::size_t cursorIdx_;
+
 };
 
 #endif
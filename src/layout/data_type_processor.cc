@@ -8,11 +8,141 @@
 //
 #include "data_type_processor.h"
 #include <cassert>
+#include "data_type.h"
 #include "data_type_layout.h"
 #include "file_distribution.h"
 #include "file_view.h"
+#include "simple_stripe_distribution.h"
 using namespace std;
 
+/** Visitor that applies the view displacement and stores each region */
+class DisplacedRegionCollector : public FileRegionVisitor
+{
+public:
+    /** Constructor */
+    DisplacedRegionCollector(const FSSize& displacement,
+                             vector<FileRegion>& outRegions)
+        : displacement_(displacement), regions_(outRegions) {};
+
+    /** Displace and store the region */
+    virtual void visitRegion(const FileRegion& region)
+    {
+        FileRegion fr = {region.offset + displacement_, region.extent};
+        regions_.push_back(fr);
+    };
+
+private:
+    FSOffset displacement_;
+    vector<FileRegion>& regions_;
+};
+
+/** Visitor that applies the view displacement and inserts into a set */
+class DisplacedRegionSetBuilder : public FileRegionVisitor
+{
+public:
+    /** Constructor */
+    DisplacedRegionSetBuilder(const FSSize& displacement,
+                              FileRegionSet& outRegionSet)
+        : displacement_(displacement), regionSet_(outRegionSet) {};
+
+    /** Displace and insert the region */
+    virtual void visitRegion(const FileRegion& region)
+    {
+        FileRegion fr = {region.offset + displacement_, region.extent};
+        regionSet_.insert(fr);
+    };
+
+private:
+    FSOffset displacement_;
+    FileRegionSet& regionSet_;
+};
+
+// Closed form region distribution for simple striping
+template<>
+void DataTypeProcessor::distributeContiguousRegion<SimpleStripeDistribution>(
+    const FSOffset& offset,
+    const FSSize& extent,
+    const SimpleStripeDistribution& dist,
+    const FSSize& bstreamSize,
+    bool dataExtend,
+    DataTypeLayout& outLayout);
+
+// Single strip walk region summary for simple striping
+template<>
+void DataTypeProcessor::summarizeRegion<SimpleStripeDistribution>(
+    const FSOffset& offset,
+    const FSSize& extent,
+    SimpleStripeDistribution& dist,
+    const vector<FSSize>& bstreamSizes,
+    vector<ServerLayoutSummary>& outSummaries);
+
+/** Visitor that distributes each view region onto a server's layout */
+template<class Distribution>
+class DataTypeProcessor::ServerLayoutBuilder : public FileRegionVisitor
+{
+public:
+    /** Constructor */
+    ServerLayoutBuilder(const FSSize& displacement,
+                        const Distribution& dist,
+                        const FSSize& bstreamSize,
+                        bool dataExtend,
+                        DataTypeLayout& outLayout)
+        : displacement_(displacement),
+          dist_(dist),
+          bstreamSize_(bstreamSize),
+          dataExtend_(dataExtend),
+          layout_(outLayout) {};
+
+    /** Construct the data layout for this server distribution */
+    virtual void visitRegion(const FileRegion& region)
+    {
+        distributeContiguousRegion(displacement_ + region.offset,
+                                   region.extent,
+                                   dist_,
+                                   bstreamSize_,
+                                   dataExtend_,
+                                   layout_);
+    };
+
+private:
+    FSSize displacement_;
+    const Distribution& dist_;
+    FSSize bstreamSize_;
+    bool dataExtend_;
+    DataTypeLayout& layout_;
+};
+
+/** Visitor that distributes each view region onto every data object */
+template<class Distribution>
+class DataTypeProcessor::ServerSummaryBuilder : public FileRegionVisitor
+{
+public:
+    /** Constructor */
+    ServerSummaryBuilder(const FSSize& displacement,
+                         Distribution& dist,
+                         const vector<FSSize>& bstreamSizes,
+                         vector<ServerLayoutSummary>& outSummaries)
+        : displacement_(displacement),
+          dist_(dist),
+          bstreamSizes_(bstreamSizes),
+          summaries_(outSummaries) {};
+
+    /** Add the region's bytes to each data object's summary */
+    virtual void visitRegion(const FileRegion& region)
+    {
+        summarizeRegion(displacement_ + region.offset,
+                        region.extent,
+                        dist_,
+                        bstreamSizes_,
+                        summaries_);
+    };
+
+private:
+    FSSize displacement_;
+    Distribution& dist_;
+    const vector<FSSize>& bstreamSizes_;
+    vector<ServerLayoutSummary>& summaries_;
+};
 
 FSSize DataTypeProcessor::createClientFileLayoutForRead(
     const FSOffset& offset,
@@ -59,6 +189,44 @@ FSSize DataTypeProcessor::createClientFileLayoutForWrite(
     return assignedBytes;
 }
 
+FSSize DataTypeProcessor::createClientFileLayouts(
+    const FSOffset& offset,
+    const DataType& dataType,
+    const size_t& count,
+    const FileView& view,
+    const FileDistribution& dist,
+    const vector<FSSize>& bstreamSizes,
+    vector<ServerLayoutSummary>& outSummaries)
+{
+    // It isn't necessary to flatten the memory data type, simply figure out
+    // its magnitude
+    FSSize aggregateSize = dataType.getExtent() * count;
+
+    // Reset the per object summaries
+    ServerLayoutSummary empty = {0, 0};
+    outSummaries.assign(dist.getNumObjects(), empty);
+
+    // Distribute each file region to every data object as it is produced,
+    // using the closed form for simple striping when possible
+    FileDistribution* serverDist = dist.clone();
+    const DataType* fileDataType = view.getDataType();
+    if (SimpleStripeDistribution* stripeDist =
+        dynamic_cast<SimpleStripeDistribution*>(serverDist))
+    {
+        ServerSummaryBuilder<SimpleStripeDistribution> builder(
+            view.getDisplacement(), *stripeDist, bstreamSizes, outSummaries);
+        fileDataType->visitRegionsByBytes(offset, aggregateSize, builder);
+    }
+    else
+    {
+        ServerSummaryBuilder<FileDistribution> builder(
+            view.getDisplacement(), *serverDist, bstreamSizes, outSummaries);
+        fileDataType->visitRegionsByBytes(offset, aggregateSize, builder);
+    }
+    delete serverDist;
+    return aggregateSize;
+}
+
 FSSize DataTypeProcessor::createServerFileLayoutForRead(
     const FSOffset& offset,
     const FSSize& dataSize,
@@ -104,16 +272,13 @@ vector<FileRegion> DataTypeProcessor::locateFileRegions(const FSOffset& offset,
 {
     // Determine the amount of contiguous file regions that correspond to
     // this server's physical file locations
+    // Modify the file regions to take into account the view displacement
+    // as they are streamed from the view's data type
     FSSize disp = view.getDisplacement();
     const DataType* fileDataType = view.getDataType();
-    vector<FileRegion> fileRegions = fileDataType->getRegionsByBytes(offset,
-                                                                     dataSize);
-
-    // Modify the file regions to take into account the view displacement
-    for (size_t i = 0; i < fileRegions.size(); i++)
-    {
-        fileRegions[i]. offset += disp;
-    }
+    vector<FileRegion> fileRegions;
+    DisplacedRegionCollector collector(disp, fileRegions);
+    fileDataType->visitRegionsByBytes(offset, dataSize, collector);
     return fileRegions;
 }
 
@@ -123,19 +288,13 @@ FileRegionSet DataTypeProcessor::locateFileRegionSet(const FSOffset& offset,
 {
     // Determine the amount of contiguous file regions that correspond to
     // this server's physical file locations
-    FSSize disp = view.getDisplacement();
-    const DataType* fileDataType = view.getDataType();
-    vector<FileRegion> fileRegions = fileDataType->getRegionsByBytes(offset,
-                                                                     dataSize);
-
     // Modify the file regions to take into account the view displacement
     // and insert into a file region set
+    FSSize disp = view.getDisplacement();
+    const DataType* fileDataType = view.getDataType();
     FileRegionSet frs;
-    for (size_t i = 0; i < fileRegions.size(); i++)
-    {
-        fileRegions[i].offset += disp;
-        frs.insert(fileRegions[i]);
-    }
+    DisplacedRegionSetBuilder builder(disp, frs);
+    fileDataType->visitRegionsByBytes(offset, dataSize, builder);
     return frs;
 }
 
@@ -172,30 +331,33 @@ FSSize DataTypeProcessor::processServerRequest(const FSOffset& offset,
                                                DataTypeLayout& outLayout)
 {
     // Determine the amount of contiguous file regions that correspond to
-    // this server's physical file locations
+    // this server's physical file locations, distributing each region as
+    // it is produced (using the closed form for simple striping)
     FSSize disp = view.getDisplacement();
     const DataType* fileDataType = view.getDataType();
-    vector<FileRegion> fileRegions = fileDataType->getRegionsByBytes(offset,
-                                                                     dataSize);
-    for (size_t i = 0; i < fileRegions.size(); i++)
+    if (const SimpleStripeDistribution* stripeDist =
+        dynamic_cast<const SimpleStripeDistribution*>(&dist))
+    {
+        ServerLayoutBuilder<SimpleStripeDistribution> builder(
+            disp, *stripeDist, bstreamSize, dataExtend, outLayout);
+        fileDataType->visitRegionsByBytes(offset, dataSize, builder);
+    }
+    else
     {
-        // Construct the data layout for this server distribution
-        distributeContiguousRegion(disp + fileRegions[i].offset,
-                                   fileRegions[i].extent,
-                                   dist,
-                                   bstreamSize,
-                                   dataExtend,
-                                   outLayout);
+        ServerLayoutBuilder<FileDistribution> builder(
+            disp, dist, bstreamSize, dataExtend, outLayout);
+        fileDataType->visitRegionsByBytes(offset, dataSize, builder);
     }
 
     FSSize length = outLayout.getLength();
     return length;
 }
 
+template<class Distribution>
 void DataTypeProcessor::distributeContiguousRegion(
     const FSOffset& offset,
     const FSSize& extent,
-    const FileDistribution& dist,
+    const Distribution& dist,
     const FSSize& bstreamSize,
     bool dataExtend,
     DataTypeLayout& outLayout)
@@ -235,6 +397,197 @@ void DataTypeProcessor::distributeContiguousRegion(
     }
 }
 
+template<class Distribution>
+void DataTypeProcessor::summarizeContiguousRegion(const FSOffset& offset,
+                                                  const FSSize& extent,
+                                                  const Distribution& dist,
+                                                  const FSSize& bstreamSize,
+                                                  FSSize& outWriteBytes,
+                                                  FSSize& outReadBytes)
+{
+    // Mirror distributeContiguousRegion, counting bytes for both the
+    // extending and the existing data cases in the same strip walk
+    FSOffset logServerOffset = dist.nextMappedLogicalOffset(offset);
+    while (FSSize(logServerOffset) < (offset + extent))
+    {
+        // Determine the contiguous length forward from the physical offset
+        FSOffset physOffset = dist.logicalToPhysicalOffset(logServerOffset);
+        FSSize serverExtent = dist.contiguousLength(physOffset);
+        FSSize requestedExtent = min(serverExtent, extent);
+        outWriteBytes += requestedExtent;
+
+        // Trim region to include only existing data
+        if (FSSize(physOffset) < bstreamSize)
+        {
+            FSOffset finalSize = min(physOffset + requestedExtent, bstreamSize);
+            outReadBytes += finalSize - physOffset;
+        }
+
+        // Determine the next mapped offset for this server
+        logServerOffset = dist.nextMappedLogicalOffset(logServerOffset +
+                                                       serverExtent);
+    }
+}
+
+template<>
+void DataTypeProcessor::distributeContiguousRegion<SimpleStripeDistribution>(
+    const FSOffset& offset,
+    const FSSize& extent,
+    const SimpleStripeDistribution& dist,
+    const FSSize& bstreamSize,
+    bool dataExtend,
+    DataTypeLayout& outLayout)
+{
+    // Locate the first strip for this server that begins at or contains the
+    // offset, and the physical offset and strip remainder at that point
+    FSOffset logServerOffset = 0;
+    FSOffset physOffset = 0;
+    FSSize serverExtent = 0;
+    FSOffset stripBegin = 0;
+    locateFirstStrip(offset, dist, logServerOffset, physOffset, serverExtent,
+                     stripBegin);
+
+    // Each later strip for this server is a full strip exactly one stripe
+    // further in the logical file and one strip further in the bstream
+    FSSize stripSize = dist.getStripSize();
+    FSSize stripeSize = stripSize * dist.getNumObjects();
+    while (FSSize(logServerOffset) < (offset + extent))
+    {
+        // Determine how much of the extent to actually use
+        FSSize requestedExtent = min(serverExtent, extent);
+
+        // If the dataExtend flag is set add the region
+        // Otherwise, trim region to include only existing data
+        if (dataExtend)
+        {
+            outLayout.addRegion(physOffset, requestedExtent);
+        }
+        else if (FSSize(physOffset) < bstreamSize)
+        {
+            FSOffset finalSize = min(physOffset + requestedExtent, bstreamSize);
+            outLayout.addRegion(physOffset, finalSize - physOffset);
+        }
+
+        // Advance to this server's next strip
+        physOffset += serverExtent;
+        stripBegin += stripeSize;
+        logServerOffset = stripBegin;
+        serverExtent = stripSize;
+    }
+}
+
+template<class Distribution>
+void DataTypeProcessor::summarizeRegion(
+    const FSOffset& offset,
+    const FSSize& extent,
+    Distribution& dist,
+    const vector<FSSize>& bstreamSizes,
+    vector<ServerLayoutSummary>& outSummaries)
+{
+    for (size_t i = 0; i < outSummaries.size(); i++)
+    {
+        FSSize bstreamSize = 0;
+        if (i < bstreamSizes.size())
+        {
+            bstreamSize = bstreamSizes[i];
+        }
+
+        dist.setObjectIdx(i);
+        summarizeContiguousRegion(offset,
+                                  extent,
+                                  dist,
+                                  bstreamSize,
+                                  outSummaries[i].writeBytes,
+                                  outSummaries[i].readBytes);
+    }
+}
+
+template<>
+void DataTypeProcessor::summarizeRegion<SimpleStripeDistribution>(
+    const FSOffset& offset,
+    const FSSize& extent,
+    SimpleStripeDistribution& dist,
+    const vector<FSSize>& bstreamSizes,
+    vector<ServerLayoutSummary>& outSummaries)
+{
+    FSSize stripSize = dist.getStripSize();
+    size_t numObjects = dist.getNumObjects();
+    FSSize stripeSize = stripSize * numObjects;
+    assert(numObjects == outSummaries.size());
+
+    // Walk the region's strips once, crediting each strip to the object
+    // that stores it
+    FSSize regionEnd = offset + extent;
+    FSSize logOffset = offset;
+    while (logOffset < regionEnd)
+    {
+        FSSize stripe = logOffset / stripeSize;
+        if (0 == logOffset % stripeSize && stripeSize <= regionEnd - logOffset)
+        {
+            // Whole stripes place physically consecutive full strips on
+            // every object, so credit the entire span at once
+            FSSize numStripes = (regionEnd - logOffset) / stripeSize;
+            FSSize physOffset = stripe * stripSize;
+            FSSize spanExtent = numStripes * stripSize;
+            for (size_t i = 0; i < numObjects; i++)
+            {
+                outSummaries[i].writeBytes += spanExtent;
+                if (i < bstreamSizes.size() && physOffset < bstreamSizes[i])
+                {
+                    outSummaries[i].readBytes +=
+                        min(spanExtent, bstreamSizes[i] - physOffset);
+                }
+            }
+            logOffset += numStripes * stripeSize;
+        }
+        else
+        {
+            // Credit the (possibly partial) strip containing the offset
+            FSSize stripOffset = logOffset % stripSize;
+            size_t objectIdx = (logOffset / stripSize) % numObjects;
+            FSSize physOffset = stripe * stripSize + stripOffset;
+            FSSize serverExtent = stripSize - stripOffset;
+            FSSize requestedExtent = min(serverExtent, extent);
+            outSummaries[objectIdx].writeBytes += requestedExtent;
+            if (objectIdx < bstreamSizes.size() &&
+                physOffset < bstreamSizes[objectIdx])
+            {
+                outSummaries[objectIdx].readBytes +=
+                    min(physOffset + requestedExtent,
+                        bstreamSizes[objectIdx]) - physOffset;
+            }
+            logOffset += serverExtent;
+        }
+    }
+}
+
+void DataTypeProcessor::locateFirstStrip(const FSOffset& offset,
+                                         const SimpleStripeDistribution& dist,
+                                         FSOffset& outLogicalOffset,
+                                         FSOffset& outPhysicalOffset,
+                                         FSSize& outStripRemainder,
+                                         FSOffset& outStripBegin)
+{
+    FSSize stripSize = dist.getStripSize();
+    FSSize stripeSize = stripSize * dist.getNumObjects();
+
+    // Determine this server's strip in the stripe containing the offset
+    FSSize stripe = offset / stripeSize;
+    FSOffset stripBegin = stripe * stripeSize + dist.getObjectIdx() * stripSize;
+    if (FSSize(offset) >= stripBegin + stripSize)
+    {
+        // The offset is past this server's strip, use the next stripe
+        stripe++;
+        stripBegin += stripeSize;
+    }
+
+    // The first mapped offset is the offset itself if it is in the strip
+    outLogicalOffset = max(offset, stripBegin);
+    outStripBegin = stripBegin;
+    outPhysicalOffset = stripe * stripSize + (outLogicalOffset - stripBegin);
+    outStripRemainder = stripSize - (outLogicalOffset - stripBegin);
+}
+
 /*
  * Local variables:
  *  indent-tabs-mode: nil
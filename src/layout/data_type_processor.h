@@ -16,6 +16,7 @@ class DataType;
 class DataTypeLayout;
 class FileDistribution;
 class FileView;
+class SimpleStripeDistribution;
 
 /** Data type processor to determine which file portions are alloted
  *  to each I/O node for a give MPI data type and file distribution
@@ -24,6 +25,16 @@ class FileView;
 class DataTypeProcessor
 {
 public:
+    /** The portion of a client request assigned to a single data object */
+    struct ServerLayoutSummary
+    {
+        /** Bytes assigned when the request may extend the bstream */
+        FSSize writeBytes;
+
+        /** Bytes assigned that lie within the object's bstream size */
+        FSSize readBytes;
+    };
+
     /**
      * @return the number of bytes assigned to the distribution
      * @side fills the outAggregateSize with the total I/O size
@@ -47,6 +58,26 @@ public:
                                                  const FileDistribution& dist,
                                                  FSSize& outAggregateSize);
 
+    /**
+     * Walk the view once and determine the bytes of the request assigned
+     * to every data object in the distribution.  Equivalent to calling
+     * createClientFileLayoutForWrite and createClientFileLayoutForRead for
+     * each object index in turn.
+     *
+     * @return the aggregate I/O size
+     * @side resizes outSummaries to the number of data objects and fills
+     *   entry i with the bytes assigned to object i, where readBytes is
+     *   limited by bstreamSizes[i]
+     */
+    static FSSize createClientFileLayouts(
+        const FSOffset& offset,
+        const DataType& dataType,
+        const std::size_t& count,
+        const FileView& view,
+        const FileDistribution& dist,
+        const std::vector<FSSize>& bstreamSizes,
+        std::vector<ServerLayoutSummary>& outSummaries);
+
     /**
      * @return the number of bytes assigned to the distribution
      * @side Fills the layout object with physical offsets and extents for
@@ -89,6 +120,13 @@ public:
                                              const FileView& view);
 
 private:
+    /** Visitor distributing streamed view regions onto a server layout */
+    template<class Distribution> class ServerLayoutBuilder;
+    template<class Distribution> friend class ServerLayoutBuilder;
+
+    /** Visitor accumulating streamed view regions for every data object */
+    template<class Distribution> class ServerSummaryBuilder;
+    template<class Distribution> friend class ServerSummaryBuilder;
 
     /**
      * @return the number of bytes processed
@@ -115,13 +153,63 @@ private:
                                        bool dataExtend,
                                        DataTypeLayout& outLayout);
 
-    /** Construct the server local offset extent pairs */
+    /**
+     * Construct the server local offset extent pairs.  The generic
+     * implementation walks the distribution strip by strip through the
+     * FileDistribution interface; distributions with a closed form
+     * provide specializations.
+     */
+    template<class Distribution>
     static void distributeContiguousRegion(const FSOffset& offset,
                                            const FSSize& extent,
-                                           const FileDistribution& dist,
+                                           const Distribution& dist,
                                            const FSSize& bstreamSize,
                                            bool dataExtend,
                                            DataTypeLayout& outLayout);
+
+    /**
+     * Determine the server local byte counts for a contiguous region
+     *
+     * @side adds the bytes distributed to the server to outWriteBytes, and
+     *   the bytes that also lie within bstreamSize to outReadBytes
+     */
+    template<class Distribution>
+    static void summarizeContiguousRegion(const FSOffset& offset,
+                                          const FSSize& extent,
+                                          const Distribution& dist,
+                                          const FSSize& bstreamSize,
+                                          FSSize& outWriteBytes,
+                                          FSSize& outReadBytes);
+
+    /**
+     * Determine every data object's byte counts for a contiguous region.
+     * The generic implementation summarizes the region once per object;
+     * distributions with a closed form provide specializations.
+     *
+     * @side adds each object's distributed and existing bytes to its entry
+     *   in outSummaries
+     */
+    template<class Distribution>
+    static void summarizeRegion(
+        const FSOffset& offset,
+        const FSSize& extent,
+        Distribution& dist,
+        const std::vector<FSSize>& bstreamSizes,
+        std::vector<ServerLayoutSummary>& outSummaries);
+
+    /**
+     * Locate the first strip of a simple stripe distribution's server that
+     * begins at or contains offset
+     *
+     * @side sets the first mapped logical offset, its physical offset, the
+     *   bytes remaining in its strip, and the logical offset of the strip
+     */
+    static void locateFirstStrip(const FSOffset& offset,
+                                 const SimpleStripeDistribution& dist,
+                                 FSOffset& outLogicalOffset,
+                                 FSOffset& outPhysicalOffset,
+                                 FSSize& outStripRemainder,
+                                 FSOffset& outStripBegin);
 };
 
 #endif
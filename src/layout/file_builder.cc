@@ -29,10 +29,17 @@ FileBuilder::~FileBuilder()
     while (handleToMetaMap_.end() != iter)
     {
         FSMetaData* meta = iter->second;
-        delete meta->dist;
         delete meta;
         ++iter;
     }
+
+    map<int, FileDistribution*>::const_iterator distIter =
+        distributions_.begin();
+    while (distributions_.end() != distIter)
+    {
+        delete distIter->second;
+        ++distIter;
+    }
 }
 
 void FileBuilder::setDefaultMetaDataSize(size_t metaDataSize)
@@ -55,9 +62,12 @@ int FileBuilder::registerFSServer(const HandleRange& range, bool isMetaServer)
 
 bool FileBuilder::fileExists(const Filename& fileName) const
 {
-    std::map<std::string, FSHandle>::const_iterator pos;
-    pos = nameToHandleMap_.find(fileName.str());
-    return (nameToHandleMap_.end() != pos);
+    FileId fileId = 0;
+    if (!FileIdRegistry::instance().find(fileName, fileId))
+    {
+        return false;
+    }
+    return (nameToHandleMap_.end() != nameToHandleMap_.find(fileId));
 }
 
 vector<int> FileBuilder::getMetaServers() const
@@ -68,8 +78,14 @@ vector<int> FileBuilder::getMetaServers() const
 FSMetaData* FileBuilder::getMetaData(const Filename& fileName) const
 {
     FSMetaData* md = 0;
-    std::map<std::string, FSHandle>::const_iterator p1;
-    p1 = nameToHandleMap_.find(fileName.str());
+    FileId fileId = 0;
+    if (!FileIdRegistry::instance().find(fileName, fileId))
+    {
+        return md;
+    }
+
+    std::map<FileId, FSHandle>::const_iterator p1;
+    p1 = nameToHandleMap_.find(fileId);
     if (nameToHandleMap_.end() != p1)
     {
         std::map<FSHandle, FSMetaData*>::const_iterator p2;
@@ -160,7 +176,8 @@ void FileBuilder::createDirectory(const Filename& dirName,
         layoutManager.addFile(metaServer, direntName, meta->size);
 
         // Record bookkeeping information
-        nameToHandleMap_[dirName.str()] = meta->handle;
+        nameToHandleMap_[FileIdRegistry::instance().intern(dirName)] =
+            meta->handle;
         handleToMetaMap_[meta->handle] = meta;
     }
 }
@@ -193,7 +210,7 @@ void FileBuilder::createFile(const Filename& fileName,
         meta->nlinks = 0;
         meta->size = fileSize;
         meta->handle = getNextHandle(metaServer);
-        meta->dist = new SimpleStripeDistribution(0, numServers);
+        meta->dist = getDistribution(numServers);
 
         // Construct the storage layout for the file metadata
         Filename storageMeta(meta->handle);
@@ -226,7 +243,8 @@ void FileBuilder::createFile(const Filename& fileName,
         }
 
         // Record bookeeping information
-        nameToHandleMap_[fileName.str()] = meta->handle;
+        nameToHandleMap_[FileIdRegistry::instance().intern(fileName)] =
+            meta->handle;
         handleToMetaMap_[meta->handle] = meta;
     }
     else
@@ -235,6 +253,25 @@ void FileBuilder::createFile(const Filename& fileName,
     }
 }
 
+FileDistribution* FileBuilder::getDistribution(int numServers)
+{
+    // Distributions are immutable once assigned to a file, so a single
+    // distribution describes every file striped across numServers
+    FileDistribution* dist = 0;
+    map<int, FileDistribution*>::const_iterator iter =
+        distributions_.find(numServers);
+    if (distributions_.end() != iter)
+    {
+        dist = iter->second;
+    }
+    else
+    {
+        dist = new SimpleStripeDistribution(0, numServers);
+        distributions_[numServers] = dist;
+    }
+    return dist;
+}
+
 size_t FileBuilder::getNumDataObjects(const FSHandle& metaHandle) const
 {
     std::map<FSHandle, FSMetaData*>::const_iterator pos =
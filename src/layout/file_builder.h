@@ -10,6 +10,7 @@
 //
 #include <map>
 #include <vector>
+#include "file_id_registry.h"
 #include "io_trace.h"
 #include "pfs_types.h"
 #include "singleton.h"
@@ -107,16 +108,22 @@ private:
     /** Disabled assignment operator */
     FileBuilder& operator=(const FileBuilder& other);
 
+    /** @return the distribution shared by all files with numServers */
+    FileDistribution* getDistribution(int numServers);
+
     /** Size of metadata entries */
     std::size_t defaultMetaDataSize_;
 
     /** Next serer number to assign */
     std::size_t nextServerNumber_;
 
-    std::map<std::string, FSHandle> nameToHandleMap_;
+    std::map<FileId, FSHandle> nameToHandleMap_;
 
     std::map<FSHandle, FSMetaData*> handleToMetaMap_;
 
+    /** Distributions shared by files, keyed by number of data objects */
+    std::map<int, FileDistribution*> distributions_;
+
     std::vector<HandleRange> handlesByServer_;
 
     std::vector<int> metaServers_;
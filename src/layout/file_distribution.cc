@@ -24,6 +24,32 @@ FileDistribution::FileDistribution(const FileDistribution& other)
     assert(objectIdx_ < numObjects_);
 }
 
+FileDistribution::~FileDistribution()
+{
+    for (size_t i = 0; i < objectDists_.size(); i++)
+    {
+        delete objectDists_[i];
+    }
+}
+
+const FileDistribution* FileDistribution::getObjectDistribution(
+    size_t objectIdx) const
+{
+    assert(objectIdx < numObjects_);
+    if (objectDists_.empty())
+    {
+        objectDists_.resize(numObjects_, 0);
+    }
+
+    if (0 == objectDists_[objectIdx])
+    {
+        FileDistribution* objectDist = clone();
+        objectDist->setObjectIdx(objectIdx);
+        objectDists_[objectIdx] = objectDist;
+    }
+    return objectDists_[objectIdx];
+}
+
 FSOffset FileDistribution::logicalToPhysicalOffset(
     FSOffset logicalOffset) const
 {
@@ -9,6 +9,7 @@
 // for details on this and other legal matters.
 //
 #include <cstddef>
+#include <vector>
 #include "pfs_types.h"
 
 /**
@@ -26,7 +27,7 @@ public:
     FileDistribution(const FileDistribution& other);
 
     /** Destructor */
-    virtual ~FileDistribution() {};
+    virtual ~FileDistribution();
 
     /** @return a pointer to a correctly copied concrete FileDistribution */
     FileDistribution* clone() const { return doClone(); };
@@ -40,6 +41,13 @@ public:
     /** Set object index */
     void setObjectIdx(std::size_t objectIdx) { objectIdx_ = objectIdx; };
 
+    /**
+     * @return the distribution for objectIdx.  It is created on first use,
+     *   owned by this distribution, and shared by all requests to the data
+     *   object, so it must not be modified.
+     */
+    const FileDistribution* getObjectDistribution(std::size_t objectIdx) const;
+
     /** @return the physical offset for a logical offset */
     FSOffset logicalToPhysicalOffset(FSOffset logicalOffset) const;
 
@@ -63,8 +71,14 @@ protected:
     /** the total number of data objects */
     std::size_t numObjects_;
 
+    /** the shared distribution for each data object, created on first use */
+    mutable std::vector<FileDistribution*> objectDists_;
+
 private:
 
+    /** Hidden assignment operator */
+    FileDistribution& operator=(const FileDistribution& other);
+
     /** @return a pointer to a correctly copied derived FileDistribution */
     virtual FileDistribution* doClone() const = 0;
 
@@ -31,6 +31,9 @@ public:
     /** Destructor */
     virtual ~SimpleStripeDistribution() {};
 
+    /** @return the size of each contiguous strip */
+    FSSize getStripSize() const { return stripSize_; };
+
 private:
 
     /** @return a cloned copy of this SimpleStripeDistribution*/
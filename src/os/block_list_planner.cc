@@ -0,0 +1,97 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include "block_list_planner.h"
+#include <algorithm>
+#include <cassert>
+#include <set>
+using namespace std;
+
+BlockListPlanner::BlockListPlanner(const vector<FSBlock>& blocks)
+    : blocks_(blocks),
+      numRequested_(blocks.size()),
+      numRuns_(0)
+{
+    // Sort the blocks and remove duplicates
+    sort(blocks_.begin(), blocks_.end());
+    blocks_.erase(unique(blocks_.begin(), blocks_.end()), blocks_.end());
+
+    // Count the runs of consecutive blocks
+    for (size_t i = 0; i < blocks_.size(); i++)
+    {
+        if (0 == i || blocks_[i - 1] + 1 != blocks_[i])
+        {
+            numRuns_++;
+        }
+    }
+}
+
+double BlockListPlanner::getMergeRatio() const
+{
+    if (0 == numRuns_)
+    {
+        return 0.0;
+    }
+    return double(numRequested_) / double(numRuns_);
+}
+
+vector<FileRegion> BlockListPlanner::getPartialBlockRegions(
+    const vector<FileRegion>& regions, size_t blockSize)
+{
+    assert(0 < blockSize);
+    FSOffset bs = FSOffset(blockSize);
+
+    // Sort the regions so that overlapping and adjacent regions merge
+    vector<FileRegion> sorted(regions);
+    sort(sorted.begin(), sorted.end());
+
+    // A block is partial if an end of the region union falls within it
+    set<FSBlock> partialBlocks;
+    size_t i = 0;
+    while (i < sorted.size())
+    {
+        FSOffset begin = sorted[i].offset;
+        FSOffset end = begin + FSOffset(sorted[i].extent);
+        for (i++; i < sorted.size() && sorted[i].offset <= end; i++)
+        {
+            end = max(end, sorted[i].offset + FSOffset(sorted[i].extent));
+        }
+
+        if (begin < end)
+        {
+            if (0 != begin % bs)
+            {
+                partialBlocks.insert(begin / bs);
+            }
+            if (0 != end % bs)
+            {
+                partialBlocks.insert(end / bs);
+            }
+        }
+    }
+
+    vector<FileRegion> partialRegions;
+    partialRegions.reserve(partialBlocks.size());
+    set<FSBlock>::const_iterator iter;
+    for (iter = partialBlocks.begin(); iter != partialBlocks.end(); ++iter)
+    {
+        FileRegion fr = {*iter * bs, blockSize};
+        partialRegions.push_back(fr);
+    }
+    return partialRegions;
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
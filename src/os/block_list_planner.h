@@ -0,0 +1,71 @@
+#ifndef BLOCK_LIST_PLANNER_H
+#define BLOCK_LIST_PLANNER_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstddef>
+#include <vector>
+#include "basic_types.h"
+
+/**
+ * Plans the block list submitted for a list I/O request.  The blocks of
+ * all of the request's file regions are sorted and duplicate blocks are
+ * removed, so that each block is accessed once and the block translator
+ * can merge consecutive blocks into a single device request.
+ */
+class BlockListPlanner
+{
+public:
+    /**
+     * Constructor
+     *
+     * @param blocks the blocks of each file region in region order
+     */
+    explicit BlockListPlanner(const std::vector<FSBlock>& blocks);
+
+    /** @return the sorted and duplicate free blocks to submit */
+    const std::vector<FSBlock>& getBlocks() const { return blocks_; };
+
+    /** @return the number of blocks before planning */
+    std::size_t getNumRequestedBlocks() const { return numRequested_; };
+
+    /** @return the number of runs of consecutive blocks */
+    std::size_t getNumRuns() const { return numRuns_; };
+
+    /** @return the number of requested blocks per submitted run */
+    double getMergeRatio() const;
+
+    /**
+     * @return a block sized region for each file block partially covered
+     *   by the union of the file regions
+     */
+    static std::vector<FileRegion> getPartialBlockRegions(
+        const std::vector<FileRegion>& regions, std::size_t blockSize);
+
+private:
+    /** The planned blocks */
+    std::vector<FSBlock> blocks_;
+
+    /** The number of blocks before planning */
+    std::size_t numRequested_;
+
+    /** The number of runs of consecutive planned blocks */
+    std::size_t numRuns_;
+};
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -47,37 +47,49 @@ void BlockTranslator::handleMessage(cMessage *msg)
         assert(0 != blockRead || 0 != blockWrite);
         assert(0 != blockIO);
 
-        // Generate requests for each block
+        // Generate a device request for each run of consecutive blocks
         size_t numRequestsGenerated = 0;
         size_t numBlocks = blockIO->getBlocksArraySize();
-        for (size_t i = 0; i < numBlocks; i++)
+        size_t runBegin = 0;
+        while (runBegin < numBlocks)
         {
-            // Create multiple device requests for each block
-            vector<LogicalBlockAddress> lbas =
-                getAddresses(blockIO->getBlocks(i));
-            for (size_t j = 0; j < lbas.size(); j++)
+            // Determine the length of the consecutive block run
+            FSBlock firstBlock = blockIO->getBlocks(runBegin);
+            size_t runLength = 1;
+            while ((runBegin + runLength) < numBlocks &&
+                   blockIO->getBlocks(runBegin + runLength) ==
+                   FSBlock(firstBlock + runLength))
             {
-                spfsOSDeviceIORequest* req = 0;
-                if (0 != blockRead)
-                {
-                    req = new spfsOSReadDeviceRequest();
-                }
-                else
-                {
-                    assert(0 != blockWrite);
-                    spfsOSWriteDeviceRequest* writeDev =
-                        new spfsOSWriteDeviceRequest();
-                    writeDev->setWriteThrough(blockWrite->getWriteThrough());
-                    req = writeDev;
-                }
-                assert(0 != req);
-                req->setAddress(lbas[j]);
-                req->setContextPointer(msg);
-                send(req, "request");
+                runLength++;
             }
 
+            // Create a single device request for the run
+            size_t extent = 0;
+            LogicalBlockAddress lba =
+                getAddressExtent(firstBlock, runLength, extent);
+            spfsOSDeviceIORequest* req = 0;
+            if (0 != blockRead)
+            {
+                req =
+                    new spfsOSReadDeviceRequest(0, SPFS_OS_READ_DEVICE_REQUEST);
+            }
+            else
+            {
+                assert(0 != blockWrite);
+                spfsOSWriteDeviceRequest* writeDev =
+                    new spfsOSWriteDeviceRequest(0, SPFS_OS_WRITE_DEVICE_REQUEST);
+                writeDev->setWriteThrough(blockWrite->getWriteThrough());
+                req = writeDev;
+            }
+            assert(0 != req);
+            req->setAddress(lba);
+            req->setExtent(extent);
+            req->setContextPointer(msg);
+            send(req, "request");
+
             // Track the number of requests generated
-            numRequestsGenerated += lbas.size();
+            numRequestsGenerated++;
+            runBegin += runLength;
         }
 
         // Update the originating request with the number of requests created
@@ -100,7 +112,8 @@ void BlockTranslator::handleMessage(cMessage *msg)
         if (1 == numRemainingResponses)
         {
             // Construct the correct response type
-            spfsOSReadBlocksResponse* resp = new spfsOSReadBlocksResponse();
+            spfsOSReadBlocksResponse* resp =
+                new spfsOSReadBlocksResponse(0, SPFS_OS_READ_BLOCKS_RESPONSE);
             resp->setContextPointer(ioRequest);
             send(resp, "out");
         }
@@ -126,11 +139,12 @@ NoTranslation::NoTranslation()
 {
 }
 
-vector<LogicalBlockAddress> NoTranslation::getAddresses(FSBlock block) const
+LogicalBlockAddress NoTranslation::getAddressExtent(FSBlock block,
+                                                    size_t numBlocks,
+                                                    size_t& outExtent) const
 {
-    vector<LogicalBlockAddress> lba(1);
-    lba.push_back(block);
-    return lba;
+    outExtent = numBlocks;
+    return block;
 }
 
 //=============================================================================
@@ -150,18 +164,13 @@ void BasicTranslator::initializeTranslator()
     addrsPerBlock_ = 4096 / 512;
 }
 
-vector<LogicalBlockAddress> BasicTranslator::getAddresses(FSBlock block) const
+LogicalBlockAddress BasicTranslator::getAddressExtent(FSBlock block,
+                                                      size_t numBlocks,
+                                                      size_t& outExtent) const
 {
-    // Find the first address for this block
-    LogicalBlockAddress begAddr = block * addrsPerBlock_;
-
-    // Construct all the addresses for this block
-    vector<LogicalBlockAddress> addresses;
-    for (int i = 0; i < addrsPerBlock_; i++)
-    {
-        addresses.push_back(begAddr + i);
-    }
-    return addresses;
+    // Each file system block spans addrsPerBlock_ consecutive addresses
+    outExtent = numBlocks * addrsPerBlock_;
+    return block * addrsPerBlock_;
 }
 
 /*
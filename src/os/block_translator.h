@@ -8,7 +8,7 @@
 // This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
 // for details on this and other legal matters.
 //
-#include <vector>
+#include <cstddef>
 #include <omnetpp.h>
 #include "basic_types.h"
 
@@ -17,6 +17,9 @@
  * translator is responsible for translating the File System blocks (which
  * are not required to be sized similarly to disk geometry) into disk
  * hardware addresses (which for a hard drive will be sector numbers).
+ *
+ * Runs of consecutive file system blocks are coalesced so that a single
+ * device request is issued for each contiguous extent of hardware addresses.
  */
 class BlockTranslator : public cSimpleModule
 {
@@ -46,10 +49,13 @@ protected:
     virtual void initializeTranslator() = 0;
 
     /**
-     * @return a hardware address for the give file system block
+     * @return the first hardware address for the numBlocks contiguous file
+     *   system blocks beginning at block
+     * @side sets outExtent to the number of hardware addresses spanned
      */
-    virtual std::vector<LogicalBlockAddress> getAddresses(
-        FSBlock blocks) const = 0;
+    virtual LogicalBlockAddress getAddressExtent(FSBlock block,
+                                                 std::size_t numBlocks,
+                                                 std::size_t& outExtent) const = 0;
 
 private:
 
@@ -71,10 +77,13 @@ protected:
     virtual void initializeTranslator() {};
 
     /**
-     * @return a hardware address for the give file system block
+     * @return the first hardware address for the numBlocks contiguous file
+     *   system blocks beginning at block
+     * @side sets outExtent to the number of hardware addresses spanned
      */
-    virtual std::vector<LogicalBlockAddress> getAddresses(
-        FSBlock block) const;
+    virtual LogicalBlockAddress getAddressExtent(FSBlock block,
+                                                 std::size_t numBlocks,
+                                                 std::size_t& outExtent) const;
 };
 
 /**
@@ -93,10 +102,13 @@ protected:
     virtual void initializeTranslator();
 
     /**
-     * @return a hardware address for the give file system block
+     * @return the first hardware address for the numBlocks contiguous file
+     *   system blocks beginning at block
+     * @side sets outExtent to the number of hardware addresses spanned
      */
-    virtual std::vector<LogicalBlockAddress> getAddresses(
-        FSBlock block) const;
+    virtual LogicalBlockAddress getAddressExtent(FSBlock block,
+                                                 std::size_t numBlocks,
+                                                 std::size_t& outExtent) const;
 
 private:
 
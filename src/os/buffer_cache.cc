@@ -6,8 +6,11 @@
 // This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
 // for details on this and other legal matters.
 //
+#include <algorithm>
+#include <cassert>
 #include <stdexcept>
 #include "buffer_cache.h"
+#include "message_kind.h"
 #include "os_proto_m.h"
 using namespace std;
 
@@ -122,77 +125,224 @@ void NoBufferCache::handleBlockResponse(cMessage* blockResponse)
 Define_Module(LRUBufferCache)
 
 LRUBufferCache::LRUBufferCache()
-    : cache_(0)
+    : writebackTimer_(0),
+      dirtyBlocksVector_("SPFS Buffer Cache Dirty Blocks"),
+      stallDelayVector_("SPFS Buffer Cache Write Stall Delay"),
+      cache_(0)
 {
 }
 
 void LRUBufferCache::initializeCache()
 {
     dirtyThreshold_ = par("dirtyThreshold");
+    dirtyBackgroundThreshold_ = par("dirtyBackgroundThreshold");
+    dirtyExpireTime_ = par("dirtyExpireSecs").doubleValue();
+    writebackInterval_ = par("writebackIntervalSecs").doubleValue();
+    maxThrottleDelay_ = par("maxThrottleDelaySecs").doubleValue();
+    assert(dirtyBackgroundThreshold_ <= dirtyThreshold_);
+    assert(0.0 < writebackInterval_.dbl());
 
     long numEntries = par("numEntries");
-    cache_ = new LRUCache<LogicalBlockAddress, char>(numEntries);
+    string policy = par("replacementPolicy").stringValue();
+    cache_ = new ReplacementCache<LogicalBlockAddress, char>(numEntries,
+                                                             policy);
+
+    minReadaheadBlocks_ = par("minReadaheadBlocks");
+    maxReadaheadBlocks_ = par("maxReadaheadBlocks");
+    long maxReadaheadStreams = par("maxReadaheadStreams");
+    maxReadaheadStreams_ = maxReadaheadStreams;
+    assert(0 < minReadaheadBlocks_);
+    assert(0 <= maxReadaheadBlocks_);
+    statNumReadaheadBlocks_ = 0;
+    statNumReadaheadHits_ = 0;
+    statNumReadaheadWaste_ = 0;
+    statNumReadaheadEvictions_ = 0;
+
+    writebackTimer_ = new cMessage("Buffer Cache Writeback");
+    writebackCursor_ = 0;
+    numWritebackBlocks_ = 0;
+    writebackBegin_ = 0.0;
+    statNumBlocksFlushed_ = 0;
+    statNumStalls_ = 0;
+    statWritebackTime_ = 0.0;
+    statStallTime_ = 0.0;
 }
 
 void LRUBufferCache::finalizeCache()
 {
+    // Record write back statistics
+    double flushThroughput = 0.0;
+    if (0.0 < statWritebackTime_.dbl())
+    {
+        flushThroughput = statNumBlocksFlushed_ / statWritebackTime_.dbl();
+    }
+    recordScalar("SPFS Buffer Cache Blocks Flushed", statNumBlocksFlushed_);
+    recordScalar("SPFS Buffer Cache Flush Throughput", flushThroughput);
+    recordScalar("SPFS Buffer Cache Write Stalls", statNumStalls_);
+    recordScalar("SPFS Buffer Cache Write Stall Time", statStallTime_);
+    recordScalar("SPFS Buffer Cache Final Dirty Blocks", dirtyBlocks_.size());
+
+    // Record readahead statistics, counting unreferenced blocks as waste
+    double numUnused = readaheadBlocks_.size() + readaheadInFlight_.size();
+    recordScalar("SPFS Buffer Cache Readahead Blocks", statNumReadaheadBlocks_);
+    recordScalar("SPFS Buffer Cache Readahead Hits", statNumReadaheadHits_);
+    recordScalar("SPFS Buffer Cache Readahead Waste",
+                 statNumReadaheadWaste_ + numUnused);
+    recordScalar("SPFS Buffer Cache Readahead Evictions",
+                 statNumReadaheadEvictions_);
+
+    // Record replacement policy statistics
+    recordScalar("SPFS Buffer Cache Ghost Hits", cache_->getNumGhostHits());
+    recordScalar("SPFS Buffer Cache Ghost Entries",
+                 cache_->getNumGhostEntries());
+
+    cancelAndDelete(writebackTimer_);
+    writebackTimer_ = 0;
+
     assert(0 != cache_);
     delete cache_;
 }
 
+void LRUBufferCache::handleMessage(cMessage* msg)
+{
+    if (msg == writebackTimer_)
+    {
+        flushDirtyBlocks();
+        scheduleWriteback();
+    }
+    else
+    {
+        BufferCache::handleMessage(msg);
+    }
+}
+
 void LRUBufferCache::handleBlockRequest(cMessage* msg)
 {
-    if (spfsOSReadDeviceRequest* read =
-        dynamic_cast<spfsOSReadDeviceRequest*>(msg))
+    if (SPFS_OS_READ_DEVICE_REQUEST == msg->getKind())
     {
-        LogicalBlockAddress readLBA = read->getAddress();
-        if (isCached(readLBA))
+        spfsOSReadDeviceRequest* read =
+            kind_cast<spfsOSReadDeviceRequest>(msg);
+        LogicalBlockAddress firstLBA = read->getAddress();
+        long extent = read->getExtent();
+        assert(0 < extent);
+
+        // Determine the blocks to read ahead for this stream
+        LogicalBlockAddress readaheadBegin = 0;
+        long readaheadLength = 0;
+        updateReadahead(firstLBA, extent, readaheadBegin, readaheadLength);
+
+        // Examine each block in the extent, issuing a single device read
+        // for each contiguous run of blocks that is neither cached nor
+        // already pending
+        long numRemainingBlocks = 0;
+        LogicalBlockAddress missBegin = firstLBA;
+        long missLength = 0;
+        for (long i = 0; i < extent; i++)
         {
-            // Update statistics
-            registerHit();
-
-            // Create and send response
-            spfsOSReadDeviceResponse* resp = new spfsOSReadDeviceResponse();
-            resp->setContextPointer(msg);
-            send(resp, outGateId_);
+            LogicalBlockAddress lba = firstLBA + i;
+            if (isCached(lba))
+            {
+                // Update statistics
+                registerHit();
+                if (0 != readaheadBlocks_.erase(lba))
+                {
+                    statNumReadaheadHits_++;
+                }
+            }
+            else
+            {
+                if (isPending(lba))
+                {
+                    if (0 != readaheadInFlight_.erase(lba))
+                    {
+                        statNumReadaheadHits_++;
+                    }
+                    addPending(lba, msg);
+                }
+                else
+                {
+                    // Update statistics
+                    registerMiss();
+
+                    // Add to pending list and extend the current miss run
+                    addPending(lba, msg);
+                    if (0 == missLength)
+                    {
+                        missBegin = lba;
+                    }
+                    missLength++;
+                    continue;
+                }
+                numRemainingBlocks++;
+            }
+
+            // The current miss run (if any) has ended
+            if (0 != missLength)
+            {
+                numRemainingBlocks += missLength;
+                sendDeviceRead(missBegin, missLength);
+                missLength = 0;
+            }
         }
-        else if (isPending(readLBA))
+
+        // Issue the trailing miss run along with any readahead
+        numRemainingBlocks += missLength;
+        if (0 != readaheadLength)
         {
-            addPending(readLBA, msg);
+            issueReadahead(readaheadBegin, readaheadLength,
+                           missBegin, missLength);
         }
-        else
+        else if (0 != missLength)
         {
-            // Update statistics
-            registerMiss();
-
-            // Add to pending list
-            addPending(readLBA, msg);
+            sendDeviceRead(missBegin, missLength);
+        }
 
-            // Forward request to next module
-            send(msg, "request");
+        // Respond immediately if every block was cached, otherwise wait
+        // for the pending blocks to arrive
+        read->setNumRemainingBlocks(numRemainingBlocks);
+        if (0 == numRemainingBlocks)
+        {
+            // Create and send response
+            spfsOSReadDeviceResponse* resp =
+                new spfsOSReadDeviceResponse(0, SPFS_OS_READ_DEVICE_RESPONSE);
+            resp->setContextPointer(msg);
+            send(resp, outGateId_);
         }
     }
-    else if (spfsOSWriteDeviceRequest* write =
-             dynamic_cast<spfsOSWriteDeviceRequest*>(msg))
+    else if (SPFS_OS_WRITE_DEVICE_REQUEST == msg->getKind())
     {
-        // If the cache has too many dirty entries, switch to write-through
-        if (cache_->percentDirty() > dirtyThreshold_)
+        spfsOSWriteDeviceRequest* write =
+            kind_cast<spfsOSWriteDeviceRequest>(msg);
+        // Retrieve the write through status
+        bool isWriteThrough = write->getWriteThrough();
+        if (isWriteThrough)
         {
             registerWriteThrough();
-            write->setWriteThrough(true);
         }
 
-        // Retrieve the write through status
-        bool isWriteThrough = write->getWriteThrough();
-
-        // Perform cache eviction if needed
-        evictCacheEntry(write->getAddress());
-
-        // Add an entry to the cache with dirty status determined by write
-        // through status
-        LogicalBlockAddress writeLBA = write->getAddress();
+        // Add an entry to the cache for each block with dirty status
+        // determined by write through status, collecting any dirty evictions
+        LogicalBlockAddress firstLBA = write->getAddress();
+        long extent = write->getExtent();
         bool isDirty = !isWriteThrough;
-        cache_->insert(writeLBA, 0, isDirty);
+        vector<LogicalBlockAddress> dirtyEvictions;
+        for (long i = 0; i < extent; i++)
+        {
+            LogicalBlockAddress writeLBA = firstLBA + i;
+            insertBlock(writeLBA, isDirty, dirtyEvictions);
+            readaheadBlocks_.erase(writeLBA);
+            if (isDirty)
+            {
+                markDirty(writeLBA);
+            }
+            else
+            {
+                dirtyBlocks_.erase(writeLBA);
+            }
+        }
+
+        // Write back the evicted dirty blocks
+        writeBackBlocks(dirtyEvictions);
 
         // Perform write though if necessary
         if (isWriteThrough)
@@ -202,11 +352,32 @@ void LRUBufferCache::handleBlockRequest(cMessage* msg)
         }
         else
         {
-            // Create and send response
-            spfsOSWriteDeviceResponse* resp = new spfsOSWriteDeviceResponse();
+            // Create and send response, delaying the writer if too much of
+            // the cache is dirty
+            spfsOSWriteDeviceResponse* resp =
+                new spfsOSWriteDeviceResponse(0, SPFS_OS_WRITE_DEVICE_RESPONSE);
             resp->setContextPointer(msg);
-            send(resp, "out");
+            simtime_t throttleDelay = getThrottleDelay();
+            if (0.0 < throttleDelay.dbl())
+            {
+                statNumStalls_++;
+                statStallTime_ += throttleDelay;
+                stallDelayVector_.record(throttleDelay);
+                sendDelayed(resp, throttleDelay, "out");
+            }
+            else
+            {
+                send(resp, "out");
+            }
+
+            // Begin background write back once above the background ratio
+            if (dirtyRatio() >= dirtyBackgroundThreshold_)
+            {
+                flushDirtyBlocks();
+            }
+            scheduleWriteback();
         }
+        dirtyBlocksVector_.record(dirtyBlocks_.size());
     }
     else
     {
@@ -218,34 +389,54 @@ void LRUBufferCache::handleBlockResponse(cMessage* msg)
 {
     // Add data read from the disk to the cache
     cMessage* req = static_cast<cMessage*>(msg->getContextPointer());
-    if (spfsOSReadDeviceRequest* read =
-        dynamic_cast<spfsOSReadDeviceRequest*>(req))
+    if (SPFS_OS_READ_DEVICE_REQUEST == req->getKind())
     {
-        LogicalBlockAddress lba = read->getAddress();
-
-        // If a cache entry does not exist for this block, then no later
-        // write has arrived and the returned value is valid to cache
-        if (!isCached(lba))
+        spfsOSReadDeviceRequest* read =
+            kind_cast<spfsOSReadDeviceRequest>(req);
+        LogicalBlockAddress firstLBA = read->getAddress();
+        long extent = read->getExtent();
+        vector<LogicalBlockAddress> dirtyEvictions;
+        for (long i = 0; i < extent; i++)
         {
-            // Perform cache eviction if needed
-            evictCacheEntry(lba);
-
-            // Add block to cache
-            cache_->insert(lba, 0, false);
+            // If a cache entry does not exist for this block, then no later
+            // write has arrived and the returned value is valid to cache
+            LogicalBlockAddress lba = firstLBA + i;
+            bool isReadahead = (0 != readaheadInFlight_.erase(lba));
+            if (!cache_->exists(lba))
+            {
+                // Add block to cache, performing an eviction if needed
+                if (isReadahead && isFull())
+                {
+                    statNumReadaheadEvictions_++;
+                }
+                insertBlock(lba, false, dirtyEvictions);
+                if (isReadahead)
+                {
+                    readaheadBlocks_.insert(lba);
+                }
+            }
+
+            // Forward completed responses up the chain
+            satisfyPending(lba);
         }
 
-        // Forward completed response up the chain
-        satisfyPending(lba);
+        // Write back the evicted dirty blocks
+        writeBackBlocks(dirtyEvictions);
+
+        // Device reads are always generated by the cache
+        delete req;
         delete msg;
     }
-    else if (spfsOSWriteDeviceRequest* write =
-             dynamic_cast<spfsOSWriteDeviceRequest*>(req))
+    else if (SPFS_OS_WRITE_DEVICE_REQUEST == req->getKind())
     {
+        spfsOSWriteDeviceRequest* write =
+            kind_cast<spfsOSWriteDeviceRequest>(req);
         bool isWriteThrough = write->getWriteThrough();
         if (isWriteThrough)
         {
             // Create and send response for write through request
-            spfsOSWriteDeviceResponse* resp = new spfsOSWriteDeviceResponse();
+            spfsOSWriteDeviceResponse* resp =
+                new spfsOSWriteDeviceResponse(0, SPFS_OS_WRITE_DEVICE_RESPONSE);
             resp->setContextPointer(req);
             send(resp, "out");
             delete msg;
@@ -253,6 +444,7 @@ void LRUBufferCache::handleBlockResponse(cMessage* msg)
         else
         {
             // Discard dirty block write back request and response
+            completeWriteback(write->getExtent());
             delete req;
             delete msg;
         }
@@ -260,48 +452,179 @@ void LRUBufferCache::handleBlockResponse(cMessage* msg)
 
 }
 
-void LRUBufferCache::evictCacheEntry(LogicalBlockAddress lba)
+void LRUBufferCache::sendDeviceRead(LogicalBlockAddress lba, long extent)
 {
-    if (isFull() && !isCached(lba))
+    spfsOSReadDeviceRequest* read =
+        new spfsOSReadDeviceRequest(0, SPFS_OS_READ_DEVICE_REQUEST);
+    read->setAddress(lba);
+    read->setExtent(extent);
+    send(read, "request");
+}
+
+void LRUBufferCache::insertBlock(LogicalBlockAddress lba,
+                                 bool isDirty,
+                                 vector<LogicalBlockAddress>& outDirty)
+{
+    LogicalBlockAddress evictedLBA = 0;
+    char evictedValue = 0;
+    bool isEvictedDirty = false;
+    if (cache_->insertAndRecall(lba, 0, isDirty,
+                                evictedLBA, evictedValue, isEvictedDirty))
     {
-        Entry evictee = getNextEviction();
-        if (evictee.isDirty)
+        if (0 != readaheadBlocks_.erase(evictedLBA))
         {
-            spfsOSWriteDeviceRequest* write = new spfsOSWriteDeviceRequest();
-            write->setAddress(evictee.lba);
-            send(write, "request");
+            statNumReadaheadWaste_++;
+        }
+        if (isEvictedDirty)
+        {
+            outDirty.push_back(evictedLBA);
+            dirtyBlocks_.erase(evictedLBA);
         }
     }
 }
 
-bool LRUBufferCache::isCached(LogicalBlockAddress address)
+void LRUBufferCache::writeBackBlocks(vector<LogicalBlockAddress>& blocks)
 {
-    if (cache_->exists(address))
+    // Track the time spent writing back
+    if (0 == numWritebackBlocks_ && !blocks.empty())
     {
-        // Use lookup to refresh the LRU ordering for this entry
-        cache_->lookup(address);
-        return true;
+        writebackBegin_ = simTime();
     }
-    else
+    numWritebackBlocks_ += blocks.size();
+
+    // Coalesce the dirty blocks into contiguous extents
+    sort(blocks.begin(), blocks.end());
+    size_t runBegin = 0;
+    while (runBegin < blocks.size())
     {
-        return false;
+        size_t runLength = 1;
+        while ((runBegin + runLength) < blocks.size() &&
+               blocks[runBegin + runLength] ==
+               LogicalBlockAddress(blocks[runBegin] + runLength))
+        {
+            runLength++;
+        }
+
+        spfsOSWriteDeviceRequest* write =
+            new spfsOSWriteDeviceRequest(0, SPFS_OS_WRITE_DEVICE_REQUEST);
+        write->setAddress(blocks[runBegin]);
+        write->setExtent(runLength);
+        send(write, "request");
+        runBegin += runLength;
     }
 }
 
-bool LRUBufferCache::isFull()
+void LRUBufferCache::markDirty(LogicalBlockAddress lba)
 {
-    return (cache_->capacity() == cache_->size());
+    // Retain the original dirty time so rewrites do not defer write back
+    dirtyBlocks_.insert(make_pair(lba, simTime()));
+}
+
+double LRUBufferCache::dirtyRatio() const
+{
+    return double(dirtyBlocks_.size() + numWritebackBlocks_) /
+        double(cache_->capacity());
+}
+
+simtime_t LRUBufferCache::getThrottleDelay() const
+{
+    // Writers run freely until halfway between the background and dirty
+    // thresholds, and are then delayed in proportion to the dirty ratio
+    double ratio = dirtyRatio();
+    double freeRunThreshold =
+        (dirtyBackgroundThreshold_ + dirtyThreshold_) / 2.0;
+    if (ratio < freeRunThreshold)
+    {
+        return 0.0;
+    }
+    else if (ratio >= dirtyThreshold_)
+    {
+        return maxThrottleDelay_;
+    }
+    double position =
+        (ratio - freeRunThreshold) / (dirtyThreshold_ - freeRunThreshold);
+    return maxThrottleDelay_ * position;
 }
 
-LRUBufferCache::Entry LRUBufferCache::getNextEviction()
+void LRUBufferCache::flushDirtyBlocks()
 {
-    // Retrieve the LRU item to be evicted
-    pair<LogicalBlockAddress,char> lruEntry = cache_->getLRU();
+    // Collect the expired dirty blocks
+    vector<LogicalBlockAddress> blocks;
+    simtime_t expireTime = simTime() - dirtyExpireTime_;
+    map<LogicalBlockAddress, simtime_t>::iterator iter;
+    for (iter = dirtyBlocks_.begin(); iter != dirtyBlocks_.end(); iter++)
+    {
+        if (iter->second <= expireTime)
+        {
+            blocks.push_back(iter->first);
+        }
+    }
 
-    Entry evictee;
-    evictee.lba = lruEntry.first;
-    evictee.isDirty = cache_->getDirtyBit(evictee.lba);
-    return evictee;
+    // Collect additional unexpired blocks in LBA order, continuing from
+    // the previous background write back, until the background
+    // threshold will be met
+    long backgroundBlocks =
+        long(dirtyBackgroundThreshold_ * cache_->capacity());
+    long numExcess = long(dirtyBlocks_.size() + numWritebackBlocks_) -
+        long(blocks.size()) - backgroundBlocks;
+    if (0 < numExcess)
+    {
+        iter = dirtyBlocks_.lower_bound(writebackCursor_);
+        size_t numDirty = dirtyBlocks_.size();
+        for (size_t i = 0; i < numDirty && 0 < numExcess; i++, iter++)
+        {
+            if (iter == dirtyBlocks_.end())
+            {
+                iter = dirtyBlocks_.begin();
+            }
+
+            if (iter->second > expireTime)
+            {
+                blocks.push_back(iter->first);
+                writebackCursor_ = iter->first + 1;
+                numExcess--;
+            }
+        }
+    }
+
+    // Clean the blocks and write them back
+    for (size_t i = 0; i < blocks.size(); i++)
+    {
+        cache_->setDirtyBit(blocks[i], false);
+        dirtyBlocks_.erase(blocks[i]);
+    }
+    writeBackBlocks(blocks);
+    dirtyBlocksVector_.record(dirtyBlocks_.size());
+}
+
+void LRUBufferCache::scheduleWriteback()
+{
+    if (!dirtyBlocks_.empty() && !writebackTimer_->isScheduled())
+    {
+        scheduleAt(simTime() + writebackInterval_, writebackTimer_);
+    }
+}
+
+void LRUBufferCache::completeWriteback(long extent)
+{
+    assert(extent <= numWritebackBlocks_);
+    numWritebackBlocks_ -= extent;
+    statNumBlocksFlushed_ += extent;
+    if (0 == numWritebackBlocks_)
+    {
+        statWritebackTime_ += simTime() - writebackBegin_;
+    }
+}
+
+bool LRUBufferCache::isCached(LogicalBlockAddress address)
+{
+    // Use find to register a reference with the replacement policy
+    return (0 != cache_->find(address));
+}
+
+bool LRUBufferCache::isFull()
+{
+    return (cache_->capacity() == cache_->size());
 }
 
 void LRUBufferCache::addPending(LogicalBlockAddress lba, cMessage* msg)
@@ -313,7 +636,7 @@ bool LRUBufferCache::isPending(LogicalBlockAddress lba)
 {
     bool isPending = false;
     PendingRequestMap::const_iterator iter = pendingRequests_.find(lba);
-    if (pendingRequests_.end() != iter)
+    if (pendingRequests_.end() != iter || 0 != readaheadInFlight_.count(lba))
     {
         isPending = true;
     }
@@ -328,18 +651,177 @@ void LRUBufferCache::satisfyPending(LogicalBlockAddress lba)
     while (range.first != range.second)
     {
         PendingRequestMap::iterator ele = range.first++;
-        cMessage* request = ele->second;
+        spfsOSReadDeviceRequest* request =
+            static_cast<spfsOSReadDeviceRequest*>(ele->second);
 
-        // Create and send response
-        spfsOSReadDeviceResponse* resp = new spfsOSReadDeviceResponse();
-        resp->setContextPointer(request);
-        send(resp, outGateId_);
+        // Create and send response if this was the last block outstanding
+        long numRemainingBlocks = request->getNumRemainingBlocks() - 1;
+        request->setNumRemainingBlocks(numRemainingBlocks);
+        if (0 == numRemainingBlocks)
+        {
+            spfsOSReadDeviceResponse* resp =
+                new spfsOSReadDeviceResponse(0, SPFS_OS_READ_DEVICE_RESPONSE);
+            resp->setContextPointer(request);
+            send(resp, outGateId_);
+        }
 
         // Delete the element
         pendingRequests_.erase(ele);
     }
 }
 
+void LRUBufferCache::updateReadahead(LogicalBlockAddress lba,
+                                     long extent,
+                                     LogicalBlockAddress& outBegin,
+                                     long& outLength)
+{
+    outLength = 0;
+    if (0 == maxReadaheadBlocks_)
+    {
+        return;
+    }
+
+    // Locate the stream this read belongs to, preferring a stream whose
+    // readahead marker lies in the read
+    LogicalBlockAddress end = lba + extent;
+    list<ReadaheadStream>::iterator stream = readaheadStreams_.end();
+    bool isMarkerHit = false;
+    list<ReadaheadStream>::iterator iter;
+    for (iter = readaheadStreams_.begin();
+         iter != readaheadStreams_.end();
+         iter++)
+    {
+        LogicalBlockAddress marker = iter->start + iter->size - iter->asyncSize;
+        if (0 != iter->size && lba <= marker && marker < end)
+        {
+            stream = iter;
+            isMarkerHit = true;
+            break;
+        }
+        else if (iter->nextLBA == lba && stream == readaheadStreams_.end())
+        {
+            stream = iter;
+        }
+    }
+
+    if (isMarkerHit)
+    {
+        // Asynchronously read the next, larger window
+        stream->start += stream->size;
+        stream->size = getNextReadaheadSize(stream->size);
+        stream->asyncSize = stream->size;
+        outBegin = stream->start;
+        outLength = stream->size;
+    }
+    else if (stream != readaheadStreams_.end())
+    {
+        // A sequential read outside the current window starts a new window
+        // containing the read, and reads the remainder of the window ahead
+        if (lba >= LogicalBlockAddress(stream->start + stream->size))
+        {
+            stream->start = lba;
+            stream->size = max(getInitReadaheadSize(extent), extent);
+            stream->asyncSize = stream->size - extent;
+            outBegin = end;
+            outLength = stream->asyncSize;
+        }
+    }
+    else
+    {
+        // Begin tracking a new stream, replacing the least recent stream
+        ReadaheadStream newStream;
+        newStream.start = lba;
+        newStream.size = 0;
+        newStream.asyncSize = 0;
+        readaheadStreams_.push_front(newStream);
+        stream = readaheadStreams_.begin();
+        if (readaheadStreams_.size() > maxReadaheadStreams_)
+        {
+            readaheadStreams_.pop_back();
+        }
+    }
+
+    // Record the stream position and move it to the front
+    stream->nextLBA = end;
+    readaheadStreams_.splice(readaheadStreams_.begin(),
+                             readaheadStreams_,
+                             stream);
+}
+
+void LRUBufferCache::issueReadahead(LogicalBlockAddress begin,
+                                    long length,
+                                    LogicalBlockAddress missBegin,
+                                    long missLength)
+{
+    // The miss run is only extended if it ends where the window begins
+    if (0 != missLength && LogicalBlockAddress(missBegin + missLength) != begin)
+    {
+        sendDeviceRead(missBegin, missLength);
+        missLength = 0;
+    }
+
+    // Read each run of uncached blocks in the window
+    for (long i = 0; i < length; i++)
+    {
+        LogicalBlockAddress lba = begin + i;
+        if (!cache_->exists(lba) && !isPending(lba))
+        {
+            readaheadInFlight_.insert(lba);
+            statNumReadaheadBlocks_++;
+            if (0 == missLength)
+            {
+                missBegin = lba;
+            }
+            missLength++;
+        }
+        else if (0 != missLength)
+        {
+            sendDeviceRead(missBegin, missLength);
+            missLength = 0;
+        }
+    }
+
+    if (0 != missLength)
+    {
+        sendDeviceRead(missBegin, missLength);
+    }
+}
+
+long LRUBufferCache::getInitReadaheadSize(long requestSize) const
+{
+    // Round the request up to a power of two, and then scale it up more
+    // for small requests
+    long size = 1;
+    while (size < requestSize)
+    {
+        size *= 2;
+    }
+
+    if (size <= maxReadaheadBlocks_ / 32)
+    {
+        size *= 4;
+    }
+    else if (size <= maxReadaheadBlocks_ / 4)
+    {
+        size *= 2;
+    }
+    else
+    {
+        size = maxReadaheadBlocks_;
+    }
+    return min(max(size, minReadaheadBlocks_), maxReadaheadBlocks_);
+}
+
+long LRUBufferCache::getNextReadaheadSize(long currentSize) const
+{
+    long size = 2 * currentSize;
+    if (currentSize < maxReadaheadBlocks_ / 16)
+    {
+        size = 4 * currentSize;
+    }
+    return min(max(size, minReadaheadBlocks_), maxReadaheadBlocks_);
+}
+
 /*
  * Local variables:
  *  c-indent-level: 4
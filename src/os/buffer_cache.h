@@ -8,10 +8,13 @@
 // This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
 // for details on this and other legal matters.
 //
+#include <list>
 #include <map>
+#include <set>
+#include <vector>
 #include <omnetpp.h>
 #include "basic_types.h"
-#include "lru_cache.h"
+#include "replacement_cache.h"
 
 /**
  * Abstract base class for OS Buffer Cache Managers
@@ -124,7 +127,20 @@ private:
 };
 
 /**
- * Least Recently Used Cache Manager
+ * Block Cache Manager using the replacement policy named by the
+ * replacementPolicy parameter (LRU, ARC, 2Q or CLOCK-Pro)
+ *
+ * Dirty blocks are written back in LBA order by a periodic flusher once
+ * they are older than the expire time, or once the fraction of dirty and
+ * in flight blocks exceeds the background threshold.  Writers are
+ * progressively delayed as the dirty fraction moves from halfway between
+ * the background threshold and the dirty threshold up to the dirty
+ * threshold, similar to Linux writeback throttling.
+ *
+ * Sequential read streams are detected per LBA run and read ahead using
+ * the Linux on-demand readahead algorithm: a stream's first sequential
+ * miss starts a window sized from the request, and touching the window's
+ * marker block asynchronously reads the next, larger window.
  */
 class LRUBufferCache : public BufferCache
 {
@@ -135,21 +151,15 @@ public:
     LRUBufferCache();
 
 protected:
-    /**
-     *
-     */
-    struct Entry
-    {
-        LogicalBlockAddress lba;
-        bool isDirty;
-    };
-
     /** Initialize this cache */
     virtual void initializeCache();
 
     /** Finalize this cache */
     virtual void finalizeCache();
 
+    /** Handle the write back timer, and forward other messages */
+    virtual void handleMessage(cMessage* msg);
+
     /**
      */
     virtual bool isCached(LogicalBlockAddress address);
@@ -157,12 +167,25 @@ protected:
     /** @return true if the cache is full */
     virtual bool isFull();
 
-    /** @return the least recently used entry */
-    virtual Entry getNextEviction();
-
 private:
     typedef std::multimap<LogicalBlockAddress, cMessage*> PendingRequestMap;
 
+    /** Readahead state for a sequential stream of block reads */
+    struct ReadaheadStream
+    {
+        /** The first block of the current readahead window */
+        LogicalBlockAddress start;
+
+        /** The number of blocks in the current readahead window */
+        long size;
+
+        /** The number of blocks at the window's end read asynchronously */
+        long asyncSize;
+
+        /** The block following the stream's most recent read */
+        LogicalBlockAddress nextLBA;
+    };
+
     /** Handle caching for incoming block requests from the file system */
     virtual void handleBlockRequest(cMessage* msg);
 
@@ -176,18 +199,136 @@ private:
     void satisfyPending(LogicalBlockAddress lba);
 
     /**
-     * Evict a cache entry if the cache is full and write the block to disk
-     * if it is marked dirty
+     * Update the stream state for a read of extent blocks at lba
+     *
+     * @side set outBegin and outLength to the blocks to read ahead, with
+     *   outLength set to 0 if no readahead is needed
+     */
+    void updateReadahead(LogicalBlockAddress lba,
+                         long extent,
+                         LogicalBlockAddress& outBegin,
+                         long& outLength);
+
+    /**
+     * Read the uncached blocks of the readahead window, merging the
+     * window with the miss run that ends where the window begins
      */
-    void evictCacheEntry(LogicalBlockAddress lba);
+    void issueReadahead(LogicalBlockAddress begin,
+                        long length,
+                        LogicalBlockAddress missBegin,
+                        long missLength);
+
+    /** @return the initial readahead window size for a request */
+    long getInitReadaheadSize(long requestSize) const;
+
+    /** @return the readahead window size following a window */
+    long getNextReadaheadSize(long currentSize) const;
+
+    /** Send a device read for the extent of blocks beginning at lba */
+    void sendDeviceRead(LogicalBlockAddress lba, long extent);
+
+    /**
+     * Add a block to the cache and add the block evicted by the
+     * replacement policy to outDirty if it is marked dirty
+     */
+    void insertBlock(LogicalBlockAddress lba,
+                     bool isDirty,
+                     std::vector<LogicalBlockAddress>& outDirty);
+
+    /**
+     * Write the dirty blocks to disk, coalescing contiguous blocks into
+     * a single device write
+     */
+    void writeBackBlocks(std::vector<LogicalBlockAddress>& blocks);
+
+    /** Mark a cached block dirty, retaining the time it was first dirtied */
+    void markDirty(LogicalBlockAddress lba);
+
+    /** @return the fraction of the cache that is dirty or being written */
+    double dirtyRatio() const;
+
+    /** @return the delay for a write at the current dirty ratio */
+    simtime_t getThrottleDelay() const;
+
+    /**
+     * Write back the expired dirty blocks, and then write back dirty blocks
+     * in LBA order until the dirty ratio will fall below the background
+     * threshold
+     */
+    void flushDirtyBlocks();
+
+    /** Schedule the next periodic write back if any blocks are dirty */
+    void scheduleWriteback();
+
+    /** Record the completion of a write back of extent blocks */
+    void completeWriteback(long extent);
 
     /** Dirty percent threshold parameter */
     double dirtyThreshold_;
 
+    /** Dirty percent that begins background write back */
+    double dirtyBackgroundThreshold_;
+
+    /** Age at which a dirty block is written back */
+    simtime_t dirtyExpireTime_;
+
+    /** Period of the write back timer */
+    simtime_t writebackInterval_;
+
+    /** Delay applied to a write at the dirty threshold */
+    simtime_t maxThrottleDelay_;
+
+    /** Periodic write back timer */
+    cMessage* writebackTimer_;
+
+    /** Dirty blocks and the time each was first dirtied */
+    std::map<LogicalBlockAddress, simtime_t> dirtyBlocks_;
+
+    /** The address to continue background write back from */
+    LogicalBlockAddress writebackCursor_;
+
+    /** The number of blocks being written back */
+    long numWritebackBlocks_;
+
+    /** The time the current write back began */
+    simtime_t writebackBegin_;
+
+    // Write back metric data collected at runtime
+    double statNumBlocksFlushed_;
+    double statNumStalls_;
+    simtime_t statWritebackTime_;
+    simtime_t statStallTime_;
+    cOutVector dirtyBlocksVector_;
+    cOutVector stallDelayVector_;
+
     /** Cache helper class */
-    LRUCache<LogicalBlockAddress, char>* cache_;
+    ReplacementCache<LogicalBlockAddress, char>* cache_;
 
     PendingRequestMap pendingRequests_;
+
+    /** The smallest readahead window */
+    long minReadaheadBlocks_;
+
+    /** The largest readahead window (0 disables readahead) */
+    long maxReadaheadBlocks_;
+
+    /** The maximum number of sequential streams tracked */
+    std::size_t maxReadaheadStreams_;
+
+    /** Sequential streams, most recently read first */
+    std::list<ReadaheadStream> readaheadStreams_;
+
+    /** Blocks being read ahead that no request has referenced */
+    std::set<LogicalBlockAddress> readaheadInFlight_;
+
+    /** Cached blocks read ahead that no request has referenced */
+    std::set<LogicalBlockAddress> readaheadBlocks_;
+
+    // Readahead metric data collected at runtime
+    double statNumReadaheadBlocks_;
+    double statNumReadaheadHits_;
+    double statNumReadaheadWaste_;
+    double statNumReadaheadEvictions_;
 };
 
 #endif
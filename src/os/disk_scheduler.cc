@@ -9,32 +9,105 @@
 //
 #include "disk_scheduler.h"
 #include <cassert>
+#include "message_kind.h"
 #include "os_proto_m.h"
 using namespace std;
 
 //=============================================================================
 //
-// DiskScheduler implementation (abstract class)
+// SchedulerQueue implementation
 //
 //=============================================================================
+SchedulerQueue::SchedulerQueue()
+{
+}
+
+void SchedulerQueue::insert(SchedulerEntry* entry)
+{
+    entry->lbaRef = lbaMap_.insert(make_pair(entry->lba, entry));
+    entry->arrivalRef = arrivalList_.insert(arrivalList_.end(), entry);
+}
+
+void SchedulerQueue::remove(SchedulerEntry* entry)
+{
+    lbaMap_.erase(entry->lbaRef);
+    arrivalList_.erase(entry->arrivalRef);
+}
+
+SchedulerEntry* SchedulerQueue::front() const
+{
+    return arrivalList_.empty() ? 0 : arrivalList_.front();
+}
+
+SchedulerEntry* SchedulerQueue::lowest() const
+{
+    return lbaMap_.empty() ? 0 : lbaMap_.begin()->second;
+}
+
+SchedulerEntry* SchedulerQueue::highest() const
+{
+    return lbaMap_.empty() ? 0 : lbaMap_.rbegin()->second;
+}
+
+SchedulerEntry* SchedulerQueue::successor(LogicalBlockAddress lba) const
+{
+    LBAMap::const_iterator iter = lbaMap_.lower_bound(lba);
+    return (lbaMap_.end() == iter) ? 0 : iter->second;
+}
+
+SchedulerEntry* SchedulerQueue::predecessor(LogicalBlockAddress lba) const
+{
+    // Step back from the first entry above lba
+    LBAMap::const_iterator iter = lbaMap_.upper_bound(lba);
+    if (lbaMap_.begin() == iter)
+    {
+        return 0;
+    }
+    return (--iter)->second;
+}
+
+SchedulerEntry* SchedulerQueue::nearest(LogicalBlockAddress lba) const
+{
+    SchedulerEntry* above = successor(lba);
+    SchedulerEntry* below = predecessor(lba);
+    if (0 == below)
+    {
+        return above;
+    }
+    else if (0 == above)
+    {
+        return below;
+    }
+    return ((above->lba - lba) <= (lba - below->lba)) ? above : below;
+}
 
-vector<SchedulerEntry*> DiskScheduler::extractIdenticalEntries(
-    cQueue& queue, LogicalBlockAddress lba, bool readsOnly)
+vector<SchedulerEntry*> SchedulerQueue::extractCovered(LogicalBlockAddress lba,
+                                                       long extent,
+                                                       bool readsOnly)
 {
+    // Only entries beginning within the extent may be covered by it
     vector<SchedulerEntry*> completed;
-    for (cQueue::Iterator iter(queue); !iter.end() ; iter++ )
+    LogicalBlockAddress end = lba + extent;
+    LBAMap::iterator iter = lbaMap_.lower_bound(lba);
+    while (lbaMap_.end() != iter && iter->first < end)
     {
-        SchedulerEntry* entry = static_cast<SchedulerEntry*>(iter());
-        if (lba == entry->lba &&
+        SchedulerEntry* entry = (iter++)->second;
+        if ((entry->lba + entry->extent) <= end &&
             (entry->isReadRequest || !readsOnly))
         {
             completed.push_back(entry);
-            queue.remove(entry);
+            remove(entry);
         }
     }
     return completed;
 }
 
+//=============================================================================
+//
+// DiskScheduler implementation (abstract class)
+//
+//=============================================================================
+
 DiskScheduler::DiskScheduler()
 {
 }
@@ -48,6 +121,10 @@ void DiskScheduler::initialize()
     inGateId_ = gate("in")->getId();
     outGateId_ = gate("out")->getId();
     requestGateId_ = gate("request")->getId();
+    maxOutstandingRequests_ = par("maxOutstandingRequests").longValue();
+    numOutstandingRequests_ = 0;
+    assert(0 < maxOutstandingRequests_);
+    headAddress_ = 0;
 
     // Initialize derived schedulers
     initializeScheduler();
@@ -61,35 +138,44 @@ void DiskScheduler::handleMessage( cMessage *msg )
 {
     if (msg->getArrivalGateId() == inGateId_)
     {
-        // If the scheduler is empty, send this entry to disk
-        // otherwise, add it to the scheduler
-        if (isEmpty())
+        // Create a scheduler entry for this request
+        SchedulerEntry* thisEntry = 0;
+        switch (msg->getKind())
         {
-            send(msg, requestGateId_);
-        }
-        else
-        {
-            // Create a scheduler entry for this request
-            SchedulerEntry* thisEntry = 0;
-            if (spfsOSReadDeviceRequest* read =
-                dynamic_cast<spfsOSReadDeviceRequest*>(msg))
+            case SPFS_OS_READ_DEVICE_REQUEST:
             {
+                spfsOSReadDeviceRequest* read =
+                    kind_cast<spfsOSReadDeviceRequest>(msg);
                 thisEntry = new SchedulerEntry();
                 thisEntry->lba = read->getAddress();
+                thisEntry->extent = read->getExtent();
                 thisEntry->request = msg;
                 thisEntry->isReadRequest = true;
+                break;
             }
-            else if (spfsOSWriteDeviceRequest* write =
-                     dynamic_cast<spfsOSWriteDeviceRequest*>(msg))
+            case SPFS_OS_WRITE_DEVICE_REQUEST:
             {
+                spfsOSWriteDeviceRequest* write =
+                    kind_cast<spfsOSWriteDeviceRequest>(msg);
                 thisEntry = new SchedulerEntry();
                 thisEntry->lba = write->getAddress();
+                thisEntry->extent = write->getExtent();
                 thisEntry->request = msg;
                 thisEntry->isReadRequest = false;
+                break;
             }
+        }
+        assert(0 != thisEntry);
+        thisEntry->arrivalTime = simTime();
 
-            // Add this entry to the scheduler
-            assert(0 != thisEntry);
+        // If the disk can accept another request, send this entry to disk
+        // otherwise, add it to the scheduler
+        if (numOutstandingRequests_ < maxOutstandingRequests_)
+        {
+            dispatchEntry(thisEntry);
+        }
+        else
+        {
             addEntry(thisEntry);
         }
     }
@@ -97,22 +183,26 @@ void DiskScheduler::handleMessage( cMessage *msg )
     {
         // See if the completed request satisfies any other requests
         vector<SchedulerEntry*> completedReqs;
-        if (spfsOSReadDeviceResponse* read =
-            dynamic_cast<spfsOSReadDeviceResponse*>(msg))
+        switch (msg->getKind())
         {
-            spfsOSReadDeviceRequest* readReq =
-                static_cast<spfsOSReadDeviceRequest*>(read->getContextPointer());
-            LogicalBlockAddress readBlock = readReq->getAddress();
-            completedReqs = popRequestsCompletedByRead(readBlock);
-        }
-        else if (spfsOSWriteDeviceResponse* write =
-                 dynamic_cast<spfsOSWriteDeviceResponse*>(msg))
-        {
-            spfsOSWriteDeviceRequest* writeReq =
-               static_cast<spfsOSWriteDeviceRequest*>(write->getContextPointer());
-            LogicalBlockAddress writtenBlock = writeReq->getAddress();
-            completedReqs = popRequestsCompletedByWrite(writtenBlock);
-
+            case SPFS_OS_READ_DEVICE_RESPONSE:
+            {
+                spfsOSReadDeviceRequest* readReq =
+                    static_cast<spfsOSReadDeviceRequest*>(
+                        msg->getContextPointer());
+                completedReqs = popRequestsCompletedByRead(
+                    readReq->getAddress(), readReq->getExtent());
+                break;
+            }
+            case SPFS_OS_WRITE_DEVICE_RESPONSE:
+            {
+                spfsOSWriteDeviceRequest* writeReq =
+                    static_cast<spfsOSWriteDeviceRequest*>(
+                        msg->getContextPointer());
+                completedReqs = popRequestsCompletedByWrite(
+                    writeReq->getAddress(), writeReq->getExtent());
+                break;
+            }
         }
 
         // Construct the responses for the completed requests
@@ -121,11 +211,13 @@ void DiskScheduler::handleMessage( cMessage *msg )
             cMessage* resp = 0;
             if (completedReqs[i]->isReadRequest)
             {
-                resp = new spfsOSReadDeviceResponse();
+                resp =
+                    new spfsOSReadDeviceResponse(0, SPFS_OS_READ_DEVICE_RESPONSE);
             }
             else
             {
-                resp = new spfsOSWriteDeviceResponse();
+                resp =
+                    new spfsOSWriteDeviceResponse(0, SPFS_OS_WRITE_DEVICE_RESPONSE);
             }
             resp->setContextPointer(completedReqs[i]->request);
             send(resp, outGateId_);
@@ -135,50 +227,56 @@ void DiskScheduler::handleMessage( cMessage *msg )
         // Forward the device's response
         send(msg, outGateId_);
 
-        // Schedule the next entry
-        if (!isEmpty())
+        // The device has released the request, schedule the next entries
+        assert(0 < numOutstandingRequests_);
+        numOutstandingRequests_--;
+        while (numOutstandingRequests_ < maxOutstandingRequests_ &&
+               !isEmpty())
         {
-            SchedulerEntry* next = popNextEntry();
-            send(next->request, outGateId_);
-            delete next;
+            dispatchEntry(popNextEntry());
         }
     }
 }
 
-//=============================================================================
-//
-// FCFSDiskScheduler implementation (concrete DiskScheduler)
-//
-//=============================================================================
-Define_Module(FCFSDiskScheduler);
-
-FCFSDiskScheduler::FCFSDiskScheduler()
+vector<SchedulerEntry*> DiskScheduler::popRequestsCompletedByRead(
+    LogicalBlockAddress lba, long extent)
 {
+    return queue_.extractCovered(lba, extent, true);
 }
 
-void FCFSDiskScheduler::addEntry(SchedulerEntry* entry)
+vector<SchedulerEntry*> DiskScheduler::popRequestsCompletedByWrite(
+    LogicalBlockAddress lba, long extent)
 {
-    fcfsQueue.insert(entry);
+    return queue_.extractCovered(lba, extent, false);
 }
 
-SchedulerEntry* FCFSDiskScheduler::popNextEntry()
+void DiskScheduler::dispatchEntry(SchedulerEntry* entry)
 {
-    return static_cast<SchedulerEntry*>(fcfsQueue.pop());
+    assert(0 != entry);
+    numOutstandingRequests_++;
+    headAddress_ = entry->lba + entry->extent;
+    send(entry->request, requestGateId_);
+    delete entry;
 }
 
-vector<SchedulerEntry*> FCFSDiskScheduler::popRequestsCompletedByRead(
-    LogicalBlockAddress lba)
+//=============================================================================
+//
+// FCFSDiskScheduler implementation (concrete DiskScheduler)
+//
+//=============================================================================
+Define_Module(FCFSDiskScheduler);
+
+FCFSDiskScheduler::FCFSDiskScheduler()
 {
-    return extractIdenticalEntries(fcfsQueue, lba, true);
 }
 
-vector<SchedulerEntry*> FCFSDiskScheduler::popRequestsCompletedByWrite(
-    LogicalBlockAddress lba)
+SchedulerEntry* FCFSDiskScheduler::popNextEntry()
 {
-    return extractIdenticalEntries(fcfsQueue, lba, false);
+    SchedulerEntry* entry = queue_.front();
+    queue_.remove(entry);
+    return entry;
 }
 
-
 //=============================================================================
 //
 // SSTFDiskScheduler implementation (concrete DiskScheduler)
@@ -190,240 +288,301 @@ SSTFDiskScheduler::SSTFDiskScheduler()
 {
 }
 
-void SSTFDiskScheduler::initializeScheduler()
+SchedulerEntry* SSTFDiskScheduler::popNextEntry()
 {
-    // Assume the arm is at the origin on initialization
-    currentAddress_ = 0;
+    SchedulerEntry* closestEntry = queue_.nearest(getHeadAddress());
+    queue_.remove(closestEntry);
+    return closestEntry;
 }
 
-void SSTFDiskScheduler::addEntry(SchedulerEntry* entry)
+//=============================================================================
+//
+// ScanDiskScheduler implementation (concrete DiskScheduler)
+//
+//=============================================================================
+Define_Module(ScanDiskScheduler);
+
+ScanDiskScheduler::ScanDiskScheduler()
 {
-    sstfQueue.insert(entry);
 }
 
-SchedulerEntry* SSTFDiskScheduler::popNextEntry()
+void ScanDiskScheduler::initializeScheduler()
 {
-    cQueue::Iterator iter(sstfQueue, false);
-    SchedulerEntry* closestEntry = static_cast<SchedulerEntry*>(iter());
-    int64_t smallestDelta = abs64(currentAddress_ - closestEntry->lba);
-
-    // Bruteforce though the queue to find the closest request
-    for ( ; !iter.end() ; iter++ )
-    {
-        SchedulerEntry* entry = static_cast<SchedulerEntry*>(iter());
-        int64_t delta = abs64(currentAddress_ - entry->lba);
-        if (delta < smallestDelta)
-        {
-            closestEntry = entry;
-            smallestDelta = delta;
-        }
-    }
-
-    sstfQueue.remove(closestEntry);
-    return closestEntry;
+    isGoingUp_ = true;
 }
 
-vector<SchedulerEntry*> SSTFDiskScheduler::popRequestsCompletedByRead(
-    LogicalBlockAddress lba)
+SchedulerEntry* ScanDiskScheduler::popNextEntry()
 {
-    return extractIdenticalEntries(sstfQueue, lba, true);
+    return popNextSweepEntry(queue_);
 }
 
-vector<SchedulerEntry*> SSTFDiskScheduler::popRequestsCompletedByWrite(
-    LogicalBlockAddress lba)
+SchedulerEntry* ScanDiskScheduler::popNextSweepEntry(SchedulerQueue& queue)
 {
-    return extractIdenticalEntries(sstfQueue, lba, false);
+    // Continue the sweep in the current direction, reversing direction
+    // when no entries remain ahead of the head
+    LogicalBlockAddress head = getHeadAddress();
+    SchedulerEntry* entry =
+        isGoingUp_ ? queue.successor(head) : queue.predecessor(head);
+    if (0 == entry)
+    {
+        isGoingUp_ = !isGoingUp_;
+        entry = isGoingUp_ ? queue.successor(head) : queue.predecessor(head);
+    }
+    queue.remove(entry);
+    return entry;
 }
 
-/*
-//------------------------------------------------
+//=============================================================================
 //
-//  CScanScheduler
+// CScanDiskScheduler implementation (concrete DiskScheduler)
 //
-//  CSCAN Disk Scheduler -- Each sweep of the disk is in the same
-//  direction.  In this implementation, the block with the lowest
-//  number is serviced first.
-
-Define_Module_Like( CScanDiskScheduler, DiskScheduler )
+//=============================================================================
+Define_Module(CScanDiskScheduler);
 
 CScanDiskScheduler::CScanDiskScheduler()
 {
 }
 
-void CScanDiskScheduler::setup()
+SchedulerEntry* CScanDiskScheduler::popNextEntry()
 {
-    //BWS queue.setup( CompareBlocksNumber, true );
+    return popNextSweepEntry(queue_);
 }
 
-//------------------------------------------------
-//
-//  NStepCScanScheduler
-//
-//  NStep CSCAN Disk Scheduler -- Each sweep of the disk is in the same
-//  direction.  In this implementation, the block with the lowest
-//  number is serviced first.  By adding NStep, the possibility of
-//  indefinite postponement is reduced.
+SchedulerEntry* CScanDiskScheduler::popNextSweepEntry(SchedulerQueue& queue)
+{
+    // Sweep upward, returning to the lowest address at the end
+    SchedulerEntry* entry = queue.successor(getHeadAddress());
+    if (0 == entry)
+    {
+        entry = queue.lowest();
+    }
+    queue.remove(entry);
+    return entry;
+}
+
+//=============================================================================
 //
-//  Implementation Notes:
+// NStepDiskScheduler implementation (concrete DiskScheduler)
 //
-//  This algorithm uses both queues.
-
-Define_Module_Like( NStepCScanDiskScheduler, DiskScheduler )
+//=============================================================================
+Define_Module(NStepDiskScheduler);
 
-NStepCScanDiskScheduler::NStepCScanDiskScheduler()
+/** Move all of the entries in source into destination */
+static void moveEntries(SchedulerQueue& source, SchedulerQueue& destination)
 {
+    while (!source.empty())
+    {
+        SchedulerEntry* entry = source.front();
+        source.remove(entry);
+        destination.insert(entry);
+    }
 }
 
-void NStepCScanDiskScheduler::setup()
+/** Extract covered entries from both queues */
+static vector<SchedulerEntry*> extractCovered(SchedulerQueue& queue1,
+                                              SchedulerQueue& queue2,
+                                              LogicalBlockAddress lba,
+                                              long extent,
+                                              bool readsOnly)
 {
-    //BWS queue.setup( CompareBlocksNumber, false );
-    nstep_queue.setup( NULL, true );
+    vector<SchedulerEntry*> completed =
+        queue1.extractCovered(lba, extent, readsOnly);
+    vector<SchedulerEntry*> completed2 =
+        queue2.extractCovered(lba, extent, readsOnly);
+    completed.insert(completed.end(), completed2.begin(), completed2.end());
+    return completed;
 }
 
-void NStepCScanDiskScheduler::insertNewRequest( cMessage *msg )
+NStepDiskScheduler::NStepDiskScheduler()
 {
-  //  If servicing the primary queue, then put the new request
-  //  on the secondary queue.
-
-  ev << className() << ": Inserting " << msg->name() << " on ";
-  nstep_queue.insert( msg );
-  ev << "secondary queue" << endl;
 }
 
-cMessage *NStepCScanDiskScheduler::getNextToDo( void )
+bool NStepDiskScheduler::isEmpty() const
 {
-  cMessage *msg;
-
-  if ( queue.empty() ) {
-    if ( nstep_queue.empty() )
-      return NULL;
+    return queue_.empty() && nextSweepQueue_.empty();
+}
 
-    // ev << className() << ": Switching to primary queue" << endl;
+void NStepDiskScheduler::addEntry(SchedulerEntry* entry)
+{
+    nextSweepQueue_.insert(entry);
+}
 
-    while ( !nstep_queue.empty() ) {
-      msg = (cMessage *) nstep_queue.pop();
-      //BWS ev << className() << ": Moving " << msg->name() << endl;
-      queue.insert( msg );
+SchedulerEntry* NStepDiskScheduler::popNextEntry()
+{
+    // Begin the next sweep once the current sweep completes
+    if (queue_.empty())
+    {
+        moveEntries(nextSweepQueue_, queue_);
     }
-  }
+    return popNextSweepEntry(queue_);
+}
 
-  return (cMessage *)queue.pop();
+vector<SchedulerEntry*> NStepDiskScheduler::popRequestsCompletedByRead(
+    LogicalBlockAddress lba, long extent)
+{
+    return extractCovered(queue_, nextSweepQueue_, lba, extent, true);
 }
 
+vector<SchedulerEntry*> NStepDiskScheduler::popRequestsCompletedByWrite(
+    LogicalBlockAddress lba, long extent)
+{
+    return extractCovered(queue_, nextSweepQueue_, lba, extent, false);
+}
 
-//------------------------------------------------
+//=============================================================================
 //
-//  ScanScheduler
+// NStepCScanDiskScheduler implementation (concrete DiskScheduler)
 //
-//  SCAN Disk Scheduler -- each sweep of the disk is in a different
-//  direction.  On one pass, the block with the lowest number is
-//  serviced first.  On the next pass, the block with the highest
-//  number is serviced.
-
-Define_Module_Like( ScanDiskScheduler, DiskScheduler )
+//=============================================================================
+Define_Module(NStepCScanDiskScheduler);
 
-ScanDiskScheduler::ScanDiskScheduler()
+NStepCScanDiskScheduler::NStepCScanDiskScheduler()
 {
 }
 
-void ScanDiskScheduler::setup()
+bool NStepCScanDiskScheduler::isEmpty() const
 {
-  going_up = false;
+    return queue_.empty() && nextSweepQueue_.empty();
 }
 
-void ScanDiskScheduler::insertNewRequest( cMessage *msg )
+void NStepCScanDiskScheduler::addEntry(SchedulerEntry* entry)
 {
-  if ( queue.empty() ) {
-
-    ev << className() << ": Switching directions from " ;
-    if ( going_up ) ev << "UP";
-    else            ev << "DOWN";
-
-    going_up = (going_up) ? false : true;
-    //BWS queue.setup( CompareBlocksNumber, !going_up );
-
-    ev << " to ";
-    if ( going_up ) ev << "UP";
-    else            ev << "DOWN";
-    ev << endl;
-  }
+    nextSweepQueue_.insert(entry);
+}
 
-  ev << className() << ": Inserting " << msg->name() << endl;
-  queue.insert( msg );
+SchedulerEntry* NStepCScanDiskScheduler::popNextEntry()
+{
+    // Begin the next sweep once the current sweep completes
+    if (queue_.empty())
+    {
+        moveEntries(nextSweepQueue_, queue_);
+    }
+    return popNextSweepEntry(queue_);
 }
 
-// ScanScheduler::getNextToDo
-//
-//  Behavior is the same as AbstractScheduler
+vector<SchedulerEntry*> NStepCScanDiskScheduler::popRequestsCompletedByRead(
+    LogicalBlockAddress lba, long extent)
+{
+    return extractCovered(queue_, nextSweepQueue_, lba, extent, true);
+}
 
+vector<SchedulerEntry*> NStepCScanDiskScheduler::popRequestsCompletedByWrite(
+    LogicalBlockAddress lba, long extent)
+{
+    return extractCovered(queue_, nextSweepQueue_, lba, extent, false);
+}
 
-//------------------------------------------------
-//
-//  NStepScanScheduler
-//
-//  N-Step SCAN Disk Scheduler -- each sweep of the disk is in a different
-//  direction.  On one pass, the block with the lowest number is
-//  serviced first.  On the next pass, the block with the highest
-//  number is serviced.
+//=============================================================================
 //
-//  Implementation Notes:
+// DeadlineDiskScheduler implementation (concrete DiskScheduler)
 //
-//  This algorithm uses both queues.
-
-Define_Module_Like( NStepScanDiskScheduler, DiskScheduler )
+//=============================================================================
+Define_Module(DeadlineDiskScheduler);
 
-NStepScanDiskScheduler::NStepScanDiskScheduler()
+DeadlineDiskScheduler::DeadlineDiskScheduler()
 {
 }
 
-void NStepScanDiskScheduler::setup()
+void DeadlineDiskScheduler::initializeScheduler()
 {
-  going_up = false;
-  nstep_queue.setup( NULL, true );
+    readExpireTime_ = par("readExpireSecs").doubleValue();
+    writeExpireTime_ = par("writeExpireSecs").doubleValue();
+    fifoBatch_ = par("fifoBatch").longValue();
+    writesStarved_ = par("writesStarved").longValue();
+    assert(0 < fifoBatch_);
+    isReadBatch_ = true;
+    batchCount_ = 0;
+    numStarvedBatches_ = 0;
 }
 
-void NStepScanDiskScheduler::insertNewRequest( cMessage *msg )
+bool DeadlineDiskScheduler::isEmpty() const
 {
-  //  If servicing the primary queue, then put the new request
-  //  on the secondary queue.
-
-  ev << className() << ": Inserting " << msg->name() << " on ";
-  nstep_queue.insert( msg );
-  ev << "secondary queue" << endl;
+    return readQueue_.empty() && writeQueue_.empty();
 }
 
-cMessage *NStepScanDiskScheduler::getNextToDo( void )
+void DeadlineDiskScheduler::addEntry(SchedulerEntry* entry)
 {
-  cMessage *msg;
+    if (entry->isReadRequest)
+    {
+        readQueue_.insert(entry);
+    }
+    else
+    {
+        writeQueue_.insert(entry);
+    }
+}
 
-  if ( queue.empty() ) {
-    if ( nstep_queue.empty() )
-      return NULL;
+SchedulerEntry* DeadlineDiskScheduler::popNextEntry()
+{
+    // Continue the current batch upward from the head
+    SchedulerEntry* entry = 0;
+    if (batchCount_ < fifoBatch_)
+    {
+        SchedulerQueue& batchQueue = isReadBatch_ ? readQueue_ : writeQueue_;
+        entry = batchQueue.successor(getHeadAddress());
+    }
 
-    // ev << className() << ": Switching to primary queue" << endl;
+    // Begin a new batch, preferring reads until writes have starved
+    if (0 == entry)
+    {
+        bool hasReads = !readQueue_.empty();
+        bool hasWrites = !writeQueue_.empty();
+        if (hasReads && (!hasWrites || numStarvedBatches_ < writesStarved_))
+        {
+            isReadBatch_ = true;
+            if (hasWrites)
+            {
+                numStarvedBatches_++;
+            }
+            entry = getBatchStart(readQueue_, readExpireTime_);
+        }
+        else
+        {
+            isReadBatch_ = false;
+            numStarvedBatches_ = 0;
+            entry = getBatchStart(writeQueue_, writeExpireTime_);
+        }
+        batchCount_ = 0;
+    }
 
-    ev << className() << ": Switching directions from " ;
-    if ( going_up ) ev << "UP";
-    else            ev << "DOWN";
+    batchCount_++;
+    if (isReadBatch_)
+    {
+        readQueue_.remove(entry);
+    }
+    else
+    {
+        writeQueue_.remove(entry);
+    }
+    return entry;
+}
 
-    going_up = (going_up) ? false : true;
-    //BWS queue.setup( CompareBlocksNumber, !going_up );
+vector<SchedulerEntry*> DeadlineDiskScheduler::popRequestsCompletedByRead(
+    LogicalBlockAddress lba, long extent)
+{
+    return readQueue_.extractCovered(lba, extent, true);
+}
 
-    ev << " to ";
-    if ( going_up ) ev << "UP";
-    else            ev << "DOWN";
-    ev << endl;
+vector<SchedulerEntry*> DeadlineDiskScheduler::popRequestsCompletedByWrite(
+    LogicalBlockAddress lba, long extent)
+{
+    return extractCovered(readQueue_, writeQueue_, lba, extent, false);
+}
 
-    while ( !nstep_queue.empty() ) {
-      msg = (cMessage *) nstep_queue.pop();
-      ev << className() << ": Moving " << msg->name() << endl;
-      queue.insert( msg );
+SchedulerEntry* DeadlineDiskScheduler::getBatchStart(
+    const SchedulerQueue& queue, simtime_t expireTime) const
+{
+    // An expired request begins the batch, otherwise continue upward from
+    // the head, or begin from the oldest request
+    SchedulerEntry* oldest = queue.front();
+    if (simTime() - oldest->arrivalTime >= expireTime)
+    {
+        return oldest;
     }
-  }
 
-  return (cMessage *)queue.pop();
+    SchedulerEntry* next = queue.successor(getHeadAddress());
+    return (0 != next) ? next : oldest;
 }
-*/
 
 /*
  * Local variables:
@@ -9,6 +9,9 @@
 // This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
 // for details on this and other legal matters.
 //
+#include <cstddef>
+#include <list>
+#include <map>
 #include <vector>
 #include <omnetpp.h>
 #include "basic_types.h"
@@ -19,29 +22,103 @@
 struct SchedulerEntry : public cObject
 {
     LogicalBlockAddress lba;
+    long extent;
     cMessage* request;
     bool isReadRequest;
+    simtime_t arrivalTime;
+
+    /** Position in the owning queue's LBA index */
+    std::multimap<LogicalBlockAddress, SchedulerEntry*>::iterator lbaRef;
+
+    /** Position in the owning queue's arrival order */
+    std::list<SchedulerEntry*>::iterator arrivalRef;
 };
 
 /**
- * Abstract base class for Disk Schedulers
+ * Queue of disk scheduler entries indexed by both arrival order and
+ * starting block address.  Insertion, removal and address queries are
+ * O(log n).
  */
-class DiskScheduler : public cSimpleModule
+class SchedulerQueue
 {
-  public:
+public:
+    /** Constructor */
+    SchedulerQueue();
+
+    /** @return true if the queue contains no entries */
+    bool empty() const { return arrivalList_.empty(); };
+
+    /** @return the number of entries in the queue */
+    std::size_t size() const { return arrivalList_.size(); };
+
+    /** Add an entry to the queue */
+    void insert(SchedulerEntry* entry);
+
+    /** Remove an entry contained in the queue */
+    void remove(SchedulerEntry* entry);
+
+    /** @return the earliest arriving entry, or 0 if the queue is empty */
+    SchedulerEntry* front() const;
+
+    /** @return the entry with the lowest address, or 0 if empty */
+    SchedulerEntry* lowest() const;
+
+    /** @return the entry with the highest address, or 0 if empty */
+    SchedulerEntry* highest() const;
+
+    /**
+     * @return the lowest addressed entry at or above lba, or 0 if none
+     *   exists
+     */
+    SchedulerEntry* successor(LogicalBlockAddress lba) const;
+
+    /**
+     * @return the highest addressed entry at or below lba, or 0 if none
+     *   exists
+     */
+    SchedulerEntry* predecessor(LogicalBlockAddress lba) const;
+
     /**
-     * Remove and return entries from the queue that match the address lba.
-     *  If readsOnly is set to true, only identical reads are extracted, if
-     *  set to false both reads and writes are extracted
+     * @return the entry whose address is nearest to lba, preferring the
+     *   higher address on a tie, or 0 if the queue is empty
+     */
+    SchedulerEntry* nearest(LogicalBlockAddress lba) const;
+
+    /**
+     * Remove and return entries from the queue whose extents lie entirely
+     *  within the extent beginning at address lba.  If readsOnly is set to
+     *  true, only covered reads are extracted, if set to false both reads
+     *  and writes are extracted
      *
-     * @param the queue to extract from
-     * @param the block address to compare for equality
+     * @param the first block address of the completed extent
+     * @param the number of blocks in the completed extent
      * @param set to true to extract only reads, ow extract reads and writes
      * @return the extracted entries
      */
-    static std::vector<SchedulerEntry*> extractIdenticalEntries(
-        cQueue& queue, LogicalBlockAddress lba, bool readsOnly);
+    std::vector<SchedulerEntry*> extractCovered(LogicalBlockAddress lba,
+                                                long extent,
+                                                bool readsOnly);
+
+private:
+    typedef std::multimap<LogicalBlockAddress, SchedulerEntry*> LBAMap;
+
+    /** Entries ordered by starting address */
+    LBAMap lbaMap_;
 
+    /** Entries ordered by arrival */
+    std::list<SchedulerEntry*> arrivalList_;
+};
+
+/**
+ * Abstract base class for Disk Schedulers
+ *
+ * Up to maxOutstandingRequests requests are outstanding at the disk at a
+ * time, so that disks with command queuing may reorder them, and the
+ * remaining requests are held in the scheduler until the disk responds.
+ */
+class DiskScheduler : public cSimpleModule
+{
+  public:
     /**
      *  This is the constructor for this simulation module.
      *
@@ -68,36 +145,56 @@ protected:
     virtual void initializeScheduler() = 0;
 
     /** @return true if the disk scheduler has no outstanding entries */
-    virtual bool isEmpty() const = 0;
+    virtual bool isEmpty() const { return queue_.empty(); };
 
     /** Add entry to the scheduler */
-    virtual void addEntry(SchedulerEntry* entry) = 0;
+    virtual void addEntry(SchedulerEntry* entry) { queue_.insert(entry); };
 
     /** @return the next scheduled entry */
     virtual SchedulerEntry* popNextEntry() = 0;
 
     /**
-     * Remove a superceded request if one exists.  A read or write request
-     * becomes superceded if an incoming write request is to the same address.
+     * Remove the queued reads satisfied by a completed device read
      *
-     * @return the superceded request
+     * @return the satisfied requests
      */
     virtual std::vector<SchedulerEntry*> popRequestsCompletedByRead(
-        LogicalBlockAddress lba) = 0;
+        LogicalBlockAddress lba, long extent);
 
     /**
+     * Remove the queued reads and writes satisfied by a completed device
+     * write
+     *
      * @return a list of all satisfied requests
      */
     virtual std::vector<SchedulerEntry*> popRequestsCompletedByWrite(
-        LogicalBlockAddress lba) = 0;
+        LogicalBlockAddress lba, long extent);
+
+    /** @return the block address following the last dispatched request */
+    LogicalBlockAddress getHeadAddress() const { return headAddress_; };
+
+    /** Queued entries */
+    SchedulerQueue queue_;
 
 private:
 
+    /** Send an entry's request to the disk */
+    void dispatchEntry(SchedulerEntry* entry);
+
     int inGateId_;
 
     int outGateId_;
 
     int requestGateId_;
+
+    /** The maximum number of requests outstanding at the disk */
+    std::size_t maxOutstandingRequests_;
+
+    /** The number of requests outstanding at the disk */
+    std::size_t numOutstandingRequests_;
+
+    /** The block address following the last dispatched request */
+    LogicalBlockAddress headAddress_;
 };
 
 /**
@@ -113,21 +210,7 @@ protected:
 
     virtual void initializeScheduler() {};
 
-    virtual bool isEmpty() const { return fcfsQueue.empty(); };
-
-    virtual void addEntry( SchedulerEntry* entry);
-
     virtual SchedulerEntry* popNextEntry();
-
-    virtual std::vector<SchedulerEntry*> popRequestsCompletedByRead(
-        LogicalBlockAddress lba);
-
-    virtual std::vector<SchedulerEntry*> popRequestsCompletedByWrite(
-        LogicalBlockAddress lba);
-private:
-
-    cQueue fcfsQueue;
-
 };
 
 /**
@@ -141,28 +224,14 @@ public:
 
 protected:
 
-    virtual void initializeScheduler();
-
-    virtual bool isEmpty() const {return sstfQueue.empty(); };
-
-    virtual void addEntry( SchedulerEntry* entry);
+    virtual void initializeScheduler() {};
 
     virtual SchedulerEntry* popNextEntry();
-
-    virtual std::vector<SchedulerEntry*> popRequestsCompletedByRead(
-        LogicalBlockAddress lba);
-
-    virtual std::vector<SchedulerEntry*> popRequestsCompletedByWrite(
-        LogicalBlockAddress lba);
-private:
-
-    cQueue sstfQueue;
-
-    LogicalBlockAddress currentAddress_;
 };
 
 /**
- * SCAN Disk Scheduler
+ * SCAN Disk Scheduler -- each sweep of the disk is in a different
+ * direction.
  */
 class ScanDiskScheduler : public DiskScheduler
 {
@@ -172,26 +241,21 @@ public:
 
 protected:
 
-    virtual void initializeScheduler() {};
-
-    virtual void addEntry( SchedulerEntry* entry);
+    virtual void initializeScheduler();
 
     virtual SchedulerEntry* popNextEntry();
 
-    virtual std::vector<SchedulerEntry*> popSupercededRequests(
-        LogicalBlockAddress lba);
+    /** @return the next entry in the sweep over queue */
+    SchedulerEntry* popNextSweepEntry(SchedulerQueue& queue);
 
-    virtual std::vector<SchedulerEntry*> popAllSatisfiedRequests(
-        LogicalBlockAddress lba);
 private:
 
-    cQueue scanQueue;
-
     bool isGoingUp_;
 };
 
 /**
- * C-SCAN Disk Scheduler
+ * C-SCAN Disk Scheduler -- each sweep of the disk is in the upward
+ * direction, returning to the lowest address when the sweep completes.
  */
 class CScanDiskScheduler : public DiskScheduler
 {
@@ -203,76 +267,133 @@ protected:
 
     virtual void initializeScheduler() {};
 
-    virtual void addEntry( SchedulerEntry* entry);
+    virtual SchedulerEntry* popNextEntry();
+
+    /** @return the next entry in the sweep over queue */
+    SchedulerEntry* popNextSweepEntry(SchedulerQueue& queue);
+};
+
+/**
+ * N-Step SCAN Disk Scheduler -- requests arriving during a sweep are
+ * deferred to the next sweep, bounding postponement
+ */
+class NStepDiskScheduler : public ScanDiskScheduler
+{
+public:
+    /** Constructor */
+    NStepDiskScheduler();
+
+protected:
+
+    virtual bool isEmpty() const;
+
+    virtual void addEntry(SchedulerEntry* entry);
 
     virtual SchedulerEntry* popNextEntry();
 
-    virtual std::vector<SchedulerEntry*> popSupercededRequests(
-        LogicalBlockAddress lba);
+    virtual std::vector<SchedulerEntry*> popRequestsCompletedByRead(
+        LogicalBlockAddress lba, long extent);
 
-    virtual std::vector<SchedulerEntry*> popAllSatisfiedRequests(
-        LogicalBlockAddress lba);
-private:
+    virtual std::vector<SchedulerEntry*> popRequestsCompletedByWrite(
+        LogicalBlockAddress lba, long extent);
 
-    cQueue sstfQueue;
+private:
 
-    LogicalBlockAddress currentBlock_;
+    /** Requests deferred to the next sweep */
+    SchedulerQueue nextSweepQueue_;
 };
 
 /**
- * N-Step SCAN Disk Scheduler
+ * N-Step C-SCAN Disk Scheduler -- requests arriving during a sweep are
+ * deferred to the next sweep, bounding postponement
  */
-class NStepScanDiskScheduler : public DiskScheduler
+class NStepCScanDiskScheduler : public CScanDiskScheduler
 {
 public:
     /** Constructor */
-    NStepScanDiskScheduler();
+    NStepCScanDiskScheduler();
 
 protected:
 
-    virtual void initializeScheduler() {};
+    virtual bool isEmpty() const;
 
-    virtual void addEntry( SchedulerEntry* entry);
+    virtual void addEntry(SchedulerEntry* entry);
 
     virtual SchedulerEntry* popNextEntry();
 
-    virtual std::vector<SchedulerEntry*> popSupercededRequests(
-        LogicalBlockAddress lba);
+    virtual std::vector<SchedulerEntry*> popRequestsCompletedByRead(
+        LogicalBlockAddress lba, long extent);
 
-    virtual std::vector<SchedulerEntry*> popAllSatisfiedRequests(
-        LogicalBlockAddress lba);
-private:
+    virtual std::vector<SchedulerEntry*> popRequestsCompletedByWrite(
+        LogicalBlockAddress lba, long extent);
 
-    cQueue scanQueue;
+private:
 
-    bool isGoingUp_;
+    /** Requests deferred to the next sweep */
+    SchedulerQueue nextSweepQueue_;
 };
 
 /**
- * N-Step C-SCAN Disk Scheduler
+ * Deadline Disk Scheduler -- reads and writes are serviced in ascending
+ * address batches of up to fifoBatch requests.  Reads are preferred, but
+ * writes are serviced after at most writesStarved read batches, and a
+ * batch begins at the oldest request of its direction once that request
+ * has waited past its expire time.
  */
-class NStepCScanDiskScheduler : public DiskScheduler
+class DeadlineDiskScheduler : public DiskScheduler
 {
 public:
     /** Constructor */
-    NStepCScanDiskScheduler();
+    DeadlineDiskScheduler();
 
 protected:
 
-    virtual void initializeScheduler() {};
+    virtual void initializeScheduler();
 
-    virtual void addEntry( SchedulerEntry* entry);
+    virtual bool isEmpty() const;
+
+    virtual void addEntry(SchedulerEntry* entry);
 
     virtual SchedulerEntry* popNextEntry();
 
-    virtual std::vector<SchedulerEntry*> popSupercededRequests(
-        LogicalBlockAddress lba);
+    virtual std::vector<SchedulerEntry*> popRequestsCompletedByRead(
+        LogicalBlockAddress lba, long extent);
+
+    virtual std::vector<SchedulerEntry*> popRequestsCompletedByWrite(
+        LogicalBlockAddress lba, long extent);
 
-    virtual std::vector<SchedulerEntry*> popAllSatisfiedRequests(
-        LogicalBlockAddress lba);
 private:
 
-    cQueue scanQueue;
+    /** @return the first entry of a new batch from queue */
+    SchedulerEntry* getBatchStart(const SchedulerQueue& queue,
+                                  simtime_t expireTime) const;
+
+    /** Queued reads */
+    SchedulerQueue readQueue_;
+
+    /** Queued writes */
+    SchedulerQueue writeQueue_;
+
+    /** Time a read may wait before it begins a batch */
+    simtime_t readExpireTime_;
+
+    /** Time a write may wait before it begins a batch */
+    simtime_t writeExpireTime_;
+
+    /** Maximum number of requests in a batch */
+    long fifoBatch_;
+
+    /** Maximum number of read batches while writes wait */
+    long writesStarved_;
+
+    /** True if the current batch is reads */
+    bool isReadBatch_;
+
+    /** The number of requests dispatched in the current batch */
+    long batchCount_;
+
+    /** The number of read batches dispatched while writes waited */
+    long numStarvedBatches_;
 };
 
 #endif
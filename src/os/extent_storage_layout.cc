@@ -0,0 +1,421 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include "extent_storage_layout.h"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include "file_id_registry.h"
+using namespace std;
+
+ExtentStorageLayout::ExtentStorageLayout(size_t blockSize,
+                                         int64_t blocksPerGroup,
+                                         size_t numGroups,
+                                         int64_t reservationBlocks)
+    : StorageLayout(),
+      fsBlockSize_(blockSize),
+      blocksPerGroup_(blocksPerGroup),
+      reservationBlocks_(reservationBlocks),
+      groups_(numGroups),
+      nextDirectoryGroup_(0)
+{
+    assert(0 < fsBlockSize_);
+    assert(int64_t(NUM_INODE_TABLE_BLOCKS) < blocksPerGroup_);
+    assert(0 < numGroups);
+    assert(0 <= reservationBlocks_);
+
+    // Each group's data blocks follow its inode table
+    for (size_t i = 0; i < groups_.size(); i++)
+    {
+        FSBlock groupBegin = i * blocksPerGroup_;
+        int64_t numDataBlocks = blocksPerGroup_ - NUM_INODE_TABLE_BLOCKS;
+        groups_[i].freeExtents[groupBegin + NUM_INODE_TABLE_BLOCKS] =
+            numDataBlocks;
+        groups_[i].numFreeBlocks = numDataBlocks;
+        groups_[i].nextINode = 0;
+    }
+}
+
+size_t ExtentStorageLayout::getNumExtents(FileId fileId) const
+{
+    return getFileLayout(fileId).extents.size();
+}
+
+FSSize ExtentStorageLayout::getNumFreeBlocks() const
+{
+    FSSize numFreeBlocks = 0;
+    for (size_t i = 0; i < groups_.size(); i++)
+    {
+        numFreeBlocks += groups_[i].numFreeBlocks;
+    }
+    return numFreeBlocks;
+}
+
+void ExtentStorageLayout::addDirectoryToLayout(FileId dirId)
+{
+    // Spread directories across the allocation groups
+    size_t group = nextDirectoryGroup_++ % groups_.size();
+    FileLayout& layout = createFileLayout(dirId, group);
+
+    // Assign a fixed number of blocks for storing directory entries, and
+    // release the reservation as directories do not grow
+    allocateFileBlocks(layout, 0, NUM_DIRECTORY_DATA_BLOCKS - 1);
+    if (0 < layout.reservationBlocks)
+    {
+        freeBlocks(layout.reservationBegin, layout.reservationBlocks);
+        layout.reservationBlocks = 0;
+    }
+}
+
+void ExtentStorageLayout::addFileToLayout(FileId fileId, FSSize fileSize)
+{
+    // Place the file in its parent directory's group
+    const FileIdRegistry& registry = FileIdRegistry::instance();
+    FileId parentId;
+    map<FileId, FileLayout>::const_iterator parent = files_.end();
+    if (registry.find(registry.getFilename(fileId).getParent(), parentId))
+    {
+        parent = files_.find(parentId);
+    }
+
+    size_t group;
+    if (files_.end() != parent)
+    {
+        group = parent->second.group;
+    }
+    else
+    {
+        group = nextDirectoryGroup_++ % groups_.size();
+    }
+    FileLayout& layout = createFileLayout(fileId, group);
+
+    // Allocate the file's existing data
+    if (0 < fileSize)
+    {
+        allocateFileBlocks(layout, 0, (fileSize - 1) / fsBlockSize_);
+    }
+}
+
+vector<FSBlock> ExtentStorageLayout::getLayoutFileDataBlocks(
+    FileId fileId, vector<FileRegion> regions) const
+{
+    const FileLayout& layout = getFileLayout(fileId);
+    vector<FSBlock> blocks;
+    for (size_t i = 0; i < regions.size(); i++)
+    {
+        if (0 < regions[i].extent)
+        {
+            FSBlock first = regions[i].offset / fsBlockSize_;
+            FSBlock last =
+                (regions[i].offset + regions[i].extent - 1) / fsBlockSize_;
+            appendMappedBlocks(layout, first, last, blocks);
+        }
+    }
+    return blocks;
+}
+
+vector<FSBlock> ExtentStorageLayout::allocateLayoutFileDataBlocks(
+    FileId fileId, vector<FileRegion> regions)
+{
+    map<FileId, FileLayout>::iterator iter = files_.find(fileId);
+    assert(files_.end() != iter);
+    FileLayout& layout = iter->second;
+
+    vector<FSBlock> blocks;
+    for (size_t i = 0; i < regions.size(); i++)
+    {
+        if (0 < regions[i].extent)
+        {
+            FSBlock first = regions[i].offset / fsBlockSize_;
+            FSBlock last =
+                (regions[i].offset + regions[i].extent - 1) / fsBlockSize_;
+            allocateFileBlocks(layout, first, last);
+            appendMappedBlocks(layout, first, last, blocks);
+        }
+    }
+    return blocks;
+}
+
+vector<FSBlock> ExtentStorageLayout::getLayoutFileMetaDataBlocks(
+    FileId fileId) const
+{
+    vector<FSBlock> blocks(1);
+    blocks[0] = getFileLayout(fileId).inodeBlock;
+    return blocks;
+}
+
+ExtentStorageLayout::FileLayout& ExtentStorageLayout::createFileLayout(
+    FileId fileId, size_t group)
+{
+    // Assign the next block of the group's inode table
+    AllocationGroup& ag = groups_[group];
+    FileLayout& layout = files_[fileId];
+    layout.group = group;
+    layout.inodeBlock =
+        group * blocksPerGroup_ + (ag.nextINode++ % NUM_INODE_TABLE_BLOCKS);
+    layout.extents.clear();
+    layout.reservationBegin = 0;
+    layout.reservationBlocks = 0;
+    return layout;
+}
+
+const ExtentStorageLayout::FileLayout& ExtentStorageLayout::getFileLayout(
+    FileId fileId) const
+{
+    map<FileId, FileLayout>::const_iterator iter = files_.find(fileId);
+    assert(files_.end() != iter);
+    return iter->second;
+}
+
+void ExtentStorageLayout::appendMappedBlocks(const FileLayout& layout,
+                                             FSBlock first,
+                                             FSBlock last,
+                                             vector<FSBlock>& outBlocks) const
+{
+    // Begin with the extent holding or following the first block
+    map<FSBlock, Extent>::const_iterator iter =
+        layout.extents.upper_bound(first);
+    if (layout.extents.begin() != iter)
+    {
+        --iter;
+        if (iter->first + iter->second.numBlocks <= first)
+        {
+            ++iter;
+        }
+    }
+
+    for (; layout.extents.end() != iter && iter->first <= last; ++iter)
+    {
+        FSBlock begin = max(first, iter->first);
+        FSBlock end = min(last, iter->first + iter->second.numBlocks - 1);
+        for (FSBlock fileBlock = begin; fileBlock <= end; fileBlock++)
+        {
+            outBlocks.push_back(
+                iter->second.physicalBlock + (fileBlock - iter->first));
+        }
+    }
+}
+
+void ExtentStorageLayout::allocateFileBlocks(FileLayout& layout,
+                                             FSBlock first,
+                                             FSBlock last)
+{
+    FSBlock fileBlock = first;
+    while (fileBlock <= last)
+    {
+        // Skip blocks that are already mapped
+        map<FSBlock, Extent>::iterator next =
+            layout.extents.upper_bound(fileBlock);
+        if (layout.extents.begin() != next)
+        {
+            map<FSBlock, Extent>::iterator prev = next;
+            --prev;
+            FSBlock prevEnd = prev->first + prev->second.numBlocks;
+            if (fileBlock < prevEnd)
+            {
+                fileBlock = prevEnd;
+                continue;
+            }
+        }
+
+        // Allocate the unmapped run
+        FSBlock end = last + 1;
+        if (layout.extents.end() != next)
+        {
+            end = min(end, next->first);
+        }
+        allocateExtent(layout, fileBlock, end - fileBlock);
+        fileBlock = end;
+    }
+}
+
+void ExtentStorageLayout::allocateExtent(FileLayout& layout,
+                                         FSBlock fileBlock,
+                                         int64_t numBlocks)
+{
+    while (0 < numBlocks)
+    {
+        // The goal is the block following the previous file block
+        FSBlock goal = -1;
+        map<FSBlock, Extent>::iterator prev =
+            layout.extents.lower_bound(fileBlock);
+        if (layout.extents.begin() != prev)
+        {
+            --prev;
+            if (prev->first + prev->second.numBlocks == fileBlock)
+            {
+                goal = prev->second.physicalBlock + prev->second.numBlocks;
+            }
+        }
+
+        // Allocate from the reservation if it continues the file
+        if (0 < layout.reservationBlocks &&
+            (-1 == goal || goal == layout.reservationBegin))
+        {
+            int64_t length = min(numBlocks, layout.reservationBlocks);
+            addExtent(layout, fileBlock, layout.reservationBegin, length);
+            layout.reservationBegin += length;
+            layout.reservationBlocks -= length;
+            fileBlock += length;
+            numBlocks -= length;
+            continue;
+        }
+
+        // Otherwise release the reservation and reserve a new window
+        if (0 < layout.reservationBlocks)
+        {
+            freeBlocks(layout.reservationBegin, layout.reservationBlocks);
+            layout.reservationBlocks = 0;
+        }
+
+        FSBlock begin = 0;
+        int64_t length = allocateFreeBlocks(layout.group,
+                                           goal,
+                                           max(numBlocks, reservationBlocks_),
+                                           begin);
+        int64_t used = min(numBlocks, length);
+        addExtent(layout, fileBlock, begin, used);
+        layout.reservationBegin = begin + used;
+        layout.reservationBlocks = length - used;
+        fileBlock += used;
+        numBlocks -= used;
+    }
+}
+
+void ExtentStorageLayout::addExtent(FileLayout& layout,
+                                    FSBlock fileBlock,
+                                    FSBlock physicalBlock,
+                                    int64_t numBlocks)
+{
+    // Extend the previous extent when the blocks continue it
+    map<FSBlock, Extent>::iterator prev = layout.extents.lower_bound(fileBlock);
+    if (layout.extents.begin() != prev)
+    {
+        --prev;
+        if (prev->first + prev->second.numBlocks == fileBlock &&
+            prev->second.physicalBlock + prev->second.numBlocks == physicalBlock)
+        {
+            prev->second.numBlocks += numBlocks;
+            return;
+        }
+    }
+
+    Extent extent = {physicalBlock, numBlocks};
+    layout.extents[fileBlock] = extent;
+}
+
+int64_t ExtentStorageLayout::allocateFreeBlocks(size_t group,
+                                               FSBlock goal,
+                                               int64_t maxBlocks,
+                                               FSBlock& outBegin)
+{
+    assert(0 < maxBlocks);
+
+    // Search from the goal's group, or the file's group without a goal
+    size_t firstGroup = (-1 == goal) ? group : getGroup(goal);
+    for (size_t i = 0; i < groups_.size(); i++)
+    {
+        size_t groupNumber = (firstGroup + i) % groups_.size();
+        AllocationGroup& ag = groups_[groupNumber];
+        if (ag.freeExtents.empty())
+        {
+            continue;
+        }
+
+        // Prefer the free extent holding or following the goal
+        map<FSBlock, int64_t>::iterator iter = ag.freeExtents.begin();
+        FSBlock begin = iter->first;
+        if (0 == i && -1 != goal)
+        {
+            iter = ag.freeExtents.upper_bound(goal);
+            if (ag.freeExtents.begin() != iter)
+            {
+                map<FSBlock, int64_t>::iterator prev = iter;
+                --prev;
+                if (goal < prev->first + prev->second)
+                {
+                    iter = prev;
+                }
+            }
+            if (ag.freeExtents.end() == iter)
+            {
+                iter = ag.freeExtents.begin();
+            }
+
+            begin = iter->first;
+            if (iter->first <= goal && goal < iter->first + iter->second)
+            {
+                begin = goal;
+            }
+        }
+
+        // Split the free extent around the allocated blocks
+        FSBlock extentBegin = iter->first;
+        FSBlock extentEnd = iter->first + iter->second;
+        int64_t length = min(maxBlocks, extentEnd - begin);
+        ag.freeExtents.erase(iter);
+        if (extentBegin < begin)
+        {
+            ag.freeExtents[extentBegin] = begin - extentBegin;
+        }
+        if (begin + length < extentEnd)
+        {
+            ag.freeExtents[begin + length] = extentEnd - (begin + length);
+        }
+        ag.numFreeBlocks -= length;
+        outBegin = begin;
+        return length;
+    }
+
+    cerr << __FILE__ << ":" << __LINE__ << ":"
+         << "ERROR: Storage layout has no free blocks" << endl;
+    assert(0);
+    return 0;
+}
+
+void ExtentStorageLayout::freeBlocks(FSBlock begin, int64_t numBlocks)
+{
+    AllocationGroup& ag = groups_[getGroup(begin)];
+    ag.numFreeBlocks += numBlocks;
+
+    // Merge with the following free extent
+    map<FSBlock, int64_t>::iterator next = ag.freeExtents.lower_bound(begin);
+    if (ag.freeExtents.end() != next && begin + numBlocks == next->first)
+    {
+        numBlocks += next->second;
+        ag.freeExtents.erase(next++);
+    }
+
+    // Merge with the preceding free extent
+    if (ag.freeExtents.begin() != next)
+    {
+        map<FSBlock, int64_t>::iterator prev = next;
+        --prev;
+        if (prev->first + prev->second == begin)
+        {
+            prev->second += numBlocks;
+            return;
+        }
+    }
+    ag.freeExtents[begin] = numBlocks;
+}
+
+size_t ExtentStorageLayout::getGroup(FSBlock block) const
+{
+    return size_t(block / blocksPerGroup_);
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,202 @@
+#ifndef EXTENT_STORAGE_LAYOUT_H
+#define EXTENT_STORAGE_LAYOUT_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstddef>
+#include <map>
+#include <vector>
+#include "basic_types.h"
+#include "filename.h"
+#include "storage_layout.h"
+
+/**
+ * Provides an extent allocating disk layout.
+ *
+ * The disk is divided into allocation groups, each beginning with an inode
+ * table.  Directories are spread across the groups, and a file is placed in
+ * the group of its parent directory.  Data blocks are allocated when they
+ * are first written, and are mapped by a per-file tree of extents.
+ *
+ * Each file reserves a window of reservationBlocks free blocks following
+ * its last allocation, and later appends are allocated from the window,
+ * as delayed allocation would.  Files written concurrently in the same
+ * group interleave at the granularity of their windows, fragmenting into
+ * multiple extents.
+ */
+class ExtentStorageLayout : public StorageLayout
+{
+public:
+
+    /** The number of data blocks to assign to a directory */
+    static const std::size_t NUM_DIRECTORY_DATA_BLOCKS = 10;
+
+    /** The number of inode blocks at the beginning of each group */
+    static const std::size_t NUM_INODE_TABLE_BLOCKS = 64;
+
+    /**
+     * Constructor
+     *
+     * @param blockSize the file system block size in bytes
+     * @param blocksPerGroup the number of blocks in each allocation group
+     * @param numGroups the number of allocation groups
+     * @param reservationBlocks the number of blocks reserved for appends
+     */
+    ExtentStorageLayout(std::size_t blockSize,
+                        int64_t blocksPerGroup,
+                        std::size_t numGroups,
+                        int64_t reservationBlocks);
+
+    /** @return the number of extents mapping a file's data */
+    std::size_t getNumExtents(FileId fileId) const;
+
+    /** @return the number of free (and unreserved) data blocks */
+    FSSize getNumFreeBlocks() const;
+
+protected:
+
+    /** Add layout information for a directory */
+    virtual void addDirectoryToLayout(FileId dirId);
+
+    /** Add layout information for a file */
+    virtual void addFileToLayout(FileId fileId, FSSize size);
+
+    /**
+     * @return vector of data blocks for a file and vector of file regions,
+     *   omitting unallocated blocks
+     */
+    virtual std::vector<FSBlock> getLayoutFileDataBlocks(
+        FileId fileId, std::vector<FileRegion> regions) const;
+
+    /** @return vector of data blocks written, allocating any new blocks */
+    virtual std::vector<FSBlock> allocateLayoutFileDataBlocks(
+        FileId fileId, std::vector<FileRegion> regions);
+
+    /** @return the metadata blocks associated with a file */
+    virtual std::vector<FSBlock> getLayoutFileMetaDataBlocks(
+        FileId fileId) const;
+
+private:
+
+    /** A run of physical blocks mapped to a run of file blocks */
+    struct Extent
+    {
+        FSBlock physicalBlock;
+        int64_t numBlocks;
+    };
+
+    /** Layout of a file or directory */
+    struct FileLayout
+    {
+        /** The file's allocation group */
+        std::size_t group;
+
+        /** The file's inode block */
+        FSBlock inodeBlock;
+
+        /** Extents keyed by first file block */
+        std::map<FSBlock, Extent> extents;
+
+        /** Blocks reserved for the file's next allocation */
+        FSBlock reservationBegin;
+        int64_t reservationBlocks;
+    };
+
+    /** Free space of an allocation group */
+    struct AllocationGroup
+    {
+        /** Free extents keyed by first block */
+        std::map<FSBlock, int64_t> freeExtents;
+
+        /** The number of free blocks */
+        int64_t numFreeBlocks;
+
+        /** The next inode block to assign */
+        std::size_t nextINode;
+    };
+
+    /** Copy constructor hidden */
+    ExtentStorageLayout( StorageLayout& other );
+
+    /** Assignment operator hidden */
+    ExtentStorageLayout operator=(StorageLayout& other );
+
+    /** Create the layout for a new file in group */
+    FileLayout& createFileLayout(FileId fileId, std::size_t group);
+
+    /** @return the layout of an existing file */
+    const FileLayout& getFileLayout(FileId fileId) const;
+
+    /** Append the physical blocks mapped to [first, last] of a file */
+    void appendMappedBlocks(const FileLayout& layout,
+                            FSBlock first,
+                            FSBlock last,
+                            std::vector<FSBlock>& outBlocks) const;
+
+    /** Allocate the unmapped blocks in [first, last] of a file */
+    void allocateFileBlocks(FileLayout& layout, FSBlock first, FSBlock last);
+
+    /** Map [fileBlock, fileBlock + numBlocks) to physical blocks */
+    void allocateExtent(FileLayout& layout,
+                        FSBlock fileBlock,
+                        int64_t numBlocks);
+
+    /** Add a mapping to the file's extent tree */
+    void addExtent(FileLayout& layout,
+                   FSBlock fileBlock,
+                   FSBlock physicalBlock,
+                   int64_t numBlocks);
+
+    /**
+     * Remove up to maxBlocks free blocks from the disk, preferring blocks
+     * at goal, then following goal within goal's group, then within the
+     * remaining groups
+     *
+     * @return the number of blocks allocated beginning at outBegin
+     */
+    int64_t allocateFreeBlocks(std::size_t group,
+                              FSBlock goal,
+                              int64_t maxBlocks,
+                              FSBlock& outBegin);
+
+    /** Return blocks to the free space of their group */
+    void freeBlocks(FSBlock begin, int64_t numBlocks);
+
+    /** @return the group holding a block */
+    std::size_t getGroup(FSBlock block) const;
+
+    /** File system's block size */
+    std::size_t fsBlockSize_;
+
+    /** Blocks in each allocation group */
+    int64_t blocksPerGroup_;
+
+    /** Blocks reserved for a file's appends */
+    int64_t reservationBlocks_;
+
+    /** Allocation group free space */
+    std::vector<AllocationGroup> groups_;
+
+    /** Group to assign the next directory */
+    std::size_t nextDirectoryGroup_;
+
+    /** Layout of each file and directory */
+    std::map<FileId, FileLayout> files_;
+};
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -8,9 +8,13 @@
 //
 #include "file_system.h"
 #include <cassert>
+#include <string>
 #include <vector>
+#include "block_list_planner.h"
+#include "file_id_registry.h"
 #include "filename.h"
 #include "os_proto_m.h"
+#include "extent_storage_layout.h"
 #include "fixed_inode_storage_layout.h"
 using namespace std;
 
@@ -43,12 +47,18 @@ void FileSystem::initialize()
     outGateId_ = findGate("out");
     requestGateId_ = findGate("request");
 
+    // Initialize statistics
+    mergeRatioVector_.setName("SPFS File System List I/O Merge Ratio");
+    statNumPartialBlockReads_ = 0;
+
     // Initialize concrete file system
     initializeFileSystem();
 }
 
 void FileSystem::finish()
 {
+    recordScalar("SPFS File System Partial Block Reads",
+                 statNumPartialBlockReads_);
     finishFileSystem();
 }
 
@@ -63,7 +73,12 @@ void FileSystem::handleMessage(cMessage *msg)
     // and then process the response
     if (msg->getArrivalGateId() == inGateId_)
     {
-        processMessage(dynamic_cast<spfsOSFileRequest*>(msg), msg);
+        // Intern the filename once for all of the request's layout lookups
+        spfsOSFileRequest* request = dynamic_cast<spfsOSFileRequest*>(msg);
+        assert(0 != request);
+        Filename filename(request->getFilename());
+        request->setFileId(FileIdRegistry::instance().intern(filename));
+        processMessage(request, msg);
     }
     else
     {
@@ -155,6 +170,7 @@ void FileSystem::processIOMessage(spfsOSFileLIORequest* request, cMessage* msg)
     enum {
         INIT = 0,
         READ_META = FSM_Steady(1),
+        READ_PARTIAL_BLOCKS = FSM_Steady(6),
         SEND_IO_REQUEST = FSM_Transient(2),
         WRITE_META = FSM_Steady(3),
         IO_COMPLETE = FSM_Steady(4),
@@ -177,6 +193,27 @@ void FileSystem::processIOMessage(spfsOSFileLIORequest* request, cMessage* msg)
             break;
         }
         case FSM_Exit(READ_META):
+        {
+            // Writes read the allocated blocks they partially overwrite
+            assert(0 != dynamic_cast<spfsOSReadBlocksResponse*>(msg));
+            if (0 != dynamic_cast<spfsOSFileWriteRequest*>(request) &&
+                !getPartialDataBlocks(request).empty())
+            {
+                FSM_Goto(currentState, READ_PARTIAL_BLOCKS);
+            }
+            else
+            {
+                FSM_Goto(currentState, SEND_IO_REQUEST);
+            }
+            break;
+        }
+        case FSM_Enter(READ_PARTIAL_BLOCKS):
+        {
+            assert(0 != dynamic_cast<spfsOSReadBlocksResponse*>(msg));
+            readPartialBlocks(request);
+            break;
+        }
+        case FSM_Exit(READ_PARTIAL_BLOCKS):
         {
             assert(0 != dynamic_cast<spfsOSReadBlocksResponse*>(msg));
             FSM_Goto(currentState, SEND_IO_REQUEST);
@@ -239,8 +276,7 @@ void FileSystem::processIOMessage(spfsOSFileLIORequest* request, cMessage* msg)
 void FileSystem::readMetaData(spfsOSFileRequest* request)
 {
     // Lookup the metadata blocks
-    Filename filename(request->getFilename());
-    vector<FSBlock> blocks = getMetaDataBlocks(filename);
+    vector<FSBlock> blocks = getMetaDataBlocks(request->getFileId());
     assert(0 != blocks.size());
 
     // Construct the read message
@@ -256,8 +292,7 @@ void FileSystem::readMetaData(spfsOSFileRequest* request)
 void FileSystem::writeMetaData(spfsOSFileRequest* request)
 {
     // Lookup the metadata blocks
-    Filename filename(request->getFilename());
-    vector<FSBlock> blocks = getMetaDataBlocks(filename);
+    vector<FSBlock> blocks = getMetaDataBlocks(request->getFileId());
     assert(0 != blocks.size());
 
     // Write the first meta data block to simulate updating the atime
@@ -280,14 +315,36 @@ void FileSystem::writeMetaData(spfsOSFileRequest* request)
     send(writeBlock, requestGateId_);
 }
 
-void FileSystem::performIO(spfsOSFileLIORequest* ioRequest)
+void FileSystem::readPartialBlocks(spfsOSFileLIORequest* ioRequest)
 {
-    // Convert the file system request into block requests
-    vector<FSBlock> blocks = getDataBlocks(ioRequest);
+    // Read the partial blocks in a single sorted request
+    BlockListPlanner plan(getPartialDataBlocks(ioRequest));
+    const vector<FSBlock>& blocks = plan.getBlocks();
+    assert(0 != blocks.size());
+    statNumPartialBlockReads_ += blocks.size();
+
+    spfsOSReadBlocksRequest* readBlocks =
+        new spfsOSReadBlocksRequest(0, SPFS_OS_READ_BLOCKS_REQUEST);
+    readBlocks->setContextPointer(ioRequest);
+    readBlocks->setBlocksArraySize(blocks.size());
+    for (size_t i = 0; i < blocks.size(); i++)
+        readBlocks->setBlocks(i, blocks[i]);
+    send(readBlocks, requestGateId_);
+}
 
+void FileSystem::performIO(spfsOSFileLIORequest* ioRequest)
+{
     // Fill out the appropriate read or write message
     if (0 != dynamic_cast<spfsOSFileReadRequest*>(ioRequest))
     {
+        // Convert the file system request into a sorted list of unique
+        // block requests
+        BlockListPlanner plan(getDataBlocks(ioRequest));
+        const vector<FSBlock>& blocks = plan.getBlocks();
+        if (0 != plan.getNumRuns())
+        {
+            mergeRatioVector_.record(plan.getMergeRatio());
+        }
         spfsOSReadBlocksRequest* readBlocks =
             new spfsOSReadBlocksRequest(0, SPFS_OS_READ_BLOCKS_REQUEST);
         readBlocks->setContextPointer(ioRequest);
@@ -298,6 +355,14 @@ void FileSystem::performIO(spfsOSFileLIORequest* ioRequest)
     }
     else
     {
+        // Convert the file system request into a sorted list of unique
+        // block requests, allocating storage for any new blocks
+        BlockListPlanner plan(allocateDataBlocks(ioRequest));
+        const vector<FSBlock>& blocks = plan.getBlocks();
+        if (0 != plan.getNumRuns())
+        {
+            mergeRatioVector_.record(plan.getMergeRatio());
+        }
         spfsOSWriteBlocksRequest* writeBlocks =
             new spfsOSWriteBlocksRequest(0, SPFS_OS_WRITE_BLOCKS_REQUEST);
         writeBlocks->setContextPointer(ioRequest);
@@ -347,7 +412,20 @@ void NativeFileSystem::initializeFileSystem()
     blockSize_ = par("blockSizeBytes").longValue();
 
     // Construct the storage layout for the file system
-    storageLayout_ = new FixedINodeStorageLayout(getBlockSize());
+    string layoutType = par("storageLayoutType").stringValue();
+    if ("ExtentStorageLayout" == layoutType)
+    {
+        storageLayout_ =
+            new ExtentStorageLayout(getBlockSize(),
+                                    par("blocksPerGroup").longValue(),
+                                    par("numAllocationGroups").longValue(),
+                                    par("reservationBlocks").longValue());
+    }
+    else
+    {
+        assert("FixedINodeStorageLayout" == layoutType);
+        storageLayout_ = new FixedINodeStorageLayout(getBlockSize());
+    }
 }
 
 void NativeFileSystem::finishFileSystem()
@@ -368,34 +446,57 @@ void NativeFileSystem::allocateFileStorage(const Filename& filename,
     storageLayout_->addFile(filename, size);
 }
 
-vector<FSBlock> NativeFileSystem::getMetaDataBlocks(
-    const Filename& filename) const
+vector<FSBlock> NativeFileSystem::getMetaDataBlocks(FileId fileId) const
 {
-    return storageLayout_->getFileMetaDataBlocks(filename);
+    return storageLayout_->getFileMetaDataBlocks(fileId);
 }
 
 vector<FSBlock> NativeFileSystem::getDataBlocks(
-    const Filename& filename, FSOffset offset, FSSize extent) const
+    FileId fileId, FSOffset offset, FSSize extent) const
 {
-    return storageLayout_->getFileDataBlocks(filename, offset, extent);
+    return storageLayout_->getFileDataBlocks(fileId, offset, extent);
 }
 
 vector<FSBlock> NativeFileSystem::getDataBlocks(
     spfsOSFileLIORequest* ioRequest) const
 {
     assert(0 != ioRequest);
+    return storageLayout_->getFileDataBlocks(ioRequest->getFileId(),
+                                             getFileRegions(ioRequest));
+}
+
+vector<FSBlock> NativeFileSystem::allocateDataBlocks(
+    spfsOSFileLIORequest* ioRequest)
+{
+    assert(0 != ioRequest);
+    return storageLayout_->allocateFileDataBlocks(ioRequest->getFileId(),
+                                                  getFileRegions(ioRequest));
+}
+
+vector<FSBlock> NativeFileSystem::getPartialDataBlocks(
+    spfsOSFileLIORequest* ioRequest) const
+{
+    assert(0 != ioRequest);
+    vector<FileRegion> partialRegions =
+        BlockListPlanner::getPartialBlockRegions(getFileRegions(ioRequest),
+                                                 getBlockSize());
+    return storageLayout_->getFileDataBlocks(ioRequest->getFileId(),
+                                             partialRegions);
+}
+
+vector<FileRegion> NativeFileSystem::getFileRegions(
+    spfsOSFileLIORequest* ioRequest)
+{
     // Create the regions from the request
     int numRegions = ioRequest->getOffsetArraySize();
-    vector<FileRegion> regions(numRegions);
+    vector<FileRegion> regions;
+    regions.reserve(numRegions);
     for (int i = 0; i < numRegions; i++)
     {
         FileRegion fr = {ioRequest->getOffset(i), ioRequest->getExtent(i)};
         regions.push_back(fr);
     }
-
-    // Get the blocks from the storage layout
-    Filename f(ioRequest->getFilename());
-    return storageLayout_->getFileDataBlocks(f, regions);
+    return regions;
 }
 
 /*
@@ -28,9 +28,10 @@ class spfsOSFileRequest;
  * - Reads meta data on file open
  * - Loads metadata before accessing data blocks
  * - Writes first metadata block on reads and writes (i.e. modifies the atime)
+ * - Reads partially written blocks before writing them
+ * - Sorts list I/O blocks and removes duplicates before submitting them
  *
  * TODO: The following additional feature(s) are desired:
- * - Read block before writing partial blocks
  * - Journal structures for metadata writing
  * - Support for an O_DIRECT type mode that bypasses the block cache
  *
@@ -94,20 +95,30 @@ private:
     /** Update the meta data to signal the file I/O has been performed */
     void writeMetaData(spfsOSFileRequest* request);
 
+    /** Read the partially written blocks for a file write request */
+    void readPartialBlocks(spfsOSFileLIORequest* ioRequest);
+
     /** Send a request for the data blocks for a file I/O request */
     void performIO(spfsOSFileLIORequest* ioRequest);
 
     /** Send the final read or write response */
     void sendFileIOResponse(spfsOSFileLIORequest* ioRequest);
 
-    /** @return the meta data blocks for a filename */
-    virtual std::vector<FSBlock> getMetaDataBlocks(
-        const Filename& filename) const = 0;
+    /** @return the meta data blocks for a file */
+    virtual std::vector<FSBlock> getMetaDataBlocks(FileId fileId) const = 0;
 
     /** @return the data blocks for a file region */
     virtual std::vector<FSBlock> getDataBlocks(
         spfsOSFileLIORequest* ioRequest) const = 0;
 
+    /** @return the data blocks to write, allocating any new blocks */
+    virtual std::vector<FSBlock> allocateDataBlocks(
+        spfsOSFileLIORequest* ioRequest) = 0;
+
+    /** @return the allocated blocks partially written by a file region */
+    virtual std::vector<FSBlock> getPartialDataBlocks(
+        spfsOSFileLIORequest* ioRequest) const = 0;
+
     /** Flag indicating if atime is updated on each access */
     bool noATime_;
 
@@ -119,13 +130,19 @@ private:
 
     /** request gate id */
     int requestGateId_;
+
+    /** Requested blocks per submitted run for each list I/O request */
+    cOutVector mergeRatioVector_;
+
+    /** Statistics */
+    double statNumPartialBlockReads_;
 };
 
 /**
  * Model of a Native OS File System.  Supports the following features:
  *
  * - Configurable block size
- * - Contiguous disk layout
+ * - Contiguous or extent allocating disk layout
  *
  */
 class NativeFileSystem : public FileSystem
@@ -152,18 +169,29 @@ protected:
 
 private:
 
-    /** @return the meta data blocks for a filename */
-    virtual std::vector<FSBlock> getMetaDataBlocks(
-        const Filename& filename) const;
+    /** @return the meta data blocks for a file */
+    virtual std::vector<FSBlock> getMetaDataBlocks(FileId fileId) const;
 
     /** @return the data blocks for a file region */
     virtual std::vector<FSBlock> getDataBlocks(
-        const Filename& filename, FSOffset offset, FSSize extent) const;
+        FileId fileId, FSOffset offset, FSSize extent) const;
 
     /** @return the data blocks for a list file region */
     virtual std::vector<FSBlock> getDataBlocks(
         spfsOSFileLIORequest* ioRequest) const;
 
+    /** @return the data blocks to write, allocating any new blocks */
+    virtual std::vector<FSBlock> allocateDataBlocks(
+        spfsOSFileLIORequest* ioRequest);
+
+    /** @return the allocated blocks partially written by a file region */
+    virtual std::vector<FSBlock> getPartialDataBlocks(
+        spfsOSFileLIORequest* ioRequest) const;
+
+    /** @return the file regions accessed by the request */
+    static std::vector<FileRegion> getFileRegions(
+        spfsOSFileLIORequest* ioRequest);
+
     /** File system block size in bytes */
     std::size_t blockSize_;
 
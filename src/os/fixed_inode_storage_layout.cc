@@ -22,35 +22,34 @@ FixedINodeStorageLayout::FixedINodeStorageLayout(size_t blockSize)
     nextDataBlock_ = 1000;
 }
 
-void FixedINodeStorageLayout::addDirectoryToLayout(const Filename& dirName)
+void FixedINodeStorageLayout::addDirectoryToLayout(FileId dirId)
 {
     // Assign a single block for storing directory metadata
-    metaDataBlocks_[dirName] = nextMetaDataBlock_++;
+    metaDataBlocks_[dirId] = nextMetaDataBlock_++;
 
     // Assign a fixed number of blocks for storing directory entries
-    dataBlocks_[dirName] = nextDataBlock_;
+    dataBlocks_[dirId] = nextDataBlock_;
     nextDataBlock_ += NUM_DIRECTORY_DATA_BLOCKS;
 }
 
-void FixedINodeStorageLayout::addFileToLayout(const Filename& filename,
-                                              FSSize fileSize)
+void FixedINodeStorageLayout::addFileToLayout(FileId fileId, FSSize fileSize)
 {
     // Assign a single block for storing the inodes
-    metaDataBlocks_[filename] = nextMetaDataBlock_++;
+    metaDataBlocks_[fileId] = nextMetaDataBlock_++;
 
     // Assign contiguous data blocks to the file
     int64_t numBlocks = fileSize / fsBlockSize_;
-    dataBlocks_[filename] = nextDataBlock_;
+    dataBlocks_[fileId] = nextDataBlock_;
     nextDataBlock_ += numBlocks;
 
 }
 
 vector<FSBlock> FixedINodeStorageLayout::getLayoutFileMetaDataBlocks(
-    const Filename& filename) const
+    FileId fileId) const
 {
     // Locate the file's inode block
-    std::map<Filename, FSBlock>::const_iterator iter =
-        metaDataBlocks_.find(filename);
+    std::map<FileId, FSBlock>::const_iterator iter =
+        metaDataBlocks_.find(fileId);
     assert(metaDataBlocks_.end() != iter);
 
     // Return the inode block
@@ -60,13 +59,12 @@ vector<FSBlock> FixedINodeStorageLayout::getLayoutFileMetaDataBlocks(
 }
 
 vector<FSBlock> FixedINodeStorageLayout::getLayoutFileDataBlocks(
-    const Filename& filename, vector<FileRegion> regions) const
+    FileId fileId, vector<FileRegion> regions) const
 {
     vector<FSBlock> blocks;
 
     // Locate the file's first block
-    std::map<Filename, FSBlock>::const_iterator iter =
-        dataBlocks_.find(filename);
+    std::map<FileId, FSBlock>::const_iterator iter = dataBlocks_.find(fileId);
     assert(dataBlocks_.end() != iter);
     FSBlock firstFileBlock = iter->second;
 
@@ -28,18 +28,18 @@ public:
 protected:
 
     /** Add layout information for a directory */
-    virtual void addDirectoryToLayout(const Filename& filename);
+    virtual void addDirectoryToLayout(FileId dirId);
 
     /** Add layout information for a file */
-    virtual void addFileToLayout(const Filename& filename, FSSize size);
+    virtual void addFileToLayout(FileId fileId, FSSize size);
 
     /** @return vector of data blocks for a file and vector of file regions */
     virtual std::vector<FSBlock> getLayoutFileDataBlocks(
-        const Filename& file, std::vector<FileRegion> regions) const;
+        FileId fileId, std::vector<FileRegion> regions) const;
 
     /** @return the metadata blocks associated with a file */
     virtual std::vector<FSBlock> getLayoutFileMetaDataBlocks(
-        const Filename& file) const;
+        FileId fileId) const;
 
 
 private:
@@ -60,10 +60,10 @@ private:
     FSBlock nextDataBlock_;
 
     /** Map to the first inode block for a file */
-    std::map<Filename, FSBlock> metaDataBlocks_;
+    std::map<FileId, FSBlock> metaDataBlocks_;
 
     /** Map to the first data block for a file */
-    std::map<Filename, FSBlock> dataBlocks_;
+    std::map<FileId, FSBlock> dataBlocks_;
 };
 
 #endif
@@ -5,8 +5,10 @@ DIR := src/os
 
 SIM_SRC += $(DIR)/access_manager.cc \
 	$(DIR)/buffer_cache.cc \
+	$(DIR)/block_list_planner.cc \
 	$(DIR)/block_translator.cc \
 	$(DIR)/disk_scheduler.cc \
+	$(DIR)/extent_storage_layout.cc \
 	$(DIR)/file_system.cc \
 	$(DIR)/fixed_inode_storage_layout.cc \
 	$(DIR)/io_library.cc \
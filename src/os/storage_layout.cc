@@ -8,6 +8,7 @@
 //
 #include "storage_layout.h"
 #include <cassert>
+#include "file_id_registry.h"
 using namespace std;
 
 StorageLayout::StorageLayout()
@@ -18,38 +19,52 @@ StorageLayout::~StorageLayout()
 {
 }
 
-void StorageLayout::addDirectory(const Filename& dirName)
+FileId StorageLayout::addDirectory(const Filename& dirName)
 {
-    addDirectoryToLayout(dirName);
+    FileId dirId = FileIdRegistry::instance().intern(dirName);
+    addDirectoryToLayout(dirId);
+    return dirId;
 }
 
-void StorageLayout::addFile(const Filename& filename, FSSize fileSize)
+FileId StorageLayout::addFile(const Filename& filename, FSSize fileSize)
 {
-    addFileToLayout(filename, fileSize);
+    FileId fileId = FileIdRegistry::instance().intern(filename);
+    addFileToLayout(fileId, fileSize);
+    return fileId;
 }
 
-vector<FSBlock> StorageLayout::getFileMetaDataBlocks(
-    const Filename& filename) const
+vector<FSBlock> StorageLayout::getFileMetaDataBlocks(FileId fileId) const
 {
-    return getLayoutFileMetaDataBlocks(filename);
+    return getLayoutFileMetaDataBlocks(fileId);
 }
 
-vector<FSBlock> StorageLayout::getFileDataBlocks(const Filename& filename,
+vector<FSBlock> StorageLayout::getFileDataBlocks(FileId fileId,
                                                  FSOffset offset,
                                                  FSSize extent) const
 {
     // Create a file region
     FileRegion fr = {offset, extent};
-    vector<FileRegion> regions(1);
-    regions.push_back(fr);
+    vector<FileRegion> regions(1, fr);
 
-    return getFileDataBlocks(filename, regions);
+    return getFileDataBlocks(fileId, regions);
 }
 
 vector<FSBlock> StorageLayout::getFileDataBlocks(
-    const Filename& filename, vector<FileRegion> regions) const
+    FileId fileId, vector<FileRegion> regions) const
 {
-    return getLayoutFileDataBlocks(filename, regions);
+    return getLayoutFileDataBlocks(fileId, regions);
+}
+
+vector<FSBlock> StorageLayout::allocateFileDataBlocks(
+    FileId fileId, vector<FileRegion> regions)
+{
+    return allocateLayoutFileDataBlocks(fileId, regions);
+}
+
+vector<FSBlock> StorageLayout::allocateLayoutFileDataBlocks(
+    FileId fileId, vector<FileRegion> regions)
+{
+    return getLayoutFileDataBlocks(fileId, regions);
 }
 
 /*
@@ -13,7 +13,11 @@
 #include "basic_types.h"
 #include "filename.h"
 
-/** An abstract storage layout interface */
+/**
+ * An abstract storage layout interface.  Files are named when they are
+ * added to the layout, and are afterwards identified by their interned
+ * FileId.
+ */
 class StorageLayout
 {
 public:
@@ -24,39 +28,61 @@ public:
     /** Destructor */
     virtual ~StorageLayout() = 0;
 
-    /** Add layout information for a directory */
-    void addDirectory(const Filename& filename);
+    /**
+     * Add layout information for a directory
+     *
+     * @return the directory's id for subsequent layout lookups
+     */
+    FileId addDirectory(const Filename& filename);
 
-    /** Add layout information for a file */
-    void addFile(const Filename& filename, FSSize size);
+    /**
+     * Add layout information for a file
+     *
+     * @return the file's id for subsequent layout lookups
+     */
+    FileId addFile(const Filename& filename, FSSize size);
 
     /** @return vector of data blocks for a file's offset and extent */
-    std::vector<FSBlock> getFileDataBlocks(const Filename& file,
+    std::vector<FSBlock> getFileDataBlocks(FileId fileId,
                                            FSOffset offset,
                                            FSSize extent) const;
 
     /** @return vector of data blocks for a file and vector of file regions */
     std::vector<FSBlock> getFileDataBlocks(
-        const Filename& file, std::vector<FileRegion> regions) const;
+        FileId fileId, std::vector<FileRegion> regions) const;
+
+    /**
+     * @return vector of data blocks to write for a file and vector of file
+     *   regions, allocating storage for any unallocated blocks
+     */
+    std::vector<FSBlock> allocateFileDataBlocks(
+        FileId fileId, std::vector<FileRegion> regions);
 
     /** @return the metadata blocks associated with a file */
-    std::vector<FSBlock> getFileMetaDataBlocks(
-        const Filename& file) const;
+    std::vector<FSBlock> getFileMetaDataBlocks(FileId fileId) const;
 
 protected:
     /** Add layout information for a directory */
-    virtual void addDirectoryToLayout(const Filename& filename) = 0;
+    virtual void addDirectoryToLayout(FileId dirId) = 0;
 
     /** Add layout information for a file */
-    virtual void addFileToLayout(const Filename& filename, FSSize size) = 0;
+    virtual void addFileToLayout(FileId fileId, FSSize size) = 0;
 
     /** @return vector of data blocks for a file and vector of file regions */
     virtual std::vector<FSBlock> getLayoutFileDataBlocks(
-        const Filename& file, std::vector<FileRegion> regions) const = 0;
+        FileId fileId, std::vector<FileRegion> regions) const = 0;
+
+    /**
+     * @return vector of data blocks to write for a file and vector of file
+     *   regions.  Layouts that allocate all storage up front return the
+     *   existing data blocks.
+     */
+    virtual std::vector<FSBlock> allocateLayoutFileDataBlocks(
+        FileId fileId, std::vector<FileRegion> regions);
 
     /** @return the metadata blocks associated with a file */
     virtual std::vector<FSBlock> getLayoutFileMetaDataBlocks(
-        const Filename& file) const = 0;
+        FileId fileId) const = 0;
 
 private:
     /** Copy constructor */
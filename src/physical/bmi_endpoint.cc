@@ -65,10 +65,8 @@ void BMIEndpoint::handleMessage(cMessage* msg)
     if (msg->getArrivalGateId() == appInGateId_)
     {
         // Perform the network queueing costs
-        //TODO: This used to use the message size
-        simtime_t scheduleTime =
-            getNextMessageOutScheduleTime(0);
-        scheduleAt(scheduleTime, msg);
+        scheduleAt(getOutboundScheduleTime(check_and_cast<cPacket*>(msg)),
+                   msg);
     }
     else if (msg->isSelfMessage())
     {
@@ -107,8 +105,8 @@ void BMIEndpoint::handleMessageFromNetwork(cMessage* msg)
 
     // Calculate the network queueing costs
     simtime_t currentTime = simulation.getSimTime();
-    //TODO: This used to use the actual message size
-    simtime_t delay = getNextMessageInScheduleTime(0) - currentTime;
+    simtime_t delay =
+        getInboundScheduleTime(check_and_cast<cPacket*>(msg)) - currentTime;
 
     // If the message is a flow message, send it directly
     // Otherwise extract the payload and send it on
@@ -137,6 +135,20 @@ cMessage* BMIEndpoint::extractBMIPayload(spfsBMIMessage* bmiMsg)
     return payload;
 }
 
+simtime_t BMIEndpoint::getOutboundScheduleTime(cPacket* pkt)
+{
+    // The host copies the message into the network buffers
+    assert(0 != pkt);
+    return getNextMessageOutScheduleTime(pkt->getByteLength());
+}
+
+simtime_t BMIEndpoint::getInboundScheduleTime(cPacket* pkt)
+{
+    // The host copies the message out of the network buffers
+    assert(0 != pkt);
+    return getNextMessageInScheduleTime(pkt->getByteLength());
+}
+
 bool BMIEndpoint::handleIsLocal(const FSHandle& handle)
 {
     return (handle >= handleRange_.first && handle <= handleRange_.last);
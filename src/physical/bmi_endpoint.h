@@ -1,3 +1,5 @@
+#ifndef BMI_ENDPOINT_H
+#define BMI_ENDPOINT_H
 //
 // This file is part of Hecios
 //
@@ -67,6 +69,12 @@ protected:
     /** Send a BMIExpected message over the network */
     virtual void sendOverNetwork(spfsBMIUnexpectedMessage* unexpectedMsg) = 0;
 
+    /** @return the time the outbound message from the application is sent */
+    virtual simtime_t getOutboundScheduleTime(cPacket* pkt);
+
+    /** @return the time the inbound message is delivered to the application */
+    virtual simtime_t getInboundScheduleTime(cPacket* pkt);
+
 private:
     /** handle messages received from the network */
     void handleMessageFromNetwork(cMessage* msg);
@@ -104,6 +112,8 @@ private:
     double scaledOverheadSecs_;
 };
 
+#endif
+
 /*
  * Local variables:
  *  indent-tabs-mode: nil
@@ -0,0 +1,189 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include "bmi_flow_endpoint.h"
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include "InterfaceTableAccess.h"
+#include "IPv4InterfaceData.h"
+#include "IPvXAddress.h"
+#include "bmi_network.h"
+#include "bmi_proto_m.h"
+#include "pfs_utils.h"
+#include "pvfs_proto_m.h"
+using namespace std;
+
+// OMNet Registriation Method
+Define_Module(BMIFlowEndpoint);
+
+//
+// Stage 0 - initialize the BMI endpoint
+// Stage 3 - register this endpoint's host address with the network
+//           (IP addresses should be set at this time)
+//
+void BMIFlowEndpoint::initialize(int stage)
+{
+    if (0 == stage)
+    {
+        BMIEndpoint::initialize();
+    }
+    else if (3 == stage)
+    {
+        network_ = findNetwork(par("networkName").stringValue());
+        endpointId_ = network_->registerEndpoint(this, getHostAddress());
+    }
+}
+
+void BMIFlowEndpoint::initializeEndpoint()
+{
+}
+
+void BMIFlowEndpoint::finalizeEndpoint()
+{
+}
+
+spfsBMIUnexpectedMessage* BMIFlowEndpoint::createUnexpectedMessage(
+    spfsRequest* request)
+{
+    assert(0 != request);
+    spfsBMIUnexpectedMessage* pkt =
+        new spfsBMIUnexpectedMessage(0, SPFS_BMI_UNEXPECTED_MESSAGE);
+    pkt->setHandle(request->getHandle());
+    pkt->encapsulate(request);
+    pkt->addByteLength(BMI_UNEXPECTED_MSG_BYTES);
+    return pkt;
+}
+
+spfsBMIExpectedMessage* BMIFlowEndpoint::createExpectedMessage(cPacket* msg)
+{
+    assert(0 != msg);
+
+    // Retrieve the connection id used for the originating request
+    spfsRequest* req = static_cast<spfsRequest*>(msg->getContextPointer());
+
+    spfsBMIExpectedMessage* pkt =
+        new spfsBMIExpectedMessage(0, SPFS_BMI_EXPECTED_MESSAGE);
+    pkt->setConnectionId(req->getBmiConnectionId());
+    pkt->encapsulate(msg);
+    pkt->addByteLength(BMI_EXPECTED_MSG_BYTES);
+    return pkt;
+}
+
+cMessage* BMIFlowEndpoint::extractBMIPayload(spfsBMIMessage* bmiMsg)
+{
+    assert(0 != bmiMsg);
+    cMessage* payload = bmiMsg->decapsulate();
+    assert(0 != payload);
+
+    // If this is a request, store the sender for use during the response
+    if (spfsRequest* request = dynamic_cast<spfsRequest*>(payload))
+    {
+        static ConnectionId nextConnectionId = 0;
+        request->setBmiConnectionId(nextConnectionId++);
+        requestToEndpointMap_[request->getBmiConnectionId()] =
+            bmiMsg->getSourceEndpoint();
+    }
+    return payload;
+}
+
+void BMIFlowEndpoint::sendOverNetwork(spfsBMIExpectedMessage* msg)
+{
+    assert(0 != msg);
+
+    // Responses and server data flows return to the requesting endpoint.
+    // Client data flows use the file handle as the connection id, as with
+    // BMITcpClient.
+    int destEndpoint = -1;
+    map<ConnectionId, int>::const_iterator pos =
+        requestToEndpointMap_.find(msg->getConnectionId());
+    if (requestToEndpointMap_.end() != pos)
+    {
+        destEndpoint = pos->second;
+    }
+    else
+    {
+        destEndpoint = getServerEndpoint(msg->getConnectionId());
+    }
+
+    msg->setSourceEndpoint(endpointId_);
+    network_->transfer(msg, endpointId_, destEndpoint);
+}
+
+void BMIFlowEndpoint::sendOverNetwork(spfsBMIUnexpectedMessage* msg)
+{
+    assert(0 != msg);
+    msg->setSourceEndpoint(endpointId_);
+    network_->transfer(msg, endpointId_, getServerEndpoint(msg->getHandle()));
+}
+
+BMINetwork* BMIFlowEndpoint::findNetwork(const char* networkName) const
+{
+    // Search each enclosing module for the network
+    for (cModule* parent = getParentModule();
+         0 != parent;
+         parent = parent->getParentModule())
+    {
+        cModule* module = parent->getSubmodule(networkName);
+        if (0 != module)
+        {
+            BMINetwork* network = dynamic_cast<BMINetwork*>(module);
+            assert(0 != network);
+            return network;
+        }
+    }
+
+    cerr << __FILE__ << ":" << __LINE__ << ":"
+         << "BMIFlowEndpoint unable to locate network: "
+         << networkName << endl;
+    assert(false);
+    return 0;
+}
+
+string BMIFlowEndpoint::getHostAddress() const
+{
+    // Retrieve the INET host
+    cModule* host = getParentModule();
+    assert(0 != host);
+    IInterfaceTable* ifTable = dynamic_cast<IInterfaceTable*>(
+        host->getSubmodule("interfaceTable"));
+    assert(0 != ifTable);
+
+    // Find eth0's IP address
+    for (int i = 0; i < ifTable->getNumInterfaces(); i++)
+    {
+        InterfaceEntry* ie = ifTable->getInterface(i);
+        if (0 == strcmp("eth0", ie->getName()))
+        {
+            assert(0 != ie->ipv4Data());
+            return IPvXAddress(ie->ipv4Data()->getIPAddress()).str();
+        }
+    }
+
+    // Hosts without an interface are addressed by module path
+    return host->getFullPath();
+}
+
+int BMIFlowEndpoint::getServerEndpoint(const FSHandle& handle) const
+{
+    IPvXAddress* serverIp = PFSUtils::instance().getServerIP(handle);
+    assert(0 != serverIp);
+    int endpoint = network_->getEndpointId(serverIp->str());
+    assert(-1 != endpoint);
+    return endpoint;
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,90 @@
+#ifndef BMI_FLOW_ENDPOINT_H
+#define BMI_FLOW_ENDPOINT_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <map>
+#include <string>
+#include <omnetpp.h>
+#include "basic_types.h"
+#include "bmi_endpoint.h"
+class BMINetwork;
+
+/**
+ * Model of a bmi endpoint that transfers messages over a modeled
+ * BMINetwork (e.g. the flow-level BMIFlowNetwork) rather than TCP.
+ * Requests are routed to the server owning the request handle, and
+ * responses are routed back to the endpoint that sent the originating
+ * request.
+ */
+class BMIFlowEndpoint : public BMIEndpoint
+{
+public:
+    /** Constructor */
+    BMIFlowEndpoint() : BMIEndpoint(), network_(0), endpointId_(-1) {};
+
+    /** @return a BMIExpected message encapsulating msg */
+    virtual spfsBMIExpectedMessage* createExpectedMessage(cPacket* msg);
+
+    /** @return a BMIUnexpected message encapsulating msg */
+    virtual spfsBMIUnexpectedMessage* createUnexpectedMessage(
+        spfsRequest* request);
+
+protected:
+    /** Must have more stages than it takes to assign IPs */
+    virtual int numInitStages() const {return 4;};
+
+    /** Register with the network once IPs are assigned */
+    virtual void initialize(int stage);
+
+    /** Initialize this endpoint type */
+    virtual void initializeEndpoint();
+
+    /** Finalize this endpoint type */
+    virtual void finalizeEndpoint();
+
+    /** Extract the payload and record the sender of requests */
+    virtual cMessage* extractBMIPayload(spfsBMIMessage* bmiMsg);
+
+    /** Send a BMIExpected message over the network */
+    virtual void sendOverNetwork(spfsBMIExpectedMessage* expectedMsg);
+
+    /** Send a BMIExpected message over the network */
+    virtual void sendOverNetwork(spfsBMIUnexpectedMessage* unexpectedMsg);
+
+private:
+    /** @return the named network module enclosing this endpoint */
+    BMINetwork* findNetwork(const char* networkName) const;
+
+    /** @return the address of this endpoint's host */
+    std::string getHostAddress() const;
+
+    /** @return the endpoint of the server owning handle */
+    int getServerEndpoint(const FSHandle& handle) const;
+
+    /** The network */
+    BMINetwork* network_;
+
+    /** This endpoint's id within the network */
+    int endpointId_;
+
+    /** Map of request connection ids to the endpoints awaiting responses */
+    std::map<ConnectionId, int> requestToEndpointMap_;
+};
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,171 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include "bmi_flow_network.h"
+#include <cassert>
+#include <iostream>
+using namespace std;
+
+// OMNet Registriation Method
+Define_Module(BMIFlowNetwork);
+
+BMIFlowNetwork::BMIFlowNetwork()
+    : BMINetwork(),
+      completionMsg_(0),
+      nextCompletionFlow_(0)
+{
+}
+
+void BMIFlowNetwork::initialize()
+{
+    nicBytesPerSec_ = par("nicBytesPerSec").doubleValue();
+    switchPortBytesPerSec_ = par("switchPortBytesPerSec").doubleValue();
+    latencySecs_ = par("latencySecs").doubleValue();
+    assert(0.0 < nicBytesPerSec_);
+    assert(0.0 < switchPortBytesPerSec_);
+    assert(0.0 <= latencySecs_);
+
+    // A backplane capacity of 0 indicates a non-blocking switch
+    double backplaneBytesPerSec = par("backplaneBytesPerSec").doubleValue();
+    if (0.0 < backplaneBytesPerSec)
+    {
+        backplane_.push_back(model_.addLink(backplaneBytesPerSec));
+    }
+
+    completionMsg_ = new cMessage("Flow Completion");
+    lastAdvanceTime_ = 0.0;
+    numTransfers_ = 0;
+    numRateUpdates_ = 0;
+}
+
+void BMIFlowNetwork::finish()
+{
+    recordScalar("SPFS Flow Network Transfers", numTransfers_);
+    recordScalar("SPFS Flow Network Rate Updates", numRateUpdates_);
+
+    // Cleanup any messages still in flight
+    map<FlowNetworkModel::FlowId, Transfer>::iterator iter;
+    for (iter = transfers_.begin(); iter != transfers_.end(); ++iter)
+    {
+        delete iter->second.msg;
+    }
+    transfers_.clear();
+    cancelAndDelete(completionMsg_);
+    completionMsg_ = 0;
+}
+
+void BMIFlowNetwork::addHost(cModule* endpoint)
+{
+    Host host;
+    host.nicLink = model_.addLink(nicBytesPerSec_);
+    host.portLink = model_.addLink(switchPortBytesPerSec_);
+    hosts_.push_back(host);
+    assert(getNumHosts() == hosts_.size());
+}
+
+void BMIFlowNetwork::transfer(cPacket* msg, int srcEndpoint, int destEndpoint)
+{
+    Enter_Method("Flow network is transferring a message");
+    take(msg);
+    numTransfers_++;
+
+    // Messages between endpoints on one host and messages without a
+    // payload do not consume any link bandwidth
+    size_t srcHost = getHost(srcEndpoint);
+    size_t destHost = getHost(destEndpoint);
+    if (srcHost == destHost || 0 == msg->getByteLength())
+    {
+        deliver(msg, destEndpoint, latencySecs_);
+        return;
+    }
+
+    // Bring the existing flows up to date before the rates change
+    advanceToNow();
+
+    vector<FlowNetworkModel::LinkId> path;
+    path.push_back(hosts_[srcHost].nicLink);
+    appendSwitchPath(srcHost, destHost, msg, path);
+    path.push_back(hosts_[destHost].portLink);
+    FlowNetworkModel::FlowId flow =
+        model_.addFlow(path, double(msg->getByteLength()));
+
+    Transfer t;
+    t.msg = msg;
+    t.destEndpoint = destEndpoint;
+    transfers_[flow] = t;
+    rescheduleCompletion();
+}
+
+void BMIFlowNetwork::appendSwitchPath(size_t srcHost,
+                                      size_t destHost,
+                                      cPacket* msg,
+                                      vector<FlowNetworkModel::LinkId>& path)
+{
+    path.insert(path.end(), backplane_.begin(), backplane_.end());
+}
+
+void BMIFlowNetwork::handleMessage(cMessage* msg)
+{
+    assert(completionMsg_ == msg);
+    advanceToNow();
+
+    // The scheduled flow is complete even if rounding its completion time
+    // to the simulation time resolution left some of its bytes undrained
+    deliverFlow(nextCompletionFlow_);
+    deliverCompletedFlows();
+    rescheduleCompletion();
+}
+
+void BMIFlowNetwork::advanceToNow()
+{
+    simtime_t now = simTime();
+    model_.advance((now - lastAdvanceTime_).dbl());
+    lastAdvanceTime_ = now;
+}
+
+void BMIFlowNetwork::deliverCompletedFlows()
+{
+    vector<FlowNetworkModel::FlowId> completed = model_.getCompletedFlows();
+    for (size_t i = 0; i < completed.size(); i++)
+    {
+        deliverFlow(completed[i]);
+    }
+}
+
+void BMIFlowNetwork::deliverFlow(FlowNetworkModel::FlowId flow)
+{
+    map<FlowNetworkModel::FlowId, Transfer>::iterator iter =
+        transfers_.find(flow);
+    assert(transfers_.end() != iter);
+    deliver(iter->second.msg, iter->second.destEndpoint, latencySecs_);
+    transfers_.erase(iter);
+    model_.removeFlow(flow);
+}
+
+void BMIFlowNetwork::rescheduleCompletion()
+{
+    model_.computeRates();
+    numRateUpdates_++;
+
+    cancelEvent(completionMsg_);
+    double secs = 0.0;
+    if (model_.getNextCompletion(nextCompletionFlow_, secs))
+    {
+        scheduleAt(simTime() + secs, completionMsg_);
+    }
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
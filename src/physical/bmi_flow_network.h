@@ -0,0 +1,141 @@
+#ifndef BMI_FLOW_NETWORK_H
+#define BMI_FLOW_NETWORK_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstddef>
+#include <map>
+#include <vector>
+#include <omnetpp.h>
+#include "bmi_network.h"
+#include "flow_network_model.h"
+
+/**
+ * Flow-level model of a single switch cluster network used in place of
+ * packet-level TCP and Ethernet.  Each host has a NIC link into the switch
+ * and a switch port link out of it, and an optional backplane link is
+ * shared by all traffic.  Each BMI message is one flow whose rate is the
+ * max-min fair share of the links it crosses, so the simulation schedules
+ * events per message rather than per frame.
+ */
+class BMIFlowNetwork : public BMINetwork
+{
+public:
+    /** Constructor */
+    BMIFlowNetwork();
+
+    /**
+     * Transfer msg from the source to the destination endpoint.  The
+     * message is delivered once its flow completes.
+     */
+    virtual void transfer(cPacket* msg, int srcEndpoint, int destEndpoint);
+
+protected:
+    /** Implementation of initialize */
+    virtual void initialize();
+
+    /** Implementation of finish */
+    virtual void finish();
+
+    /** Implementation of handleMessage */
+    virtual void handleMessage(cMessage* msg);
+
+    /** Add the NIC and switch port links for a new host */
+    virtual void addHost(cModule* endpoint);
+
+    /**
+     * Append the links inside the switching fabric between the hosts'
+     * switch ports to the message's path.  By default the hosts share a
+     * single switch and only cross its backplane.
+     */
+    virtual void appendSwitchPath(std::size_t srcHost,
+                                  std::size_t destHost,
+                                  cPacket* msg,
+                                  std::vector<FlowNetworkModel::LinkId>& path);
+
+    /** @return the fluid network state */
+    FlowNetworkModel& getModel() { return model_; };
+
+    /** @return the switch port bandwidth */
+    double getSwitchPortBytesPerSec() const { return switchPortBytesPerSec_; };
+
+private:
+    /** The links owned by a host */
+    struct Host
+    {
+        FlowNetworkModel::LinkId nicLink;
+        FlowNetworkModel::LinkId portLink;
+    };
+
+    /** An in-flight message */
+    struct Transfer
+    {
+        cPacket* msg;
+        int destEndpoint;
+    };
+
+    /** Drain the flows up to the current time */
+    void advanceToNow();
+
+    /** Deliver the completed flows' messages */
+    void deliverCompletedFlows();
+
+    /** Deliver the flow's message and remove the flow */
+    void deliverFlow(FlowNetworkModel::FlowId flow);
+
+    /** Recompute the flow rates and reschedule the completion event */
+    void rescheduleCompletion();
+
+    /** Fluid network state */
+    FlowNetworkModel model_;
+
+    /** Hosts indexed by host id */
+    std::vector<Host> hosts_;
+
+    /** Messages in flight indexed by flow */
+    std::map<FlowNetworkModel::FlowId, Transfer> transfers_;
+
+    /** Backplane link, if the backplane capacity is limited */
+    std::vector<FlowNetworkModel::LinkId> backplane_;
+
+    /** Self message signalling the next flow completion */
+    cMessage* completionMsg_;
+
+    /** The flow the completion event is scheduled for */
+    FlowNetworkModel::FlowId nextCompletionFlow_;
+
+    /** Time the flows were last drained */
+    simtime_t lastAdvanceTime_;
+
+    /** Host NIC bandwidth */
+    double nicBytesPerSec_;
+
+    /** Switch port bandwidth */
+    double switchPortBytesPerSec_;
+
+    /** Per message latency through the switch */
+    double latencySecs_;
+
+    /** Number of messages transferred */
+    std::size_t numTransfers_;
+
+    /** Number of times the flow rates were recomputed */
+    std::size_t numRateUpdates_;
+};
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
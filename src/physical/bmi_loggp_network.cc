@@ -0,0 +1,126 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include "bmi_network.h"
+#include "loggp_model.h"
+#include <omnetpp.h>
+using namespace std;
+
+/**
+ * Analytic LogGP model of a single switch cluster network.  Each host has
+ * serialized NIC send and receive queues, so the model shows NIC
+ * saturation and incast without simulating packets.
+ */
+class BMILogGPNetwork : public BMINetwork
+{
+public:
+    /** Constructor */
+    BMILogGPNetwork() : BMINetwork(), model_(0) {};
+
+    /** Transfer msg, delivering it at the time computed by the model */
+    virtual void transfer(cPacket* msg, int srcEndpoint, int destEndpoint);
+
+protected:
+    /** Implementation of initialize */
+    virtual void initialize();
+
+    /** Implementation of finish */
+    virtual void finish();
+
+    /** Implementation of handleMessage */
+    virtual void handleMessage(cMessage* msg);
+
+    /** Add the NIC queues for a new host */
+    virtual void addHost(cModule* endpoint);
+
+private:
+    /** The LogGP model */
+    LogGPModel* model_;
+
+    /** Number of messages transferred */
+    size_t numTransfers_;
+
+    /** Total time messages spent in the network */
+    simtime_t totalTransferTime_;
+};
+
+// OMNet Registriation Method
+Define_Module(BMILogGPNetwork);
+
+void BMILogGPNetwork::initialize()
+{
+    model_ = new LogGPModel(par("latencySecs").doubleValue(),
+                            par("overheadSecs").doubleValue(),
+                            par("gapSecs").doubleValue(),
+                            par("gapPerByteSecs").doubleValue(),
+                            par("backplaneBytesPerSec").doubleValue());
+    numTransfers_ = 0;
+    totalTransferTime_ = 0.0;
+}
+
+void BMILogGPNetwork::finish()
+{
+    double meanTransferTime = 0.0;
+    if (0 != numTransfers_)
+    {
+        meanTransferTime = totalTransferTime_.dbl() / numTransfers_;
+    }
+    recordScalar("SPFS LogGP Network Transfers", numTransfers_);
+    recordScalar("SPFS LogGP Network Mean Transfer Time", meanTransferTime);
+
+    delete model_;
+    model_ = 0;
+}
+
+void BMILogGPNetwork::handleMessage(cMessage* msg)
+{
+    cerr << "BMILogGPNetwork cannot receive messages." << endl;
+    delete msg;
+}
+
+void BMILogGPNetwork::addHost(cModule* endpoint)
+{
+    size_t node = model_->addNode();
+    assert(node + 1 == getNumHosts());
+}
+
+void BMILogGPNetwork::transfer(cPacket* msg, int srcEndpoint, int destEndpoint)
+{
+    Enter_Method("LogGP network is transferring a message");
+    take(msg);
+    numTransfers_++;
+
+    // Messages between endpoints on one host do not use the network
+    size_t srcHost = getHost(srcEndpoint);
+    size_t destHost = getHost(destEndpoint);
+    simtime_t delay = 0.0;
+    if (srcHost != destHost)
+    {
+        simtime_t now = simTime();
+        double deliveryTime = model_->send(srcHost,
+                                           destHost,
+                                           now.dbl(),
+                                           double(msg->getByteLength()));
+        delay = deliveryTime - now;
+    }
+    totalTransferTime_ += delay;
+    deliver(msg, destEndpoint, delay);
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,81 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include "bmi_network.h"
+#include <cassert>
+using namespace std;
+
+BMINetwork::BMINetwork()
+    : cSimpleModule(),
+      numHosts_(0)
+{
+}
+
+int BMINetwork::registerEndpoint(cModule* endpoint, const string& hostAddress)
+{
+    assert(0 != endpoint);
+
+    // Create the host on first registration
+    map<string, size_t>::const_iterator iter =
+        hostsByAddress_.find(hostAddress);
+    size_t hostId = numHosts_;
+    if (hostsByAddress_.end() == iter)
+    {
+        hostsByAddress_[hostAddress] = hostId;
+        numHosts_++;
+        addHost(endpoint);
+    }
+    else
+    {
+        hostId = iter->second;
+    }
+
+    Endpoint ep;
+    ep.module = endpoint;
+    ep.host = hostId;
+    endpoints_.push_back(ep);
+    int endpointId = int(endpoints_.size() - 1);
+    if (endpointsByAddress_.end() == endpointsByAddress_.find(hostAddress))
+    {
+        endpointsByAddress_[hostAddress] = endpointId;
+    }
+    return endpointId;
+}
+
+int BMINetwork::getEndpointId(const string& hostAddress) const
+{
+    map<string, int>::const_iterator iter =
+        endpointsByAddress_.find(hostAddress);
+    if (endpointsByAddress_.end() != iter)
+    {
+        return iter->second;
+    }
+    return -1;
+}
+
+size_t BMINetwork::getHost(int endpoint) const
+{
+    assert(0 <= endpoint && size_t(endpoint) < endpoints_.size());
+    return endpoints_[endpoint].host;
+}
+
+void BMINetwork::deliver(cPacket* msg, int destEndpoint, simtime_t delay)
+{
+    assert(0 <= destEndpoint && size_t(destEndpoint) < endpoints_.size());
+    sendDirect(msg, delay, 0.0, endpoints_[destEndpoint].module, "directIn");
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,97 @@
+#ifndef BMI_NETWORK_H
+#define BMI_NETWORK_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+#include <omnetpp.h>
+
+/**
+ * Abstract model of a cluster network shared by the BMIFlowEndpoint
+ * modules.  The network tracks which host each endpoint runs on and
+ * delivers transferred messages to the destination endpoint's directIn
+ * gate; derived models decide when each message arrives.
+ */
+class BMINetwork : public cSimpleModule
+{
+public:
+    /** Constructor */
+    BMINetwork();
+
+    /**
+     * Register an endpoint on the host with the given network address.
+     * Endpoints on the same host share its network interface.
+     *
+     * @return the id of the endpoint
+     */
+    int registerEndpoint(cModule* endpoint, const std::string& hostAddress);
+
+    /**
+     * @return the first endpoint registered on the host with the address,
+     *   or -1 if none is registered
+     */
+    int getEndpointId(const std::string& hostAddress) const;
+
+    /**
+     * Transfer msg from the source to the destination endpoint.  The
+     * message is delivered to the destination's directIn gate.
+     */
+    virtual void transfer(cPacket* msg, int srcEndpoint, int destEndpoint) = 0;
+
+protected:
+    /**
+     * Add the model state for a newly registered host
+     *
+     * @param endpoint the first endpoint registered on the host
+     */
+    virtual void addHost(cModule* endpoint) = 0;
+
+    /** @return the number of hosts */
+    std::size_t getNumHosts() const { return numHosts_; };
+
+    /** @return the host the endpoint runs on */
+    std::size_t getHost(int endpoint) const;
+
+    /** Deliver msg to the endpoint after delay */
+    void deliver(cPacket* msg, int destEndpoint, simtime_t delay);
+
+private:
+    /** A registered endpoint */
+    struct Endpoint
+    {
+        cModule* module;
+        std::size_t host;
+    };
+
+    /** Registered endpoints indexed by endpoint id */
+    std::vector<Endpoint> endpoints_;
+
+    /** Number of registered hosts */
+    std::size_t numHosts_;
+
+    /** Map of network addresses to host ids */
+    std::map<std::string, std::size_t> hostsByAddress_;
+
+    /** Map of network addresses to the first endpoint on each host */
+    std::map<std::string, int> endpointsByAddress_;
+};
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,167 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cassert>
+#include <cstddef>
+#include <omnetpp.h>
+#include "bmi_flow_endpoint.h"
+#include "bmi_proto_m.h"
+#include "message_kind.h"
+#include "registration_cache.h"
+using namespace std;
+
+/**
+ * Model of a bmi endpoint for an RDMA fabric such as InfiniBand.  Small
+ * messages are sent eagerly and pay the usual host overheads.  Flow
+ * buffers larger than the eager limit use a rendezvous protocol: the
+ * sender registers its buffer and exchanges a handshake with the
+ * receiver, which registers its own buffer, and the data is then moved by
+ * RDMA without host copies, so the per-byte host overhead is never
+ * charged for them.  Registrations are cached by flow, so the pipelined
+ * buffers of a flow are only registered once.
+ */
+class BMIRdmaEndpoint : public BMIFlowEndpoint
+{
+public:
+    /** Constructor */
+    BMIRdmaEndpoint();
+
+    /** Destructor */
+    virtual ~BMIRdmaEndpoint();
+
+protected:
+    /** Initialize the RDMA parameters and registration cache */
+    virtual void initializeEndpoint();
+
+    /** Record the protocol statistics */
+    virtual void finalizeEndpoint();
+
+    /** @return the send time after the rendezvous for large flow buffers */
+    virtual simtime_t getOutboundScheduleTime(cPacket* pkt);
+
+    /** @return the delivery time without host copies for large buffers */
+    virtual simtime_t getInboundScheduleTime(cPacket* pkt);
+
+private:
+    /** @return true if msg is a flow buffer sent by rendezvous */
+    bool isRendezvous(cPacket* pkt) const;
+
+    /** @return the time to register the flow buffer in msg */
+    double registerBuffer(cPacket* pkt);
+
+    /** Largest message sent eagerly */
+    long eagerLimitBytes_;
+
+    /** Round trip time of the rendezvous handshake */
+    double rendezvousHandshakeSecs_;
+
+    /** Registered memory regions */
+    RegistrationCache* registrationCache_;
+
+    /** Number of messages sent eagerly */
+    size_t numEagerSends_;
+
+    /** Number of messages sent by rendezvous */
+    size_t numRendezvousSends_;
+};
+
+// OMNet Registriation Method
+Define_Module(BMIRdmaEndpoint);
+
+BMIRdmaEndpoint::BMIRdmaEndpoint()
+    : BMIFlowEndpoint(),
+      eagerLimitBytes_(0),
+      rendezvousHandshakeSecs_(0.0),
+      registrationCache_(0),
+      numEagerSends_(0),
+      numRendezvousSends_(0)
+{
+}
+
+BMIRdmaEndpoint::~BMIRdmaEndpoint()
+{
+    delete registrationCache_;
+    registrationCache_ = 0;
+}
+
+void BMIRdmaEndpoint::initializeEndpoint()
+{
+    BMIFlowEndpoint::initializeEndpoint();
+    eagerLimitBytes_ = par("eagerLimitBytes").longValue();
+    rendezvousHandshakeSecs_ = par("rendezvousHandshakeSecs").doubleValue();
+    registrationCache_ = new RegistrationCache(
+        par("registrationCacheEntries").longValue(),
+        par("registrationFixedSecs").doubleValue(),
+        par("registrationPerByteSecs").doubleValue());
+    numEagerSends_ = 0;
+    numRendezvousSends_ = 0;
+}
+
+void BMIRdmaEndpoint::finalizeEndpoint()
+{
+    BMIFlowEndpoint::finalizeEndpoint();
+    recordScalar("BMI RDMA eager sends", numEagerSends_);
+    recordScalar("BMI RDMA rendezvous sends", numRendezvousSends_);
+    recordScalar("BMI RDMA registration hits",
+                 registrationCache_->getNumHits());
+    recordScalar("BMI RDMA registration misses",
+                 registrationCache_->getNumMisses());
+}
+
+simtime_t BMIRdmaEndpoint::getOutboundScheduleTime(cPacket* pkt)
+{
+    if (!isRendezvous(pkt))
+    {
+        numEagerSends_++;
+        return BMIFlowEndpoint::getOutboundScheduleTime(pkt);
+    }
+
+    // Register the send buffer and perform the handshake; the data
+    // transfer bypasses the host, so the outbound queue is not used
+    numRendezvousSends_++;
+    return simTime() + registerBuffer(pkt) + rendezvousHandshakeSecs_;
+}
+
+simtime_t BMIRdmaEndpoint::getInboundScheduleTime(cPacket* pkt)
+{
+    if (!isRendezvous(pkt))
+    {
+        return BMIFlowEndpoint::getInboundScheduleTime(pkt);
+    }
+
+    // The data was placed directly into the registered receive buffer
+    return simTime() + registerBuffer(pkt);
+}
+
+bool BMIRdmaEndpoint::isRendezvous(cPacket* pkt) const
+{
+    assert(0 != pkt);
+    if (SPFS_BMI_PUSH_DATA_REQUEST == pkt->getKind())
+    {
+        spfsBMIPushDataRequest* push = kind_cast<spfsBMIPushDataRequest>(pkt);
+        return (eagerLimitBytes_ < push->getByteLength());
+    }
+    return false;
+}
+
+double BMIRdmaEndpoint::registerBuffer(cPacket* pkt)
+{
+    spfsBMIPushDataRequest* push = kind_cast<spfsBMIPushDataRequest>(pkt);
+    return registrationCache_->registerBuffer(push->getFlowId(),
+                                              push->getDataSize());
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
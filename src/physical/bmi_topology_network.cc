@@ -0,0 +1,280 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <omnetpp.h>
+#include "bmi_flow_network.h"
+#include "bmi_proto_m.h"
+#include "dragonfly_topology.h"
+#include "fat_tree_topology.h"
+#include "message_kind.h"
+#include "switch_topology.h"
+using namespace std;
+
+/**
+ * Flow-level model of a cluster network built from many switches.  Hosts
+ * attach to the edge switches of a fat tree or dragonfly, and the messages
+ * of each BMI connection are routed over one of the equal cost paths
+ * selected by hashing the connection (ECMP).  IO nodes may be placed on
+ * dedicated edge switches or distributed among the compute node switches.
+ */
+class BMITopologyNetwork : public BMIFlowNetwork
+{
+public:
+    /** Constructor */
+    BMITopologyNetwork() : BMIFlowNetwork(), topology_(0) {};
+
+    /** Destructor */
+    virtual ~BMITopologyNetwork();
+
+protected:
+    /** Construct the topology */
+    virtual void initialize();
+
+    /** Record the link utilization */
+    virtual void finish();
+
+    /** Attach the new host to its edge switch */
+    virtual void addHost(cModule* endpoint);
+
+    /** Append the ECMP route between the hosts' edge switches */
+    virtual void appendSwitchPath(std::size_t srcHost,
+                                  std::size_t destHost,
+                                  cPacket* msg,
+                                  std::vector<FlowNetworkModel::LinkId>& path);
+
+private:
+    /** @return the edge switch the endpoint's cluster node attaches to */
+    std::size_t getEdgeSwitch(cModule* endpoint) const;
+
+    /** @return the ECMP hash of the message's BMI connection */
+    static std::size_t getConnectionHash(std::size_t srcHost,
+                                         std::size_t destHost,
+                                         cPacket* msg);
+
+    /** The switches and links between the hosts */
+    SwitchTopology* topology_;
+
+    /** Edge switch indexed by host id */
+    std::vector<std::size_t> hostSwitches_;
+
+    /** Hosts attached to each edge switch */
+    std::size_t hostsPerSwitch_;
+
+    /** True if the IO nodes share the compute node edge switches */
+    bool distributeIONodes_;
+};
+
+// OMNet Registriation Method
+Define_Module(BMITopologyNetwork);
+
+BMITopologyNetwork::~BMITopologyNetwork()
+{
+    delete topology_;
+    topology_ = 0;
+}
+
+void BMITopologyNetwork::initialize()
+{
+    BMIFlowNetwork::initialize();
+    hostsPerSwitch_ = par("hostsPerSwitch").longValue();
+    assert(0 < hostsPerSwitch_);
+
+    string placement = par("ioNodePlacement").stringValue();
+    assert("dedicated" == placement || "distributed" == placement);
+    distributeIONodes_ = ("distributed" == placement);
+
+    // Inter-switch links default to the switch port bandwidth
+    double linkBytesPerSec = par("switchLinkBytesPerSec").doubleValue();
+    if (0.0 == linkBytesPerSec)
+    {
+        linkBytesPerSec = getSwitchPortBytesPerSec();
+    }
+
+    string topologyType = par("topology").stringValue();
+    if ("fatTree" == topologyType)
+    {
+        // Oversubscription reduces the leaf uplinks below the bandwidth
+        // of the leaf's hosts; the levels above are non-blocking
+        long numLevels = par("fatTreeLevels").longValue();
+        assert(2 == numLevels || 3 == numLevels);
+        size_t numPods = (3 == numLevels) ? par("numPods").longValue() : 1;
+        size_t leavesPerPod = par("leafSwitchesPerPod").longValue();
+        size_t spinesPerPod = par("spineSwitchesPerPod").longValue();
+        size_t coresPerSpine =
+            (3 == numLevels) ? par("coreSwitchesPerSpine").longValue() : 0;
+        double oversubscription = par("oversubscription").doubleValue();
+        assert(1.0 <= oversubscription);
+        double leafLinkBytesPerSec =
+            hostsPerSwitch_ * getSwitchPortBytesPerSec() /
+            (oversubscription * spinesPerPod);
+        double coreLinkBytesPerSec = (0 < coresPerSpine) ?
+            leavesPerPod * leafLinkBytesPerSec / coresPerSpine : 0.0;
+        topology_ = new FatTreeTopology(getModel(),
+                                        numPods,
+                                        leavesPerPod,
+                                        spinesPerPod,
+                                        coresPerSpine,
+                                        leafLinkBytesPerSec,
+                                        coreLinkBytesPerSec);
+    }
+    else
+    {
+        assert("dragonfly" == topologyType);
+        topology_ = new DragonflyTopology(
+            getModel(),
+            par("numGroups").longValue(),
+            par("routersPerGroup").longValue(),
+            par("globalLinksPerGroupPair").longValue(),
+            linkBytesPerSec,
+            linkBytesPerSec);
+    }
+}
+
+void BMITopologyNetwork::finish()
+{
+    // Record the fraction of each inter-switch link's capacity used
+    double maxUtilization = 0.0;
+    double totalUtilization = 0.0;
+    double elapsedSecs = simTime().dbl();
+    for (size_t i = 0; i < topology_->getNumLinks(); i++)
+    {
+        FlowNetworkModel::LinkId link = topology_->getLink(i);
+        double utilization = 0.0;
+        if (0.0 < elapsedSecs)
+        {
+            utilization = getModel().getLinkBytes(link) /
+                (getModel().getLinkCapacity(link) * elapsedSecs);
+        }
+        string name = "SPFS Topology Link Utilization " +
+            topology_->getLinkName(i);
+        recordScalar(name.c_str(), utilization);
+        maxUtilization = max(maxUtilization, utilization);
+        totalUtilization += utilization;
+    }
+
+    double meanUtilization = 0.0;
+    if (0 < topology_->getNumLinks())
+    {
+        meanUtilization = totalUtilization / topology_->getNumLinks();
+    }
+    recordScalar("SPFS Topology Max Link Utilization", maxUtilization);
+    recordScalar("SPFS Topology Mean Link Utilization", meanUtilization);
+    BMIFlowNetwork::finish();
+}
+
+void BMITopologyNetwork::addHost(cModule* endpoint)
+{
+    BMIFlowNetwork::addHost(endpoint);
+    hostSwitches_.push_back(getEdgeSwitch(endpoint));
+}
+
+void BMITopologyNetwork::appendSwitchPath(
+    size_t srcHost,
+    size_t destHost,
+    cPacket* msg,
+    vector<FlowNetworkModel::LinkId>& path)
+{
+    BMIFlowNetwork::appendSwitchPath(srcHost, destHost, msg, path);
+    assert(srcHost < hostSwitches_.size());
+    assert(destHost < hostSwitches_.size());
+    topology_->route(hostSwitches_[srcHost],
+                     hostSwitches_[destHost],
+                     getConnectionHash(srcHost, destHost, msg),
+                     path);
+}
+
+size_t BMITopologyNetwork::getEdgeSwitch(cModule* endpoint) const
+{
+    // Locate the cluster node containing the endpoint
+    cModule* cluster = getParentModule();
+    cModule* node = endpoint;
+    while (0 != node->getParentModule() && cluster != node->getParentModule())
+    {
+        node = node->getParentModule();
+    }
+
+    // Compute nodes fill the edge switches in order
+    size_t numComputeNodes = size_t(cluster->par("numCPUNodes").doubleValue());
+    size_t numComputeSwitches = size_t(ceil(double(numComputeNodes) /
+                                            hostsPerSwitch_));
+    size_t edgeSwitch = (getNumHosts() - 1) / hostsPerSwitch_;
+    if (0 == strcmp("cpun", node->getName()))
+    {
+        edgeSwitch = node->getIndex() / hostsPerSwitch_;
+    }
+    else if (0 == strcmp("ion", node->getName()))
+    {
+        // IO nodes are either spread round robin over the compute
+        // switches or fill the switches after them
+        if (distributeIONodes_ && 0 < numComputeSwitches)
+        {
+            edgeSwitch = node->getIndex() % numComputeSwitches;
+        }
+        else
+        {
+            edgeSwitch = numComputeSwitches +
+                node->getIndex() / hostsPerSwitch_;
+        }
+    }
+    assert(edgeSwitch < topology_->getNumEdgeSwitches());
+    return edgeSwitch;
+}
+
+size_t BMITopologyNetwork::getConnectionHash(size_t srcHost,
+                                             size_t destHost,
+                                             cPacket* msg)
+{
+    // Expected messages (including flow data) carry the connection id,
+    // and unexpected messages open a connection for the handle
+    size_t connection = 0;
+    switch (msg->getKind())
+    {
+        case SPFS_BMI_EXPECTED_MESSAGE:
+        case SPFS_BMI_PUSH_DATA_REQUEST:
+        case SPFS_BMI_PUSH_DATA_RESPONSE:
+        {
+            spfsBMIExpectedMessage* expected =
+                kind_cast<spfsBMIExpectedMessage>(msg);
+            connection = size_t(expected->getConnectionId());
+            break;
+        }
+        case SPFS_BMI_UNEXPECTED_MESSAGE:
+        {
+            spfsBMIUnexpectedMessage* unexpected =
+                kind_cast<spfsBMIUnexpectedMessage>(msg);
+            connection = size_t(unexpected->getHandle());
+            break;
+        }
+        default:
+            break;
+    }
+
+    // Mix the bits so consecutive connections spread over the paths
+    size_t hash = (connection * 31 + srcHost) * 31 + destHost;
+    hash ^= (hash >> 16);
+    hash *= 0x45d9f3b;
+    hash ^= (hash >> 16);
+    return hash;
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
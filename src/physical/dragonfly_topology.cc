@@ -0,0 +1,144 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include "dragonfly_topology.h"
+#include <cassert>
+using namespace std;
+
+DragonflyTopology::DragonflyTopology(FlowNetworkModel& model,
+                                     size_t numGroups,
+                                     size_t routersPerGroup,
+                                     size_t globalLinksPerPair,
+                                     double localLinkBytesPerSec,
+                                     double globalLinkBytesPerSec)
+    : SwitchTopology(model),
+      numGroups_(numGroups),
+      routersPerGroup_(routersPerGroup),
+      globalLinksPerPair_(globalLinksPerPair)
+{
+    assert(0 < numGroups_);
+    assert(0 < routersPerGroup_);
+    assert(0 < globalLinksPerPair_);
+
+    // Fully connect the routers within each group; the unused self links
+    // keep the indexing simple
+    localLinks_.resize(numGroups_ * routersPerGroup_ * routersPerGroup_);
+    for (size_t group = 0; group < numGroups_; group++)
+    {
+        for (size_t from = 0; from < routersPerGroup_; from++)
+        {
+            for (size_t to = 0; to < routersPerGroup_; to++)
+            {
+                if (from != to)
+                {
+                    size_t index =
+                        (group * routersPerGroup_ + from) * routersPerGroup_ +
+                        to;
+                    localLinks_[index] =
+                        addLink(switchName("router", group, from),
+                                switchName("router", group, to),
+                                localLinkBytesPerSec);
+                }
+            }
+        }
+    }
+
+    // Connect each pair of groups
+    globalLinks_.resize(numGroups_ * numGroups_ * globalLinksPerPair_);
+    for (size_t group = 0; group < numGroups_; group++)
+    {
+        for (size_t peer = 0; peer < numGroups_; peer++)
+        {
+            if (group == peer)
+            {
+                continue;
+            }
+
+            for (size_t link = 0; link < globalLinksPerPair_; link++)
+            {
+                size_t from = getGlobalRouter(group, peer, link);
+                size_t to = getGlobalRouter(peer, group, link);
+                size_t index =
+                    (group * numGroups_ + peer) * globalLinksPerPair_ + link;
+                globalLinks_[index] =
+                    addLink(switchName("router", group, from),
+                            switchName("router", peer, to),
+                            globalLinkBytesPerSec);
+            }
+        }
+    }
+}
+
+size_t DragonflyTopology::getNumEdgeSwitches() const
+{
+    return numGroups_ * routersPerGroup_;
+}
+
+void DragonflyTopology::route(size_t srcSwitch,
+                              size_t destSwitch,
+                              size_t hash,
+                              Path& outPath) const
+{
+    assert(srcSwitch < getNumEdgeSwitches());
+    assert(destSwitch < getNumEdgeSwitches());
+    size_t srcGroup = srcSwitch / routersPerGroup_;
+    size_t destGroup = destSwitch / routersPerGroup_;
+    if (srcGroup == destGroup)
+    {
+        appendLocalLink(srcSwitch, destSwitch, outPath);
+        return;
+    }
+
+    // Hop to the router owning the hashed global link, cross it, and hop
+    // to the destination router
+    size_t link = hash % globalLinksPerPair_;
+    size_t exitRouter = srcGroup * routersPerGroup_ +
+        getGlobalRouter(srcGroup, destGroup, link);
+    size_t entryRouter = destGroup * routersPerGroup_ +
+        getGlobalRouter(destGroup, srcGroup, link);
+    size_t globalIndex =
+        (srcGroup * numGroups_ + destGroup) * globalLinksPerPair_ + link;
+    appendLocalLink(srcSwitch, exitRouter, outPath);
+    outPath.push_back(globalLinks_[globalIndex]);
+    appendLocalLink(entryRouter, destSwitch, outPath);
+}
+
+size_t DragonflyTopology::getGlobalRouter(size_t group,
+                                          size_t peer,
+                                          size_t link) const
+{
+    // Number the group's global links by peer, skipping the group itself
+    size_t peerIndex = (peer < group) ? peer : peer - 1;
+    return (peerIndex * globalLinksPerPair_ + link) % routersPerGroup_;
+}
+
+void DragonflyTopology::appendLocalLink(size_t fromRouter,
+                                        size_t toRouter,
+                                        Path& outPath) const
+{
+    if (fromRouter != toRouter)
+    {
+        size_t group = fromRouter / routersPerGroup_;
+        size_t from = fromRouter % routersPerGroup_;
+        size_t to = toRouter % routersPerGroup_;
+        assert(group == toRouter / routersPerGroup_);
+        size_t index =
+            (group * routersPerGroup_ + from) * routersPerGroup_ + to;
+        outPath.push_back(localLinks_[index]);
+    }
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
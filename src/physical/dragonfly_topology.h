@@ -0,0 +1,93 @@
+#ifndef DRAGONFLY_TOPOLOGY_H
+#define DRAGONFLY_TOPOLOGY_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstddef>
+#include <vector>
+#include "switch_topology.h"
+
+/**
+ * Dragonfly topology.  The routers of a group are fully connected by local
+ * links, and every pair of groups is joined by globalLinksPerPair global
+ * links spread round robin over the routers of each group.  Flows take a
+ * minimal route (local, global, local hop) over a hashed global link.
+ */
+class DragonflyTopology : public SwitchTopology
+{
+public:
+    /**
+     * Constructor
+     *
+     * @param model the model to add the links to
+     * @param numGroups the number of groups
+     * @param routersPerGroup the number of routers in each group
+     * @param globalLinksPerPair the number of links between two groups
+     * @param localLinkBytesPerSec the capacity of each local link
+     * @param globalLinkBytesPerSec the capacity of each global link
+     */
+    DragonflyTopology(FlowNetworkModel& model,
+                      std::size_t numGroups,
+                      std::size_t routersPerGroup,
+                      std::size_t globalLinksPerPair,
+                      double localLinkBytesPerSec,
+                      double globalLinkBytesPerSec);
+
+    /** @return the number of routers */
+    virtual std::size_t getNumEdgeSwitches() const;
+
+    /** Append the minimal route across a hashed global link */
+    virtual void route(std::size_t srcSwitch,
+                       std::size_t destSwitch,
+                       std::size_t hash,
+                       Path& outPath) const;
+
+private:
+    /** @return the router in group attached to the global link to peer */
+    std::size_t getGlobalRouter(std::size_t group,
+                                std::size_t peer,
+                                std::size_t link) const;
+
+    /** Append the local link between the routers, if they differ */
+    void appendLocalLink(std::size_t fromRouter,
+                         std::size_t toRouter,
+                         Path& outPath) const;
+
+    /** Number of groups */
+    std::size_t numGroups_;
+
+    /** Routers per group */
+    std::size_t routersPerGroup_;
+
+    /** Global links between each pair of groups */
+    std::size_t globalLinksPerPair_;
+
+    /**
+     * Local links indexed by
+     * (group * routersPerGroup + from) * routersPerGroup + to
+     */
+    std::vector<FlowNetworkModel::LinkId> localLinks_;
+
+    /**
+     * Global links indexed by
+     * (group * numGroups + peer) * globalLinksPerPair + link
+     */
+    std::vector<FlowNetworkModel::LinkId> globalLinks_;
+};
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
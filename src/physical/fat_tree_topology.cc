@@ -0,0 +1,113 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include "fat_tree_topology.h"
+#include <cassert>
+using namespace std;
+
+FatTreeTopology::FatTreeTopology(FlowNetworkModel& model,
+                                 size_t numPods,
+                                 size_t leavesPerPod,
+                                 size_t spinesPerPod,
+                                 size_t coresPerSpine,
+                                 double leafLinkBytesPerSec,
+                                 double coreLinkBytesPerSec)
+    : SwitchTopology(model),
+      numPods_(numPods),
+      leavesPerPod_(leavesPerPod),
+      spinesPerPod_(spinesPerPod),
+      coresPerSpine_(coresPerSpine)
+{
+    assert(0 < numPods_);
+    assert(0 < leavesPerPod_);
+    assert(0 < spinesPerPod_);
+    assert(1 == numPods_ || 0 < coresPerSpine_);
+
+    // Connect each leaf to each spine in its pod
+    for (size_t pod = 0; pod < numPods_; pod++)
+    {
+        for (size_t leaf = 0; leaf < leavesPerPod_; leaf++)
+        {
+            string leafName = switchName("leaf", pod, leaf);
+            for (size_t spine = 0; spine < spinesPerPod_; spine++)
+            {
+                string spineName = switchName("spine", pod, spine);
+                leafUp_.push_back(
+                    addLink(leafName, spineName, leafLinkBytesPerSec));
+                leafDown_.push_back(
+                    addLink(spineName, leafName, leafLinkBytesPerSec));
+            }
+        }
+    }
+
+    // Connect each spine to the cores in its group
+    if (1 < numPods_)
+    {
+        for (size_t pod = 0; pod < numPods_; pod++)
+        {
+            for (size_t spine = 0; spine < spinesPerPod_; spine++)
+            {
+                string spineName = switchName("spine", pod, spine);
+                for (size_t core = 0; core < coresPerSpine_; core++)
+                {
+                    string coreName = switchName("core", spine, core);
+                    spineUp_.push_back(
+                        addLink(spineName, coreName, coreLinkBytesPerSec));
+                    spineDown_.push_back(
+                        addLink(coreName, spineName, coreLinkBytesPerSec));
+                }
+            }
+        }
+    }
+}
+
+size_t FatTreeTopology::getNumEdgeSwitches() const
+{
+    return numPods_ * leavesPerPod_;
+}
+
+void FatTreeTopology::route(size_t srcSwitch,
+                            size_t destSwitch,
+                            size_t hash,
+                            Path& outPath) const
+{
+    assert(srcSwitch < getNumEdgeSwitches());
+    assert(destSwitch < getNumEdgeSwitches());
+
+    // Hosts on the same leaf do not leave it
+    if (srcSwitch == destSwitch)
+    {
+        return;
+    }
+
+    // Climb to a hashed spine, crossing a hashed core between pods
+    size_t spine = hash % spinesPerPod_;
+    outPath.push_back(leafUp_[srcSwitch * spinesPerPod_ + spine]);
+
+    size_t srcPod = srcSwitch / leavesPerPod_;
+    size_t destPod = destSwitch / leavesPerPod_;
+    if (srcPod != destPod)
+    {
+        size_t core = (hash / spinesPerPod_) % coresPerSpine_;
+        size_t srcSpine = srcPod * spinesPerPod_ + spine;
+        size_t destSpine = destPod * spinesPerPod_ + spine;
+        outPath.push_back(spineUp_[srcSpine * coresPerSpine_ + core]);
+        outPath.push_back(spineDown_[destSpine * coresPerSpine_ + core]);
+    }
+    outPath.push_back(leafDown_[destSwitch * spinesPerPod_ + spine]);
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,93 @@
+#ifndef FAT_TREE_TOPOLOGY_H
+#define FAT_TREE_TOPOLOGY_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstddef>
+#include <vector>
+#include "switch_topology.h"
+
+/**
+ * Two or three level fat tree.  Each pod has a row of leaf switches fully
+ * connected to a row of spine switches.  A two level tree is a single pod.
+ * A three level tree connects spine s of every pod to the core switches in
+ * core group s, so any two pods are joined by spinesPerPod * coresPerSpine
+ * equal cost paths.  Oversubscription is expressed by the link capacities.
+ */
+class FatTreeTopology : public SwitchTopology
+{
+public:
+    /**
+     * Constructor
+     *
+     * @param model the model to add the links to
+     * @param numPods the number of pods, 1 for a two level tree
+     * @param leavesPerPod the number of leaf switches in each pod
+     * @param spinesPerPod the number of spine switches in each pod
+     * @param coresPerSpine the core switches each spine connects to, 0 for
+     *   a two level tree
+     * @param leafLinkBytesPerSec the capacity of each leaf-spine link
+     * @param coreLinkBytesPerSec the capacity of each spine-core link
+     */
+    FatTreeTopology(FlowNetworkModel& model,
+                    std::size_t numPods,
+                    std::size_t leavesPerPod,
+                    std::size_t spinesPerPod,
+                    std::size_t coresPerSpine,
+                    double leafLinkBytesPerSec,
+                    double coreLinkBytesPerSec);
+
+    /** @return the number of leaf switches */
+    virtual std::size_t getNumEdgeSwitches() const;
+
+    /** Append the up and down links through a hashed spine and core */
+    virtual void route(std::size_t srcSwitch,
+                       std::size_t destSwitch,
+                       std::size_t hash,
+                       Path& outPath) const;
+
+private:
+    /** Number of pods */
+    std::size_t numPods_;
+
+    /** Leaf switches per pod */
+    std::size_t leavesPerPod_;
+
+    /** Spine switches per pod */
+    std::size_t spinesPerPod_;
+
+    /** Core switches per spine */
+    std::size_t coresPerSpine_;
+
+    /** Leaf to spine links indexed by leaf * spinesPerPod + spine */
+    std::vector<FlowNetworkModel::LinkId> leafUp_;
+
+    /** Spine to leaf links indexed by leaf * spinesPerPod + spine */
+    std::vector<FlowNetworkModel::LinkId> leafDown_;
+
+    /**
+     * Spine to core links indexed by
+     * (pod * spinesPerPod + spine) * coresPerSpine + core
+     */
+    std::vector<FlowNetworkModel::LinkId> spineUp_;
+
+    /** Core to spine links indexed as spineUp_ */
+    std::vector<FlowNetworkModel::LinkId> spineDown_;
+};
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
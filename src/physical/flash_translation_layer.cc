@@ -0,0 +1,195 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include "flash_translation_layer.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+using namespace std;
+
+FlashTranslationLayer::FlashTranslationLayer(int64_t numLogicalPages,
+                                             size_t numDies,
+                                             size_t pagesPerBlock,
+                                             double overprovisioning,
+                                             size_t gcThreshold)
+    : pagesPerBlock_(pagesPerBlock),
+      blocksPerDie_(0),
+      gcThreshold_(gcThreshold),
+      dies_(numDies),
+      numHostWrites_(0),
+      numFlashWrites_(0),
+      numErases_(0)
+{
+    assert(0 < numLogicalPages);
+    assert(0 < numDies);
+    assert(0 < pagesPerBlock);
+    assert(0.0 <= overprovisioning);
+    assert(2 <= gcThreshold);
+
+    // Size each die for its share of the logical pages plus the spare
+    // area.  At least gcThreshold + 1 spare blocks are required so that a
+    // die below the threshold always holds a block with invalid pages.
+    double pagesPerDie = ceil(double(numLogicalPages) / numDies);
+    size_t minBlocks = size_t(ceil(pagesPerDie / pagesPerBlock));
+    size_t spareBlocks =
+        size_t(ceil(pagesPerDie * (1.0 + overprovisioning) / pagesPerBlock));
+    blocksPerDie_ = max(spareBlocks, minBlocks + gcThreshold_ + 1);
+
+    // Begin writing the first block of each die
+    for (size_t i = 0; i < dies_.size(); i++)
+    {
+        dies_[i].nextUnusedBlock = 0;
+        allocateBlock(dies_[i]);
+    }
+}
+
+size_t FlashTranslationLayer::getDie(int64_t logicalPage) const
+{
+    assert(0 <= logicalPage);
+    return size_t(logicalPage % int64_t(dies_.size()));
+}
+
+bool FlashTranslationLayer::isMapped(int64_t logicalPage) const
+{
+    return (pageMap_.end() != pageMap_.find(logicalPage));
+}
+
+FlashTranslationLayer::WriteCost FlashTranslationLayer::writePage(
+    int64_t logicalPage)
+{
+    WriteCost cost;
+    cost.die = getDie(logicalPage);
+    cost.numCopies = 0;
+    cost.numErases = 0;
+
+    Die& die = dies_[cost.die];
+    invalidatePage(die, logicalPage);
+    appendPage(die, logicalPage);
+    numHostWrites_++;
+
+    collectGarbage(die, cost);
+    return cost;
+}
+
+size_t FlashTranslationLayer::getNumFreeBlocks(size_t die) const
+{
+    const Die& d = dies_[die];
+    return (blocksPerDie_ - d.nextUnusedBlock) + d.freeBlocks.size();
+}
+
+double FlashTranslationLayer::getWriteAmplification() const
+{
+    if (0 == numHostWrites_)
+    {
+        return 0.0;
+    }
+    return double(numFlashWrites_) / double(numHostWrites_);
+}
+
+void FlashTranslationLayer::appendPage(Die& die, int64_t logicalPage)
+{
+    // Seal the active block once it fills
+    if (pagesPerBlock_ == die.writePointer)
+    {
+        EraseBlock& full = die.blocks[die.activeBlock];
+        die.sealedBlocks.insert(make_pair(full.numValid, die.activeBlock));
+        allocateBlock(die);
+    }
+
+    EraseBlock& active = die.blocks[die.activeBlock];
+    active.owners[die.writePointer] = logicalPage;
+    active.numValid++;
+    pageMap_[logicalPage] = make_pair(die.activeBlock, die.writePointer);
+    die.writePointer++;
+    numFlashWrites_++;
+}
+
+void FlashTranslationLayer::invalidatePage(Die& die, int64_t logicalPage)
+{
+    map<int64_t, PageLocation>::iterator loc = pageMap_.find(logicalPage);
+    if (pageMap_.end() == loc)
+    {
+        return;
+    }
+
+    size_t blockNumber = loc->second.first;
+    EraseBlock& block = die.blocks[blockNumber];
+    block.owners[loc->second.second] = -1;
+
+    // Keep the victim order current for sealed blocks
+    if (blockNumber != die.activeBlock)
+    {
+        die.sealedBlocks.erase(make_pair(block.numValid, blockNumber));
+        die.sealedBlocks.insert(make_pair(block.numValid - 1, blockNumber));
+    }
+    block.numValid--;
+    pageMap_.erase(loc);
+}
+
+void FlashTranslationLayer::allocateBlock(Die& die)
+{
+    size_t blockNumber;
+    if (!die.freeBlocks.empty())
+    {
+        blockNumber = die.freeBlocks.front();
+        die.freeBlocks.pop_front();
+    }
+    else
+    {
+        assert(die.nextUnusedBlock < blocksPerDie_);
+        blockNumber = die.nextUnusedBlock++;
+    }
+
+    EraseBlock& block = die.blocks[blockNumber];
+    block.owners.assign(pagesPerBlock_, -1);
+    block.numValid = 0;
+    die.activeBlock = blockNumber;
+    die.writePointer = 0;
+}
+
+void FlashTranslationLayer::collectGarbage(Die& die, WriteCost& cost)
+{
+    while (getNumFreeBlocks(cost.die) < gcThreshold_ &&
+           !die.sealedBlocks.empty())
+    {
+        // Greedily select the block with the fewest valid pages
+        size_t victimNumber = die.sealedBlocks.begin()->second;
+        if (pagesPerBlock_ == die.sealedBlocks.begin()->first)
+        {
+            break;
+        }
+        die.sealedBlocks.erase(die.sealedBlocks.begin());
+
+        // Relocate the valid pages to the log
+        vector<int64_t> owners = die.blocks[victimNumber].owners;
+        for (size_t i = 0; i < owners.size(); i++)
+        {
+            if (-1 != owners[i])
+            {
+                appendPage(die, owners[i]);
+                cost.numCopies++;
+            }
+        }
+
+        // Erase the victim
+        die.blocks.erase(victimNumber);
+        die.freeBlocks.push_back(victimNumber);
+        cost.numErases++;
+        numErases_++;
+    }
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
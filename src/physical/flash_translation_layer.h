@@ -0,0 +1,167 @@
+#ifndef FLASH_TRANSLATION_LAYER_H
+#define FLASH_TRANSLATION_LAYER_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * Page mapped, log structured flash translation layer.
+ *
+ * Logical pages are statically striped across the dies, and each die
+ * appends written pages to its active erase block.  Overwritten pages are
+ * invalidated in place.  When a die's free erase blocks fall below the
+ * garbage collection threshold, the sealed block with the fewest valid
+ * pages is collected: its valid pages are copied to the log and the block
+ * is erased.
+ */
+class FlashTranslationLayer
+{
+public:
+    /** Flash work performed by a single page write */
+    struct WriteCost
+    {
+        /** The die written */
+        std::size_t die;
+
+        /** Valid pages copied by garbage collection */
+        std::size_t numCopies;
+
+        /** Blocks erased by garbage collection */
+        std::size_t numErases;
+    };
+
+    /**
+     * Constructor
+     *
+     * @param numLogicalPages the number of host visible pages
+     * @param numDies the number of independent flash dies
+     * @param pagesPerBlock the number of pages in an erase block
+     * @param overprovisioning the fraction of spare physical pages
+     * @param gcThreshold collect garbage on a die when fewer than this
+     *   many erase blocks are free
+     */
+    FlashTranslationLayer(int64_t numLogicalPages,
+                          std::size_t numDies,
+                          std::size_t pagesPerBlock,
+                          double overprovisioning,
+                          std::size_t gcThreshold);
+
+    /** @return the die that stores the logical page */
+    std::size_t getDie(int64_t logicalPage) const;
+
+    /** @return true if the logical page has been written */
+    bool isMapped(int64_t logicalPage) const;
+
+    /** Write the logical page to the log of its die */
+    WriteCost writePage(int64_t logicalPage);
+
+    /** @return the number of erase blocks in each die */
+    std::size_t getBlocksPerDie() const { return blocksPerDie_; };
+
+    /** @return the number of free erase blocks in a die */
+    std::size_t getNumFreeBlocks(std::size_t die) const;
+
+    /** @return the number of pages written by the host */
+    uint64_t getNumHostWrites() const { return numHostWrites_; };
+
+    /** @return the number of pages programmed, including copies */
+    uint64_t getNumFlashWrites() const { return numFlashWrites_; };
+
+    /** @return the number of erase blocks erased */
+    uint64_t getNumErases() const { return numErases_; };
+
+    /** @return flash page programs per host page write */
+    double getWriteAmplification() const;
+
+private:
+    /** State of a written erase block */
+    struct EraseBlock
+    {
+        /** The logical page stored in each physical page, or -1 */
+        std::vector<int64_t> owners;
+
+        /** The number of valid pages */
+        std::size_t numValid;
+    };
+
+    /** Log state of a die */
+    struct Die
+    {
+        /** Written erase blocks */
+        std::map<std::size_t, EraseBlock> blocks;
+
+        /** Full erase blocks ordered by number of valid pages */
+        std::set<std::pair<std::size_t, std::size_t> > sealedBlocks;
+
+        /** Erased blocks available for writing */
+        std::deque<std::size_t> freeBlocks;
+
+        /** The lowest block that has never been written */
+        std::size_t nextUnusedBlock;
+
+        /** The block receiving writes */
+        std::size_t activeBlock;
+
+        /** The next page to write in the active block */
+        std::size_t writePointer;
+    };
+
+    /** Physical location of a page within its die */
+    typedef std::pair<std::size_t, std::size_t> PageLocation;
+
+    /** Append the logical page to the die's log */
+    void appendPage(Die& die, int64_t logicalPage);
+
+    /** Invalidate the current location of the logical page */
+    void invalidatePage(Die& die, int64_t logicalPage);
+
+    /** Begin writing a free erase block */
+    void allocateBlock(Die& die);
+
+    /** Collect erase blocks until the die reaches the threshold */
+    void collectGarbage(Die& die, WriteCost& cost);
+
+    /** Pages in an erase block */
+    std::size_t pagesPerBlock_;
+
+    /** Erase blocks in each die */
+    std::size_t blocksPerDie_;
+
+    /** Minimum free erase blocks in each die */
+    std::size_t gcThreshold_;
+
+    /** Die states */
+    std::vector<Die> dies_;
+
+    /** Location of each written logical page */
+    std::map<int64_t, PageLocation> pageMap_;
+
+    /** Statistics */
+    uint64_t numHostWrites_;
+    uint64_t numFlashWrites_;
+    uint64_t numErases_;
+};
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
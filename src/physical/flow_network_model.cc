@@ -0,0 +1,220 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include "flow_network_model.h"
+#include <cassert>
+#include <limits>
+using namespace std;
+
+/** Flows with less than this many bytes remaining are complete */
+static const double COMPLETION_THRESHOLD_BYTES = 1.0e-3;
+
+FlowNetworkModel::FlowNetworkModel()
+    : nextFlowId_(0)
+{
+}
+
+FlowNetworkModel::LinkId FlowNetworkModel::addLink(double bytesPerSec)
+{
+    assert(0.0 < bytesPerSec);
+    capacities_.push_back(bytesPerSec);
+    linkBytes_.push_back(0.0);
+    return capacities_.size() - 1;
+}
+
+double FlowNetworkModel::getLinkCapacity(LinkId link) const
+{
+    assert(link < capacities_.size());
+    return capacities_[link];
+}
+
+double FlowNetworkModel::getLinkBytes(LinkId link) const
+{
+    assert(link < linkBytes_.size());
+    return linkBytes_[link];
+}
+
+FlowNetworkModel::FlowId FlowNetworkModel::addFlow(const vector<LinkId>& path,
+                                                   double numBytes)
+{
+    assert(!path.empty());
+    assert(0.0 <= numBytes);
+    Flow flow;
+    flow.path = path;
+    flow.remainingBytes = numBytes;
+    flow.rate = 0.0;
+    flows_[nextFlowId_] = flow;
+    return nextFlowId_++;
+}
+
+void FlowNetworkModel::removeFlow(FlowId flow)
+{
+    size_t numErased = flows_.erase(flow);
+    assert(1 == numErased);
+}
+
+double FlowNetworkModel::getRate(FlowId flow) const
+{
+    map<FlowId, Flow>::const_iterator iter = flows_.find(flow);
+    assert(flows_.end() != iter);
+    return iter->second.rate;
+}
+
+double FlowNetworkModel::getRemainingBytes(FlowId flow) const
+{
+    map<FlowId, Flow>::const_iterator iter = flows_.find(flow);
+    assert(flows_.end() != iter);
+    return iter->second.remainingBytes;
+}
+
+void FlowNetworkModel::advance(double elapsedSecs)
+{
+    assert(0.0 <= elapsedSecs);
+    map<FlowId, Flow>::iterator iter;
+    for (iter = flows_.begin(); iter != flows_.end(); ++iter)
+    {
+        Flow& flow = iter->second;
+        double numBytes = flow.rate * elapsedSecs;
+        if (numBytes > flow.remainingBytes)
+        {
+            numBytes = flow.remainingBytes;
+        }
+        flow.remainingBytes -= numBytes;
+
+        // Account the carried bytes to each link on the path
+        for (size_t i = 0; i < flow.path.size(); i++)
+        {
+            linkBytes_[flow.path[i]] += numBytes;
+        }
+    }
+}
+
+void FlowNetworkModel::computeRates()
+{
+    // Progressive filling: repeatedly find the link offering the smallest
+    // fair share to its unassigned flows, fix those flows at that share,
+    // and remove their bandwidth from the other links they cross
+    vector<double> residual(capacities_);
+    vector<size_t> numUnassigned(capacities_.size(), 0);
+    map<FlowId, Flow>::iterator iter;
+    for (iter = flows_.begin(); iter != flows_.end(); ++iter)
+    {
+        iter->second.rate = -1.0;
+        for (size_t i = 0; i < iter->second.path.size(); i++)
+        {
+            numUnassigned[iter->second.path[i]]++;
+        }
+    }
+
+    size_t numAssigned = 0;
+    while (numAssigned < flows_.size())
+    {
+        // Locate the bottleneck link
+        LinkId bottleneck = 0;
+        double share = numeric_limits<double>::max();
+        for (LinkId link = 0; link < capacities_.size(); link++)
+        {
+            if (0 != numUnassigned[link])
+            {
+                double linkShare = residual[link] / numUnassigned[link];
+                if (linkShare < share)
+                {
+                    share = linkShare;
+                    bottleneck = link;
+                }
+            }
+        }
+        assert(numeric_limits<double>::max() != share);
+        if (share < 0.0)
+        {
+            share = 0.0;
+        }
+
+        // Assign the share to each unassigned flow crossing the bottleneck
+        for (iter = flows_.begin(); iter != flows_.end(); ++iter)
+        {
+            Flow& flow = iter->second;
+            if (0.0 > flow.rate)
+            {
+                bool crossesBottleneck = false;
+                for (size_t i = 0; i < flow.path.size(); i++)
+                {
+                    if (bottleneck == flow.path[i])
+                    {
+                        crossesBottleneck = true;
+                        break;
+                    }
+                }
+
+                if (crossesBottleneck)
+                {
+                    flow.rate = share;
+                    numAssigned++;
+                    for (size_t i = 0; i < flow.path.size(); i++)
+                    {
+                        residual[flow.path[i]] -= share;
+                        numUnassigned[flow.path[i]]--;
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool FlowNetworkModel::getNextCompletion(FlowId& outFlow,
+                                         double& outSecs) const
+{
+    bool isFound = false;
+    map<FlowId, Flow>::const_iterator iter;
+    for (iter = flows_.begin(); iter != flows_.end(); ++iter)
+    {
+        const Flow& flow = iter->second;
+        double secs = numeric_limits<double>::max();
+        if (COMPLETION_THRESHOLD_BYTES > flow.remainingBytes)
+        {
+            secs = 0.0;
+        }
+        else if (0.0 < flow.rate)
+        {
+            secs = flow.remainingBytes / flow.rate;
+        }
+
+        if (numeric_limits<double>::max() != secs &&
+            (!isFound || secs < outSecs))
+        {
+            outFlow = iter->first;
+            outSecs = secs;
+            isFound = true;
+        }
+    }
+    return isFound;
+}
+
+vector<FlowNetworkModel::FlowId> FlowNetworkModel::getCompletedFlows() const
+{
+    vector<FlowId> completed;
+    map<FlowId, Flow>::const_iterator iter;
+    for (iter = flows_.begin(); iter != flows_.end(); ++iter)
+    {
+        if (COMPLETION_THRESHOLD_BYTES > iter->second.remainingBytes)
+        {
+            completed.push_back(iter->first);
+        }
+    }
+    return completed;
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
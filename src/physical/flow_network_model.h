@@ -0,0 +1,122 @@
+#ifndef FLOW_NETWORK_MODEL_H
+#define FLOW_NETWORK_MODEL_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstddef>
+#include <map>
+#include <vector>
+
+/**
+ * Fluid model of a network.  Each transfer is a flow across a fixed path
+ * of links, and the link bandwidth is shared among the flows crossing it
+ * using max-min fairness.  The rates are constant between flow arrivals
+ * and departures, so the owner only needs to recompute them (and the
+ * next completion time) when a flow is added or removed.
+ */
+class FlowNetworkModel
+{
+public:
+    /** Link identifier */
+    typedef std::size_t LinkId;
+
+    /** Flow identifier */
+    typedef std::size_t FlowId;
+
+    /** Constructor */
+    FlowNetworkModel();
+
+    /**
+     * Add a link
+     *
+     * @param bytesPerSec the link capacity
+     * @return the id of the new link
+     */
+    LinkId addLink(double bytesPerSec);
+
+    /** @return the number of links */
+    std::size_t getNumLinks() const { return capacities_.size(); };
+
+    /** @return the capacity of the link in bytes per second */
+    double getLinkCapacity(LinkId link) const;
+
+    /** @return the total bytes the flows have carried across the link */
+    double getLinkBytes(LinkId link) const;
+
+    /**
+     * Add a flow without recomputing the rates
+     *
+     * @param path the links the flow crosses
+     * @param numBytes the amount of data to transfer
+     * @return the id of the new flow
+     */
+    FlowId addFlow(const std::vector<LinkId>& path, double numBytes);
+
+    /** Remove the flow without recomputing the rates */
+    void removeFlow(FlowId flow);
+
+    /** @return the number of active flows */
+    std::size_t getNumFlows() const { return flows_.size(); };
+
+    /** @return the current rate of the flow in bytes per second */
+    double getRate(FlowId flow) const;
+
+    /** @return the bytes the flow has yet to transfer */
+    double getRemainingBytes(FlowId flow) const;
+
+    /** Drain every flow at its current rate for elapsedSecs */
+    void advance(double elapsedSecs);
+
+    /** Assign max-min fair rates to the active flows */
+    void computeRates();
+
+    /**
+     * Find the flow that will finish first at the current rates
+     *
+     * @param outFlow set to the id of the flow
+     * @param outSecs set to the time until the flow completes
+     * @return false if no flow is active
+     */
+    bool getNextCompletion(FlowId& outFlow, double& outSecs) const;
+
+    /** @return the ids of the flows with no bytes remaining */
+    std::vector<FlowId> getCompletedFlows() const;
+
+private:
+    /** An active transfer */
+    struct Flow
+    {
+        std::vector<LinkId> path;
+        double remainingBytes;
+        double rate;
+    };
+
+    /** Link capacities indexed by link id */
+    std::vector<double> capacities_;
+
+    /** Bytes carried indexed by link id */
+    std::vector<double> linkBytes_;
+
+    /** Active flows */
+    std::map<FlowId, Flow> flows_;
+
+    /** Id for the next flow */
+    FlowId nextFlowId_;
+};
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
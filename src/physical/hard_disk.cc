@@ -8,8 +8,11 @@
 //
 #include "hard_disk.h"
 #include <cassert>
+#include <cmath>
 #include <cstdlib>
 #include "basic_types.h"
+#include "flash_translation_layer.h"
+#include "message_kind.h"
 #include "os_proto_m.h"
 using namespace std;
 
@@ -41,35 +44,34 @@ void HardDisk::finish()
 
 void HardDisk::handleMessage(cMessage *msg)
 {
-    // Service and construct responses for read and write requests
+    // Service read and write requests
     double delay = 0.0;
-    cMessage* resp = 0;
-    if (spfsOSReadDeviceRequest* read =
-        dynamic_cast<spfsOSReadDeviceRequest*>(msg))
-    {
-        LogicalBlockAddress diskBlock = read->getAddress();
-        delay = service(diskBlock, true);
-        resp = new spfsOSReadDeviceResponse();
-        totalBlocksRead_++;
-    }
-    else if (spfsOSWriteDeviceRequest* write =
-             dynamic_cast<spfsOSWriteDeviceRequest*>(msg))
-    {
-        LogicalBlockAddress diskBlock = write->getAddress();
-        delay = service(diskBlock, false);
-        resp = new spfsOSWriteDeviceResponse();
-        totalBlocksWritten_++;
-    }
-    else
+    switch (msg->getKind())
     {
-        cerr << __FILE__ << ":" << __LINE__ << ":"
-             << "ERROR in hard disk for message:" << msg->info() << endl;
-        assert(0);
+        case SPFS_OS_READ_DEVICE_REQUEST:
+        {
+            spfsOSReadDeviceRequest* read =
+                kind_cast<spfsOSReadDeviceRequest>(msg);
+            delay = service(read->getAddress(), read->getExtent(), true);
+            break;
+        }
+        case SPFS_OS_WRITE_DEVICE_REQUEST:
+        {
+            spfsOSWriteDeviceRequest* write =
+                kind_cast<spfsOSWriteDeviceRequest>(msg);
+            delay = service(write->getAddress(), write->getExtent(), false);
+            break;
+        }
+        default:
+        {
+            cerr << __FILE__ << ":" << __LINE__ << ":"
+                 << "ERROR in hard disk for message:" << msg->info() << endl;
+            assert(0);
+        }
     }
 
     // Schedule response at the end of service period
-    resp->setContextPointer(msg);
-    sendDelayed(resp, delay, outGateId_);
+    sendResponse(msg, delay);
 }
 
 long HardDisk::getBasicBlockSize() const
@@ -87,15 +89,42 @@ void HardDisk::registerDiskDelay(double diskTime)
     //     << "Disk delay: " << diskTime << " Total Delay: " << totalDelay_ << endl;
 }
 
+void HardDisk::sendResponse(cMessage* request, double delay)
+{
+    cMessage* resp = 0;
+    if (SPFS_OS_READ_DEVICE_REQUEST == request->getKind())
+    {
+        spfsOSReadDeviceRequest* read =
+            kind_cast<spfsOSReadDeviceRequest>(request);
+        resp = new spfsOSReadDeviceResponse(0, SPFS_OS_READ_DEVICE_RESPONSE);
+        totalBlocksRead_ += read->getExtent();
+    }
+    else
+    {
+        spfsOSWriteDeviceRequest* write =
+            kind_cast<spfsOSWriteDeviceRequest>(request);
+        resp = new spfsOSWriteDeviceResponse(0, SPFS_OS_WRITE_DEVICE_RESPONSE);
+        totalBlocksWritten_ += write->getExtent();
+    }
+    resp->setContextPointer(request);
+    sendDelayed(resp, delay, outGateId_);
+}
+
 //
 // Create BasicModelDisk module -- this not code originally developed as part
 // of FSS
 //
 Define_Module(BasicModelDisk);
 
-void BasicModelDisk::handleMessage(cMessage* msg)
+BasicModelDisk::BasicModelDisk()
+    : completionMsg_(0)
+{
+}
+
+BasicModelDisk::~BasicModelDisk()
 {
-    HardDisk::handleMessage(msg);
+    cancelAndDelete(completionMsg_);
+    completionMsg_ = 0;
 }
 
 void BasicModelDisk::initialize()
@@ -111,7 +140,7 @@ void BasicModelDisk::initialize()
     rpms_ = par("rpm").longValue();
 
     // Derived layout parameters
-    headsPerCylinder_ = numCylinders_ / numHeads_;
+    sectorsPerCylinder_ = numHeads_ * sectorsPerTrack_;
 
     // Drive performance parameters
     fixedControllerReadOverheadSecs_ =
@@ -123,95 +152,512 @@ void BasicModelDisk::initialize()
     averageWriteSeekSecs_ = par("averageWriteSeekSecs").doubleValue();
 
     // Derived performance parameters
-    timePerRevolution_ = 1.0 / rpms_;
+    timePerRevolution_ = 60.0 / rpms_;
     timePerSector_ = timePerRevolution_ / sectorsPerTrack_;
 
     // FIXME: Need workaround to get 64 bits of integer precisison
     // could use strings here, but double reinterpret won't work :(
     capacity_ = 512 * numSectors_;
 
+    // Drive controller parameters
+    queueDepth_ = par("queueDepth").longValue();
+    size_t numCacheSegments = par("numCacheSegments").longValue();
+    cacheSegmentBlocks_ = par("cacheSegmentBlocks").longValue();
+    readaheadBlocks_ = par("readaheadBlocks").longValue();
+    isWriteCacheEnabled_ = par("writeCacheEnabled").boolValue();
+    bufferTransferSecsPerBlock_ =
+        basicBlockSize() / par("interfaceBytesPerSec").doubleValue();
+    maxDirtyBlocks_ = (numCacheSegments * cacheSegmentBlocks_) / 2;
+    assert(0 < queueDepth_);
+    assert(0 < cacheSegmentBlocks_);
+
     // Park the head at the central cylinder to begin with
     lastCylinder_ = numCylinders_/2;
 
-    // Set the time of the last service completion
-    lastCompletionTime_ = 0.0;
+    // Begin with an empty command queue and buffer
+    completionMsg_ = new cMessage("Disk Command Completion");
+    CacheSegment emptySegment = {0, 0, 0.0};
+    cacheSegments_.assign(numCacheSegments, emptySegment);
+    numDirtyBlocks_ = 0;
+    isReadaheadPending_ = false;
+
+    // Initialize statistics
+    numReadHits_ = 0;
+    numPartialReadHits_ = 0;
+    numReadMisses_ = 0;
+    numCachedWrites_ = 0;
+    numReadaheadBlocks_ = 0;
+    maxQueueDepth_ = 0;
+    queueDepthVector_.setName("SPFS Disk Queue Depth");
 }
 
-double BasicModelDisk::service(LogicalBlockAddress blockNumber, bool isRead)
+void BasicModelDisk::finish()
 {
-    // Service delay
-    double totalDelay = 0.0;
+    HardDisk::finish();
+    recordScalar("SPFS Disk Cache Read Hits", numReadHits_);
+    recordScalar("SPFS Disk Cache Partial Read Hits", numPartialReadHits_);
+    recordScalar("SPFS Disk Cache Read Misses", numReadMisses_);
+    recordScalar("SPFS Disk Cached Writes", numCachedWrites_);
+    recordScalar("SPFS Disk Readahead Blocks", numReadaheadBlocks_);
+    recordScalar("SPFS Disk Max Queue Depth", maxQueueDepth_);
+}
 
-    // Determine physical location, better would be to use zoned sector per
-    // track counts
-    int temp = blockNumber % (headsPerCylinder_ * sectorsPerTrack_);
-    int destCylinder = blockNumber / (headsPerCylinder_ * sectorsPerTrack_);
-    int destHead = temp / sectorsPerTrack_;
-    int destSector = temp % sectorsPerTrack_ + 1;
+void BasicModelDisk::handleMessage(cMessage* msg)
+{
+    if (msg == completionMsg_)
+    {
+        completeCommand();
+        return;
+    }
 
-    // Account for cylinder switch/arm movement
-    int cylindersToMove = destCylinder - lastCylinder_;
-    if (0 != cylindersToMove)
+    // Construct the command for the request
+    DiskCommand command;
+    command.request = msg;
+    switch (msg->getKind())
     {
-        // Simply use the average seek time to calculate cylinder location
-        // (a bad choice, but arm acceleration data is not currently available
-        // this is a serious departure from the paper's model, possibly leading
-        // to double digit inaccuracies)
-        if (isRead)
-            totalDelay += averageReadSeekSecs_;
-        else
-            totalDelay += averageWriteSeekSecs_;
+        case SPFS_OS_READ_DEVICE_REQUEST:
+        {
+            spfsOSReadDeviceRequest* read =
+                kind_cast<spfsOSReadDeviceRequest>(msg);
+            command.lba = read->getAddress();
+            command.numBlocks = read->getExtent();
+            command.isRead = true;
+            break;
+        }
+        case SPFS_OS_WRITE_DEVICE_REQUEST:
+        {
+            spfsOSWriteDeviceRequest* write =
+                kind_cast<spfsOSWriteDeviceRequest>(msg);
+            command.lba = write->getAddress();
+            command.numBlocks = write->getExtent();
+            command.isRead = false;
+            break;
+        }
+        default:
+        {
+            cerr << __FILE__ << ":" << __LINE__ << ":"
+                 << "ERROR in hard disk for message:" << msg->info() << endl;
+            assert(0);
+        }
+    }
+    assert(0 < command.numBlocks);
+
+    // Complete writes once they are transferred into the write cache, and
+    // destage them later
+    if (!command.isRead && isWriteCacheEnabled_ &&
+        numDirtyBlocks_ + command.numBlocks <= maxDirtyBlocks_)
+    {
+        double delay = fixedControllerWriteOverheadSecs_ +
+            command.numBlocks * bufferTransferSecsPerBlock_;
+        fillCache(command.lba, command.lba + command.numBlocks);
+        sendResponse(msg, delay);
+        numDirtyBlocks_ += command.numBlocks;
+        numCachedWrites_++;
+        command.request = 0;
+    }
+
+    // Queue the command
+    commandQueue_.push_back(command);
+    maxQueueDepth_ = max(maxQueueDepth_, commandQueue_.size());
+    queueDepthVector_.record(commandQueue_.size());
+    if (!completionMsg_->isScheduled())
+    {
+        startNextCommand();
     }
+}
+
+double BasicModelDisk::service(LogicalBlockAddress blockNumber,
+                               long numBlocks,
+                               bool isRead)
+{
+    assert(0 < numBlocks);
+
+    // Position the head over the first block
+    double totalDelay = accessTime(blockNumber, isRead, simTime());
+
+    // Add delay to transfer the data off the media, switching tracks each
+    // time the extent crosses a track boundary
+    LogicalBlockAddress lastBlock = blockNumber + numBlocks - 1;
+    long trackSwitches = (lastBlock / sectorsPerTrack_) -
+        (blockNumber / sectorsPerTrack_);
+    totalDelay += numBlocks * timePerSector_;
+    totalDelay += trackSwitches * trackSwitchTimeSecs_;
+
+    // Update disk state to the position of the final block transferred
+    lastCylinder_ = lastBlock / sectorsPerCylinder_;
+    return totalDelay;
+}
 
-    // Account for head switch time/fixed controller overhead if the
-    // controller is not currently active
+uint32_t BasicModelDisk::basicBlockSize() const
+{
+    //FIXME return capacity_ / numSectors_;
+    return 512;
+}
+
+double BasicModelDisk::accessTime(LogicalBlockAddress blockNumber,
+                                  bool isRead,
+                                  simtime_t startTime) const
+{
+    // Account for cylinder switch/arm movement
+    uint32_t destCylinder = blockNumber / sectorsPerCylinder_;
+    uint32_t distance = (destCylinder < lastCylinder_) ?
+        (lastCylinder_ - destCylinder) : (destCylinder - lastCylinder_);
+    double positionDelay = seekTime(distance, isRead);
+
+    // Account for fixed controller overhead
     if (isRead)
     {
-        totalDelay += fixedControllerReadOverheadSecs_;
+        positionDelay += fixedControllerReadOverheadSecs_;
     }
     else
     {
-        totalDelay += fixedControllerWriteOverheadSecs_;
+        positionDelay += fixedControllerWriteOverheadSecs_;
+    }
+
+    // Account for the rotational delay until the destination sector
+    // arrives under the head
+    double angle =
+        fmod(startTime.dbl() + positionDelay, timePerRevolution_);
+    double destAngle = (blockNumber % sectorsPerTrack_) * timePerSector_;
+    double rotationalDelay = destAngle - angle;
+    if (rotationalDelay < 0.0)
+    {
+        // Must wrap around to sector 0
+        rotationalDelay += timePerRevolution_;
+    }
+    return positionDelay + rotationalDelay;
+}
+
+double BasicModelDisk::seekTime(uint32_t distance, bool isRead) const
+{
+    if (0 == distance)
+    {
+        return 0.0;
+    }
+
+    // Seek time grows with the square root of the seek distance, scaled so
+    // that seeks between uniformly random cylinders, whose mean square root
+    // distance is 8/15 of the full stroke, average the average seek time
+    double averageSeekSecs =
+        isRead ? averageReadSeekSecs_ : averageWriteSeekSecs_;
+    double seekSecs = (averageSeekSecs - trackSwitchTimeSecs_) *
+        sqrt(double(distance) / numCylinders_) * 15.0 / 8.0;
+    return trackSwitchTimeSecs_ + max(0.0, seekSecs);
+}
+
+long BasicModelDisk::getCachedBlocks(LogicalBlockAddress blockNumber,
+                                     long numBlocks) const
+{
+    LogicalBlockAddress cachedEnd = blockNumber;
+    for (size_t i = 0; i < cacheSegments_.size(); i++)
+    {
+        const CacheSegment& segment = cacheSegments_[i];
+        if (segment.begin <= blockNumber && blockNumber < segment.end)
+        {
+            cachedEnd = max(cachedEnd, segment.end);
+        }
     }
+    return long(min(LogicalBlockAddress(numBlocks), cachedEnd - blockNumber));
+}
 
-    // Account for the sector switching/rotational delay
+void BasicModelDisk::fillCache(LogicalBlockAddress begin,
+                               LogicalBlockAddress end)
+{
+    if (cacheSegments_.empty())
+    {
+        return;
+    }
+
+    // Extend a segment holding or adjoining the beginning of the range,
+    // otherwise replace the least recently used segment
+    size_t target = 0;
+    bool isExtension = false;
+    for (size_t i = 0; i < cacheSegments_.size(); i++)
+    {
+        const CacheSegment& segment = cacheSegments_[i];
+        if (segment.begin < segment.end &&
+            segment.begin <= begin && begin <= segment.end)
+        {
+            target = i;
+            isExtension = true;
+            break;
+        }
+        else if (segment.lastUse < cacheSegments_[target].lastUse)
+        {
+            target = i;
+        }
+    }
+
+    CacheSegment& segment = cacheSegments_[target];
+    if (isExtension)
+    {
+        segment.end = max(segment.end, end);
+    }
+    else
+    {
+        segment.begin = begin;
+        segment.end = end;
+    }
+
+    // Keep the most recent blocks when the segment overflows
+    if (cacheSegmentBlocks_ < segment.end - segment.begin)
+    {
+        segment.begin = segment.end - cacheSegmentBlocks_;
+    }
+    segment.lastUse = simTime();
+}
+
+void BasicModelDisk::completeReadahead()
+{
+    if (!isReadaheadPending_)
+    {
+        return;
+    }
+    isReadaheadPending_ = false;
+
+    // The drive reads ahead until it begins another command
+    double readSecs = (simTime() - readaheadStartTime_).dbl();
+    LogicalBlockAddress numBlocks = min(
+        LogicalBlockAddress(readaheadBlocks_),
+        LogicalBlockAddress(readSecs / timePerSector_));
+    numBlocks = min(numBlocks, numSectors_ - readaheadBegin_);
+    if (0 < numBlocks)
+    {
+        fillCache(readaheadBegin_, readaheadBegin_ + numBlocks);
+        lastCylinder_ = (readaheadBegin_ + numBlocks - 1) / sectorsPerCylinder_;
+        numReadaheadBlocks_ += numBlocks;
+    }
+}
+
+void BasicModelDisk::startNextCommand()
+{
+    if (commandQueue_.empty())
+    {
+        return;
+    }
+    completeReadahead();
+
+    // Select the command with the shortest access time among the first
+    // queueDepth commands, earliest first among ties
     simtime_t currentTime = simTime();
-    long sectorsToMove = 0;
-    long currentSector =
-        static_cast<long>(fmod(currentTime.dbl(), timePerRevolution_)/timePerSector_);
-    if (currentSector != destSector)
+    list<DiskCommand>::iterator next = commandQueue_.begin();
+    double nextAccessTime = 0.0;
+    size_t position = 0;
+    for (list<DiskCommand>::iterator iter = commandQueue_.begin();
+         iter != commandQueue_.end() && position < queueDepth_;
+         ++iter, ++position)
+    {
+        long cachedBlocks = 0;
+        if (iter->isRead)
+        {
+            cachedBlocks = getCachedBlocks(iter->lba, iter->numBlocks);
+        }
+
+        double commandAccessTime = 0.0;
+        if (cachedBlocks < iter->numBlocks)
+        {
+            commandAccessTime = accessTime(iter->lba + cachedBlocks,
+                                           iter->isRead,
+                                           currentTime);
+        }
+
+        if (0 == position || commandAccessTime < nextAccessTime)
+        {
+            next = iter;
+            nextAccessTime = commandAccessTime;
+        }
+    }
+    activeCommand_ = *next;
+    commandQueue_.erase(next);
+    queueDepthVector_.record(commandQueue_.size());
+
+    // Service the command from the buffer and the media
+    double delay = 0.0;
+    LogicalBlockAddress lba = activeCommand_.lba;
+    long numBlocks = activeCommand_.numBlocks;
+    if (activeCommand_.isRead)
     {
-        if (currentSector < destSector)
+        long cachedBlocks = getCachedBlocks(lba, numBlocks);
+        if (cachedBlocks == numBlocks)
         {
-            sectorsToMove = destSector - currentSector;
+            delay = fixedControllerReadOverheadSecs_ +
+                numBlocks * bufferTransferSecsPerBlock_;
+            numReadHits_++;
         }
         else
         {
-            // Must wrap around to sector 0
-            sectorsToMove  = sectorsPerTrack_ - currentSector;
-            sectorsToMove += destSector;
+            delay = service(lba + cachedBlocks,
+                            numBlocks - cachedBlocks,
+                            true);
+            if (0 < cachedBlocks)
+            {
+                numPartialReadHits_++;
+            }
+            else
+            {
+                numReadMisses_++;
+            }
+
+            // Read ahead once the command completes
+            isReadaheadPending_ =
+                (0 < readaheadBlocks_ && !cacheSegments_.empty());
+            readaheadBegin_ = lba + numBlocks;
+            readaheadStartTime_ = currentTime + delay;
         }
-        totalDelay += sectorsToMove * timePerSector_;
     }
+    else
+    {
+        delay = service(lba, numBlocks, false);
+    }
+    fillCache(lba, lba + numBlocks);
+    registerDiskDelay(delay);
+    scheduleAt(currentTime + delay, completionMsg_);
+}
 
-    // Add delay to transfer the data off the media
-    totalDelay += timePerSector_;
-    registerDiskDelay(totalDelay);
+void BasicModelDisk::completeCommand()
+{
+    if (0 != activeCommand_.request)
+    {
+        sendResponse(activeCommand_.request, 0.0);
+    }
+    else
+    {
+        // The destaged blocks are no longer dirty
+        numDirtyBlocks_ -= activeCommand_.numBlocks;
+    }
+    startNextCommand();
+}
 
-    // Update disk state
-    lastCylinder_ = destCylinder;
-    lastHead_ = destHead;
-    lastCompletionTime_ = max(lastCompletionTime_, currentTime) + totalDelay;
+//
+// Create FlashModelDisk module
+//
+Define_Module(FlashModelDisk);
 
-    // Modify the delay to take into account that the disk can only service
-    // one request at a time
-    simtime_t completionDelay = (lastCompletionTime_ - currentTime) + totalDelay;
-    return completionDelay.dbl();
+FlashModelDisk::FlashModelDisk()
+    : ftl_(0)
+{
 }
 
-uint32_t BasicModelDisk::basicBlockSize() const
+FlashModelDisk::~FlashModelDisk()
+{
+    delete ftl_;
+    ftl_ = 0;
+}
+
+void FlashModelDisk::initialize()
+{
+    // Initialize parent
+    HardDisk::initialize();
+
+    // Device organization parameters
+    numChannels_ = par("numChannels").longValue();
+    size_t diesPerChannel = par("diesPerChannel").longValue();
+    size_t pageSize = par("pageSize").longValue();
+    size_t pagesPerBlock = par("pagesPerBlock").longValue();
+    double numSectors = par("numSectors").doubleValue();
+    double overprovisioning = par("overprovisioning").doubleValue();
+    size_t gcThreshold = par("gcThreshold").longValue();
+    assert(0 < numChannels_);
+    assert(0 < diesPerChannel);
+    assert(0 == (pageSize % basicBlockSize()));
+
+    // Device performance parameters
+    controllerOverheadSecs_ = par("controllerOverheadSecs").doubleValue();
+    pageReadSecs_ = par("pageReadSecs").doubleValue();
+    pageProgramSecs_ = par("pageProgramSecs").doubleValue();
+    blockEraseSecs_ = par("blockEraseSecs").doubleValue();
+    double channelBytesPerSec = par("channelBytesPerSec").doubleValue();
+
+    // Derived parameters
+    sectorsPerPage_ = pageSize / basicBlockSize();
+    pageTransferSecs_ = pageSize / channelBytesPerSec;
+    int64_t numPages = int64_t(ceil(numSectors / sectorsPerPage_));
+
+    // Logical pages are striped across the channels first, and then
+    // across the dies on each channel
+    size_t numDies = numChannels_ * diesPerChannel;
+    ftl_ = new FlashTranslationLayer(numPages,
+                                     numDies,
+                                     pagesPerBlock,
+                                     overprovisioning,
+                                     gcThreshold);
+    dieFreeTimes_.assign(numDies, 0.0);
+    channelFreeTimes_.assign(numChannels_, 0.0);
+    numPageCopies_ = 0;
+}
+
+void FlashModelDisk::finish()
+{
+    HardDisk::finish();
+    recordScalar("SPFS Flash Pages Written", ftl_->getNumHostWrites());
+    recordScalar("SPFS Flash Page Copies", numPageCopies_);
+    recordScalar("SPFS Flash Block Erases", ftl_->getNumErases());
+    recordScalar("SPFS Flash Write Amplification",
+                 ftl_->getWriteAmplification());
+}
+
+double FlashModelDisk::service(LogicalBlockAddress blockNumber,
+                               long numBlocks,
+                               bool isRead)
+{
+    assert(0 < numBlocks);
+
+    // The controller processes the command before dispatching any pages
+    simtime_t currentTime = simTime();
+    simtime_t startTime = currentTime + controllerOverheadSecs_;
+    simtime_t completionTime = startTime;
+
+    LogicalBlockAddress lastBlock = blockNumber + numBlocks - 1;
+    int64_t firstPage = blockNumber / sectorsPerPage_;
+    int64_t lastPage = lastBlock / sectorsPerPage_;
+    for (int64_t page = firstPage; page <= lastPage; page++)
+    {
+        size_t die = ftl_->getDie(page);
+        size_t channel = die % numChannels_;
+        simtime_t& dieFree = dieFreeTimes_[die];
+        simtime_t& channelFree = channelFreeTimes_[channel];
+        if (isRead)
+        {
+            // Sense the page, then move it across the channel; the die's
+            // page register is busy until the transfer completes
+            simtime_t readDone = max(startTime, dieFree) + pageReadSecs_;
+            channelFree = max(readDone, channelFree) + pageTransferSecs_;
+            dieFree = channelFree;
+            completionTime = max(completionTime, channelFree);
+        }
+        else
+        {
+            // Pages partially covered by the write must first be read
+            LogicalBlockAddress pageBegin = page * sectorsPerPage_;
+            LogicalBlockAddress pageEnd = pageBegin + sectorsPerPage_ - 1;
+            bool isPartial = (pageBegin < blockNumber || lastBlock < pageEnd);
+            double mergeSecs = 0.0;
+            if (isPartial && ftl_->isMapped(page))
+            {
+                mergeSecs = pageReadSecs_;
+            }
+
+            // Move the page across the channel, then program it along
+            // with any garbage collection the write triggered
+            FlashTranslationLayer::WriteCost cost = ftl_->writePage(page);
+            simtime_t transferBegin =
+                max(max(startTime, dieFree) + mergeSecs, channelFree);
+            channelFree = transferBegin + pageTransferSecs_;
+            dieFree = channelFree + pageProgramSecs_;
+            completionTime = max(completionTime, dieFree);
+            dieFree += cost.numCopies * (pageReadSecs_ + pageProgramSecs_) +
+                cost.numErases * blockEraseSecs_;
+            numPageCopies_ += cost.numCopies;
+        }
+    }
+
+    double delay = (completionTime - currentTime).dbl();
+    registerDiskDelay(delay);
+    return delay;
+}
+
+uint32_t FlashModelDisk::basicBlockSize() const
 {
-    //FIXME return capacity_ / numSectors_;
     return 512;
 }
 
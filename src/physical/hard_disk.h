@@ -8,9 +8,13 @@
 // This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
 // for details on this and other legal matters.
 //
+#include <cstddef>
+#include <list>
+#include <vector>
 #include <stdint.h>
 #include <omnetpp.h>
 #include "basic_types.h"
+class FlashTranslationLayer;
 
 /** @brief Abstract base class for hard disks  */
 class HardDisk : public cSimpleModule
@@ -45,10 +49,18 @@ protected:
     /** Register the time spent in disk service for this request */
     void registerDiskDelay(double delay);
 
+    /** Send the response to a read or write request after delay */
+    void sendResponse(cMessage* request, double delay);
+
 private:
 
-    /** @return the disk service *completion* time for the message */
-    virtual double service(LogicalBlockAddress blockNumber, bool isRead) = 0;
+    /**
+     * @return the disk service *completion* time for the extent of
+     *   numBlocks contiguous blocks beginning at blockNumber
+     */
+    virtual double service(LogicalBlockAddress blockNumber,
+                           long numBlocks,
+                           bool isRead) = 0;
 
     /** @return the basic block size for the disk model */
     virtual uint32_t basicBlockSize() const = 0;
@@ -72,29 +84,97 @@ private:
  * by Ruemmler and Wilkes.
  *
  * Model does account for controller delay, disk architecture, and density,
- * however it lacks adequate modelling of position modeling, detailed
- * disk layout, or possible read/write parity based optimizations
+ * however it lacks adequate modelling of detailed disk layout, or possible
+ * read/write parity based optimizations
  *
+ * The drive holds the commands it receives in a command queue, and selects
+ * the queued command with the shortest access time among the first
+ * queueDepth commands; a depth of 1 services commands in arrival order.
+ * The drive's buffer is divided into numCacheSegments segments.  Reads
+ * served from a segment skip the media access, and after a read miss the
+ * drive reads ahead into the segment until the next command begins.  With
+ * write caching enabled, writes complete once transferred into the buffer
+ * and are destaged to the media as queued commands, as long as no more
+ * than half of the buffer is dirty.
  */
 class BasicModelDisk : public HardDisk
 {
 public:
+    /** Constructor */
+    BasicModelDisk();
+
+    /** Destructor */
+    virtual ~BasicModelDisk();
 
     /** Initialize Omnet model */
     virtual void initialize();
 
 protected:
 
+    /** Record drive cache and queue statistics */
+    virtual void finish();
+
     virtual void handleMessage(cMessage* msg);
 
 private:
 
-    /** Concrete implementation of service method */
-    virtual double service(LogicalBlockAddress blockNumber, bool isRead);
+    /** A command held in the drive's command queue */
+    struct DiskCommand
+    {
+        /** The host request, or 0 for a write cache destage */
+        cMessage* request;
+        LogicalBlockAddress lba;
+        long numBlocks;
+        bool isRead;
+    };
+
+    /** A contiguous range of blocks held in the drive's buffer */
+    struct CacheSegment
+    {
+        LogicalBlockAddress begin;
+        LogicalBlockAddress end;
+        simtime_t lastUse;
+    };
+
+    /**
+     * Concrete implementation of service method.  A contiguous extent
+     * beginning now is charged a seek, controller overhead and rotational
+     * delay, followed by the media transfer and any track switches within
+     * it.  The head is left at the final block transferred.
+     */
+    virtual double service(LogicalBlockAddress blockNumber,
+                           long numBlocks,
+                           bool isRead);
 
     /** @return the basic block size for the disk model */
     virtual uint32_t basicBlockSize() const;
 
+    /**
+     * @return the time to position the head over blockNumber from its
+     *   current position for a media access beginning at startTime
+     */
+    double accessTime(LogicalBlockAddress blockNumber,
+                      bool isRead,
+                      simtime_t startTime) const;
+
+    /** @return the seek time to travel the distance in cylinders */
+    double seekTime(uint32_t distance, bool isRead) const;
+
+    /** @return the number of leading blocks of the extent in the buffer */
+    long getCachedBlocks(LogicalBlockAddress blockNumber, long numBlocks) const;
+
+    /** Add the blocks [begin, end) to the buffer */
+    void fillCache(LogicalBlockAddress begin, LogicalBlockAddress end);
+
+    /** Add the blocks read ahead since the last read miss to the buffer */
+    void completeReadahead();
+
+    /** Begin servicing the next queued command, if any */
+    void startNextCommand();
+
+    /** Complete the command in service */
+    void completeCommand();
+
     // Data descibing disk characteristics
     double fixedControllerReadOverheadSecs_;
     double fixedControllerWriteOverheadSecs_;
@@ -109,15 +189,104 @@ private:
     uint32_t sectorsPerTrack_;
     uint32_t rpms_;
 
+    // Data describing drive controller characteristics
+    std::size_t queueDepth_;
+    long cacheSegmentBlocks_;
+    long readaheadBlocks_;
+    bool isWriteCacheEnabled_;
+    double bufferTransferSecsPerBlock_;
+
     // Data derived from disk characteristics
-    uint32_t headsPerCylinder_;
+    uint32_t sectorsPerCylinder_;
     double timePerRevolution_;
     double timePerSector_;
+    long maxDirtyBlocks_;
 
     // Disk state
     uint32_t lastCylinder_;
-    uint32_t lastHead_;
-    simtime_t lastCompletionTime_;
+
+    // Drive controller state
+    std::list<DiskCommand> commandQueue_;
+    DiskCommand activeCommand_;
+    cMessage* completionMsg_;
+    std::vector<CacheSegment> cacheSegments_;
+    long numDirtyBlocks_;
+
+    // Read ahead state
+    bool isReadaheadPending_;
+    LogicalBlockAddress readaheadBegin_;
+    simtime_t readaheadStartTime_;
+
+    /** Statistics */
+    double numReadHits_;
+    double numPartialReadHits_;
+    double numReadMisses_;
+    double numCachedWrites_;
+    double numReadaheadBlocks_;
+    std::size_t maxQueueDepth_;
+    cOutVector queueDepthVector_;
+};
+
+/**
+ * Flash based solid state disk model.
+ *
+ * The device is organized as channels of flash dies.  Each die services
+ * one page read, program or block erase at a time, and each channel bus
+ * transfers one page at a time, so requests spanning pages on different
+ * dies proceed in parallel.  Logical pages are mapped by a log structured
+ * flash translation layer, and the page copies and erases performed by its
+ * garbage collection delay the die that performs them.  Writes smaller
+ * than a page read the remainder of a written page before programming.
+ */
+class FlashModelDisk : public HardDisk
+{
+public:
+    /** Constructor */
+    FlashModelDisk();
+
+    /** Destructor */
+    virtual ~FlashModelDisk();
+
+protected:
+
+    /** Initialize Omnet model */
+    virtual void initialize();
+
+    /** Record flash translation statistics */
+    virtual void finish();
+
+private:
+
+    /**
+     * Concrete implementation of service method.  Each page of the extent
+     * is scheduled on its die and channel after the work already
+     * scheduled there.
+     */
+    virtual double service(LogicalBlockAddress blockNumber,
+                           long numBlocks,
+                           bool isRead);
+
+    /** @return the basic block size for the disk model */
+    virtual uint32_t basicBlockSize() const;
+
+    // Data describing device characteristics
+    std::size_t numChannels_;
+    std::size_t sectorsPerPage_;
+    double controllerOverheadSecs_;
+    double pageReadSecs_;
+    double pageProgramSecs_;
+    double blockEraseSecs_;
+    double pageTransferSecs_;
+
+    /** Logical to physical page mapping */
+    FlashTranslationLayer* ftl_;
+
+    // Device state
+    std::vector<simtime_t> dieFreeTimes_;
+    std::vector<simtime_t> channelFreeTimes_;
+
+    /** Statistics */
+    uint64_t numPageCopies_;
 };
 
 #endif
@@ -0,0 +1,89 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include "loggp_model.h"
+#include <algorithm>
+#include <cassert>
+using namespace std;
+
+LogGPModel::LogGPModel(double latencySecs,
+                       double overheadSecs,
+                       double gapSecs,
+                       double gapPerByteSecs,
+                       double backplaneBytesPerSec)
+    : latencySecs_(latencySecs),
+      overheadSecs_(overheadSecs),
+      gapSecs_(gapSecs),
+      gapPerByteSecs_(gapPerByteSecs),
+      backplaneBytesPerSec_(backplaneBytesPerSec),
+      backplaneFreeTime_(0.0)
+{
+    assert(0.0 <= latencySecs_);
+    assert(0.0 <= overheadSecs_);
+    assert(0.0 <= gapSecs_);
+    assert(0.0 <= gapPerByteSecs_);
+    assert(0.0 <= backplaneBytesPerSec_);
+}
+
+size_t LogGPModel::addNode()
+{
+    Node node;
+    node.sendFreeTime = 0.0;
+    node.recvFreeTime = 0.0;
+    nodes_.push_back(node);
+    return nodes_.size() - 1;
+}
+
+double LogGPModel::send(size_t src,
+                        size_t dest,
+                        double sendTime,
+                        double numBytes)
+{
+    assert(src < nodes_.size());
+    assert(dest < nodes_.size());
+    assert(0.0 <= numBytes);
+    double byteSecs = (1.0 < numBytes) ? (numBytes - 1.0) * gapPerByteSecs_
+                                       : 0.0;
+
+    // Inject the message once the sender's overhead is paid and its NIC
+    // is free
+    Node& sender = nodes_[src];
+    double injectTime = max(sendTime + overheadSecs_, sender.sendFreeTime);
+    double injectedTime = injectTime + byteSecs;
+    sender.sendFreeTime = max(injectTime + gapSecs_, injectedTime);
+
+    // Queue the message on the switch backplane
+    double switchedTime = injectedTime;
+    if (0.0 < backplaneBytesPerSec_)
+    {
+        double backplaneStart = max(injectTime, backplaneFreeTime_);
+        backplaneFreeTime_ = backplaneStart + numBytes / backplaneBytesPerSec_;
+        switchedTime = max(switchedTime, backplaneFreeTime_);
+    }
+
+    // Receive the message once the receiver's NIC is free; the last byte
+    // cannot arrive before it is switched
+    Node& receiver = nodes_[dest];
+    double recvTime = max(injectTime + latencySecs_, receiver.recvFreeTime);
+    double receivedTime = max(recvTime + byteSecs,
+                              switchedTime + latencySecs_);
+    receiver.recvFreeTime = max(recvTime + gapSecs_, receivedTime);
+
+    // The receiver pays its overhead before the message is delivered
+    return receivedTime + overheadSecs_;
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,102 @@
+#ifndef LOGGP_MODEL_H
+#define LOGGP_MODEL_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstddef>
+#include <vector>
+
+/**
+ * Analytic LogGP network model.  A message of k bytes costs the sender
+ * and receiver an overhead of o, occupies the sending and receiving NICs
+ * for (k - 1) * G, and reaches the receiver L after it is injected.  Each
+ * NIC starts at most one message every g, and an optional switch
+ * backplane limits the aggregate bandwidth of all messages.  NICs and the
+ * backplane are FIFO queues, so a message's delivery time is known when
+ * it is sent and no intermediate events are required.
+ */
+class LogGPModel
+{
+public:
+    /**
+     * Constructor
+     *
+     * @param latencySecs L, the wire and switch latency
+     * @param overheadSecs o, the send and receive processor overhead
+     * @param gapSecs g, the minimum interval between messages on a NIC
+     * @param gapPerByteSecs G, the NIC time per byte
+     * @param backplaneBytesPerSec the aggregate switch bandwidth, or 0 if
+     *   the switch is non-blocking
+     */
+    LogGPModel(double latencySecs,
+               double overheadSecs,
+               double gapSecs,
+               double gapPerByteSecs,
+               double backplaneBytesPerSec);
+
+    /** @return the id of a newly added node */
+    std::size_t addNode();
+
+    /** @return the number of nodes */
+    std::size_t getNumNodes() const { return nodes_.size(); };
+
+    /**
+     * Reserve the NICs and backplane for a message
+     *
+     * @param src the sending node
+     * @param dest the receiving node
+     * @param sendTime the time the message is sent
+     * @param numBytes the message size
+     * @return the time the message is delivered to the receiver
+     */
+    double send(std::size_t src,
+                std::size_t dest,
+                double sendTime,
+                double numBytes);
+
+private:
+    /** NIC queue state for a node */
+    struct Node
+    {
+        double sendFreeTime;
+        double recvFreeTime;
+    };
+
+    /** L */
+    double latencySecs_;
+
+    /** o */
+    double overheadSecs_;
+
+    /** g */
+    double gapSecs_;
+
+    /** G */
+    double gapPerByteSecs_;
+
+    /** Aggregate switch bandwidth, 0 if unlimited */
+    double backplaneBytesPerSec_;
+
+    /** Time the backplane finishes its queued messages */
+    double backplaneFreeTime_;
+
+    /** Nodes indexed by id */
+    std::vector<Node> nodes_;
+};
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
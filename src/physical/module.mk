@@ -5,12 +5,27 @@ DIR := src/physical
 
 SIM_SRC += $(DIR)/bmi_endpoint.cc \
 	$(DIR)/bmi_direct_endpoint.cc \
+	$(DIR)/bmi_flow_endpoint.cc \
+	$(DIR)/bmi_flow_network.cc \
+	$(DIR)/bmi_loggp_network.cc \
+	$(DIR)/bmi_network.cc \
+	$(DIR)/bmi_rdma_endpoint.cc \
 	$(DIR)/bmi_tcp_client.cc \
 	$(DIR)/bmi_tcp_server.cc \
+	$(DIR)/bmi_topology_network.cc \
+	$(DIR)/dragonfly_topology.cc \
 	$(DIR)/enhanced_ether_encap.cc \
 	$(DIR)/enhanced_ether_mac_base.cc \
 	$(DIR)/enhanced_ether_mac2.cc \
 	$(DIR)/enhanced_mac_relay_unit_pp.cc \
+	$(DIR)/fat_tree_topology.cc \
+	$(DIR)/flash_translation_layer.cc \
+	$(DIR)/flow_network_model.cc \
 	$(DIR)/hard_disk.cc \
+	$(DIR)/loggp_model.cc \
 	$(DIR)/mpi_tcp_client.cc \
-	$(DIR)/mpi_tcp_server.cc
+	$(DIR)/mpi_tcp_server.cc \
+	$(DIR)/raid_layout.cc \
+	$(DIR)/registration_cache.cc \
+	$(DIR)/storage_array_controller.cc \
+	$(DIR)/switch_topology.cc
@@ -0,0 +1,204 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include "raid_layout.h"
+#include <algorithm>
+#include <cassert>
+using namespace std;
+
+/** Order member extents by member and then address */
+static bool lessThanMemberExtent(const MemberExtent& lhs,
+                                 const MemberExtent& rhs)
+{
+    if (lhs.disk != rhs.disk)
+    {
+        return lhs.disk < rhs.disk;
+    }
+    return lhs.lba < rhs.lba;
+}
+
+RaidLayout::RaidLayout(int raidLevel, size_t numDisks, long chunkBlocks)
+    : numDisks_(numDisks),
+      numParity_(0),
+      chunkBlocks_(chunkBlocks)
+{
+    assert(0 == raidLevel || 5 == raidLevel || 6 == raidLevel);
+    assert(0 < chunkBlocks);
+    if (5 == raidLevel)
+    {
+        numParity_ = 1;
+    }
+    else if (6 == raidLevel)
+    {
+        numParity_ = 2;
+    }
+    assert(numParity_ < numDisks_);
+}
+
+long RaidLayout::getStripeBlocks() const
+{
+    return chunkBlocks_ * getNumDataDisks();
+}
+
+size_t RaidLayout::getParityDisk(int64_t stripe) const
+{
+    return (numDisks_ - 1) - size_t(stripe % numDisks_);
+}
+
+size_t RaidLayout::getDataDisk(int64_t stripe, size_t chunk) const
+{
+    assert(chunk < getNumDataDisks());
+    if (0 == numParity_)
+    {
+        return chunk;
+    }
+
+    // Data chunks follow the parity chunks, wrapping around the members
+    return (getParityDisk(stripe) + numParity_ + chunk) % numDisks_;
+}
+
+vector<MemberExtent> RaidLayout::mapRead(LogicalBlockAddress lba,
+                                         long extent) const
+{
+    vector<MemberExtent> extents;
+    appendDataExtents(lba, extent, extents);
+    coalesce(extents);
+    return extents;
+}
+
+vector<StripeUpdate> RaidLayout::mapWrite(LogicalBlockAddress lba,
+                                          long extent) const
+{
+    vector<StripeUpdate> updates;
+    StripeUpdate fullStripes;
+    fullStripes.numStripes = 0;
+    size_t fullStripesIndex = 0;
+
+    LogicalBlockAddress end = lba + extent;
+    LogicalBlockAddress pos = lba;
+    long stripeBlocks = getStripeBlocks();
+    while (pos < end)
+    {
+        int64_t stripe = pos / stripeBlocks;
+        LogicalBlockAddress stripeBegin = stripe * stripeBlocks;
+        LogicalBlockAddress stripeEnd = stripeBegin + stripeBlocks;
+        LogicalBlockAddress segmentEnd = min(end, stripeEnd);
+        if (0 == numParity_ || (pos == stripeBegin && segmentEnd == stripeEnd))
+        {
+            // Writes without parity dependencies need no reads
+            if (0 == fullStripes.numStripes)
+            {
+                fullStripesIndex = updates.size();
+            }
+            appendDataExtents(pos, segmentEnd - pos, fullStripes.writes);
+            appendParityExtents(stripe, 0, chunkBlocks_, fullStripes.writes);
+            fullStripes.numStripes++;
+        }
+        else
+        {
+            // Read the old data and parity, then write the new
+            StripeUpdate partial;
+            partial.numStripes = 1;
+            appendDataExtents(pos, segmentEnd - pos, partial.writes);
+
+            // The parity covers the union of the chunk ranges written
+            long parityBegin = chunkBlocks_;
+            long parityEnd = 0;
+            for (size_t i = 0; i < partial.writes.size(); i++)
+            {
+                long offset = partial.writes[i].lba - stripe * chunkBlocks_;
+                parityBegin = min(parityBegin, offset);
+                parityEnd = max(parityEnd, offset + partial.writes[i].extent);
+            }
+            appendParityExtents(stripe, parityBegin, parityEnd, partial.writes);
+            partial.reads = partial.writes;
+            updates.push_back(partial);
+        }
+        pos = segmentEnd;
+    }
+
+    if (0 != fullStripes.numStripes)
+    {
+        coalesce(fullStripes.writes);
+        updates.insert(updates.begin() + fullStripesIndex, fullStripes);
+    }
+    return updates;
+}
+
+void RaidLayout::appendDataExtents(LogicalBlockAddress lba,
+                                   long extent,
+                                   vector<MemberExtent>& outExtents) const
+{
+    LogicalBlockAddress end = lba + extent;
+    LogicalBlockAddress pos = lba;
+    size_t numDataDisks = getNumDataDisks();
+    while (pos < end)
+    {
+        int64_t chunkNumber = pos / chunkBlocks_;
+        int64_t stripe = chunkNumber / numDataDisks;
+        long offset = pos % chunkBlocks_;
+
+        MemberExtent member;
+        member.disk = getDataDisk(stripe, size_t(chunkNumber % numDataDisks));
+        member.lba = stripe * chunkBlocks_ + offset;
+        member.extent = long(min(LogicalBlockAddress(chunkBlocks_ - offset),
+                                 end - pos));
+        outExtents.push_back(member);
+        pos += member.extent;
+    }
+}
+
+void RaidLayout::appendParityExtents(int64_t stripe,
+                                     long begin,
+                                     long end,
+                                     vector<MemberExtent>& outExtents) const
+{
+    for (size_t i = 0; i < numParity_; i++)
+    {
+        MemberExtent member;
+        member.disk = (getParityDisk(stripe) + i) % numDisks_;
+        member.lba = stripe * chunkBlocks_ + begin;
+        member.extent = end - begin;
+        outExtents.push_back(member);
+    }
+}
+
+void RaidLayout::coalesce(vector<MemberExtent>& extents)
+{
+    if (extents.empty())
+    {
+        return;
+    }
+
+    sort(extents.begin(), extents.end(), lessThanMemberExtent);
+    size_t last = 0;
+    for (size_t i = 1; i < extents.size(); i++)
+    {
+        MemberExtent& prev = extents[last];
+        if (prev.disk == extents[i].disk &&
+            prev.lba + prev.extent == extents[i].lba)
+        {
+            prev.extent += extents[i].extent;
+        }
+        else
+        {
+            extents[++last] = extents[i];
+        }
+    }
+    extents.resize(last + 1);
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,126 @@
+#ifndef RAID_LAYOUT_H
+#define RAID_LAYOUT_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstddef>
+#include <vector>
+#include "basic_types.h"
+
+/** A contiguous extent of blocks on one member device */
+struct MemberExtent
+{
+    std::size_t disk;
+    LogicalBlockAddress lba;
+    long extent;
+};
+
+/**
+ * Member device operations required to update the array.  The writes may
+ * not begin until all of the reads complete.
+ */
+struct StripeUpdate
+{
+    /** Old data and parity read for a read-modify-write */
+    std::vector<MemberExtent> reads;
+
+    /** New data and parity written */
+    std::vector<MemberExtent> writes;
+
+    /** The number of stripes updated */
+    std::size_t numStripes;
+};
+
+/**
+ * Block layout of a striped storage array.  Array blocks are striped across
+ * the member devices in chunks of chunkBlocks blocks.  RAID-5 adds a parity
+ * chunk to each stripe and RAID-6 adds two; parity rotates across the
+ * members using the left symmetric layout.
+ */
+class RaidLayout
+{
+public:
+    /**
+     * Constructor
+     *
+     * @param raidLevel 0, 5 or 6
+     * @param numDisks the number of member devices
+     * @param chunkBlocks the number of blocks in each chunk
+     */
+    RaidLayout(int raidLevel, std::size_t numDisks, long chunkBlocks);
+
+    /** @return the number of member devices */
+    std::size_t getNumDisks() const { return numDisks_; };
+
+    /** @return the number of parity chunks in each stripe */
+    std::size_t getNumParityDisks() const { return numParity_; };
+
+    /** @return the number of member devices holding data in each stripe */
+    std::size_t getNumDataDisks() const { return numDisks_ - numParity_; };
+
+    /** @return the number of array blocks in each stripe */
+    long getStripeBlocks() const;
+
+    /** @return the member holding the (first) parity chunk of the stripe */
+    std::size_t getParityDisk(int64_t stripe) const;
+
+    /** @return the member holding the chunk'th data chunk of the stripe */
+    std::size_t getDataDisk(int64_t stripe, std::size_t chunk) const;
+
+    /**
+     * @return the member extents read for the array extent, merged where
+     *   contiguous on a member
+     */
+    std::vector<MemberExtent> mapRead(LogicalBlockAddress lba,
+                                      long extent) const;
+
+    /**
+     * @return the member updates needed to write the array extent.  Full
+     *   stripes are written without reading and are merged into a single
+     *   update, and each partial stripe is updated with a read-modify-write
+     *   of its data and parity.
+     */
+    std::vector<StripeUpdate> mapWrite(LogicalBlockAddress lba,
+                                       long extent) const;
+
+private:
+    /** Append the member extents holding the array data */
+    void appendDataExtents(LogicalBlockAddress lba,
+                           long extent,
+                           std::vector<MemberExtent>& outExtents) const;
+
+    /** Append the parity extents covering [begin, end) of each chunk */
+    void appendParityExtents(int64_t stripe,
+                             long begin,
+                             long end,
+                             std::vector<MemberExtent>& outExtents) const;
+
+    /** Sort extents by member and merge contiguous extents */
+    static void coalesce(std::vector<MemberExtent>& extents);
+
+    /** The number of member devices */
+    std::size_t numDisks_;
+
+    /** The number of parity chunks in each stripe */
+    std::size_t numParity_;
+
+    /** The number of blocks in each chunk */
+    long chunkBlocks_;
+};
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
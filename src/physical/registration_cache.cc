@@ -0,0 +1,50 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include "registration_cache.h"
+#include <cassert>
+using namespace std;
+
+RegistrationCache::RegistrationCache(int numEntries,
+                                     double fixedSecs,
+                                     double perByteSecs)
+    : registrations_(numEntries),
+      fixedSecs_(fixedSecs),
+      perByteSecs_(perByteSecs),
+      numHits_(0),
+      numMisses_(0)
+{
+    assert(0 < numEntries);
+    assert(0.0 <= fixedSecs_);
+    assert(0.0 <= perByteSecs_);
+}
+
+double RegistrationCache::registerBuffer(int bufferId, FSSize numBytes)
+{
+    // A cached registration covering the buffer is free
+    FSSize* registeredBytes = registrations_.find(bufferId);
+    if (0 != registeredBytes && numBytes <= *registeredBytes)
+    {
+        numHits_++;
+        return 0.0;
+    }
+
+    numMisses_++;
+    registrations_.insert(bufferId, numBytes);
+    return fixedSecs_ + perByteSecs_ * numBytes;
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,73 @@
+#ifndef REGISTRATION_CACHE_H
+#define REGISTRATION_CACHE_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstddef>
+#include "basic_types.h"
+#include "lru_cache.h"
+
+/**
+ * Model of an RDMA memory registration cache.  Registering a buffer with
+ * the NIC costs a fixed time plus a per-byte (per-page pinning) time.
+ * Registered buffers are cached by id, so a buffer reused for each push of
+ * a flow is only registered once unless it is evicted or grows.
+ */
+class RegistrationCache
+{
+public:
+    /**
+     * Constructor
+     *
+     * @param numEntries the number of registrations cached
+     * @param fixedSecs the fixed cost of each registration
+     * @param perByteSecs the per-byte cost of each registration
+     */
+    RegistrationCache(int numEntries, double fixedSecs, double perByteSecs);
+
+    /**
+     * Register the buffer
+     *
+     * @return the time spent registering, 0 if the buffer is cached
+     */
+    double registerBuffer(int bufferId, FSSize numBytes);
+
+    /** @return the number of registrations satisfied by the cache */
+    std::size_t getNumHits() const { return numHits_; };
+
+    /** @return the number of registrations performed */
+    std::size_t getNumMisses() const { return numMisses_; };
+
+private:
+    /** Registered buffer sizes by buffer id */
+    LRUCache<int, FSSize> registrations_;
+
+    /** Fixed registration cost */
+    double fixedSecs_;
+
+    /** Per-byte registration cost */
+    double perByteSecs_;
+
+    /** Cached registrations */
+    std::size_t numHits_;
+
+    /** Registrations performed */
+    std::size_t numMisses_;
+};
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
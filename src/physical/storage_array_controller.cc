@@ -0,0 +1,255 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include "storage_array_controller.h"
+#include <cassert>
+#include <sstream>
+#include "message_kind.h"
+#include "os_proto_m.h"
+using namespace std;
+
+Define_Module(StorageArrayController);
+
+StorageArrayController::StorageArrayController()
+    : layout_(0)
+{
+}
+
+StorageArrayController::~StorageArrayController()
+{
+    delete layout_;
+    layout_ = 0;
+}
+
+void StorageArrayController::initialize()
+{
+    inGateId_ = findGate("in");
+    outGateId_ = findGate("out");
+
+    // Construct the array layout
+    size_t numDisks = gateSize("diskOut");
+    int raidLevel = par("raidLevel").longValue();
+    long chunkBlocks = par("chunkSize").longValue() / 512;
+    assert(0 < numDisks);
+    assert(0 < chunkBlocks);
+    layout_ = new RaidLayout(raidLevel, numDisks, chunkBlocks);
+
+    // Initialize member state and statistics
+    numMemberOutstanding_.assign(numDisks, 0);
+    memberBusyBegin_.assign(numDisks, 0.0);
+    memberBusyTime_.assign(numDisks, 0.0);
+    memberBlocksRead_.assign(numDisks, 0.0);
+    memberBlocksWritten_.assign(numDisks, 0.0);
+    numFullStripeWrites_ = 0;
+    numReadModifyWrites_ = 0;
+}
+
+void StorageArrayController::finish()
+{
+    double elapsed = simTime().dbl();
+    for (size_t i = 0; i < layout_->getNumDisks(); i++)
+    {
+        double utilization = 0.0;
+        if (0.0 < elapsed)
+        {
+            utilization = memberBusyTime_[i].dbl() / elapsed;
+        }
+
+        ostringstream prefix;
+        prefix << "SPFS RAID Member " << i;
+        recordScalar((prefix.str() + " Utilization").c_str(), utilization);
+        recordScalar((prefix.str() + " Blocks Read").c_str(),
+                     memberBlocksRead_[i]);
+        recordScalar((prefix.str() + " Blocks Written").c_str(),
+                     memberBlocksWritten_[i]);
+    }
+    recordScalar("SPFS RAID Full Stripe Writes", numFullStripeWrites_);
+    recordScalar("SPFS RAID Read-Modify-Writes", numReadModifyWrites_);
+}
+
+void StorageArrayController::handleMessage(cMessage* msg)
+{
+    if (msg->getArrivalGateId() == inGateId_)
+    {
+        processRequest(msg);
+    }
+    else
+    {
+        processMemberResponse(msg);
+    }
+}
+
+void StorageArrayController::processRequest(cMessage* msg)
+{
+    ArrayRequest* arrayRequest = new ArrayRequest();
+    arrayRequest->request = msg;
+    arrayRequest->numOutstanding = 0;
+
+    if (SPFS_OS_READ_DEVICE_REQUEST == msg->getKind())
+    {
+        spfsOSReadDeviceRequest* read =
+            kind_cast<spfsOSReadDeviceRequest>(msg);
+        arrayRequest->isRead = true;
+        vector<MemberExtent> members =
+            layout_->mapRead(read->getAddress(), read->getExtent());
+        arrayRequest->numOutstanding = members.size();
+        for (size_t i = 0; i < members.size(); i++)
+        {
+            issueMemberRequest(arrayRequest, members[i], true, -1);
+        }
+    }
+    else if (SPFS_OS_WRITE_DEVICE_REQUEST == msg->getKind())
+    {
+        spfsOSWriteDeviceRequest* write =
+            kind_cast<spfsOSWriteDeviceRequest>(msg);
+        arrayRequest->isRead = false;
+        arrayRequest->updates =
+            layout_->mapWrite(write->getAddress(), write->getExtent());
+
+        // Count every member request before issuing any of them
+        vector<StripeUpdate>& updates = arrayRequest->updates;
+        for (size_t i = 0; i < updates.size(); i++)
+        {
+            arrayRequest->numOutstanding +=
+                updates[i].reads.size() + updates[i].writes.size();
+            arrayRequest->numReadsOutstanding.push_back(
+                updates[i].reads.size());
+        }
+
+        // Read the old data and parity of partial stripes, and write full
+        // stripes immediately
+        for (size_t i = 0; i < updates.size(); i++)
+        {
+            if (updates[i].reads.empty())
+            {
+                if (0 != layout_->getNumParityDisks())
+                {
+                    numFullStripeWrites_ += updates[i].numStripes;
+                }
+                issueWrites(arrayRequest, i);
+            }
+            else
+            {
+                numReadModifyWrites_ += updates[i].numStripes;
+                for (size_t j = 0; j < updates[i].reads.size(); j++)
+                {
+                    issueMemberRequest(arrayRequest,
+                                       updates[i].reads[j],
+                                       true,
+                                       long(i));
+                }
+            }
+        }
+    }
+    else
+    {
+        cerr << __FILE__ << ":" << __LINE__ << ":"
+             << "ERROR in storage array for message:" << msg->info() << endl;
+        assert(0);
+    }
+    assert(0 < arrayRequest->numOutstanding);
+}
+
+void StorageArrayController::processMemberResponse(cMessage* msg)
+{
+    cMessage* memberMsg = static_cast<cMessage*>(msg->getContextPointer());
+    map<cMessage*, MemberRequest>::iterator iter =
+        memberRequests_.find(memberMsg);
+    assert(memberRequests_.end() != iter);
+    MemberRequest member = iter->second;
+    memberRequests_.erase(iter);
+    delete memberMsg;
+    delete msg;
+
+    // Update the member utilization
+    if (0 == --numMemberOutstanding_[member.disk])
+    {
+        memberBusyTime_[member.disk] +=
+            simTime() - memberBusyBegin_[member.disk];
+    }
+
+    // Begin the writes of an update once all of its reads complete
+    ArrayRequest* arrayRequest = member.parent;
+    if (-1 != member.updateIndex &&
+        0 == --arrayRequest->numReadsOutstanding[member.updateIndex])
+    {
+        issueWrites(arrayRequest, size_t(member.updateIndex));
+    }
+
+    // Respond once all of the member requests complete
+    if (0 == --arrayRequest->numOutstanding)
+    {
+        cMessage* resp = 0;
+        if (arrayRequest->isRead)
+        {
+            resp =
+                new spfsOSReadDeviceResponse(0, SPFS_OS_READ_DEVICE_RESPONSE);
+        }
+        else
+        {
+            resp =
+                new spfsOSWriteDeviceResponse(0, SPFS_OS_WRITE_DEVICE_RESPONSE);
+        }
+        resp->setContextPointer(arrayRequest->request);
+        send(resp, outGateId_);
+        delete arrayRequest;
+    }
+}
+
+void StorageArrayController::issueWrites(ArrayRequest* arrayRequest,
+                                         size_t updateIndex)
+{
+    const StripeUpdate& update = arrayRequest->updates[updateIndex];
+    for (size_t i = 0; i < update.writes.size(); i++)
+    {
+        issueMemberRequest(arrayRequest, update.writes[i], false, -1);
+    }
+}
+
+void StorageArrayController::issueMemberRequest(ArrayRequest* arrayRequest,
+                                                const MemberExtent& member,
+                                                bool isRead,
+                                                long updateIndex)
+{
+    assert(0 < member.extent);
+    spfsOSDeviceIORequest* req = 0;
+    if (isRead)
+    {
+        req = new spfsOSReadDeviceRequest(0, SPFS_OS_READ_DEVICE_REQUEST);
+        memberBlocksRead_[member.disk] += member.extent;
+    }
+    else
+    {
+        req = new spfsOSWriteDeviceRequest(0, SPFS_OS_WRITE_DEVICE_REQUEST);
+        memberBlocksWritten_[member.disk] += member.extent;
+    }
+    req->setAddress(member.lba);
+    req->setExtent(member.extent);
+
+    MemberRequest memberRequest;
+    memberRequest.parent = arrayRequest;
+    memberRequest.disk = member.disk;
+    memberRequest.updateIndex = updateIndex;
+    memberRequests_[req] = memberRequest;
+
+    if (0 == numMemberOutstanding_[member.disk]++)
+    {
+        memberBusyBegin_[member.disk] = simTime();
+    }
+    send(req, "diskOut", int(member.disk));
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
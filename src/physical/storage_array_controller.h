@@ -0,0 +1,115 @@
+#ifndef STORAGE_ARRAY_CONTROLLER_H
+#define STORAGE_ARRAY_CONTROLLER_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstddef>
+#include <map>
+#include <vector>
+#include <omnetpp.h>
+#include "raid_layout.h"
+
+/**
+ * Controller for a striped array of member devices.  Each array request is
+ * split into member requests that are serviced by the members in parallel,
+ * and the array request completes when all of its member requests
+ * complete.  For parity layouts, the writes of a partial stripe update are
+ * issued once the reads of the old data and parity complete.
+ */
+class StorageArrayController : public cSimpleModule
+{
+public:
+    /** Constructor */
+    StorageArrayController();
+
+    /** Destructor */
+    virtual ~StorageArrayController();
+
+protected:
+    /** Implementation of initialize */
+    virtual void initialize();
+
+    /** Implementation of finish */
+    virtual void finish();
+
+    /** Implementation of handleMessage */
+    virtual void handleMessage(cMessage* msg);
+
+private:
+    /** State of an array request */
+    struct ArrayRequest
+    {
+        cMessage* request;
+        bool isRead;
+        std::size_t numOutstanding;
+        std::vector<StripeUpdate> updates;
+        std::vector<std::size_t> numReadsOutstanding;
+    };
+
+    /** State of a member request */
+    struct MemberRequest
+    {
+        ArrayRequest* parent;
+        std::size_t disk;
+
+        /** The update awaiting this read, or -1 */
+        long updateIndex;
+    };
+
+    /** Split the array request into member requests */
+    void processRequest(cMessage* msg);
+
+    /** Complete a member request */
+    void processMemberResponse(cMessage* msg);
+
+    /** Issue the writes of a stripe update */
+    void issueWrites(ArrayRequest* arrayRequest, std::size_t updateIndex);
+
+    /** Send a member request to the member device */
+    void issueMemberRequest(ArrayRequest* arrayRequest,
+                            const MemberExtent& member,
+                            bool isRead,
+                            long updateIndex);
+
+    /** Block layout of the array */
+    RaidLayout* layout_;
+
+    /** In gate id */
+    int inGateId_;
+
+    /** Out gate id */
+    int outGateId_;
+
+    /** Outstanding member requests */
+    std::map<cMessage*, MemberRequest> memberRequests_;
+
+    /** Number of outstanding requests on each member */
+    std::vector<std::size_t> numMemberOutstanding_;
+
+    /** Time each member last became busy */
+    std::vector<simtime_t> memberBusyBegin_;
+
+    /** Statistics */
+    std::vector<simtime_t> memberBusyTime_;
+    std::vector<double> memberBlocksRead_;
+    std::vector<double> memberBlocksWritten_;
+    double numFullStripeWrites_;
+    double numReadModifyWrites_;
+};
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
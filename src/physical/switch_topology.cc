@@ -0,0 +1,62 @@
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include "switch_topology.h"
+#include <cassert>
+#include <sstream>
+using namespace std;
+
+SwitchTopology::SwitchTopology(FlowNetworkModel& model)
+    : model_(model)
+{
+}
+
+SwitchTopology::~SwitchTopology()
+{
+}
+
+FlowNetworkModel::LinkId SwitchTopology::getLink(size_t i) const
+{
+    assert(i < links_.size());
+    return links_[i];
+}
+
+string SwitchTopology::getLinkName(size_t i) const
+{
+    assert(i < linkNames_.size());
+    return linkNames_[i];
+}
+
+FlowNetworkModel::LinkId SwitchTopology::addLink(const string& fromSwitch,
+                                                 const string& toSwitch,
+                                                 double bytesPerSec)
+{
+    FlowNetworkModel::LinkId link = model_.addLink(bytesPerSec);
+    links_.push_back(link);
+    linkNames_.push_back(fromSwitch + "->" + toSwitch);
+    return link;
+}
+
+string SwitchTopology::switchName(const char* prefix,
+                                  size_t index1,
+                                  size_t index2)
+{
+    ostringstream name;
+    name << prefix << "[" << index1 << "][" << index2 << "]";
+    return name.str();
+}
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
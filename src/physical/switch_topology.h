@@ -0,0 +1,96 @@
+#ifndef SWITCH_TOPOLOGY_H
+#define SWITCH_TOPOLOGY_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "flow_network_model.h"
+
+/**
+ * Abstract multi-switch network topology.  Hosts attach to edge switches,
+ * and the topology adds its inter-switch links to a FlowNetworkModel and
+ * routes flows between edge switches across them.  Where several equal
+ * cost paths exist, the route is selected by a hash so that all of the
+ * messages of a connection follow one path (ECMP).
+ */
+class SwitchTopology
+{
+public:
+    /** Path of links crossed by a flow */
+    typedef std::vector<FlowNetworkModel::LinkId> Path;
+
+    /** Constructor */
+    SwitchTopology(FlowNetworkModel& model);
+
+    /** Destructor */
+    virtual ~SwitchTopology();
+
+    /** @return the number of edge switches hosts may attach to */
+    virtual std::size_t getNumEdgeSwitches() const = 0;
+
+    /**
+     * Append the inter-switch links from one edge switch to another
+     *
+     * @param srcSwitch the sending host's edge switch
+     * @param destSwitch the receiving host's edge switch
+     * @param hash selects among the equal cost paths
+     * @param outPath the path to append the links to
+     */
+    virtual void route(std::size_t srcSwitch,
+                       std::size_t destSwitch,
+                       std::size_t hash,
+                       Path& outPath) const = 0;
+
+    /** @return the number of inter-switch links */
+    std::size_t getNumLinks() const { return links_.size(); };
+
+    /** @return the model id of the i'th inter-switch link */
+    FlowNetworkModel::LinkId getLink(std::size_t i) const;
+
+    /** @return the name of the i'th inter-switch link */
+    std::string getLinkName(std::size_t i) const;
+
+protected:
+    /**
+     * Add a directed link between two switches to the model
+     *
+     * @return the model id of the link
+     */
+    FlowNetworkModel::LinkId addLink(const std::string& fromSwitch,
+                                     const std::string& toSwitch,
+                                     double bytesPerSec);
+
+    /** @return the switch name composed of prefix and the indices */
+    static std::string switchName(const char* prefix,
+                                  std::size_t index1,
+                                  std::size_t index2);
+
+private:
+    /** The model the links are added to */
+    FlowNetworkModel& model_;
+
+    /** Inter-switch links */
+    std::vector<FlowNetworkModel::LinkId> links_;
+
+    /** Inter-switch link names */
+    std::vector<std::string> linkNames_;
+};
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
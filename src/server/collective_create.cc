@@ -215,7 +215,8 @@ void CollectiveCreate::createDirEnt()
     Filename filename(createReq_->getHandle());
 
     // Create the file write request
-    spfsOSFileWriteRequest* fileWrite = new spfsOSFileWriteRequest();
+    spfsOSFileWriteRequest* fileWrite =
+        new spfsOSFileWriteRequest(0, SPFS_OS_FILE_WRITE_REQUEST);
     fileWrite->setContextPointer(createReq_);
     fileWrite->setFilename(filename.c_str());
     fileWrite->setOffsetArraySize(1);
@@ -123,7 +123,8 @@ void CollectiveGetAttr::getLocalAttributes()
     Filename f(getAttrReq_->getHandle());
 
     // Create the file system object
-    spfsOSFileReadRequest* readRequest = new spfsOSFileReadRequest();
+    spfsOSFileReadRequest* readRequest =
+        new spfsOSFileReadRequest(0, SPFS_OS_FILE_READ_REQUEST);
     readRequest->setContextPointer(getAttrReq_);
 
     // Set read parameters to accomplish a get attr
@@ -167,7 +167,7 @@ void CollectiveRemove::removeObject()
 {
     // Create the file system object
     spfsOSFileUnlinkRequest* unlinkRequest =
-        new spfsOSFileUnlinkRequest(0, SPFS_OS_FILE_OPEN_REQUEST);
+        new spfsOSFileUnlinkRequest(0, SPFS_OS_FILE_UNLINK_REQUEST);
     unlinkRequest->setContextPointer(removeReq_);
 
     // Extract the handle as the file name
@@ -188,7 +188,8 @@ void CollectiveRemove::removeDirEnt()
     Filename filename(removeReq_->getHandle());
 
     // Create the file write request
-    spfsOSFileWriteRequest* fileWrite = new spfsOSFileWriteRequest();
+    spfsOSFileWriteRequest* fileWrite =
+        new spfsOSFileWriteRequest(0, SPFS_OS_FILE_WRITE_REQUEST);
     fileWrite->setContextPointer(removeReq_);
     fileWrite->setFilename(filename.c_str());
     fileWrite->setOffsetArraySize(1);
@@ -72,7 +72,8 @@ void CreateDirEnt::writeDirEnt()
     Filename filename(createDirEntReq_->getHandle());
 
     // Create the file write request
-    spfsOSFileWriteRequest* fileWrite = new spfsOSFileWriteRequest();
+    spfsOSFileWriteRequest* fileWrite =
+        new spfsOSFileWriteRequest(0, SPFS_OS_FILE_WRITE_REQUEST);
     fileWrite->setContextPointer(createDirEntReq_);
     fileWrite->setFilename(filename.c_str());
     fileWrite->setOffsetArraySize(1);
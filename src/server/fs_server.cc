@@ -27,6 +27,7 @@
 #include "remove.h"
 #include "set_attr.h"
 #include "write.h"
+#include "message_kind.h"
 #include "pvfs_proto_m.h"
 #include "fs_server.h"
 using namespace std;
@@ -293,13 +294,14 @@ void FSServer::handleMessage(cMessage* msg)
     // If the message is a new client request, process it directly
     // Otherwise its a response, extract the originating request
     // and then process the response
-    if (spfsRequest* req = dynamic_cast<spfsRequest*>(msg))
+    if (isRequestKind(msg->getKind()))
     {
-        processRequest(req, msg);
+        processRequest(kind_cast<spfsRequest>(msg), msg);
     }
     else
     {
         cMessage* parentReq = static_cast<cMessage*>(msg->getContextPointer());
+        assert(0 != parentReq);
         spfsRequest* origRequest =
             static_cast<spfsRequest*>(parentReq->getContextPointer());
         processRequest(origRequest, msg);
@@ -421,6 +423,48 @@ void FSServer::processRequest(spfsRequest* request, cMessage* msg)
     }
 }
 
+bool FSServer::isRequestKind(int kind)
+{
+    // Requests the server does not answer reach processRequest's error
+    switch(kind)
+    {
+        case SPFS_TRUNCATE_REQUEST:
+        case SPFS_MAKE_DIR_REQUEST:
+        case SPFS_FLUSH_REQUEST:
+        case SPFS_STAT_REQUEST:
+        case SPFS_LIST_ATTR_REQUEST:
+        case SPFS_INVALIDATE_PAGES_REQUEST:
+            return true;
+        default:
+            return isAnsweredRequestKind(kind);
+    }
+}
+
+bool FSServer::isAnsweredRequestKind(int kind)
+{
+    switch(kind)
+    {
+        case SPFS_CHANGE_DIR_ENT_REQUEST:
+        case SPFS_COLLECTIVE_CREATE_REQUEST:
+        case SPFS_COLLECTIVE_GET_ATTR_REQUEST:
+        case SPFS_COLLECTIVE_REMOVE_REQUEST:
+        case SPFS_CREATE_REQUEST:
+        case SPFS_CREATE_DIR_ENT_REQUEST:
+        case SPFS_GET_ATTR_REQUEST:
+        case SPFS_LOOKUP_PATH_REQUEST:
+        case SPFS_READ_DIR_REQUEST:
+        case SPFS_READ_REQUEST:
+        case SPFS_READ_PAGES_REQUEST:
+        case SPFS_REMOVE_DIR_ENT_REQUEST:
+        case SPFS_REMOVE_REQUEST:
+        case SPFS_SET_ATTR_REQUEST:
+        case SPFS_WRITE_REQUEST:
+            return true;
+        default:
+            return false;
+    }
+}
+
 void FSServer::send(cMessage* msg)
 {
     cSimpleModule::send(msg, outGateId_);
@@ -125,6 +125,9 @@ public:
     /** Set disk data collection on or off */
     static void setCollectDiskData(bool collectFlag);
 
+    /** @return true if kind is a client request the server answers */
+    static bool isAnsweredRequestKind(int kind);
+
     /** Constructor */
     FSServer();
 
@@ -245,6 +248,9 @@ protected:
     void processRequest(spfsRequest* request, cMessage* msg);
 
 private:
+    /** @return true if kind is any client request to the server */
+    static bool isRequestKind(int kind);
+
     /**
      * @return the difference between the current time and originating req
      *    creation time
@@ -71,7 +71,8 @@ void GetAttr::enterReadAttr()
     Filename filename(getAttrReq_->getHandle());
 
     // Create the file write request
-    spfsOSFileReadRequest* fileRead = new spfsOSFileReadRequest();
+    spfsOSFileReadRequest* fileRead =
+        new spfsOSFileReadRequest(0, SPFS_OS_FILE_READ_REQUEST);
     fileRead->setFilename(filename.c_str());
     fileRead->setOffsetArraySize(1);
     fileRead->setExtentArraySize(1);
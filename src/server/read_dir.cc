@@ -71,7 +71,8 @@ void ReadDir::readDir()
     Filename filename(readDirReq_->getHandle());
 
     // Create the file read request
-    spfsOSFileReadRequest* fileRead = new spfsOSFileReadRequest();
+    spfsOSFileReadRequest* fileRead =
+        new spfsOSFileReadRequest(0, SPFS_OS_FILE_READ_REQUEST);
     fileRead->setContextPointer(readDirReq_);
     fileRead->setFilename(filename.c_str());
     fileRead->setOffsetArraySize(1);
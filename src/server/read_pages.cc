@@ -33,9 +33,6 @@ ReadPages::~ReadPages()
 {
     if (cleanupRequest_)
     {
-        // TODO: Fix this leak
-        //delete readReq_->getView();
-        delete readReq_->getDist();
         delete readReq_;
         readReq_ = 0;
     }
@@ -162,7 +159,7 @@ void ReadPages::parititionRequestPages(set<FilePageId>& outClientPages,
     outServerPages = pageUtils.determineRequestPages(readReq_->getPageSize(),
                                                      readReq_->getOffset(),
                                                      readReq_->getDataSize(),
-                                                     *readReq_->getView(),
+                                                     readReq_->getView(),
                                                      *readReq_->getDist());
 
     // Determine the pages held in a cache exclusively
@@ -173,7 +170,7 @@ void ReadPages::parititionRequestPages(set<FilePageId>& outClientPages,
     //                                              readReq_->getPageSize(),
     //                                              readReq_->getOffset(),
     //                                              readReq_->getDataSize(),
-    //                                              *readReq_->getView(),
+    //                                              readReq_->getView(),
     //                                              *readReq_->getDist());
     cerr << __FILE__ << ":" << __LINE__ << ":"
          << "Found server pages: " << outServerPages.size() << endl;
@@ -189,7 +186,7 @@ ReadPages::createInvalidatePagesRequests(const set<FilePageId>& outClientPages)
                                               readReq_->getPageSize(),
                                               readReq_->getOffset(),
                                               readReq_->getDataSize(),
-                                              *readReq_->getView(),
+                                              readReq_->getView(),
                                               *readReq_->getDist());
 
     // Construct the invalidation requests
@@ -256,7 +253,8 @@ void ReadPages::startDataFlow(const set<FilePageId>& localPages)
     dataFlowStart->setMetaHandle(readReq_->getMetaHandle());
     dataFlowStart->setOffset(0);
     dataFlowStart->setDataSize(localPages.size() * pageSize);
-    dataFlowStart->setView(pageView);
+    dataFlowStart->setView(*pageView);
+    delete pageView;
     dataFlowStart->setDist(readReq_->getDist());
     dataFlowStart->setBstreamSize(readReq_->getBstreamSize());
 
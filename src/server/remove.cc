@@ -71,7 +71,8 @@ void Remove::unlinkFile()
     Filename filename(removeReq_->getHandle());
 
     // Create the file unlink request
-    spfsOSFileUnlinkRequest* fileUnlink = new spfsOSFileUnlinkRequest();
+    spfsOSFileUnlinkRequest* fileUnlink =
+        new spfsOSFileUnlinkRequest(0, SPFS_OS_FILE_UNLINK_REQUEST);
     fileUnlink->setContextPointer(removeReq_);
     fileUnlink->setFilename(filename.c_str());
 
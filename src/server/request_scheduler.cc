@@ -7,13 +7,45 @@
 // for details on this and other legal matters.
 //
 #include "request_scheduler.h"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include "fs_server.h"
+#include "message_kind.h"
 #include "pvfs_proto_m.h"
 using namespace std;
 
 // OMNet Registration Method
-Define_Module(RequestScheduler);
+Define_Module(FIFORequestScheduler);
+Define_Module(FairRequestScheduler);
+Define_Module(PriorityRequestScheduler);
+Define_Module(ElevatorRequestScheduler);
+
+RequestScheduler::RequestScheduler()
+    : cSimpleModule(),
+      maxConcurrentRequests_(0),
+      orderDataRequests_(false),
+      nextSequenceNumber_(0),
+      queueDepth_(0),
+      maxQueueDepth_(0),
+      numDispatched_(0),
+      totalWaitTime_(0.0),
+      queueDepthVector_("SPFS Server Request Queue Depth"),
+      waitTimeVector_("SPFS Server Request Wait Time")
+{
+}
+
+RequestScheduler::~RequestScheduler()
+{
+    // Entries still in service at the end of the simulation
+    map<cMessage*, RequestSchedulerEntry*>::iterator iter;
+    for (iter = inServiceEntries_.begin();
+         iter != inServiceEntries_.end();
+         iter++)
+    {
+        delete iter->second;
+    }
+}
 
 /**
  * Initialization
@@ -24,10 +56,30 @@ void RequestScheduler::initialize()
     requestOutGateId_ = findGate("requestOut");
     serverInGateId_ = findGate("serverIn");
     serverOutGateId_ = findGate("serverOut");
+
+    long maxConcurrent = par("maxConcurrentRequests");
+    assert(0 <= maxConcurrent);
+    maxConcurrentRequests_ = maxConcurrent;
+    orderDataRequests_ = par("orderDataRequests").boolValue();
+
+    nextSequenceNumber_ = 0;
+    queueDepth_ = 0;
+    maxQueueDepth_ = 0;
+    numDispatched_ = 0;
+    totalWaitTime_ = 0.0;
+    initializeScheduler();
 }
 
 void RequestScheduler::finish()
 {
+    double meanWaitTime = 0.0;
+    if (0 != numDispatched_)
+    {
+        meanWaitTime = totalWaitTime_.dbl() / numDispatched_;
+    }
+    recordScalar("SPFS Server Requests Scheduled", numDispatched_);
+    recordScalar("SPFS Server Max Request Queue Depth", maxQueueDepth_);
+    recordScalar("SPFS Server Mean Request Wait Time", meanWaitTime);
 }
 
 /**
@@ -37,10 +89,15 @@ void RequestScheduler::handleMessage(cMessage* msg)
 {
     if (msg->getArrivalGateId() == requestInGateId_)
     {
-        // Only pfs and cache messages require scheduling
-        if ((400 <= msg->getKind()) && (600 > msg->getKind()))
+        // Only new requests the server answers require scheduling,
+        // responses belong to requests already in service
+        if (FSServer::isAnsweredRequestKind(msg->getKind()))
+        {
+            scheduleRequest(kind_cast<spfsRequest>(msg));
+        }
+        else if (SPFS_DATA_FLOW_FINISH == msg->getKind())
         {
-            scheduleRequest(msg);
+            completeDataFlow(msg);
         }
         else
         {
@@ -68,16 +125,435 @@ void RequestScheduler::handleMessage(cMessage* msg)
     }
 }
 
-void RequestScheduler::scheduleRequest(cMessage* msg)
+void RequestScheduler::scheduleRequest(spfsRequest* request)
 {
-    send(msg, serverOutGateId_);
+    RequestSchedulerEntry* entry = new RequestSchedulerEntry();
+    entry->request = request;
+    entry->handle = request->getHandle();
+    entry->clientId = request->getBmiConnectionId();
+    entry->offset = 0;
+    entry->dataSize = 0;
+    entry->isRead = false;
+    entry->isWrite = false;
+    entry->completesOnFlowFinish = false;
+    entry->arrivalTime = simTime();
+    entry->sequenceNumber = nextSequenceNumber_++;
+
+    // Extract the data request parameters
+    if (spfsReadRequest* read = dynamic_cast<spfsReadRequest*>(request))
+    {
+        entry->offset = read->getOffset();
+        entry->dataSize = read->getDataSize();
+        entry->isRead = true;
+        entry->completesOnFlowFinish = (0 != read->getLocalSize());
+    }
+    else if (spfsWriteRequest* write =
+             dynamic_cast<spfsWriteRequest*>(request))
+    {
+        entry->offset = write->getOffset();
+        entry->dataSize = write->getDataSize();
+        entry->isWrite = true;
+    }
+
+    // Data requests are ordered by handle
+    if (isOrdered(entry))
+    {
+        messageQueues_[entry->handle].push_back(entry);
+    }
+
+    addEntry(entry);
+    queueDepth_++;
+    maxQueueDepth_ = max(maxQueueDepth_, queueDepth_);
+    queueDepthVector_.record(queueDepth_);
+
+    dispatchRequests();
 }
 
 void RequestScheduler::completeRequest(cMessage* msg)
 {
+    // The final response for an in service request completes it, the
+    // write acknowledgement precedes the write's data flow and a read's
+    // response precedes its data flow
+    cMessage* completed = 0;
+    if (0 != dynamic_cast<spfsResponse*>(msg) &&
+        SPFS_WRITE_RESPONSE != msg->getKind())
+    {
+        cMessage* request = static_cast<cMessage*>(msg->getContextPointer());
+        map<cMessage*, RequestSchedulerEntry*>::iterator iter =
+            inServiceEntries_.find(request);
+        if (iter != inServiceEntries_.end() &&
+            !iter->second->completesOnFlowFinish)
+        {
+            completed = request;
+        }
+    }
+
     send(msg, requestOutGateId_);
+
+    // Begin servicing requests that were blocked by the completed request
+    if (0 != completed)
+    {
+        finishEntry(completed);
+    }
+}
+
+void RequestScheduler::completeDataFlow(cMessage* msg)
+{
+    // The flow finish refers to the flow start, which refers to the
+    // originating request
+    cMessage* flowStart = static_cast<cMessage*>(msg->getContextPointer());
+    assert(0 != flowStart);
+    cMessage* request =
+        static_cast<cMessage*>(flowStart->getContextPointer());
+
+    // Check before forwarding, the server deletes a finished read
+    map<cMessage*, RequestSchedulerEntry*>::iterator iter =
+        inServiceEntries_.find(request);
+    bool isCompleted = (iter != inServiceEntries_.end() &&
+                        iter->second->completesOnFlowFinish);
+
+    send(msg, serverOutGateId_);
+
+    if (isCompleted)
+    {
+        finishEntry(request);
+    }
+}
+
+void RequestScheduler::finishEntry(cMessage* request)
+{
+    map<cMessage*, RequestSchedulerEntry*>::iterator iter =
+        inServiceEntries_.find(request);
+    assert(iter != inServiceEntries_.end());
+    RequestSchedulerEntry* entry = iter->second;
+    inServiceEntries_.erase(iter);
+
+    releaseEntry(entry);
+    delete entry;
+    dispatchRequests();
+}
+
+bool RequestScheduler::isOrdered(const RequestSchedulerEntry* entry) const
+{
+    // Metadata requests are not serialized
+    return orderDataRequests_ && (entry->isRead || entry->isWrite);
+}
+
+bool RequestScheduler::isDispatchable(const RequestSchedulerEntry* entry) const
+{
+    if (!isOrdered(entry))
+    {
+        return true;
+    }
+
+    // A write waits for all in service requests to its handle, a read only
+    // waits for an in service write
+    if (0 != writesInService_.count(entry->handle))
+    {
+        return false;
+    }
+    if (entry->isWrite && 0 != readsInService_.count(entry->handle))
+    {
+        return false;
+    }
+
+    // Requests may not pass an earlier conflicting request to the handle
+    map<FSHandle, deque<RequestSchedulerEntry*> >::const_iterator queue =
+        messageQueues_.find(entry->handle);
+    assert(queue != messageQueues_.end());
+    deque<RequestSchedulerEntry*>::const_iterator iter;
+    for (iter = queue->second.begin(); iter != queue->second.end(); iter++)
+    {
+        if (*iter == entry)
+        {
+            return true;
+        }
+        else if ((*iter)->isWrite || entry->isWrite)
+        {
+            return false;
+        }
+    }
+    assert(false);
+    return false;
+}
+
+void RequestScheduler::dispatchRequests()
+{
+    while (0 == maxConcurrentRequests_ ||
+           inServiceEntries_.size() < maxConcurrentRequests_)
+    {
+        RequestSchedulerEntry* entry = popNextEntry();
+        if (0 == entry)
+        {
+            break;
+        }
+        dispatchEntry(entry);
+    }
 }
 
+void RequestScheduler::dispatchEntry(RequestSchedulerEntry* entry)
+{
+    assert(isDispatchable(entry));
+
+    // Remove the entry from its handle's ordering
+    if (isOrdered(entry))
+    {
+        map<FSHandle, deque<RequestSchedulerEntry*> >::iterator queue =
+            messageQueues_.find(entry->handle);
+        deque<RequestSchedulerEntry*>::iterator pos =
+            find(queue->second.begin(), queue->second.end(), entry);
+        queue->second.erase(pos);
+        if (queue->second.empty())
+        {
+            messageQueues_.erase(queue);
+        }
+
+        if (entry->isWrite)
+        {
+            writesInService_.insert(entry->handle);
+        }
+        else
+        {
+            readsInService_[entry->handle]++;
+        }
+    }
+    inServiceEntries_[entry->request] = entry;
+
+    // Record statistics
+    simtime_t waitTime = simTime() - entry->arrivalTime;
+    queueDepth_--;
+    numDispatched_++;
+    totalWaitTime_ += waitTime;
+    queueDepthVector_.record(queueDepth_);
+    waitTimeVector_.record(waitTime);
+
+    send(entry->request, serverOutGateId_);
+}
+
+void RequestScheduler::releaseEntry(RequestSchedulerEntry* entry)
+{
+    if (!isOrdered(entry))
+    {
+        return;
+    }
+
+    if (entry->isWrite)
+    {
+        writesInService_.erase(entry->handle);
+    }
+    else if (entry->isRead)
+    {
+        map<FSHandle, size_t>::iterator iter =
+            readsInService_.find(entry->handle);
+        assert(iter != readsInService_.end());
+        if (0 == --iter->second)
+        {
+            readsInService_.erase(iter);
+        }
+    }
+}
+
+//
+// FIFORequestScheduler implementation
+//
+FIFORequestScheduler::FIFORequestScheduler()
+    : RequestScheduler()
+{
+}
+
+void FIFORequestScheduler::addEntry(RequestSchedulerEntry* entry)
+{
+    fifoQueue_.push_back(entry);
+}
+
+RequestSchedulerEntry* FIFORequestScheduler::popNextEntry()
+{
+    // Service the earliest request that does not conflict
+    list<RequestSchedulerEntry*>::iterator iter;
+    for (iter = fifoQueue_.begin(); iter != fifoQueue_.end(); iter++)
+    {
+        if (isDispatchable(*iter))
+        {
+            RequestSchedulerEntry* entry = *iter;
+            fifoQueue_.erase(iter);
+            return entry;
+        }
+    }
+    return 0;
+}
+
+//
+// FairRequestScheduler implementation
+//
+FairRequestScheduler::FairRequestScheduler()
+    : RequestScheduler(),
+      lastClient_(0)
+{
+}
+
+void FairRequestScheduler::addEntry(RequestSchedulerEntry* entry)
+{
+    clientQueues_[entry->clientId].push_back(entry);
+}
+
+RequestSchedulerEntry* FairRequestScheduler::popNextEntry()
+{
+    // Visit each client once, beginning after the last client serviced
+    map<ConnectionId, list<RequestSchedulerEntry*> >::iterator client =
+        clientQueues_.upper_bound(lastClient_);
+    for (size_t i = 0; i < clientQueues_.size(); i++, client++)
+    {
+        if (client == clientQueues_.end())
+        {
+            client = clientQueues_.begin();
+        }
+
+        // Service the client's earliest request that does not conflict
+        list<RequestSchedulerEntry*>& queue = client->second;
+        list<RequestSchedulerEntry*>::iterator iter;
+        for (iter = queue.begin(); iter != queue.end(); iter++)
+        {
+            if (isDispatchable(*iter))
+            {
+                RequestSchedulerEntry* entry = *iter;
+                queue.erase(iter);
+                lastClient_ = client->first;
+                if (queue.empty())
+                {
+                    clientQueues_.erase(client);
+                }
+                return entry;
+            }
+        }
+    }
+    return 0;
+}
+
+//
+// PriorityRequestScheduler implementation
+//
+PriorityRequestScheduler::PriorityRequestScheduler()
+    : RequestScheduler()
+{
+}
+
+void PriorityRequestScheduler::addEntry(RequestSchedulerEntry* entry)
+{
+    pair<FSSize, unsigned long> key(entry->dataSize, entry->sequenceNumber);
+    priorityQueue_[key] = entry;
+}
+
+RequestSchedulerEntry* PriorityRequestScheduler::popNextEntry()
+{
+    // Service the smallest request that does not conflict
+    map<pair<FSSize, unsigned long>, RequestSchedulerEntry*>::iterator iter;
+    for (iter = priorityQueue_.begin(); iter != priorityQueue_.end(); iter++)
+    {
+        if (isDispatchable(iter->second))
+        {
+            RequestSchedulerEntry* entry = iter->second;
+            priorityQueue_.erase(iter);
+            return entry;
+        }
+    }
+    return 0;
+}
+
+//
+// ElevatorRequestScheduler implementation
+//
+ElevatorRequestScheduler::ElevatorRequestScheduler()
+    : RequestScheduler(),
+      maxBatchSize_(0),
+      currentHandle_(0),
+      currentOffset_(0),
+      batchSize_(0)
+{
+}
+
+void ElevatorRequestScheduler::initializeScheduler()
+{
+    long maxBatchSize = par("maxBatchSize");
+    assert(0 < maxBatchSize);
+    maxBatchSize_ = maxBatchSize;
+    currentHandle_ = 0;
+    currentOffset_ = 0;
+    batchSize_ = 0;
+}
+
+void ElevatorRequestScheduler::addEntry(RequestSchedulerEntry* entry)
+{
+    handleQueues_[entry->handle].insert(make_pair(entry->offset, entry));
+}
+
+RequestSchedulerEntry* ElevatorRequestScheduler::popNextEntry()
+{
+    // Continue the current batch upward from the last serviced offset
+    map<FSHandle, OffsetQueue>::iterator handle =
+        handleQueues_.find(currentHandle_);
+    if (batchSize_ < maxBatchSize_ && handle != handleQueues_.end())
+    {
+        RequestSchedulerEntry* entry =
+            popDispatchable(currentHandle_,
+                            handle->second.lower_bound(currentOffset_));
+        if (0 != entry)
+        {
+            currentOffset_ = entry->offset;
+            batchSize_++;
+            return entry;
+        }
+    }
+
+    // Begin a new batch at the lowest offset of the next handle with a
+    // dispatchable request
+    handle = handleQueues_.upper_bound(currentHandle_);
+    size_t numHandles = handleQueues_.size();
+    for (size_t i = 0; i < numHandles; i++)
+    {
+        if (handle == handleQueues_.end())
+        {
+            handle = handleQueues_.begin();
+        }
+
+        // Advance first, popping an entry may erase the handle's queue
+        FSHandle nextHandle = handle->first;
+        OffsetQueue::iterator begin = handle->second.begin();
+        handle++;
+
+        RequestSchedulerEntry* entry = popDispatchable(nextHandle, begin);
+        if (0 != entry)
+        {
+            currentHandle_ = nextHandle;
+            currentOffset_ = entry->offset;
+            batchSize_ = 1;
+            return entry;
+        }
+    }
+    return 0;
+}
+
+RequestSchedulerEntry* ElevatorRequestScheduler::popDispatchable(
+    FSHandle handle, OffsetQueue::iterator begin)
+{
+    map<FSHandle, OffsetQueue>::iterator queue = handleQueues_.find(handle);
+    assert(queue != handleQueues_.end());
+    for (OffsetQueue::iterator iter = begin;
+         iter != queue->second.end();
+         iter++)
+    {
+        if (isDispatchable(iter->second))
+        {
+            RequestSchedulerEntry* entry = iter->second;
+            queue->second.erase(iter);
+            if (queue->second.empty())
+            {
+                handleQueues_.erase(queue);
+            }
+            return entry;
+        }
+    }
+    return 0;
+}
 
 /*
  * Local variables:
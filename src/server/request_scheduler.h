@@ -8,20 +8,55 @@
 // This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
 // for details on this and other legal matters.
 //
+#include <cstddef>
+#include <deque>
+#include <list>
 #include <map>
-#include <queue>
+#include <set>
+#include <utility>
 #include <omnetpp.h>
+#include "basic_types.h"
 #include "pfs_types.h"
-using namespace std;
+class spfsRequest;
 
 /**
- * Model of a file system server request scheduler
+ * Scheduler entry for file system server requests
+ */
+struct RequestSchedulerEntry
+{
+    spfsRequest* request;
+    FSHandle handle;
+    ConnectionId clientId;
+    FSOffset offset;
+    FSSize dataSize;
+    bool isRead;
+    bool isWrite;
+    bool completesOnFlowFinish;
+    simtime_t arrivalTime;
+    unsigned long sequenceNumber;
+};
+
+/**
+ * Abstract model of a file system server request scheduler
+ *
+ * If orderDataRequests is set, data requests to the same handle are
+ * ordered so that a write is not serviced concurrently with, or ahead of,
+ * any earlier request to that handle, and a read is not serviced
+ * concurrently with, or ahead of, an earlier write.  Metadata requests are
+ * not serialized.  At most
+ * maxConcurrentRequests requests are in service at once (0 is unlimited).
+ * Reads that transfer data complete when their data flow finishes, and
+ * request kinds the server does not answer bypass the scheduler.
+ * Subclasses select which dispatchable request is serviced next.
  */
 class RequestScheduler : public cSimpleModule
 {
 public:
     /** Constructor */
-    RequestScheduler() : cSimpleModule() {};
+    RequestScheduler();
+
+    /** Destructor */
+    virtual ~RequestScheduler();
 
 protected:
 
@@ -37,11 +72,50 @@ protected:
     /** Mark request complete */
     virtual void completeRequest(cMessage* msg);
 
+    /** Mark the request whose data flow finished complete */
+    virtual void completeDataFlow(cMessage* msg);
+
     /** Schedule the next request */
-    virtual void scheduleRequest(cMessage* msg);
+    virtual void scheduleRequest(spfsRequest* request);
+
+    /** Perform initialization tasks on scheduler before messages arrive */
+    virtual void initializeScheduler() = 0;
+
+    /** Add entry to the scheduling policy */
+    virtual void addEntry(RequestSchedulerEntry* entry) = 0;
+
+    /**
+     * @return the next entry to service, removed from the policy, or 0 if
+     *   no queued entry is currently dispatchable
+     */
+    virtual RequestSchedulerEntry* popNextEntry() = 0;
+
+    /**
+     * @return true if the entry does not conflict with an in service
+     *   request or an earlier queued request to the same handle
+     */
+    bool isDispatchable(const RequestSchedulerEntry* entry) const;
 
 private:
 
+    /** @return true if the entry takes part in the handle ordering */
+    bool isOrdered(const RequestSchedulerEntry* entry) const;
+
+    /** Dispatch entries until the policy or concurrency limit blocks */
+    void dispatchRequests();
+
+    /** Send the entry's request to the server */
+    void dispatchEntry(RequestSchedulerEntry* entry);
+
+    /**
+     * Remove the request's entry from service, release its handle
+     * serialization and dispatch the requests it blocked
+     */
+    void finishEntry(cMessage* request);
+
+    /** Release the handle serialization held by an in service entry */
+    void releaseEntry(RequestSchedulerEntry* entry);
+
     /** In gate id */
     int requestInGateId_;
 
@@ -54,8 +128,156 @@ private:
     /** Out gate id */
     int serverOutGateId_;
 
-    /** Queue of messages */
-    std::map<FSHandle, std::queue<cMessage*> > messageQueues_;
+    /** The maximum number of requests in service (0 is unlimited) */
+    std::size_t maxConcurrentRequests_;
+
+    /** Serialize conflicting data requests to each handle */
+    bool orderDataRequests_;
+
+    /** Arrival number for the next request */
+    unsigned long nextSequenceNumber_;
+
+    /** Queued data requests for each handle in arrival order */
+    std::map<FSHandle, std::deque<RequestSchedulerEntry*> > messageQueues_;
+
+    /** Requests currently in service */
+    std::map<cMessage*, RequestSchedulerEntry*> inServiceEntries_;
+
+    /** Number of reads in service for each handle */
+    std::map<FSHandle, std::size_t> readsInService_;
+
+    /** Handles with a write in service */
+    std::set<FSHandle> writesInService_;
+
+    /** Number of queued requests */
+    std::size_t queueDepth_;
+
+    /** Statistics */
+    std::size_t maxQueueDepth_;
+    std::size_t numDispatched_;
+    simtime_t totalWaitTime_;
+    cOutVector queueDepthVector_;
+    cOutVector waitTimeVector_;
+};
+
+/**
+ * First come, first served request scheduler
+ */
+class FIFORequestScheduler : public RequestScheduler
+{
+public:
+    /** Constructor */
+    FIFORequestScheduler();
+
+protected:
+
+    virtual void initializeScheduler() {};
+
+    virtual void addEntry(RequestSchedulerEntry* entry);
+
+    virtual RequestSchedulerEntry* popNextEntry();
+
+private:
+
+    std::list<RequestSchedulerEntry*> fifoQueue_;
+};
+
+/**
+ * Request scheduler that services clients in round robin order
+ */
+class FairRequestScheduler : public RequestScheduler
+{
+public:
+    /** Constructor */
+    FairRequestScheduler();
+
+protected:
+
+    virtual void initializeScheduler() {};
+
+    virtual void addEntry(RequestSchedulerEntry* entry);
+
+    virtual RequestSchedulerEntry* popNextEntry();
+
+private:
+
+    /** Arrival ordered queue for each client */
+    std::map<ConnectionId, std::list<RequestSchedulerEntry*> > clientQueues_;
+
+    /** The most recently serviced client */
+    ConnectionId lastClient_;
+};
+
+/**
+ * Request scheduler that services the smallest request first.  Metadata
+ * requests transfer no data, and thus are serviced before all data
+ * requests.
+ */
+class PriorityRequestScheduler : public RequestScheduler
+{
+public:
+    /** Constructor */
+    PriorityRequestScheduler();
+
+protected:
+
+    virtual void initializeScheduler() {};
+
+    virtual void addEntry(RequestSchedulerEntry* entry);
+
+    virtual RequestSchedulerEntry* popNextEntry();
+
+private:
+
+    /** Entries ordered by size and then arrival */
+    std::map<std::pair<FSSize, unsigned long>,
+             RequestSchedulerEntry*> priorityQueue_;
+};
+
+/**
+ * Request scheduler that services batches of up to maxBatchSize requests
+ * to a single handle in ascending offset order, and then moves on to the
+ * next handle
+ */
+class ElevatorRequestScheduler : public RequestScheduler
+{
+public:
+    /** Constructor */
+    ElevatorRequestScheduler();
+
+protected:
+
+    virtual void initializeScheduler();
+
+    virtual void addEntry(RequestSchedulerEntry* entry);
+
+    virtual RequestSchedulerEntry* popNextEntry();
+
+private:
+
+    typedef std::multimap<FSOffset, RequestSchedulerEntry*> OffsetQueue;
+
+    /**
+     * @return the first dispatchable entry at or after begin in the
+     *   handle's queue removed from the scheduler, or 0 if none exists
+     */
+    RequestSchedulerEntry* popDispatchable(FSHandle handle,
+                                           OffsetQueue::iterator begin);
+
+    /** Offset ordered queue for each handle */
+    std::map<FSHandle, OffsetQueue> handleQueues_;
+
+    /** The maximum number of consecutive requests serviced for a handle */
+    std::size_t maxBatchSize_;
+
+    /** The handle of the current batch */
+    FSHandle currentHandle_;
+
+    /** The offset of the most recently serviced request */
+    FSOffset currentOffset_;
+
+    /** The number of requests serviced in the current batch */
+    std::size_t batchSize_;
 };
 
 #endif
@@ -71,7 +71,8 @@ void SetAttr::enterWriteAttr()
     Filename filename(setAttrReq_->getHandle());
 
     // Create the file write request
-    spfsOSFileWriteRequest* fileWrite = new spfsOSFileWriteRequest();
+    spfsOSFileWriteRequest* fileWrite =
+        new spfsOSFileWriteRequest(0, SPFS_OS_FILE_WRITE_REQUEST);
     fileWrite->setFilename(filename.c_str());
     fileWrite->setOffsetArraySize(1);
     fileWrite->setExtentArraySize(1);
@@ -20,6 +20,7 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 //
 #include <cppunit/extensions/HelperMacros.h>
+#include "file_id_registry.h"
 #include "multi_cache.h"
 
 class MultiCacheTest : public CppUnit::TestFixture
@@ -64,29 +65,30 @@ void MultiCacheTest::testSize()
 
     // Check that insertion modifies size correctly
     MultiCache::Page page1;
-    MultiCache::Key outKey(Filename("/out"), 1000);
+    FileId rootId = FileIdRegistry::instance().intern(Filename("/"));
+    MultiCache::Key outKey(rootId, 1000);
     MultiCache::Page* outPage;
     bool outDirtyStatus;
     try {
-        MultiCache::Key key1(Filename("/"), 1);
+        MultiCache::Key key1(rootId, 1);
         cache1.insertFullPageAndRecall(key1, page1, false, outKey, outPage, outDirtyStatus);
         CPPUNIT_ASSERT_EQUAL(size_t(1), cache1.size());
     } catch(...) {}
 
     try {
-        MultiCache::Key key2(Filename("/"), 2);
+        MultiCache::Key key2(rootId, 2);
         cache1.insertFullPageAndRecall(key2, page1, false, outKey, outPage, outDirtyStatus);
         CPPUNIT_ASSERT_EQUAL(size_t(2), cache1.size());
     } catch(...) {}
 
     try {
-        MultiCache::Key key3(Filename("/"), 3);
+        MultiCache::Key key3(rootId, 3);
         cache1.insertFullPageAndRecall(key3, page1, false, outKey, outPage, outDirtyStatus);
         CPPUNIT_ASSERT_EQUAL(size_t(3), cache1.size());
     } catch(...) {}
 
     try {
-        MultiCache::Key key4(Filename("/"), 4);
+        MultiCache::Key key4(rootId, 4);
         cache1.insertFullPageAndRecall(key4, page1, false, outKey, outPage, outDirtyStatus);
         CPPUNIT_ASSERT_EQUAL(size_t(4), cache1.size());
 
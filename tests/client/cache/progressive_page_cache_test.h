@@ -20,6 +20,7 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 //
 #include <cppunit/extensions/HelperMacros.h>
+#include "file_id_registry.h"
 #include "progressive_page_cache.h"
 
 class ProgressivePageCacheTest : public CppUnit::TestFixture
@@ -64,29 +65,30 @@ void ProgressivePageCacheTest::testSize()
 
     // Check that insertion modifies size correctly
     ProgressivePageCache::Page page1;
-    ProgressivePageCache::Key outKey(Filename("/out"), 1000);
+    FileId rootId = FileIdRegistry::instance().intern(Filename("/"));
+    ProgressivePageCache::Key outKey(rootId, 1000);
     ProgressivePageCache::Page* outPage;
     bool outDirtyStatus;
     try {
-        ProgressivePageCache::Key key1(Filename("/"), 1);
+        ProgressivePageCache::Key key1(rootId, 1);
         cache1.insertPageAndRecall(key1, page1, false, outKey, outPage, outDirtyStatus);
         CPPUNIT_ASSERT_EQUAL(size_t(1), cache1.size());
     } catch(...) {}
 
     try {
-        ProgressivePageCache::Key key2(Filename("/"), 2);
+        ProgressivePageCache::Key key2(rootId, 2);
         cache1.insertPageAndRecall(key2, page1, false, outKey, outPage, outDirtyStatus);
         CPPUNIT_ASSERT_EQUAL(size_t(2), cache1.size());
     } catch(...) {}
 
     try {
-        ProgressivePageCache::Key key3(Filename("/"), 3);
+        ProgressivePageCache::Key key3(rootId, 3);
         cache1.insertPageAndRecall(key3, page1, false, outKey, outPage, outDirtyStatus);
         CPPUNIT_ASSERT_EQUAL(size_t(3), cache1.size());
     } catch(...) {}
 
     try {
-        ProgressivePageCache::Key key4(Filename("/"), 4);
+        ProgressivePageCache::Key key4(rootId, 4);
         cache1.insertPageAndRecall(key4, page1, false, outKey, outPage, outDirtyStatus);
         CPPUNIT_ASSERT_EQUAL(size_t(4), cache1.size());
 
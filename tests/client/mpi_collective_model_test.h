@@ -0,0 +1,125 @@
+#ifndef MPI_COLLECTIVE_MODEL_TEST_H
+#define MPI_COLLECTIVE_MODEL_TEST_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstddef>
+#include <vector>
+#include <cppunit/extensions/HelperMacros.h>
+#include "mpi_collective_model.h"
+using namespace std;
+
+/** Unit test for MPICollectiveModel */
+class MPICollectiveModelTest : public CppUnit::TestFixture
+{
+    // Create unit test and register test functions for automatic
+    // exercise
+    CPPUNIT_TEST_SUITE(MPICollectiveModelTest);
+    CPPUNIT_TEST(testBarrier);
+    CPPUNIT_TEST(testBcast);
+    CPPUNIT_TEST(testRecursiveDoubling);
+    CPPUNIT_TEST(testRing);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    /** Called before each test function */
+    void setUp() {};
+
+    /** Called after each test function */
+    void tearDown() {};
+
+    void testBarrier();
+    void testBcast();
+    void testRecursiveDoubling();
+    void testRing();
+};
+
+void MPICollectiveModelTest::testBarrier()
+{
+    // 4 ranks need 2 rounds of latency
+    MPICollectiveModel model(1.0, 1.0, 0);
+    vector<double> times = model.barrier(vector<double>(4, 0.0));
+    CPPUNIT_ASSERT_EQUAL((size_t)4, times.size());
+    for (size_t i = 0; i < times.size(); i++)
+    {
+        CPPUNIT_ASSERT_EQUAL(2.0, times[i]);
+    }
+
+    // The early rank waits for the signal from the late rank
+    vector<double> arrivals;
+    arrivals.push_back(0.0);
+    arrivals.push_back(5.0);
+    times = model.barrier(arrivals);
+    CPPUNIT_ASSERT_EQUAL(6.0, times[0]);
+    CPPUNIT_ASSERT_EQUAL(5.0, times[1]);
+}
+
+void MPICollectiveModelTest::testBcast()
+{
+    // Messages of 2 bytes take 3 seconds and occupy the sender for 2.  The
+    // root sends to relative ranks 2 and 1, and relative rank 2 to 3
+    MPICollectiveModel model(1.0, 1.0, 0);
+    vector<double> times = model.bcast(vector<double>(4, 0.0), 0, 2);
+    CPPUNIT_ASSERT_EQUAL(4.0, times[0]);
+    CPPUNIT_ASSERT_EQUAL(5.0, times[1]);
+    CPPUNIT_ASSERT_EQUAL(5.0, times[2]);
+    CPPUNIT_ASSERT_EQUAL(6.0, times[3]);
+
+    // The tree is rotated to the root
+    times = model.bcast(vector<double>(4, 0.0), 1, 2);
+    CPPUNIT_ASSERT_EQUAL(4.0, times[1]);
+    CPPUNIT_ASSERT_EQUAL(5.0, times[2]);
+    CPPUNIT_ASSERT_EQUAL(5.0, times[3]);
+    CPPUNIT_ASSERT_EQUAL(6.0, times[0]);
+}
+
+void MPICollectiveModelTest::testRecursiveDoubling()
+{
+    // Each round costs 2 seconds
+    MPICollectiveModel model(1.0, 1.0, 10);
+    CPPUNIT_ASSERT_EQUAL(MPICollectiveModel::RECURSIVE_DOUBLING,
+                         model.getAllReduceAlgorithm(10));
+    vector<double> times = model.allReduce(vector<double>(4, 0.0), 1);
+    for (size_t i = 0; i < times.size(); i++)
+    {
+        CPPUNIT_ASSERT_EQUAL(4.0, times[i]);
+    }
+
+    // With 3 ranks, rank 0 hands its data to rank 1 and receives the
+    // result after ranks 1 and 2 exchange
+    times = model.allReduce(vector<double>(3, 0.0), 1);
+    CPPUNIT_ASSERT_EQUAL(6.0, times[0]);
+    CPPUNIT_ASSERT_EQUAL(4.0, times[1]);
+    CPPUNIT_ASSERT_EQUAL(4.0, times[2]);
+}
+
+void MPICollectiveModelTest::testRing()
+{
+    // 6 steps passing 3 byte chunks
+    MPICollectiveModel model(0.0, 1.0, 10);
+    CPPUNIT_ASSERT_EQUAL(MPICollectiveModel::RING,
+                         model.getAllReduceAlgorithm(11));
+    vector<double> times = model.allReduce(vector<double>(4, 0.0), 12);
+    for (size_t i = 0; i < times.size(); i++)
+    {
+        CPPUNIT_ASSERT_EQUAL(18.0, times[i]);
+    }
+}
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -11,6 +11,7 @@
 #include "client_fs_state_test.h"
 #include "direct_paged_middleware_cache_test.h"
 #include "fs_client_test.h"
+#include "mpi_collective_model_test.h"
 
 int main(int argc, char** argv)
 {
@@ -20,6 +21,7 @@ int main(int argc, char** argv)
     runner.addTest( ClientFSStateTest::suite() );
     runner.addTest( DirectPagedMiddlewareCacheTest::suite() );
     runner.addTest( FSClientTest::suite() );
+    runner.addTest( MPICollectiveModelTest::suite() );
 
     bool success = runner.run();
     return (success ? 0 : 1);
@@ -0,0 +1,84 @@
+#ifndef FILE_ID_REGISTRY_TEST_H
+#define FILE_ID_REGISTRY_TEST_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cppunit/extensions/HelperMacros.h>
+#include "file_id_registry.h"
+#include "filename.h"
+using namespace std;
+
+/** Unit test for FileIdRegistry */
+class FileIdRegistryTest : public CppUnit::TestFixture
+{
+    // Create generic unit test and register test functions for automatic
+    // exercise
+    CPPUNIT_TEST_SUITE(FileIdRegistryTest);
+    CPPUNIT_TEST(testIntern);
+    CPPUNIT_TEST(testFind);
+    CPPUNIT_TEST(testGetFilename);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    /** Called before each test function */
+    void setUp() {};
+
+    /** Called after each test function */
+    void tearDown() {};
+
+    void testIntern();
+    void testFind();
+    void testGetFilename();
+};
+
+void FileIdRegistryTest::testIntern()
+{
+    FileIdRegistry& registry = FileIdRegistry::instance();
+    size_t numFiles = registry.getNumFiles();
+    FileId id1 = registry.intern(Filename("/file_id_registry_test/a"));
+    FileId id2 = registry.intern(Filename("/file_id_registry_test/b"));
+    CPPUNIT_ASSERT(id1 != id2);
+    CPPUNIT_ASSERT_EQUAL(numFiles + 2, registry.getNumFiles());
+
+    // Equivalent paths intern to the same id
+    CPPUNIT_ASSERT_EQUAL(id1,
+                         registry.intern(Filename("//file_id_registry_test/a/")));
+    CPPUNIT_ASSERT_EQUAL(numFiles + 2, registry.getNumFiles());
+}
+
+void FileIdRegistryTest::testFind()
+{
+    FileIdRegistry& registry = FileIdRegistry::instance();
+    FileId id = 0;
+    CPPUNIT_ASSERT(!registry.find(Filename("/file_id_registry_test/c"), id));
+
+    FileId expected = registry.intern(Filename("/file_id_registry_test/c"));
+    CPPUNIT_ASSERT(registry.find(Filename("/file_id_registry_test/c"), id));
+    CPPUNIT_ASSERT_EQUAL(expected, id);
+}
+
+void FileIdRegistryTest::testGetFilename()
+{
+    FileIdRegistry& registry = FileIdRegistry::instance();
+    Filename name("/file_id_registry_test/d");
+    FileId id = registry.intern(name);
+    CPPUNIT_ASSERT_EQUAL(name, registry.getFilename(id));
+}
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
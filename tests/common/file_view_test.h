@@ -64,10 +64,16 @@ void FileViewTest::testConstructor()
 void FileViewTest::testCopyConstructor()
 {
     BasicDataType<10>* dataType = new BasicDataType<10>();
-    FileView view1(6, dataType);
-    FileView view2(view1);
-    CPPUNIT_ASSERT_EQUAL(view1.getDisplacement(), view2.getDisplacement());
-    //CPPUNIT_ASSERT_EQUAL(view1.getDataType(), view2.getDataType());
+    FileView* view1 = new FileView(6, dataType);
+    FileView view2(*view1);
+    CPPUNIT_ASSERT_EQUAL(view1->getDisplacement(), view2.getDisplacement());
+    CPPUNIT_ASSERT(view1->getDataType() == view2.getDataType());
+    CPPUNIT_ASSERT(*view1 == view2);
+
+    // The shared data type outlives the original view
+    delete view1;
+    CPPUNIT_ASSERT(dataType == view2.getDataType());
+    CPPUNIT_ASSERT_EQUAL(size_t(10), view2.getDataType()->getExtent());
 }
 
 void FileViewTest::testAssignment()
@@ -80,7 +86,7 @@ void FileViewTest::testAssignment()
 
     view2 = view1;
     CPPUNIT_ASSERT_EQUAL(view1.getDisplacement(), view2.getDisplacement());
-    //CPPUNIT_ASSERT_EQUAL(view1.getDataType(), view2.getDataType());
+    CPPUNIT_ASSERT(view1.getDataType() == view2.getDataType());
 }
 
 void FileViewTest::testGetDisplacement()
@@ -24,6 +24,7 @@ class LRUCacheTest : public CppUnit::TestFixture
     CPPUNIT_TEST(testConstructor);
     CPPUNIT_TEST(testInsert);
     CPPUNIT_TEST(testRemove);
+    CPPUNIT_TEST(testRemoveAndRecall);
     CPPUNIT_TEST(testSetDirtyBit);
     CPPUNIT_TEST(testLookup);
     CPPUNIT_TEST(testCapacity);
@@ -32,6 +33,9 @@ class LRUCacheTest : public CppUnit::TestFixture
     CPPUNIT_TEST(testSize);
     CPPUNIT_TEST(testLRUPolicy);
     CPPUNIT_TEST(testPercentDirty);
+    CPPUNIT_TEST(testInsertAndRecall);
+    CPPUNIT_TEST(testFind);
+    CPPUNIT_TEST(testGetFilteredDirtyEntries);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -48,6 +52,8 @@ public:
 
     void testRemove();
 
+    void testRemoveAndRecall();
+
     void testSetDirtyBit();
 
     void testLookup();
@@ -64,6 +70,12 @@ public:
 
     void testPercentDirty();
 
+    void testInsertAndRecall();
+
+    void testFind();
+
+    void testGetFilteredDirtyEntries();
+
 private:
     LRUCache<int, std::string>* cache1_;
     LRUCache<int, std::string>* cache2_;
@@ -115,6 +127,22 @@ void LRUCacheTest::testRemove()
     CPPUNIT_ASSERT_EQUAL((size_t)0, cache1_->size());
 }
 
+void LRUCacheTest::testRemoveAndRecall()
+{
+    string value;
+    bool isDirty = false;
+    CPPUNIT_ASSERT_THROW(cache1_->removeAndRecall(77, value, isDirty),
+                         NoSuchEntry);
+
+    // The removed entry's value and dirty bit are recalled
+    cache1_->insert(63, "value63", true);
+    cache1_->removeAndRecall(63, value, isDirty);
+    CPPUNIT_ASSERT_EQUAL(string("value63"), value);
+    CPPUNIT_ASSERT(isDirty);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, cache1_->size());
+    CPPUNIT_ASSERT_EQUAL(0.0, cache1_->percentDirty());
+}
+
 void LRUCacheTest::testSetDirtyBit()
 {
     LRUCache<int, int> cache(10);
@@ -333,6 +361,97 @@ void LRUCacheTest::testPercentDirty()
     CPPUNIT_ASSERT_EQUAL(6.0/10.0, cache1_->percentDirty());
     cache1_->insert(653, "val653", true);
     CPPUNIT_ASSERT_EQUAL(7.0/10.0, cache1_->percentDirty());
+
+    // Test percent dirty after cleaning entries
+    cache1_->insert(653, "val653", false);
+    CPPUNIT_ASSERT_EQUAL(6.0/10.0, cache1_->percentDirty());
+    cache1_->setDirtyBit(649, false);
+    CPPUNIT_ASSERT_EQUAL(5.0/10.0, cache1_->percentDirty());
+    cache1_->setDirtyBit(649, true);
+    CPPUNIT_ASSERT_EQUAL(6.0/10.0, cache1_->percentDirty());
+}
+
+void LRUCacheTest::testInsertAndRecall()
+{
+    int evictedKey = 0;
+    string evictedValue;
+    bool evictedDirtyBit = false;
+
+    // No eviction while the cache has available capacity
+    CPPUNIT_ASSERT(!cache2_->insertAndRecall(1, "value1", true, evictedKey,
+                                             evictedValue, evictedDirtyBit));
+    CPPUNIT_ASSERT(!cache2_->insertAndRecall(2, "value2", false, evictedKey,
+                                             evictedValue, evictedDirtyBit));
+    CPPUNIT_ASSERT(!cache2_->insertAndRecall(2, "value2", false, evictedKey,
+                                             evictedValue, evictedDirtyBit));
+
+    // Evict the least recently used entry
+    CPPUNIT_ASSERT(cache2_->insertAndRecall(3, "value3", false, evictedKey,
+                                            evictedValue, evictedDirtyBit));
+    CPPUNIT_ASSERT_EQUAL(1, evictedKey);
+    CPPUNIT_ASSERT_EQUAL(string("value1"), evictedValue);
+    CPPUNIT_ASSERT_EQUAL(true, evictedDirtyBit);
+    CPPUNIT_ASSERT_EQUAL(0.0, cache2_->percentDirty());
+
+    // Evicted entries are reused for new insertions
+    for (int i = 4; i < 100; i++)
+    {
+        cache2_->insert(i, "value", 0 == i % 2);
+    }
+    CPPUNIT_ASSERT_EQUAL((size_t)2, cache2_->size());
+    CPPUNIT_ASSERT(cache2_->exists(98));
+    CPPUNIT_ASSERT(cache2_->exists(99));
+    CPPUNIT_ASSERT_EQUAL(0.5, cache2_->percentDirty());
+}
+
+void LRUCacheTest::testFind()
+{
+    CPPUNIT_ASSERT(0 == cache2_->find(1));
+
+    // Find refreshes the LRU ordering, peek does not
+    cache2_->insert(1, "value1");
+    cache2_->insert(2, "value2");
+    CPPUNIT_ASSERT_EQUAL(string("value1"), *cache2_->peek(1));
+    CPPUNIT_ASSERT_EQUAL(1, cache2_->getLRU().first);
+    CPPUNIT_ASSERT_EQUAL(string("value1"), *cache2_->find(1));
+    CPPUNIT_ASSERT_EQUAL(2, cache2_->getLRU().first);
+
+    // Values may be updated in place
+    *cache2_->find(1) = "value1b";
+    CPPUNIT_ASSERT_EQUAL(string("value1b"), cache2_->lookup(1));
+}
+
+/** Filter accepting even keys */
+class EvenKeyFilter : public LRUCache<int, int>::FilterFunctor
+{
+public:
+    virtual bool filter(const int& key, const int& val, bool isDirty) const
+    {
+        return (0 == key % 2);
+    }
+};
+
+void LRUCacheTest::testGetFilteredDirtyEntries()
+{
+    LRUCache<int,int> cache(10);
+    cache.insert(1, 1, true);
+    cache.insert(2, 1, true);
+    cache.insert(3, 1, false);
+    cache.insert(4, 1, false);
+    cache.insert(6, 1, true);
+
+    EvenKeyFilter filter;
+    CPPUNIT_ASSERT_EQUAL((size_t)3, cache.getFilteredEntries(filter).size());
+    set<int> dirty = cache.getFilteredDirtyEntries(filter);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, dirty.size());
+    CPPUNIT_ASSERT(1 == dirty.count(2));
+    CPPUNIT_ASSERT(1 == dirty.count(6));
+
+    // Cleaned entries leave the dirty list
+    cache.setDirtyBit(2, false);
+    cache.remove(6);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, cache.getFilteredDirtyEntries(filter).size());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, cache.getDirtyEntries().size());
 }
 
 #endif
@@ -0,0 +1,340 @@
+#ifndef REPLACEMENT_CACHE_TEST_H
+#define REPLACEMENT_CACHE_TEST_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <cppunit/TestAssert.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "replacement_cache.h"
+using namespace std;
+
+/** Unit test for ReplacementCache and its replacement policies */
+class ReplacementCacheTest : public CppUnit::TestFixture
+{
+    // Create generic unit test and register test functions for automatic
+    // exercise
+    CPPUNIT_TEST_SUITE(ReplacementCacheTest);
+    CPPUNIT_TEST(testConstructor);
+    CPPUNIT_TEST(testInsertAndRecall);
+    CPPUNIT_TEST(testRemove);
+    CPPUNIT_TEST(testGetFilteredEntries);
+    CPPUNIT_TEST(testHitRatio);
+    CPPUNIT_TEST(testLRUPolicy);
+    CPPUNIT_TEST(testARCPolicy);
+    CPPUNIT_TEST(testTwoQueuePolicy);
+    CPPUNIT_TEST(testClockProPolicy);
+    CPPUNIT_TEST(testRandomWorkload);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    /** Called before each test function */
+    virtual void setUp() {};
+
+    /** Called after each test function */
+    virtual void tearDown() {};
+
+    void testConstructor();
+
+    void testInsertAndRecall();
+
+    void testRemove();
+
+    void testGetFilteredEntries();
+
+    void testHitRatio();
+
+    void testLRUPolicy();
+
+    void testARCPolicy();
+
+    void testTwoQueuePolicy();
+
+    void testClockProPolicy();
+
+    void testRandomWorkload();
+
+private:
+
+    /**
+     * Reference the hot keys [0, numHot) three times, separated by
+     * references to half a capacity of other keys, then scan scanLength
+     * keys once
+     *
+     * @return the number of hot keys still cached after the scan
+     */
+    size_t runScan(const string& policy, int capacity,
+                   int numHot, int scanLength);
+};
+
+void ReplacementCacheTest::testConstructor()
+{
+    ReplacementCache<int,int> cache(4, "ARC");
+    CPPUNIT_ASSERT_EQUAL((size_t)4, cache.capacity());
+    CPPUNIT_ASSERT_EQUAL((size_t)0, cache.size());
+    CPPUNIT_ASSERT_EQUAL(string("ARC"), cache.getPolicyName());
+    CPPUNIT_ASSERT_EQUAL((size_t)0, cache.getNumGhostEntries());
+
+    ReplacementCache<int,int> lru(4);
+    CPPUNIT_ASSERT_EQUAL(string("LRU"), lru.getPolicyName());
+}
+
+void ReplacementCacheTest::testInsertAndRecall()
+{
+    const char* policies[] = {"LRU", "ARC", "2Q", "CLOCK-Pro"};
+    for (size_t i = 0; i < 4; i++)
+    {
+        ReplacementCache<int,int> cache(2, policies[i]);
+        int key = -1, value = -1;
+        bool isDirty = false;
+        CPPUNIT_ASSERT(!cache.insertAndRecall(1, 10, true,
+                                              key, value, isDirty));
+        CPPUNIT_ASSERT(!cache.insertAndRecall(2, 20, false,
+                                              key, value, isDirty));
+        CPPUNIT_ASSERT(!cache.insertAndRecall(1, 11, true,
+                                              key, value, isDirty));
+        CPPUNIT_ASSERT_EQUAL(-1, key);
+
+        // Key 1 is either the first in or the dirty victim
+        CPPUNIT_ASSERT(cache.insertAndRecall(3, 30, false,
+                                             key, value, isDirty));
+        CPPUNIT_ASSERT(1 == key || 2 == key);
+        CPPUNIT_ASSERT_EQUAL(key * 10 + (1 == key ? 1 : 0), value);
+        CPPUNIT_ASSERT_EQUAL(1 == key, isDirty);
+        CPPUNIT_ASSERT(!cache.exists(key));
+        CPPUNIT_ASSERT(cache.exists(3));
+        CPPUNIT_ASSERT_EQUAL((size_t)2, cache.size());
+    }
+}
+
+void ReplacementCacheTest::testRemove()
+{
+    const char* policies[] = {"LRU", "ARC", "2Q", "CLOCK-Pro"};
+    for (size_t i = 0; i < 4; i++)
+    {
+        ReplacementCache<int,int> cache(2, policies[i]);
+        cache.insert(1, 1, true);
+        cache.insert(2, 2);
+        cache.remove(1);
+        CPPUNIT_ASSERT(!cache.exists(1));
+        CPPUNIT_ASSERT_EQUAL((size_t)0, cache.getDirtyEntries().size());
+        CPPUNIT_ASSERT_THROW(cache.remove(1), NoSuchEntry);
+
+        // The freed slot is reused without an eviction
+        int key = -1, value = -1;
+        bool isDirty = false;
+        CPPUNIT_ASSERT(!cache.insertAndRecall(3, 3, false,
+                                              key, value, isDirty));
+        CPPUNIT_ASSERT(cache.exists(2));
+        CPPUNIT_ASSERT(cache.exists(3));
+    }
+}
+
+/** Filter accepting even values */
+struct EvenValueFilter : public ReplacementCache<int,int>::FilterFunctor
+{
+    virtual bool filter(const int& key, const int& value, bool isDirty) const
+    {
+        return (0 == value % 2);
+    }
+};
+
+void ReplacementCacheTest::testGetFilteredEntries()
+{
+    const char* policies[] = {"LRU", "ARC", "2Q", "CLOCK-Pro"};
+    for (size_t i = 0; i < 4; i++)
+    {
+        ReplacementCache<int,int> cache(4, policies[i]);
+        cache.insert(1, 10, true);
+        cache.insert(2, 21, true);
+        cache.insert(3, 30);
+
+        // The filter sees the cached values
+        EvenValueFilter filter;
+        set<int> entries = cache.getFilteredEntries(filter);
+        CPPUNIT_ASSERT_EQUAL((size_t)2, entries.size());
+        CPPUNIT_ASSERT_EQUAL((size_t)1, entries.count(1));
+        CPPUNIT_ASSERT_EQUAL((size_t)1, entries.count(3));
+
+        entries = cache.getFilteredDirtyEntries(filter);
+        CPPUNIT_ASSERT_EQUAL((size_t)1, entries.size());
+        CPPUNIT_ASSERT_EQUAL((size_t)1, entries.count(1));
+    }
+}
+
+void ReplacementCacheTest::testHitRatio()
+{
+    ReplacementCache<int,int> cache(2, "2Q");
+    CPPUNIT_ASSERT_EQUAL(0.0, cache.getHitRatio());
+    cache.insert(1, 1);
+    CPPUNIT_ASSERT(0 != cache.find(1));
+    CPPUNIT_ASSERT(0 != cache.find(1));
+    CPPUNIT_ASSERT(0 != cache.find(1));
+    CPPUNIT_ASSERT(0 == cache.find(2));
+    CPPUNIT_ASSERT_THROW(cache.lookup(3), NoSuchEntry);
+    CPPUNIT_ASSERT_EQUAL((size_t)3, cache.getNumHits());
+    CPPUNIT_ASSERT_EQUAL((size_t)2, cache.getNumMisses());
+    CPPUNIT_ASSERT_EQUAL(0.6, cache.getHitRatio());
+
+    // Exists does not count as a reference
+    CPPUNIT_ASSERT(cache.exists(1));
+    CPPUNIT_ASSERT_EQUAL((size_t)3, cache.getNumHits());
+}
+
+void ReplacementCacheTest::testLRUPolicy()
+{
+    CPPUNIT_ASSERT_EQUAL((size_t)0, runScan("LRU", 8, 4, 32));
+
+    ReplacementCache<int,int> cache(2, "LRU");
+    cache.insert(1, 1);
+    cache.insert(2, 2);
+    cache.find(1);
+    cache.insert(3, 3);
+    CPPUNIT_ASSERT(cache.exists(1));
+    CPPUNIT_ASSERT(!cache.exists(2));
+    CPPUNIT_ASSERT_EQUAL((size_t)0, cache.getNumGhostEntries());
+}
+
+void ReplacementCacheTest::testARCPolicy()
+{
+    CPPUNIT_ASSERT_EQUAL((size_t)4, runScan("ARC", 8, 4, 32));
+
+    // A key evicted from T1 is remembered in B1 and readmitted
+    ReplacementCache<int,int> cache(2, "ARC");
+    cache.insert(1, 1);
+    cache.insert(2, 2);
+    cache.find(1);
+    cache.insert(3, 3);
+    CPPUNIT_ASSERT(!cache.exists(2));
+    CPPUNIT_ASSERT_EQUAL((size_t)1, cache.getNumGhostEntries());
+    cache.insert(2, 2);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, cache.getNumGhostHits());
+    CPPUNIT_ASSERT(cache.exists(2));
+}
+
+void ReplacementCacheTest::testTwoQueuePolicy()
+{
+    CPPUNIT_ASSERT_EQUAL((size_t)4, runScan("2Q", 8, 4, 32));
+
+    // A key is promoted to Am only after it returns through A1out
+    ReplacementCache<int,int> cache(4, "2Q");
+    cache.insert(1, 1);
+    cache.insert(2, 2);
+    cache.insert(3, 3);
+    cache.insert(4, 4);
+    cache.insert(5, 5);
+    CPPUNIT_ASSERT(!cache.exists(1));
+    CPPUNIT_ASSERT_EQUAL((size_t)1, cache.getNumGhostEntries());
+    cache.insert(1, 1);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, cache.getNumGhostHits());
+    for (int i = 10; i < 20; i++)
+    {
+        cache.insert(i, i);
+    }
+    CPPUNIT_ASSERT(cache.exists(1));
+}
+
+void ReplacementCacheTest::testClockProPolicy()
+{
+    CPPUNIT_ASSERT_EQUAL((size_t)4, runScan("CLOCK-Pro", 8, 4, 32));
+
+    // Evicted cold keys stay in the clock for their test period
+    ReplacementCache<int,int> cache(2, "CLOCK-Pro");
+    cache.insert(1, 1);
+    cache.insert(2, 2);
+    cache.insert(3, 3);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, cache.size());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, cache.getNumGhostEntries());
+}
+
+void ReplacementCacheTest::testRandomWorkload()
+{
+    const char* policies[] = {"LRU", "ARC", "2Q", "CLOCK-Pro"};
+    for (size_t i = 0; i < 4; i++)
+    {
+        srand(42);
+        ReplacementCache<int,int> cache(16, policies[i]);
+        set<int> resident;
+        for (int j = 0; j < 20000; j++)
+        {
+            int key = rand() % 48;
+            int op = rand() % 8;
+            if (0 == op && cache.exists(key))
+            {
+                cache.remove(key);
+                resident.erase(key);
+            }
+            else if (0 == cache.find(key))
+            {
+                int evictedKey = -1, evictedValue = -1;
+                bool isDirty = false;
+                if (cache.insertAndRecall(key, key, 1 == op,
+                                          evictedKey, evictedValue, isDirty))
+                {
+                    CPPUNIT_ASSERT_EQUAL(evictedKey, evictedValue);
+                    CPPUNIT_ASSERT_EQUAL((size_t)1,
+                                         resident.erase(evictedKey));
+                }
+                resident.insert(key);
+            }
+            CPPUNIT_ASSERT_EQUAL(resident.size(), cache.size());
+            CPPUNIT_ASSERT(cache.getNumGhostEntries() <= 32);
+        }
+        CPPUNIT_ASSERT(0.0 < cache.getHitRatio());
+    }
+}
+
+size_t ReplacementCacheTest::runScan(const string& policy, int capacity,
+                                     int numHot, int scanLength)
+{
+    ReplacementCache<int,int> cache(capacity, policy);
+    int nextKey = 1000;
+    for (int pass = 0; pass < 3; pass++)
+    {
+        for (int i = 0; i < numHot; i++)
+        {
+            if (0 == cache.find(i))
+            {
+                cache.insert(i, i);
+            }
+        }
+        for (int i = 0; i < capacity / 2; i++, nextKey++)
+        {
+            cache.insert(nextKey, nextKey);
+        }
+    }
+    for (int i = 0; i < scanLength; i++, nextKey++)
+    {
+        cache.insert(nextKey, nextKey);
+    }
+
+    size_t numHotCached = 0;
+    for (int i = 0; i < numHot; i++)
+    {
+        if (cache.exists(i))
+        {
+            numHotCached++;
+        }
+    }
+    return numHotCached;
+}
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -14,6 +14,7 @@
 #include "contiguous_data_type_test.h"
 #include "dirty_file_region_set_test.h"
 #include "file_descriptor_test.h"
+#include "file_id_registry_test.h"
 #include "file_page_utils_test.h"
 #include "file_region_set_test.h"
 #include "file_view_test.h"
@@ -23,6 +24,7 @@
 #include "lru_cache_test.h"
 #include "lru_timeout_cache_test.h"
 #include "pfs_utils_test.h"
+#include "replacement_cache_test.h"
 #include "phtf_io_trace_test.h"
 #include "shtf_io_trace_test.h"
 #include "struct_data_type_test.h"
@@ -50,6 +52,7 @@ int main(int argc, char** argv)
     runner.addTest( FileDescriptorTest::suite() );
     runner.addTest( FilePageUtilsTest::suite() );
     runner.addTest( FileRegionSetTest::suite() );
+    runner.addTest( FileIdRegistryTest::suite() );
     runner.addTest( FileViewTest::suite() );
     runner.addTest( FilenameTest::suite() );
     runner.addTest( IPSocketMapTest::suite() );
@@ -57,6 +60,7 @@ int main(int argc, char** argv)
     runner.addTest( LRUCacheTest::suite() );
     runner.addTest( LRUTimeoutCacheTest::suite() );
     runner.addTest( PFSUtilsTest::suite() );
+    runner.addTest( ReplacementCacheTest::suite() );
     //runner.addTest( PHTFIOTraceTest::suite() );
     runner.addTest( SHTFIOTraceTest::suite() );
     runner.addTest( StructDataTypeTest::suite() );
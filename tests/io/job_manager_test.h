@@ -82,7 +82,7 @@ void JobManagerTest::setUp()
     // Create the read request
     readRequest_ = new spfsReadRequest(0, SPFS_READ_REQUEST);
     readRequest_->setOffset(0);
-    readRequest_->setView(view_);
+    readRequest_->setView(*view_);
     readRequest_->setDist(distribution_);
 
     // Create the begin flow request
@@ -90,7 +90,7 @@ void JobManagerTest::setUp()
     flowStart->setContextPointer(readRequest_);
     flowStart->setOffset(0);
     flowStart->setDist(distribution_);
-    flowStart->setView(view_);
+    flowStart->setView(*view_);
 }
 
 void JobManagerTest::tearDown()
@@ -99,6 +99,7 @@ void JobManagerTest::tearDown()
     moduleTester_ = 0;
 
     delete distribution_;
+    delete view_;
     //delete readRequest_;
     //delete flowBegin_;
 }
@@ -37,6 +37,7 @@ class DataTypeLayoutTest : public CppUnit::TestFixture
     CPPUNIT_TEST(testGetRegions);
     CPPUNIT_TEST(testGetLength);
     CPPUNIT_TEST(testGetSubRegions);
+    CPPUNIT_TEST(testGetSubRegionsSequential);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -51,6 +52,7 @@ public:
     void testGetRegions();
     void testGetLength();
     void testGetSubRegions();
+    void testGetSubRegionsSequential();
 
 private:
     vector<FSOffset> offsets_;
@@ -130,6 +132,44 @@ void DataTypeLayoutTest::testGetSubRegions()
     CPPUNIT_ASSERT_EQUAL(FSSize(4096), subRegions[0].extent);
 }
 
+void DataTypeLayoutTest::testGetSubRegionsSequential()
+{
+    DataTypeLayout dtl(offsets_, extents_);
+    vector<FileRegion> subRegions;
+
+    // Slice the layout into consecutive 15 byte buffers
+    dtl.getSubRegions(0, 15, subRegions);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, subRegions.size());
+    CPPUNIT_ASSERT_EQUAL(FSOffset(12), subRegions[0].offset);
+    CPPUNIT_ASSERT_EQUAL(FSSize(10), subRegions[0].extent);
+    CPPUNIT_ASSERT_EQUAL(FSOffset(130), subRegions[1].offset);
+    CPPUNIT_ASSERT_EQUAL(FSSize(5), subRegions[1].extent);
+
+    dtl.getSubRegions(15, 15, subRegions);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, subRegions.size());
+    CPPUNIT_ASSERT_EQUAL(FSOffset(135), subRegions[0].offset);
+    CPPUNIT_ASSERT_EQUAL(FSSize(15), subRegions[0].extent);
+
+    dtl.getSubRegions(30, 15, subRegions);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, subRegions.size());
+    CPPUNIT_ASSERT_EQUAL(FSOffset(150), subRegions[0].offset);
+    CPPUNIT_ASSERT_EQUAL(FSSize(15), subRegions[0].extent);
+
+    // A request in the middle of a region must not extend past it
+    dtl.getSubRegions(5, 10, subRegions);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, subRegions.size());
+    CPPUNIT_ASSERT_EQUAL(FSOffset(17), subRegions[0].offset);
+    CPPUNIT_ASSERT_EQUAL(FSSize(5), subRegions[0].extent);
+    CPPUNIT_ASSERT_EQUAL(FSOffset(130), subRegions[1].offset);
+    CPPUNIT_ASSERT_EQUAL(FSSize(5), subRegions[1].extent);
+
+    // Seek backwards into a later region
+    dtl.getSubRegions(60, 10, subRegions);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, subRegions.size());
+    CPPUNIT_ASSERT_EQUAL(FSOffset(180), subRegions[0].offset);
+    CPPUNIT_ASSERT_EQUAL(FSSize(10), subRegions[0].extent);
+}
+
 #endif
 
 /*
@@ -35,6 +35,59 @@
 #include "subarray_data_type.h"
 using namespace std;
 
+/** Simple striping that forces the generic strip by strip mapping */
+class GenericStripeDistribution : public FileDistribution
+{
+public:
+    /** Constructor */
+    GenericStripeDistribution(std::size_t objectIdx,
+                              std::size_t numObjects,
+                              FSSize stripSize)
+        : FileDistribution(objectIdx, numObjects),
+          stripe_(objectIdx, numObjects, stripSize) {};
+
+private:
+    virtual FileDistribution* doClone() const
+    {
+        return new GenericStripeDistribution(*this);
+    };
+
+    virtual FSSize getContiguousLength(std::size_t objectIdx,
+                                       FSOffset physicalOffset) const
+    {
+        stripe_.setObjectIdx(objectIdx);
+        return stripe_.contiguousLength(physicalOffset);
+    };
+
+    virtual FSSize getLogicalFileSize() const
+    {
+        return stripe_.logicalFileSize();
+    };
+
+    virtual FSOffset getNextMappedLogicalOffset(std::size_t objectIdx,
+                                                FSOffset logicalOffset) const
+    {
+        stripe_.setObjectIdx(objectIdx);
+        return stripe_.nextMappedLogicalOffset(logicalOffset);
+    };
+
+    virtual FSOffset convertLogicalToPhysicalOffset(
+        std::size_t objectIdx, FSOffset logicalOffset) const
+    {
+        stripe_.setObjectIdx(objectIdx);
+        return stripe_.logicalToPhysicalOffset(logicalOffset);
+    };
+
+    virtual FSOffset convertPhysicalToLogicalOffset(
+        std::size_t objectIdx, FSOffset physicalOffset) const
+    {
+        stripe_.setObjectIdx(objectIdx);
+        return stripe_.physicalToLogicalOffset(physicalOffset);
+    };
+
+    mutable SimpleStripeDistribution stripe_;
+};
+
 /** Unit test for DataTypeProcessor */
 class DataTypeProcessorTest : public CppUnit::TestFixture
 {
@@ -42,11 +95,13 @@ class DataTypeProcessorTest : public CppUnit::TestFixture
     // exercise
     CPPUNIT_TEST_SUITE(DataTypeProcessorTest);
     CPPUNIT_TEST(testCreateClientFileLayoutForWrite);
+    CPPUNIT_TEST(testCreateClientFileLayouts);
     CPPUNIT_TEST(testCreateServerFileLayoutForRead);
     CPPUNIT_TEST(testCreateServerFileLayoutForWrite);
     CPPUNIT_TEST(test512kFileLayoutForServer);
     CPPUNIT_TEST(testTileIO);
     CPPUNIT_TEST(testCreateServerFileLayoutSubarray);
+    CPPUNIT_TEST(testSimpleStripeMatchesGeneric);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -57,11 +112,13 @@ public:
     virtual void tearDown();
 
     void testCreateClientFileLayoutForWrite();
+    void testCreateClientFileLayouts();
     void testCreateServerFileLayoutForRead();
     void testCreateServerFileLayoutForWrite();
     void test512kFileLayoutForServer();
     void testTileIO();
     void testCreateServerFileLayoutSubarray();
+    void testSimpleStripeMatchesGeneric();
 };
 
 void DataTypeProcessorTest::setUp()
@@ -113,6 +170,53 @@ void DataTypeProcessorTest::testCreateClientFileLayoutForWrite()
     CPPUNIT_ASSERT_EQUAL(FSSize(8000), aggSize4);
 }
 
+void DataTypeProcessorTest::testCreateClientFileLayouts()
+{
+    ByteDataType byteType;
+    ContiguousDataType elementType(8, byteType);
+
+    // Tile I/O view for process 1
+    size_t sizes[] = {1000, 80};
+    size_t subSizes[] = {1000, 10};
+    size_t starts[] = {0, 10};
+    SubarrayDataType* subarray = new SubarrayDataType(vector<size_t>(sizes, sizes + 2),
+                                                      vector<size_t>(subSizes, subSizes + 2),
+                                                      vector<size_t>(starts, starts + 2),
+                                                      SubarrayDataType::C_ORDER, elementType);
+    FileView subarrayView(0, subarray);
+
+    // Bstream sizes that limit some of the reads
+    vector<FSSize> bstreamSizes;
+    bstreamSizes.push_back(100000);
+    bstreamSizes.push_back(0);
+    bstreamSizes.push_back(1000000);
+    bstreamSizes.push_back(4000);
+
+    // Each summary must match processing the view for each server in turn
+    SimpleStripeDistribution dist(0, 4, 1000);
+    vector<DataTypeProcessor::ServerLayoutSummary> summaries;
+    FSSize aggSize = DataTypeProcessor::createClientFileLayouts(
+        16, byteType, 50000, subarrayView, dist, bstreamSizes, summaries);
+    CPPUNIT_ASSERT_EQUAL(FSSize(50000), aggSize);
+    CPPUNIT_ASSERT_EQUAL(size_t(4), summaries.size());
+    for (size_t i = 0; i < summaries.size(); i++)
+    {
+        SimpleStripeDistribution serverDist(i, 4, 1000);
+        FSSize writeAggSize = 0;
+        FSSize writeBytes = DataTypeProcessor::createClientFileLayoutForWrite(
+            16, byteType, 50000, subarrayView, serverDist, writeAggSize);
+        FSSize readAggSize = 0;
+        FSSize readBytes = DataTypeProcessor::createClientFileLayoutForRead(
+            16, byteType, 50000, subarrayView, serverDist, bstreamSizes[i],
+            readAggSize);
+        CPPUNIT_ASSERT_EQUAL(writeBytes, summaries[i].writeBytes);
+        CPPUNIT_ASSERT_EQUAL(readBytes, summaries[i].readBytes);
+        CPPUNIT_ASSERT_EQUAL(writeAggSize, aggSize);
+    }
+    CPPUNIT_ASSERT_EQUAL(FSSize(0), summaries[1].readBytes);
+    CPPUNIT_ASSERT(0 != summaries[1].writeBytes);
+}
+
 void DataTypeProcessorTest::testCreateServerFileLayoutForRead()
 {
     SimpleStripeDistribution dist0(0, 1, 100000);
@@ -301,6 +405,128 @@ void DataTypeProcessorTest::testCreateServerFileLayoutSubarray()
 
 }
 
+void DataTypeProcessorTest::testSimpleStripeMatchesGeneric()
+{
+    ByteDataType byteType;
+    ContiguousDataType elementType(8, byteType);
+
+    // A contiguous view and a strided tile I/O view
+    FileView byteView(0, byteType.clone());
+    size_t sizes[] = {100, 80};
+    size_t subSizes[] = {100, 10};
+    size_t starts[] = {0, 10};
+    SubarrayDataType* subarray = new SubarrayDataType(vector<size_t>(sizes, sizes + 2),
+                                                      vector<size_t>(subSizes, subSizes + 2),
+                                                      vector<size_t>(starts, starts + 2),
+                                                      SubarrayDataType::C_ORDER, elementType);
+    FileView subarrayView(24, subarray);
+    FileView* views[] = {&byteView, &subarrayView};
+
+    FSOffset offsets[] = {0, 1, 999, 1000, 4321};
+    FSSize sizesInBytes[] = {1, 100, 1000, 7777, 64000};
+    size_t numObjects[] = {1, 3, 4};
+    FSSize stripSizes[] = {64, 1000};
+    FSSize bstreamSizes[] = {0, 500, 6000, 1000000};
+    for (size_t v = 0; v < 2; v++)
+    {
+        for (size_t o = 0; o < 5; o++)
+        {
+            for (size_t s = 0; s < 5; s++)
+            {
+                for (size_t n = 0; n < 3; n++)
+                {
+                    for (size_t ss = 0; ss < 2; ss++)
+                    {
+                        // Server layouts must be identical for each object
+                        for (size_t i = 0; i < numObjects[n]; i++)
+                        {
+                            SimpleStripeDistribution stripeDist(
+                                i, numObjects[n], stripSizes[ss]);
+                            GenericStripeDistribution genericDist(
+                                i, numObjects[n], stripSizes[ss]);
+                            DataTypeLayout stripeWrite, genericWrite;
+                            DataTypeProcessor::createServerFileLayoutForWrite(
+                                offsets[o], sizesInBytes[s], *views[v],
+                                stripeDist, stripeWrite);
+                            DataTypeProcessor::createServerFileLayoutForWrite(
+                                offsets[o], sizesInBytes[s], *views[v],
+                                genericDist, genericWrite);
+                            vector<FileRegion> stripeRegions =
+                                stripeWrite.getRegions();
+                            vector<FileRegion> genericRegions =
+                                genericWrite.getRegions();
+                            CPPUNIT_ASSERT_EQUAL(genericRegions.size(),
+                                                 stripeRegions.size());
+                            for (size_t j = 0; j < stripeRegions.size(); j++)
+                            {
+                                CPPUNIT_ASSERT_EQUAL(genericRegions[j].offset,
+                                                     stripeRegions[j].offset);
+                                CPPUNIT_ASSERT_EQUAL(genericRegions[j].extent,
+                                                     stripeRegions[j].extent);
+                            }
+
+                            for (size_t b = 0; b < 4; b++)
+                            {
+                                DataTypeLayout stripeRead, genericRead;
+                                DataTypeProcessor::createServerFileLayoutForRead(
+                                    offsets[o], sizesInBytes[s], *views[v],
+                                    stripeDist, bstreamSizes[b], stripeRead);
+                                DataTypeProcessor::createServerFileLayoutForRead(
+                                    offsets[o], sizesInBytes[s], *views[v],
+                                    genericDist, bstreamSizes[b], genericRead);
+                                stripeRegions = stripeRead.getRegions();
+                                genericRegions = genericRead.getRegions();
+                                CPPUNIT_ASSERT_EQUAL(genericRegions.size(),
+                                                     stripeRegions.size());
+                                for (size_t j = 0; j < stripeRegions.size(); j++)
+                                {
+                                    CPPUNIT_ASSERT_EQUAL(
+                                        genericRegions[j].offset,
+                                        stripeRegions[j].offset);
+                                    CPPUNIT_ASSERT_EQUAL(
+                                        genericRegions[j].extent,
+                                        stripeRegions[j].extent);
+                                }
+                            }
+                        }
+
+                        // Per server byte counts must be identical
+                        for (size_t b = 0; b < 4; b++)
+                        {
+                            vector<FSSize> objectSizes(numObjects[n],
+                                                       bstreamSizes[b]);
+                            objectSizes[0] = bstreamSizes[3 - b];
+                            SimpleStripeDistribution stripeDist(
+                                0, numObjects[n], stripSizes[ss]);
+                            GenericStripeDistribution genericDist(
+                                0, numObjects[n], stripSizes[ss]);
+                            vector<DataTypeProcessor::ServerLayoutSummary>
+                                stripeSummaries, genericSummaries;
+                            DataTypeProcessor::createClientFileLayouts(
+                                offsets[o], byteType, sizesInBytes[s],
+                                *views[v], stripeDist, objectSizes,
+                                stripeSummaries);
+                            DataTypeProcessor::createClientFileLayouts(
+                                offsets[o], byteType, sizesInBytes[s],
+                                *views[v], genericDist, objectSizes,
+                                genericSummaries);
+                            for (size_t i = 0; i < numObjects[n]; i++)
+                            {
+                                CPPUNIT_ASSERT_EQUAL(
+                                    genericSummaries[i].writeBytes,
+                                    stripeSummaries[i].writeBytes);
+                                CPPUNIT_ASSERT_EQUAL(
+                                    genericSummaries[i].readBytes,
+                                    stripeSummaries[i].readBytes);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
 #endif
 
 /*
@@ -38,6 +38,7 @@ class SimpleStripeDistributionTest : public CppUnit::TestFixture
     CPPUNIT_TEST(testPhysicalToLogicalOffset);
     CPPUNIT_TEST(testContiguousLength);
     CPPUNIT_TEST(testLogicalFileSize);
+    CPPUNIT_TEST(testGetObjectDistribution);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -52,6 +53,7 @@ public:
     void testPhysicalToLogicalOffset();
     void testContiguousLength();
     void testLogicalFileSize();
+    void testGetObjectDistribution();
 };
 
 void SimpleStripeDistributionTest::setUp()
@@ -258,6 +260,20 @@ void SimpleStripeDistributionTest::testLogicalFileSize()
 {
 }
 
+void SimpleStripeDistributionTest::testGetObjectDistribution()
+{
+    SimpleStripeDistribution dist(0, 4, 1000);
+    const FileDistribution* object2 = dist.getObjectDistribution(2);
+    CPPUNIT_ASSERT_EQUAL(2, object2->getObjectIdx());
+    CPPUNIT_ASSERT_EQUAL(4, object2->getNumObjects());
+    CPPUNIT_ASSERT_EQUAL(FSOffset(1500), object2->logicalToPhysicalOffset(6500));
+
+    // Each object's distribution is created once and shared
+    CPPUNIT_ASSERT(object2 == dist.getObjectDistribution(2));
+    CPPUNIT_ASSERT(object2 != dist.getObjectDistribution(1));
+    CPPUNIT_ASSERT_EQUAL(0, dist.getObjectIdx());
+}
+
 #endif
 
 /*
@@ -0,0 +1,107 @@
+#ifndef BLOCK_LIST_PLANNER_TEST_H
+#define BLOCK_LIST_PLANNER_TEST_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <vector>
+#include <cppunit/extensions/HelperMacros.h>
+#include "basic_types.h"
+#include "block_list_planner.h"
+using namespace std;
+
+/** Unit test for BlockListPlanner */
+class BlockListPlannerTest : public CppUnit::TestFixture
+{
+    // Create unit test and register test functions for automatic
+    // exercise
+    CPPUNIT_TEST_SUITE(BlockListPlannerTest);
+    CPPUNIT_TEST(testConstructor);
+    CPPUNIT_TEST(testGetMergeRatio);
+    CPPUNIT_TEST(testGetPartialBlockRegions);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    /** Called before each test function */
+    virtual void setUp() {};
+
+    /** Called after each test function */
+    virtual void tearDown() {};
+
+    void testConstructor();
+    void testGetMergeRatio();
+    void testGetPartialBlockRegions();
+};
+
+void BlockListPlannerTest::testConstructor()
+{
+    // Blocks from overlapping strided regions
+    FSBlock requested[] = {7, 3, 4, 4, 5, 3, 9, 7};
+    vector<FSBlock> blocks(requested, requested + 8);
+    BlockListPlanner plan(blocks);
+
+    vector<FSBlock> planned = plan.getBlocks();
+    CPPUNIT_ASSERT_EQUAL((size_t)5, planned.size());
+    CPPUNIT_ASSERT_EQUAL((FSBlock)3, planned[0]);
+    CPPUNIT_ASSERT_EQUAL((FSBlock)4, planned[1]);
+    CPPUNIT_ASSERT_EQUAL((FSBlock)5, planned[2]);
+    CPPUNIT_ASSERT_EQUAL((FSBlock)7, planned[3]);
+    CPPUNIT_ASSERT_EQUAL((FSBlock)9, planned[4]);
+    CPPUNIT_ASSERT_EQUAL((size_t)8, plan.getNumRequestedBlocks());
+    CPPUNIT_ASSERT_EQUAL((size_t)3, plan.getNumRuns());
+}
+
+void BlockListPlannerTest::testGetMergeRatio()
+{
+    BlockListPlanner empty((vector<FSBlock>()));
+    CPPUNIT_ASSERT_EQUAL(0.0, empty.getMergeRatio());
+
+    FSBlock requested[] = {2, 0, 1, 1, 6, 5};
+    BlockListPlanner plan(vector<FSBlock>(requested, requested + 6));
+    CPPUNIT_ASSERT_EQUAL((size_t)2, plan.getNumRuns());
+    CPPUNIT_ASSERT_EQUAL(3.0, plan.getMergeRatio());
+}
+
+void BlockListPlannerTest::testGetPartialBlockRegions()
+{
+    // Regions covering [12, 268), [268, 512) and [600, 1024) of 256 byte
+    // blocks only partially cover blocks 0 and 2
+    FileRegion r[] = {{600, 424}, {268, 244}, {12, 256}};
+    vector<FileRegion> regions(r, r + 3);
+    vector<FileRegion> partial =
+        BlockListPlanner::getPartialBlockRegions(regions, 256);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, partial.size());
+    CPPUNIT_ASSERT_EQUAL((FSOffset)0, partial[0].offset);
+    CPPUNIT_ASSERT_EQUAL((FSSize)256, partial[0].extent);
+    CPPUNIT_ASSERT_EQUAL((FSOffset)512, partial[1].offset);
+    CPPUNIT_ASSERT_EQUAL((FSSize)256, partial[1].extent);
+
+    // A region within a single block
+    FileRegion single = {300, 10};
+    partial = BlockListPlanner::getPartialBlockRegions(
+        vector<FileRegion>(1, single), 256);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, partial.size());
+    CPPUNIT_ASSERT_EQUAL((FSOffset)256, partial[0].offset);
+
+    // Block aligned regions
+    FileRegion aligned = {512, 1024};
+    partial = BlockListPlanner::getPartialBlockRegions(
+        vector<FileRegion>(1, aligned), 256);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, partial.size());
+}
+
+#endif
+
+/*
+ * Local variables:
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
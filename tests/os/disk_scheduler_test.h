@@ -0,0 +1,167 @@
+#ifndef DISK_SCHEDULER_TEST_H
+#define DISK_SCHEDULER_TEST_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <vector>
+#include <cppunit/extensions/HelperMacros.h>
+#include "basic_types.h"
+#include "disk_scheduler.h"
+using namespace std;
+
+/** Unit test for SchedulerQueue */
+class SchedulerQueueTest : public CppUnit::TestFixture
+{
+    // Create unit test and register test functions for automatic
+    // exercise
+    CPPUNIT_TEST_SUITE(SchedulerQueueTest);
+    CPPUNIT_TEST(testFront);
+    CPPUNIT_TEST(testSuccessorPredecessor);
+    CPPUNIT_TEST(testNearest);
+    CPPUNIT_TEST(testExtractCovered);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    /** Called before each test function */
+    void setUp();
+
+    /** Called after each test function */
+    void tearDown();
+
+    void testFront();
+    void testSuccessorPredecessor();
+    void testNearest();
+    void testExtractCovered();
+
+private:
+
+    /** Add an entry to the test queue */
+    SchedulerEntry* addEntry(LogicalBlockAddress lba, long extent, bool isRead);
+
+    SchedulerQueue* queue_;
+
+    vector<SchedulerEntry*> entries_;
+};
+
+void SchedulerQueueTest::setUp()
+{
+    queue_ = new SchedulerQueue();
+}
+
+void SchedulerQueueTest::tearDown()
+{
+    for (size_t i = 0; i < entries_.size(); i++)
+    {
+        delete entries_[i];
+    }
+    entries_.clear();
+    delete queue_;
+    queue_ = 0;
+}
+
+SchedulerEntry* SchedulerQueueTest::addEntry(LogicalBlockAddress lba,
+                                             long extent,
+                                             bool isRead)
+{
+    SchedulerEntry* entry = new SchedulerEntry();
+    entry->lba = lba;
+    entry->extent = extent;
+    entry->request = 0;
+    entry->isReadRequest = isRead;
+    entries_.push_back(entry);
+    queue_->insert(entry);
+    return entry;
+}
+
+void SchedulerQueueTest::testFront()
+{
+    CPPUNIT_ASSERT(queue_->empty());
+    CPPUNIT_ASSERT(0 == queue_->front());
+
+    SchedulerEntry* e1 = addEntry(50, 1, true);
+    SchedulerEntry* e2 = addEntry(10, 1, true);
+    SchedulerEntry* e3 = addEntry(30, 1, false);
+    CPPUNIT_ASSERT_EQUAL((size_t)3, queue_->size());
+
+    // Front is the oldest entry regardless of address
+    CPPUNIT_ASSERT(e1 == queue_->front());
+    queue_->remove(e1);
+    CPPUNIT_ASSERT(e2 == queue_->front());
+    CPPUNIT_ASSERT(e2 == queue_->lowest());
+    CPPUNIT_ASSERT(e3 == queue_->highest());
+    queue_->remove(e2);
+    queue_->remove(e3);
+    CPPUNIT_ASSERT(queue_->empty());
+}
+
+void SchedulerQueueTest::testSuccessorPredecessor()
+{
+    SchedulerEntry* e1 = addEntry(10, 1, true);
+    SchedulerEntry* e2 = addEntry(20, 1, true);
+    SchedulerEntry* e3 = addEntry(30, 1, true);
+
+    CPPUNIT_ASSERT(e1 == queue_->successor(0));
+    CPPUNIT_ASSERT(e2 == queue_->successor(20));
+    CPPUNIT_ASSERT(e3 == queue_->successor(21));
+    CPPUNIT_ASSERT(0 == queue_->successor(31));
+
+    CPPUNIT_ASSERT(0 == queue_->predecessor(9));
+    CPPUNIT_ASSERT(e1 == queue_->predecessor(19));
+    CPPUNIT_ASSERT(e2 == queue_->predecessor(20));
+    CPPUNIT_ASSERT(e3 == queue_->predecessor(100));
+}
+
+void SchedulerQueueTest::testNearest()
+{
+    CPPUNIT_ASSERT(0 == queue_->nearest(10));
+
+    SchedulerEntry* e1 = addEntry(10, 1, true);
+    SchedulerEntry* e2 = addEntry(20, 1, true);
+    CPPUNIT_ASSERT(e1 == queue_->nearest(0));
+    CPPUNIT_ASSERT(e1 == queue_->nearest(14));
+    CPPUNIT_ASSERT(e2 == queue_->nearest(16));
+    CPPUNIT_ASSERT(e2 == queue_->nearest(100));
+
+    // Ties are broken toward the higher address
+    CPPUNIT_ASSERT(e2 == queue_->nearest(15));
+}
+
+void SchedulerQueueTest::testExtractCovered()
+{
+    SchedulerEntry* e1 = addEntry(10, 4, true);
+    SchedulerEntry* e2 = addEntry(12, 2, false);
+    SchedulerEntry* e3 = addEntry(12, 4, true);
+    SchedulerEntry* e4 = addEntry(8, 4, true);
+
+    // A read only completes reads it covers
+    vector<SchedulerEntry*> completed = queue_->extractCovered(10, 4, true);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, completed.size());
+    CPPUNIT_ASSERT(e1 == completed[0]);
+    CPPUNIT_ASSERT_EQUAL((size_t)3, queue_->size());
+
+    // A write completes reads and writes it covers
+    completed = queue_->extractCovered(8, 8, false);
+    CPPUNIT_ASSERT_EQUAL((size_t)3, completed.size());
+    CPPUNIT_ASSERT(e4 == completed[0]);
+    CPPUNIT_ASSERT(e2 == completed[1] || e2 == completed[2]);
+    CPPUNIT_ASSERT(e3 == completed[1] || e3 == completed[2]);
+    CPPUNIT_ASSERT(queue_->empty());
+    CPPUNIT_ASSERT(0 == queue_->front());
+}
+
+#endif
+
+/*
+ * Local variables:
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
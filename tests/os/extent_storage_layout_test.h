@@ -0,0 +1,183 @@
+#ifndef EXTENT_STORAGE_LAYOUT_TEST_H
+#define EXTENT_STORAGE_LAYOUT_TEST_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <vector>
+#include <cppunit/extensions/HelperMacros.h>
+#include "basic_types.h"
+#include "extent_storage_layout.h"
+using namespace std;
+
+/** Unit test for ExtentStorageLayout */
+class ExtentStorageLayoutTest : public CppUnit::TestFixture
+{
+    // Create unit test and register test functions for automatic
+    // exercise
+    CPPUNIT_TEST_SUITE(ExtentStorageLayoutTest);
+    CPPUNIT_TEST(testAddDirectory);
+    CPPUNIT_TEST(testAddFile);
+    CPPUNIT_TEST(testAppend);
+    CPPUNIT_TEST(testInterleavedAppends);
+    CPPUNIT_TEST(testUnallocatedBlocks);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    /** Called before each test function */
+    void setUp();
+
+    /** Called after each test function */
+    void tearDown();
+
+    void testAddDirectory();
+    void testAddFile();
+    void testAppend();
+    void testInterleavedAppends();
+    void testUnallocatedBlocks();
+
+private:
+
+    /** @return a vector holding the single region */
+    static vector<FileRegion> region(FSOffset offset, FSSize extent);
+
+    ExtentStorageLayout* layout_;
+
+    FileId rootId_;
+};
+
+void ExtentStorageLayoutTest::setUp()
+{
+    // 256 byte blocks, 4 groups of 1024 blocks, and 8 block reservations
+    layout_ = new ExtentStorageLayout(256, 1024, 4, 8);
+    rootId_ = layout_->addDirectory(Filename("/"));
+}
+
+void ExtentStorageLayoutTest::tearDown()
+{
+    delete layout_;
+    layout_ = 0;
+}
+
+vector<FileRegion> ExtentStorageLayoutTest::region(FSOffset offset,
+                                                   FSSize extent)
+{
+    FileRegion fr = {offset, extent};
+    return vector<FileRegion>(1, fr);
+}
+
+void ExtentStorageLayoutTest::testAddDirectory()
+{
+    // The root directory's data follows the first group's inode table
+    vector<FSBlock> blocks = layout_->getFileMetaDataBlocks(rootId_);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, blocks.size());
+    CPPUNIT_ASSERT_EQUAL((FSBlock)0, blocks[0]);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, layout_->getNumExtents(rootId_));
+    CPPUNIT_ASSERT_EQUAL((FSSize)(4 * 960 - 10), layout_->getNumFreeBlocks());
+
+    // The next directory is placed in the next group
+    Filename dir("/dir");
+    FileId dirId = layout_->addDirectory(dir);
+    blocks = layout_->getFileMetaDataBlocks(dirId);
+    CPPUNIT_ASSERT_EQUAL((FSBlock)1024, blocks[0]);
+    blocks = layout_->getFileDataBlocks(dirId, 0, 256);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, blocks.size());
+    CPPUNIT_ASSERT_EQUAL((FSBlock)1088, blocks[0]);
+}
+
+void ExtentStorageLayoutTest::testAddFile()
+{
+    Filename f1("/1");
+    FileId f1Id = layout_->addFile(f1, 1024);
+    vector<FSBlock> blocks = layout_->getFileMetaDataBlocks(f1Id);
+    CPPUNIT_ASSERT_EQUAL((FSBlock)1, blocks[0]);
+
+    // The file's data is contiguous and the remaining window is reserved
+    blocks = layout_->getFileDataBlocks(f1Id, 0, 1024);
+    CPPUNIT_ASSERT_EQUAL((size_t)4, blocks.size());
+    CPPUNIT_ASSERT_EQUAL((FSBlock)74, blocks[0]);
+    CPPUNIT_ASSERT_EQUAL((FSBlock)75, blocks[1]);
+    CPPUNIT_ASSERT_EQUAL((FSBlock)76, blocks[2]);
+    CPPUNIT_ASSERT_EQUAL((FSBlock)77, blocks[3]);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, layout_->getNumExtents(f1Id));
+    CPPUNIT_ASSERT_EQUAL((FSSize)(4 * 960 - 18), layout_->getNumFreeBlocks());
+}
+
+void ExtentStorageLayoutTest::testAppend()
+{
+    Filename f1("/1");
+    FileId f1Id = layout_->addFile(f1, 1024);
+
+    // Appends are allocated from the reservation and extend the extent
+    vector<FSBlock> blocks =
+        layout_->allocateFileDataBlocks(f1Id, region(1024, 512));
+    CPPUNIT_ASSERT_EQUAL((size_t)2, blocks.size());
+    CPPUNIT_ASSERT_EQUAL((FSBlock)78, blocks[0]);
+    CPPUNIT_ASSERT_EQUAL((FSBlock)79, blocks[1]);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, layout_->getNumExtents(f1Id));
+
+    // Rewriting allocated blocks does not allocate
+    blocks = layout_->allocateFileDataBlocks(f1Id, region(0, 1536));
+    CPPUNIT_ASSERT_EQUAL((size_t)6, blocks.size());
+    CPPUNIT_ASSERT_EQUAL((FSBlock)74, blocks[0]);
+    CPPUNIT_ASSERT_EQUAL((FSBlock)79, blocks[5]);
+    CPPUNIT_ASSERT_EQUAL((FSSize)(4 * 960 - 18), layout_->getNumFreeBlocks());
+}
+
+void ExtentStorageLayoutTest::testInterleavedAppends()
+{
+    Filename f1("/1");
+    Filename f2("/2");
+    FileId f1Id = layout_->addFile(f1, 1024);
+    FileId f2Id = layout_->addFile(f2, 0);
+
+    // The second file reserves the blocks following the first's window
+    vector<FSBlock> blocks =
+        layout_->allocateFileDataBlocks(f2Id, region(0, 256));
+    CPPUNIT_ASSERT_EQUAL((size_t)1, blocks.size());
+    CPPUNIT_ASSERT_EQUAL((FSBlock)82, blocks[0]);
+
+    // Exhausting the first file's window begins a new extent
+    blocks = layout_->allocateFileDataBlocks(f1Id, region(1024, 1536));
+    CPPUNIT_ASSERT_EQUAL((size_t)6, blocks.size());
+    CPPUNIT_ASSERT_EQUAL((FSBlock)78, blocks[0]);
+    CPPUNIT_ASSERT_EQUAL((FSBlock)81, blocks[3]);
+    CPPUNIT_ASSERT_EQUAL((FSBlock)90, blocks[4]);
+    CPPUNIT_ASSERT_EQUAL((FSBlock)91, blocks[5]);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, layout_->getNumExtents(f1Id));
+    CPPUNIT_ASSERT_EQUAL((size_t)1, layout_->getNumExtents(f2Id));
+}
+
+void ExtentStorageLayoutTest::testUnallocatedBlocks()
+{
+    Filename f1("/1");
+    FileId f1Id = layout_->addFile(f1, 0);
+
+    // Only the written block of a sparse file is mapped
+    layout_->allocateFileDataBlocks(f1Id, region(2560, 256));
+    vector<FSBlock> blocks = layout_->getFileDataBlocks(f1Id, 0, 2816);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, blocks.size());
+    CPPUNIT_ASSERT_EQUAL((FSBlock)74, blocks[0]);
+
+    // Filling the hole continues from the reservation
+    blocks = layout_->allocateFileDataBlocks(f1Id, region(0, 256));
+    CPPUNIT_ASSERT_EQUAL((size_t)1, blocks.size());
+    CPPUNIT_ASSERT_EQUAL((FSBlock)75, blocks[0]);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, layout_->getNumExtents(f1Id));
+}
+
+#endif
+
+/*
+ * Local variables:
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
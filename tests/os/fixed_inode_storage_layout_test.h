@@ -44,8 +44,8 @@ void FixedINodeStorageLayoutTest::testAddDirectory()
 {
     FixedINodeStorageLayout layout(256);
     Filename f1("/1");
-    layout.addDirectory(f1);
-    vector<FSBlock> blocks = layout.getFileMetaDataBlocks(f1);
+    FileId f1Id = layout.addDirectory(f1);
+    vector<FSBlock> blocks = layout.getFileMetaDataBlocks(f1Id);
     CPPUNIT_ASSERT_EQUAL((size_t)1, blocks.size());
     CPPUNIT_ASSERT_EQUAL((FSBlock)0, blocks[0]);
 }
@@ -54,13 +54,13 @@ void FixedINodeStorageLayoutTest::testAddFile()
 {
     FixedINodeStorageLayout layout(256);
     Filename f1("/1");
-    layout.addFile(f1, 1024);
-    vector<FSBlock> blocks = layout.getFileMetaDataBlocks(f1);
+    FileId f1Id = layout.addFile(f1, 1024);
+    vector<FSBlock> blocks = layout.getFileMetaDataBlocks(f1Id);
     CPPUNIT_ASSERT_EQUAL((size_t)1, blocks.size());
     CPPUNIT_ASSERT_EQUAL((FSBlock)0, blocks[0]);
 
     // Data blocks start at block 1000
-    blocks = layout.getFileDataBlocks(f1, 0, 1024);
+    blocks = layout.getFileDataBlocks(f1Id, 0, 1024);
     CPPUNIT_ASSERT_EQUAL((size_t)4, blocks.size());
     CPPUNIT_ASSERT_EQUAL((FSBlock)1000, blocks[0]);
     CPPUNIT_ASSERT_EQUAL((FSBlock)1001, blocks[1]);
@@ -74,16 +74,16 @@ void FixedINodeStorageLayoutTest::testGetFileMetaDataBlocks()
 
     // Create a directory to test
     Filename f1("/1");
-    layout.addDirectory(f1);    
-    vector<FSBlock> blocks1 = layout.getFileMetaDataBlocks(f1);
+    FileId f1Id = layout.addDirectory(f1);    
+    vector<FSBlock> blocks1 = layout.getFileMetaDataBlocks(f1Id);
     CPPUNIT_ASSERT_EQUAL((size_t)1, blocks1.size());
     CPPUNIT_ASSERT_EQUAL((FSBlock)0, blocks1[0]);
 
     
     // Create a file to test
     Filename f2("/2");
-    layout.addFile(f2, 0);
-    vector<FSBlock> blocks2 = layout.getFileMetaDataBlocks(f2);
+    FileId f2Id = layout.addFile(f2, 0);
+    vector<FSBlock> blocks2 = layout.getFileMetaDataBlocks(f2Id);
     CPPUNIT_ASSERT_EQUAL((size_t)1, blocks2.size());
     CPPUNIT_ASSERT_EQUAL((FSBlock)1, blocks2[0]);
 }
@@ -95,29 +95,29 @@ void FixedINodeStorageLayoutTest::testGetFileDataBlocks()
     
     // Create a file to test
     Filename f1("/1");
-    layout.addFile(f1, 2048);
+    FileId f1Id = layout.addFile(f1, 2048);
 
     // Test retrieving no blocks
-    blocks = layout.getFileDataBlocks(f1, 0, 0);
+    blocks = layout.getFileDataBlocks(f1Id, 0, 0);
     CPPUNIT_ASSERT_EQUAL((size_t)0, blocks.size());
 
     // Test retrieving entire first block
-    blocks = layout.getFileDataBlocks(f1, 0, 256);
+    blocks = layout.getFileDataBlocks(f1Id, 0, 256);
     CPPUNIT_ASSERT_EQUAL((size_t)1, blocks.size());
     CPPUNIT_ASSERT_EQUAL((FSBlock)1000, blocks[0]);
 
     // Test retrieving entire last block
-    blocks = layout.getFileDataBlocks(f1, 1792, 256);
+    blocks = layout.getFileDataBlocks(f1Id, 1792, 256);
     CPPUNIT_ASSERT_EQUAL((size_t)1, blocks.size());
     CPPUNIT_ASSERT_EQUAL((FSBlock)1007, blocks[0]);
 
     // Test retrieving entire 2nd block
-    blocks = layout.getFileDataBlocks(f1, 256, 256);
+    blocks = layout.getFileDataBlocks(f1Id, 256, 256);
     CPPUNIT_ASSERT_EQUAL((size_t)1, blocks.size());
     CPPUNIT_ASSERT_EQUAL((FSBlock)1001, blocks[0]);
 
     // Test retrieving entire file
-    blocks = layout.getFileDataBlocks(f1, 0, 2048);
+    blocks = layout.getFileDataBlocks(f1Id, 0, 2048);
     CPPUNIT_ASSERT_EQUAL((size_t)8, blocks.size());
     CPPUNIT_ASSERT_EQUAL((FSBlock)1000, blocks[0]);
     CPPUNIT_ASSERT_EQUAL((FSBlock)1001, blocks[1]);
@@ -129,28 +129,28 @@ void FixedINodeStorageLayoutTest::testGetFileDataBlocks()
     CPPUNIT_ASSERT_EQUAL((FSBlock)1007, blocks[7]);
 
     // Test a single block request in the center of a block
-    blocks = layout.getFileDataBlocks(f1, 312, 4);
+    blocks = layout.getFileDataBlocks(f1Id, 312, 4);
     CPPUNIT_ASSERT_EQUAL((size_t)1, blocks.size());
     CPPUNIT_ASSERT_EQUAL((FSBlock)1001, blocks[0]);
 
     // Test a single block request at the beginning of a block
-    blocks = layout.getFileDataBlocks(f1, 256, 12);
+    blocks = layout.getFileDataBlocks(f1Id, 256, 12);
     CPPUNIT_ASSERT_EQUAL((size_t)1, blocks.size());
     CPPUNIT_ASSERT_EQUAL((FSBlock)1001, blocks[0]);
 
     // Test a single block request at the end of a block
-    blocks = layout.getFileDataBlocks(f1, 500, 11);
+    blocks = layout.getFileDataBlocks(f1Id, 500, 11);
     CPPUNIT_ASSERT_EQUAL((size_t)1, blocks.size());
     CPPUNIT_ASSERT_EQUAL((FSBlock)1001, blocks[0]);
 
     // Test a small request that spans two blocks
-    blocks = layout.getFileDataBlocks(f1, 248, 20);
+    blocks = layout.getFileDataBlocks(f1Id, 248, 20);
     CPPUNIT_ASSERT_EQUAL((size_t)2, blocks.size());
     CPPUNIT_ASSERT_EQUAL((FSBlock)1000, blocks[0]);
     CPPUNIT_ASSERT_EQUAL((FSBlock)1001, blocks[1]);
 
     // Test a request with partial blocks at the beginning and end
-    blocks = layout.getFileDataBlocks(f1, 248, 312);
+    blocks = layout.getFileDataBlocks(f1Id, 248, 312);
     CPPUNIT_ASSERT_EQUAL((size_t)3, blocks.size());
     CPPUNIT_ASSERT_EQUAL((FSBlock)1000, blocks[0]);
     CPPUNIT_ASSERT_EQUAL((FSBlock)1001, blocks[1]);
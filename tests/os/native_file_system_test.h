@@ -220,6 +220,20 @@ void NativeFileSystemTest::testFileWrite()
         new spfsOSReadBlocksResponse(0, SPFS_OS_READ_BLOCKS_RESPONSE);
     readMetaResponse->setContextPointer(out1);
     moduleTester_->deliverMessage(readMetaResponse, "response");
+
+    // Test that file system reads the partially written block
+    CPPUNIT_ASSERT_EQUAL((size_t)1, moduleTester_->getNumOutputMessages());
+    cMessage* outPartial = moduleTester_->popOutputMessage();
+    spfsOSReadBlocksRequest* partialRead =
+        dynamic_cast<spfsOSReadBlocksRequest*>(outPartial);
+    CPPUNIT_ASSERT(0 != partialRead);
+    CPPUNIT_ASSERT_EQUAL((unsigned int)1, partialRead->getBlocksArraySize());
+
+    // Send the partial block read response
+    spfsOSReadBlocksResponse* readPartialResponse =
+        new spfsOSReadBlocksResponse(0, SPFS_OS_READ_BLOCKS_RESPONSE);
+    readPartialResponse->setContextPointer(outPartial);
+    moduleTester_->deliverMessage(readPartialResponse, "response");
     CPPUNIT_ASSERT_EQUAL((size_t)2, moduleTester_->getNumOutputMessages());
 
     // Test that file system sends meta update and data read
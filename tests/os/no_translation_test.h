@@ -24,6 +24,7 @@ class NoTranslationTest : public CppUnit::TestFixture
     // exercise
     CPPUNIT_TEST_SUITE(NoTranslationTest);
     CPPUNIT_TEST(testHandleMessage);
+    CPPUNIT_TEST(testCoalesceContiguousBlocks);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -36,6 +37,8 @@ public:
 
     void testHandleMessage();
 
+    void testCoalesceContiguousBlocks();
+
 private:
 };
 
@@ -71,6 +74,39 @@ void NoTranslationTest::testHandleMessage()
     //CPPUNIT_ASSERT(0 == output2);
 }
 
+void NoTranslationTest::testCoalesceContiguousBlocks()
+{
+    cSimpleModuleTester moduleTester("NoTranslation",
+                                     "src/os/block_translator.ned");
+
+    // Request blocks 4, 5, 6 and 9
+    spfsOSReadBlocksRequest blocksRequest;
+    blocksRequest.setBlocksArraySize(4);
+    blocksRequest.setBlocks(0, 4);
+    blocksRequest.setBlocks(1, 5);
+    blocksRequest.setBlocks(2, 6);
+    blocksRequest.setBlocks(3, 9);
+    moduleTester.deliverMessage(&blocksRequest, "in");
+
+    // Only one device request should be generated per contiguous run
+    CPPUNIT_ASSERT_EQUAL((size_t)2, moduleTester.getNumOutputMessages());
+    CPPUNIT_ASSERT_EQUAL((long)2, blocksRequest.getNumRemainingResponses());
+
+    spfsOSReadDeviceRequest* run1 =
+        dynamic_cast<spfsOSReadDeviceRequest*>(
+            moduleTester.getOutputMessage(0));
+    CPPUNIT_ASSERT(0 != run1);
+    CPPUNIT_ASSERT_EQUAL((long)4, run1->getAddress());
+    CPPUNIT_ASSERT_EQUAL((long)3, run1->getExtent());
+
+    spfsOSReadDeviceRequest* run2 =
+        dynamic_cast<spfsOSReadDeviceRequest*>(
+            moduleTester.getOutputMessage(1));
+    CPPUNIT_ASSERT(0 != run2);
+    CPPUNIT_ASSERT_EQUAL((long)9, run2->getAddress());
+    CPPUNIT_ASSERT_EQUAL((long)1, run2->getExtent());
+}
+
 #endif
 
 /*
@@ -10,6 +10,9 @@
  * Unit test driver for subsystem module
  */
 #include <cppunit/TextTestRunner.h>
+#include "block_list_planner_test.h"
+#include "disk_scheduler_test.h"
+#include "extent_storage_layout_test.h"
 #include "fixed_inode_storage_layout_test.h"
 #include "native_file_system_test.h"
 #include "no_translation_test.h"
@@ -20,6 +23,9 @@ int main(int argc, char** argv)
     CppUnit::TextTestRunner runner;
 
     // Add all of the requisite tests
+    runner.addTest( BlockListPlannerTest::suite() );
+    runner.addTest( SchedulerQueueTest::suite() );
+    runner.addTest( ExtentStorageLayoutTest::suite() );
     runner.addTest( FixedINodeStorageLayoutTest::suite() );
     runner.addTest( NativeFileSystemTest::suite() );
     runner.addTest( NoTranslationTest::suite() );
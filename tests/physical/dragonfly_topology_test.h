@@ -0,0 +1,103 @@
+#ifndef DRAGONFLY_TOPOLOGY_TEST_H
+#define DRAGONFLY_TOPOLOGY_TEST_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cppunit/extensions/HelperMacros.h>
+#include "dragonfly_topology.h"
+#include "flow_network_model.h"
+using namespace std;
+
+/** Unit test for DragonflyTopology */
+class DragonflyTopologyTest : public CppUnit::TestFixture
+{
+    // Create unit test and register test functions for automatic
+    // exercise
+    CPPUNIT_TEST_SUITE(DragonflyTopologyTest);
+    CPPUNIT_TEST(testConstructor);
+    CPPUNIT_TEST(testLocalRoute);
+    CPPUNIT_TEST(testGlobalRoute);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    /** Called before each test function */
+    void setUp() {};
+
+    /** Called after each test function */
+    void tearDown() {};
+
+    void testConstructor();
+    void testLocalRoute();
+    void testGlobalRoute();
+};
+
+void DragonflyTopologyTest::testConstructor()
+{
+    // 3 groups of 2 routers with 2 links per group pair: 2 directed local
+    // links per group and 4 directed global links per pair
+    FlowNetworkModel model;
+    DragonflyTopology topology(model, 3, 2, 2, 10.0, 5.0);
+    CPPUNIT_ASSERT_EQUAL((size_t)6, topology.getNumEdgeSwitches());
+    CPPUNIT_ASSERT_EQUAL((size_t)18, topology.getNumLinks());
+    CPPUNIT_ASSERT_EQUAL(string("router[0][0]->router[0][1]"),
+                         topology.getLinkName(0));
+    CPPUNIT_ASSERT_EQUAL(10.0, model.getLinkCapacity(topology.getLink(0)));
+    CPPUNIT_ASSERT_EQUAL(5.0, model.getLinkCapacity(topology.getLink(17)));
+}
+
+void DragonflyTopologyTest::testLocalRoute()
+{
+    FlowNetworkModel model;
+    DragonflyTopology topology(model, 2, 4, 1, 10.0, 10.0);
+    SwitchTopology::Path path;
+    topology.route(2, 2, 0, path);
+    CPPUNIT_ASSERT(path.empty());
+
+    // Routers in a group are one local hop apart
+    topology.route(1, 3, 0, path);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, path.size());
+}
+
+void DragonflyTopologyTest::testGlobalRoute()
+{
+    // Group 0's link to group 1 is on router 0 and group 1's link to group
+    // 0 is on router 4
+    FlowNetworkModel model;
+    DragonflyTopology topology(model, 2, 4, 1, 10.0, 10.0);
+    SwitchTopology::Path direct;
+    topology.route(0, 4, 0, direct);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, direct.size());
+
+    // Other routers need a local hop at each end
+    SwitchTopology::Path path;
+    topology.route(1, 6, 0, path);
+    CPPUNIT_ASSERT_EQUAL((size_t)3, path.size());
+    CPPUNIT_ASSERT_EQUAL(direct[0], path[1]);
+
+    // Multiple links between a pair are selected by the hash
+    FlowNetworkModel model2;
+    DragonflyTopology topology2(model2, 2, 2, 2, 10.0, 10.0);
+    SwitchTopology::Path path0;
+    SwitchTopology::Path path1;
+    topology2.route(0, 2, 0, path0);
+    topology2.route(0, 2, 1, path1);
+    CPPUNIT_ASSERT(path0 != path1);
+}
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,117 @@
+#ifndef FAT_TREE_TOPOLOGY_TEST_H
+#define FAT_TREE_TOPOLOGY_TEST_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cppunit/extensions/HelperMacros.h>
+#include "fat_tree_topology.h"
+#include "flow_network_model.h"
+using namespace std;
+
+/** Unit test for FatTreeTopology */
+class FatTreeTopologyTest : public CppUnit::TestFixture
+{
+    // Create unit test and register test functions for automatic
+    // exercise
+    CPPUNIT_TEST_SUITE(FatTreeTopologyTest);
+    CPPUNIT_TEST(testConstructor);
+    CPPUNIT_TEST(testTwoLevelRoute);
+    CPPUNIT_TEST(testThreeLevelRoute);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    /** Called before each test function */
+    void setUp() {};
+
+    /** Called after each test function */
+    void tearDown() {};
+
+    void testConstructor();
+    void testTwoLevelRoute();
+    void testThreeLevelRoute();
+};
+
+void FatTreeTopologyTest::testConstructor()
+{
+    // 2 pods of 3 leaves and 2 spines, 2 cores per spine
+    FlowNetworkModel model;
+    FatTreeTopology topology(model, 2, 3, 2, 2, 10.0, 20.0);
+    CPPUNIT_ASSERT_EQUAL((size_t)6, topology.getNumEdgeSwitches());
+    CPPUNIT_ASSERT_EQUAL((size_t)40, topology.getNumLinks());
+    CPPUNIT_ASSERT_EQUAL((size_t)40, model.getNumLinks());
+    CPPUNIT_ASSERT_EQUAL(string("leaf[0][0]->spine[0][0]"),
+                         topology.getLinkName(0));
+    CPPUNIT_ASSERT_EQUAL(10.0, model.getLinkCapacity(topology.getLink(0)));
+    CPPUNIT_ASSERT_EQUAL(20.0, model.getLinkCapacity(topology.getLink(39)));
+}
+
+void FatTreeTopologyTest::testTwoLevelRoute()
+{
+    FlowNetworkModel model;
+    FatTreeTopology topology(model, 1, 4, 2, 0, 10.0, 0.0);
+
+    // Hosts on one leaf stay on it
+    SwitchTopology::Path path;
+    topology.route(1, 1, 0, path);
+    CPPUNIT_ASSERT(path.empty());
+
+    // Leaves are joined by one path per spine
+    SwitchTopology::Path path0;
+    SwitchTopology::Path path1;
+    topology.route(0, 3, 0, path0);
+    topology.route(0, 3, 1, path1);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, path0.size());
+    CPPUNIT_ASSERT_EQUAL((size_t)2, path1.size());
+    CPPUNIT_ASSERT(path0[0] != path1[0]);
+    CPPUNIT_ASSERT(path0[1] != path1[1]);
+
+    // The same hash selects the same path
+    SwitchTopology::Path path2;
+    topology.route(0, 3, 2, path2);
+    CPPUNIT_ASSERT(path0 == path2);
+}
+
+void FatTreeTopologyTest::testThreeLevelRoute()
+{
+    FlowNetworkModel model;
+    FatTreeTopology topology(model, 2, 2, 2, 2, 10.0, 10.0);
+
+    // Leaves in one pod only cross a spine
+    SwitchTopology::Path path;
+    topology.route(0, 1, 0, path);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, path.size());
+
+    // Leaves in different pods cross a spine, a core and a spine; the
+    // hash spreads flows over all 4 cores
+    SwitchTopology::Path paths[4];
+    for (size_t hash = 0; hash < 4; hash++)
+    {
+        topology.route(0, 3, hash, paths[hash]);
+        CPPUNIT_ASSERT_EQUAL((size_t)4, paths[hash].size());
+    }
+    for (size_t i = 0; i < 4; i++)
+    {
+        for (size_t j = i + 1; j < 4; j++)
+        {
+            CPPUNIT_ASSERT(paths[i][1] != paths[j][1]);
+        }
+    }
+}
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,121 @@
+#ifndef FLASH_TRANSLATION_LAYER_TEST_H
+#define FLASH_TRANSLATION_LAYER_TEST_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstdlib>
+#include <cppunit/extensions/HelperMacros.h>
+#include "flash_translation_layer.h"
+using namespace std;
+
+/** Unit test for FlashTranslationLayer */
+class FlashTranslationLayerTest : public CppUnit::TestFixture
+{
+    // Create unit test and register test functions for automatic
+    // exercise
+    CPPUNIT_TEST_SUITE(FlashTranslationLayerTest);
+    CPPUNIT_TEST(testConstructor);
+    CPPUNIT_TEST(testWritePage);
+    CPPUNIT_TEST(testOverwrite);
+    CPPUNIT_TEST(testGarbageCollection);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    /** Called before each test function */
+    void setUp() {};
+
+    /** Called after each test function */
+    void tearDown() {};
+
+    void testConstructor();
+    void testWritePage();
+    void testOverwrite();
+    void testGarbageCollection();
+};
+
+void FlashTranslationLayerTest::testConstructor()
+{
+    // 1024 pages over 4 dies with 25% spare is 320 pages, or 40 blocks
+    FlashTranslationLayer ftl(1024, 4, 8, 0.25, 2);
+    CPPUNIT_ASSERT_EQUAL((size_t)40, ftl.getBlocksPerDie());
+    CPPUNIT_ASSERT_EQUAL((size_t)39, ftl.getNumFreeBlocks(0));
+    CPPUNIT_ASSERT_EQUAL((size_t)39, ftl.getNumFreeBlocks(3));
+
+    // Without spare area the die is still sized to collect garbage
+    FlashTranslationLayer ftl2(1024, 4, 8, 0.0, 2);
+    CPPUNIT_ASSERT_EQUAL((size_t)35, ftl2.getBlocksPerDie());
+}
+
+void FlashTranslationLayerTest::testWritePage()
+{
+    FlashTranslationLayer ftl(1024, 4, 8, 0.25, 2);
+    CPPUNIT_ASSERT(!ftl.isMapped(5));
+
+    FlashTranslationLayer::WriteCost cost = ftl.writePage(5);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, cost.die);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, cost.numCopies);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, cost.numErases);
+    CPPUNIT_ASSERT(ftl.isMapped(5));
+    CPPUNIT_ASSERT_EQUAL((size_t)1, ftl.getDie(5));
+    CPPUNIT_ASSERT_EQUAL((size_t)2, ftl.getDie(6));
+    CPPUNIT_ASSERT_EQUAL((uint64_t)1, ftl.getNumHostWrites());
+    CPPUNIT_ASSERT_EQUAL((uint64_t)1, ftl.getNumFlashWrites());
+}
+
+void FlashTranslationLayerTest::testOverwrite()
+{
+    // Overwriting a single page leaves only invalid victims, so garbage
+    // collection never copies
+    FlashTranslationLayer ftl(1024, 4, 8, 0.25, 2);
+    for (int i = 0; i < 10000; i++)
+    {
+        FlashTranslationLayer::WriteCost cost = ftl.writePage(0);
+        CPPUNIT_ASSERT_EQUAL((size_t)0, cost.numCopies);
+    }
+    CPPUNIT_ASSERT(0 < ftl.getNumErases());
+    CPPUNIT_ASSERT_EQUAL(1.0, ftl.getWriteAmplification());
+    CPPUNIT_ASSERT(2 <= ftl.getNumFreeBlocks(0));
+    CPPUNIT_ASSERT_EQUAL((size_t)39, ftl.getNumFreeBlocks(1));
+}
+
+void FlashTranslationLayerTest::testGarbageCollection()
+{
+    // Fill the device, then overwrite it randomly
+    FlashTranslationLayer ftl(1024, 4, 8, 0.1, 2);
+    for (int64_t i = 0; i < 1024; i++)
+    {
+        ftl.writePage(i);
+    }
+    CPPUNIT_ASSERT_EQUAL(1.0, ftl.getWriteAmplification());
+
+    srand(1);
+    for (int i = 0; i < 20000; i++)
+    {
+        ftl.writePage(rand() % 1024);
+        CPPUNIT_ASSERT(2 <= ftl.getNumFreeBlocks(i % 4));
+    }
+    CPPUNIT_ASSERT(1.0 < ftl.getWriteAmplification());
+    CPPUNIT_ASSERT_EQUAL((uint64_t)21024, ftl.getNumHostWrites());
+    for (int64_t i = 0; i < 1024; i++)
+    {
+        CPPUNIT_ASSERT(ftl.isMapped(i));
+    }
+}
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
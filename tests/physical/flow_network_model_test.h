@@ -0,0 +1,159 @@
+#ifndef FLOW_NETWORK_MODEL_TEST_H
+#define FLOW_NETWORK_MODEL_TEST_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <vector>
+#include <cppunit/extensions/HelperMacros.h>
+#include "flow_network_model.h"
+using namespace std;
+
+/** Unit test for FlowNetworkModel */
+class FlowNetworkModelTest : public CppUnit::TestFixture
+{
+    // Create unit test and register test functions for automatic
+    // exercise
+    CPPUNIT_TEST_SUITE(FlowNetworkModelTest);
+    CPPUNIT_TEST(testAddLink);
+    CPPUNIT_TEST(testSingleFlow);
+    CPPUNIT_TEST(testSharedLink);
+    CPPUNIT_TEST(testMaxMinFairness);
+    CPPUNIT_TEST(testCompletion);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    /** Called before each test function */
+    void setUp() {};
+
+    /** Called after each test function */
+    void tearDown() {};
+
+    void testAddLink();
+    void testSingleFlow();
+    void testSharedLink();
+    void testMaxMinFairness();
+    void testCompletion();
+
+private:
+
+    /** @return a path of the two links */
+    static vector<FlowNetworkModel::LinkId> makePath(
+        FlowNetworkModel::LinkId first, FlowNetworkModel::LinkId second);
+};
+
+vector<FlowNetworkModel::LinkId> FlowNetworkModelTest::makePath(
+    FlowNetworkModel::LinkId first, FlowNetworkModel::LinkId second)
+{
+    vector<FlowNetworkModel::LinkId> path;
+    path.push_back(first);
+    path.push_back(second);
+    return path;
+}
+
+void FlowNetworkModelTest::testAddLink()
+{
+    FlowNetworkModel model;
+    CPPUNIT_ASSERT_EQUAL((size_t)0, model.addLink(100.0));
+    CPPUNIT_ASSERT_EQUAL((size_t)1, model.addLink(50.0));
+    CPPUNIT_ASSERT_EQUAL((size_t)2, model.getNumLinks());
+    CPPUNIT_ASSERT_EQUAL(50.0, model.getLinkCapacity(1));
+}
+
+void FlowNetworkModelTest::testSingleFlow()
+{
+    // A lone flow is limited by the slowest link on its path
+    FlowNetworkModel model;
+    FlowNetworkModel::LinkId nic = model.addLink(100.0);
+    FlowNetworkModel::LinkId port = model.addLink(40.0);
+    FlowNetworkModel::FlowId flow = model.addFlow(makePath(nic, port), 80.0);
+    model.computeRates();
+    CPPUNIT_ASSERT_EQUAL(40.0, model.getRate(flow));
+}
+
+void FlowNetworkModelTest::testSharedLink()
+{
+    // Two flows into one port split it, and the survivor takes it all
+    FlowNetworkModel model;
+    FlowNetworkModel::LinkId nic1 = model.addLink(100.0);
+    FlowNetworkModel::LinkId nic2 = model.addLink(100.0);
+    FlowNetworkModel::LinkId port = model.addLink(100.0);
+    FlowNetworkModel::FlowId flow1 = model.addFlow(makePath(nic1, port), 1.0);
+    FlowNetworkModel::FlowId flow2 = model.addFlow(makePath(nic2, port), 1.0);
+    model.computeRates();
+    CPPUNIT_ASSERT_EQUAL(50.0, model.getRate(flow1));
+    CPPUNIT_ASSERT_EQUAL(50.0, model.getRate(flow2));
+
+    model.removeFlow(flow1);
+    model.computeRates();
+    CPPUNIT_ASSERT_EQUAL((size_t)1, model.getNumFlows());
+    CPPUNIT_ASSERT_EQUAL(100.0, model.getRate(flow2));
+}
+
+void FlowNetworkModelTest::testMaxMinFairness()
+{
+    // Flows A and B share nic1; B and C share port2.  Port2 is the
+    // bottleneck for B and C at 30 each, so A receives nic1's remaining 70
+    FlowNetworkModel model;
+    FlowNetworkModel::LinkId nic1 = model.addLink(100.0);
+    FlowNetworkModel::LinkId nic2 = model.addLink(100.0);
+    FlowNetworkModel::LinkId port1 = model.addLink(100.0);
+    FlowNetworkModel::LinkId port2 = model.addLink(60.0);
+    FlowNetworkModel::FlowId a = model.addFlow(makePath(nic1, port1), 1.0);
+    FlowNetworkModel::FlowId b = model.addFlow(makePath(nic1, port2), 1.0);
+    FlowNetworkModel::FlowId c = model.addFlow(makePath(nic2, port2), 1.0);
+    model.computeRates();
+    CPPUNIT_ASSERT_EQUAL(70.0, model.getRate(a));
+    CPPUNIT_ASSERT_EQUAL(30.0, model.getRate(b));
+    CPPUNIT_ASSERT_EQUAL(30.0, model.getRate(c));
+}
+
+void FlowNetworkModelTest::testCompletion()
+{
+    FlowNetworkModel model;
+    FlowNetworkModel::LinkId nic = model.addLink(100.0);
+    FlowNetworkModel::LinkId port = model.addLink(100.0);
+    FlowNetworkModel::FlowId id = 0;
+    double secs = 0.0;
+    CPPUNIT_ASSERT(!model.getNextCompletion(id, secs));
+
+    FlowNetworkModel::FlowId small = model.addFlow(makePath(nic, port), 50.0);
+    FlowNetworkModel::FlowId large = model.addFlow(makePath(nic, port), 200.0);
+    model.computeRates();
+    CPPUNIT_ASSERT(model.getNextCompletion(id, secs));
+    CPPUNIT_ASSERT_EQUAL(small, id);
+    CPPUNIT_ASSERT_EQUAL(1.0, secs);
+
+    // Drain until the small flow is done
+    model.advance(1.0);
+    CPPUNIT_ASSERT_EQUAL(150.0, model.getRemainingBytes(large));
+    CPPUNIT_ASSERT_EQUAL(100.0, model.getLinkBytes(nic));
+    CPPUNIT_ASSERT_EQUAL(100.0, model.getLinkBytes(port));
+    vector<FlowNetworkModel::FlowId> completed = model.getCompletedFlows();
+    CPPUNIT_ASSERT_EQUAL((size_t)1, completed.size());
+    CPPUNIT_ASSERT_EQUAL(small, completed[0]);
+
+    // The large flow speeds up once the small flow departs
+    model.removeFlow(small);
+    model.computeRates();
+    CPPUNIT_ASSERT(model.getNextCompletion(id, secs));
+    CPPUNIT_ASSERT_EQUAL(large, id);
+    CPPUNIT_ASSERT_EQUAL(1.5, secs);
+}
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,98 @@
+#ifndef LOGGP_MODEL_TEST_H
+#define LOGGP_MODEL_TEST_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cppunit/extensions/HelperMacros.h>
+#include "loggp_model.h"
+using namespace std;
+
+/** Unit test for LogGPModel */
+class LogGPModelTest : public CppUnit::TestFixture
+{
+    // Create unit test and register test functions for automatic
+    // exercise
+    CPPUNIT_TEST_SUITE(LogGPModelTest);
+    CPPUNIT_TEST(testSingleMessage);
+    CPPUNIT_TEST(testSendGap);
+    CPPUNIT_TEST(testIncast);
+    CPPUNIT_TEST(testBackplane);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    /** Called before each test function */
+    void setUp() {};
+
+    /** Called after each test function */
+    void tearDown() {};
+
+    void testSingleMessage();
+    void testSendGap();
+    void testIncast();
+    void testBackplane();
+};
+
+void LogGPModelTest::testSingleMessage()
+{
+    // o + (k - 1) * G + L + o
+    LogGPModel model(10.0, 1.0, 4.0, 0.5, 0.0);
+    size_t src = model.addNode();
+    size_t dest = model.addNode();
+    CPPUNIT_ASSERT_EQUAL((size_t)2, model.getNumNodes());
+    CPPUNIT_ASSERT_EQUAL(17.0, model.send(src, dest, 0.0, 11.0));
+
+    // Small messages cost L + 2o
+    CPPUNIT_ASSERT_EQUAL(112.0, model.send(src, dest, 100.0, 1.0));
+}
+
+void LogGPModelTest::testSendGap()
+{
+    // Back to back small messages are separated by g on the NIC
+    LogGPModel model(10.0, 1.0, 4.0, 0.5, 0.0);
+    size_t src = model.addNode();
+    size_t dest1 = model.addNode();
+    size_t dest2 = model.addNode();
+    CPPUNIT_ASSERT_EQUAL(12.0, model.send(src, dest1, 0.0, 1.0));
+    CPPUNIT_ASSERT_EQUAL(16.0, model.send(src, dest2, 0.0, 1.0));
+}
+
+void LogGPModelTest::testIncast()
+{
+    // Two senders into one receiver serialize on the receiving NIC
+    LogGPModel model(10.0, 0.0, 0.0, 1.0, 0.0);
+    size_t src1 = model.addNode();
+    size_t src2 = model.addNode();
+    size_t dest = model.addNode();
+    CPPUNIT_ASSERT_EQUAL(110.0, model.send(src1, dest, 0.0, 101.0));
+    CPPUNIT_ASSERT_EQUAL(210.0, model.send(src2, dest, 0.0, 101.0));
+}
+
+void LogGPModelTest::testBackplane()
+{
+    // Disjoint pairs still share the backplane
+    LogGPModel model(0.0, 0.0, 0.0, 0.0, 10.0);
+    size_t src1 = model.addNode();
+    size_t dest1 = model.addNode();
+    size_t src2 = model.addNode();
+    size_t dest2 = model.addNode();
+    CPPUNIT_ASSERT_EQUAL(10.0, model.send(src1, dest1, 0.0, 100.0));
+    CPPUNIT_ASSERT_EQUAL(20.0, model.send(src2, dest2, 0.0, 100.0));
+}
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
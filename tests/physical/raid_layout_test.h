@@ -0,0 +1,159 @@
+#ifndef RAID_LAYOUT_TEST_H
+#define RAID_LAYOUT_TEST_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <vector>
+#include <cppunit/extensions/HelperMacros.h>
+#include "raid_layout.h"
+using namespace std;
+
+/** Unit test for RaidLayout */
+class RaidLayoutTest : public CppUnit::TestFixture
+{
+    // Create unit test and register test functions for automatic
+    // exercise
+    CPPUNIT_TEST_SUITE(RaidLayoutTest);
+    CPPUNIT_TEST(testGetDataDisk);
+    CPPUNIT_TEST(testMapRead);
+    CPPUNIT_TEST(testMapFullStripeWrite);
+    CPPUNIT_TEST(testMapPartialStripeWrite);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    /** Called before each test function */
+    void setUp() {};
+
+    /** Called after each test function */
+    void tearDown() {};
+
+    void testGetDataDisk();
+    void testMapRead();
+    void testMapFullStripeWrite();
+    void testMapPartialStripeWrite();
+
+private:
+
+    /** Assert the member extent matches */
+    static void assertExtent(const MemberExtent& member,
+                             size_t disk,
+                             LogicalBlockAddress lba,
+                             long extent);
+};
+
+void RaidLayoutTest::assertExtent(const MemberExtent& member,
+                                  size_t disk,
+                                  LogicalBlockAddress lba,
+                                  long extent)
+{
+    CPPUNIT_ASSERT_EQUAL(disk, member.disk);
+    CPPUNIT_ASSERT_EQUAL(lba, member.lba);
+    CPPUNIT_ASSERT_EQUAL(extent, member.extent);
+}
+
+void RaidLayoutTest::testGetDataDisk()
+{
+    RaidLayout raid0(0, 4, 8);
+    CPPUNIT_ASSERT_EQUAL(32l, raid0.getStripeBlocks());
+    CPPUNIT_ASSERT_EQUAL((size_t)2, raid0.getDataDisk(5, 2));
+
+    // Left symmetric parity rotation
+    RaidLayout raid5(5, 4, 8);
+    CPPUNIT_ASSERT_EQUAL(24l, raid5.getStripeBlocks());
+    CPPUNIT_ASSERT_EQUAL((size_t)3, raid5.getParityDisk(0));
+    CPPUNIT_ASSERT_EQUAL((size_t)0, raid5.getDataDisk(0, 0));
+    CPPUNIT_ASSERT_EQUAL((size_t)2, raid5.getDataDisk(0, 2));
+    CPPUNIT_ASSERT_EQUAL((size_t)2, raid5.getParityDisk(1));
+    CPPUNIT_ASSERT_EQUAL((size_t)3, raid5.getDataDisk(1, 0));
+    CPPUNIT_ASSERT_EQUAL((size_t)1, raid5.getDataDisk(1, 2));
+
+    // The second parity chunk follows the first
+    RaidLayout raid6(6, 4, 8);
+    CPPUNIT_ASSERT_EQUAL(16l, raid6.getStripeBlocks());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, raid6.getDataDisk(0, 0));
+    CPPUNIT_ASSERT_EQUAL((size_t)2, raid6.getDataDisk(0, 1));
+}
+
+void RaidLayoutTest::testMapRead()
+{
+    // Chunks on the same member in consecutive stripes are merged
+    RaidLayout raid0(0, 4, 8);
+    vector<MemberExtent> members = raid0.mapRead(0, 64);
+    CPPUNIT_ASSERT_EQUAL((size_t)4, members.size());
+    for (size_t i = 0; i < members.size(); i++)
+    {
+        assertExtent(members[i], i, 0, 16);
+    }
+
+    // Reads skip the parity chunks
+    RaidLayout raid5(5, 4, 8);
+    members = raid5.mapRead(20, 8);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, members.size());
+    assertExtent(members[0], 2, 4, 4);
+    assertExtent(members[1], 3, 8, 4);
+}
+
+void RaidLayoutTest::testMapFullStripeWrite()
+{
+    RaidLayout raid5(5, 4, 8);
+    vector<StripeUpdate> updates = raid5.mapWrite(0, 48);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, updates.size());
+    CPPUNIT_ASSERT_EQUAL((size_t)2, updates[0].numStripes);
+    CPPUNIT_ASSERT(updates[0].reads.empty());
+    CPPUNIT_ASSERT_EQUAL((size_t)4, updates[0].writes.size());
+    for (size_t i = 0; i < updates[0].writes.size(); i++)
+    {
+        assertExtent(updates[0].writes[i], i, 0, 16);
+    }
+}
+
+void RaidLayoutTest::testMapPartialStripeWrite()
+{
+    // A partial stripe reads and writes its data and parity
+    RaidLayout raid5(5, 4, 8);
+    vector<StripeUpdate> updates = raid5.mapWrite(4, 8);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, updates.size());
+    CPPUNIT_ASSERT_EQUAL((size_t)3, updates[0].reads.size());
+    CPPUNIT_ASSERT_EQUAL((size_t)3, updates[0].writes.size());
+    assertExtent(updates[0].writes[0], 0, 4, 4);
+    assertExtent(updates[0].writes[1], 1, 0, 4);
+    assertExtent(updates[0].writes[2], 3, 0, 8);
+
+    // Partial stripes surround the full stripe update
+    updates = raid5.mapWrite(20, 32);
+    CPPUNIT_ASSERT_EQUAL((size_t)3, updates.size());
+    CPPUNIT_ASSERT_EQUAL((size_t)2, updates[0].reads.size());
+    assertExtent(updates[0].writes[0], 2, 4, 4);
+    assertExtent(updates[0].writes[1], 3, 4, 4);
+    CPPUNIT_ASSERT(updates[1].reads.empty());
+    CPPUNIT_ASSERT_EQUAL((size_t)4, updates[1].writes.size());
+    CPPUNIT_ASSERT_EQUAL((size_t)2, updates[2].reads.size());
+    assertExtent(updates[2].writes[0], 2, 16, 4);
+    assertExtent(updates[2].writes[1], 1, 16, 4);
+
+    // RAID-6 updates both parity chunks
+    RaidLayout raid6(6, 4, 8);
+    updates = raid6.mapWrite(0, 4);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, updates.size());
+    CPPUNIT_ASSERT_EQUAL((size_t)3, updates[0].writes.size());
+    assertExtent(updates[0].writes[1], 3, 0, 4);
+    assertExtent(updates[0].writes[2], 0, 0, 4);
+}
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,82 @@
+#ifndef REGISTRATION_CACHE_TEST_H
+#define REGISTRATION_CACHE_TEST_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cppunit/extensions/HelperMacros.h>
+#include "registration_cache.h"
+using namespace std;
+
+/** Unit test for RegistrationCache */
+class RegistrationCacheTest : public CppUnit::TestFixture
+{
+    // Create unit test and register test functions for automatic
+    // exercise
+    CPPUNIT_TEST_SUITE(RegistrationCacheTest);
+    CPPUNIT_TEST(testRegisterBuffer);
+    CPPUNIT_TEST(testGrowBuffer);
+    CPPUNIT_TEST(testEviction);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    /** Called before each test function */
+    void setUp() {};
+
+    /** Called after each test function */
+    void tearDown() {};
+
+    void testRegisterBuffer();
+    void testGrowBuffer();
+    void testEviction();
+};
+
+void RegistrationCacheTest::testRegisterBuffer()
+{
+    // The first registration pays fixed + per byte, reuse is free
+    RegistrationCache cache(2, 10.0, 0.5);
+    CPPUNIT_ASSERT_EQUAL(60.0, cache.registerBuffer(1, 100));
+    CPPUNIT_ASSERT_EQUAL(0.0, cache.registerBuffer(1, 100));
+    CPPUNIT_ASSERT_EQUAL(0.0, cache.registerBuffer(1, 50));
+    CPPUNIT_ASSERT_EQUAL((size_t)2, cache.getNumHits());
+    CPPUNIT_ASSERT_EQUAL((size_t)1, cache.getNumMisses());
+}
+
+void RegistrationCacheTest::testGrowBuffer()
+{
+    // A larger buffer must be registered again
+    RegistrationCache cache(2, 10.0, 0.5);
+    CPPUNIT_ASSERT_EQUAL(60.0, cache.registerBuffer(1, 100));
+    CPPUNIT_ASSERT_EQUAL(110.0, cache.registerBuffer(1, 200));
+    CPPUNIT_ASSERT_EQUAL(0.0, cache.registerBuffer(1, 200));
+    CPPUNIT_ASSERT_EQUAL((size_t)2, cache.getNumMisses());
+}
+
+void RegistrationCacheTest::testEviction()
+{
+    // The least recently used registration is evicted
+    RegistrationCache cache(2, 10.0, 0.0);
+    cache.registerBuffer(1, 100);
+    cache.registerBuffer(2, 100);
+    CPPUNIT_ASSERT_EQUAL(0.0, cache.registerBuffer(1, 100));
+    CPPUNIT_ASSERT_EQUAL(10.0, cache.registerBuffer(3, 100));
+    CPPUNIT_ASSERT_EQUAL(0.0, cache.registerBuffer(1, 100));
+    CPPUNIT_ASSERT_EQUAL(10.0, cache.registerBuffer(2, 100));
+}
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -11,7 +11,14 @@
 #include "bmi_tcp_client_test.h"
 #include "bmi_tcp_endpoint_test.h"
 #include "bmi_tcp_server_test.h"
+#include "dragonfly_topology_test.h"
+#include "fat_tree_topology_test.h"
+#include "flash_translation_layer_test.h"
+#include "flow_network_model_test.h"
+#include "loggp_model_test.h"
 #include "mpi_tcp_client_test.h"
+#include "raid_layout_test.h"
+#include "registration_cache_test.h"
 
 int main(int argc, char** argv)
 {
@@ -22,7 +29,14 @@ int main(int argc, char** argv)
     runner.addTest( BMITcpClientTest::suite() );
     //runner.addTest( BMITcpEndpointTest::suite() );
     runner.addTest( BMITcpServerTest::suite() );
+    runner.addTest( DragonflyTopologyTest::suite() );
+    runner.addTest( FatTreeTopologyTest::suite() );
+    runner.addTest( FlashTranslationLayerTest::suite() );
+    runner.addTest( FlowNetworkModelTest::suite() );
+    runner.addTest( LogGPModelTest::suite() );
     runner.addTest( MPITcpClientTest::suite() );
+    runner.addTest( RaidLayoutTest::suite() );
+    runner.addTest( RegistrationCacheTest::suite() );
 
     bool success = runner.run();
     return (success ? 0 : 1);
@@ -0,0 +1,254 @@
+#ifndef REQUEST_SCHEDULER_TEST_H
+#define REQUEST_SCHEDULER_TEST_H
+//
+// This file is part of Hecios
+//
+// Copyright (C) 2007,2008,2009 Brad Settlemyer
+//
+// This file is distributed WITHOUT ANY WARRANTY. See the file 'License.txt'
+// for details on this and other legal matters.
+//
+#include <cstddef>
+#include <iostream>
+#include <cppunit/extensions/HelperMacros.h>
+#include "csimple_module_tester.h"
+#include "request_scheduler.h"
+#include "pvfs_proto_m.h"
+using namespace std;
+
+/** Unit test for RequestScheduler */
+class RequestSchedulerTest : public CppUnit::TestFixture
+{
+    // Create generic unit test and register test functions for automatic
+    // exercise
+    CPPUNIT_TEST_SUITE(RequestSchedulerTest);
+    CPPUNIT_TEST(testUnorderedPassThrough);
+    CPPUNIT_TEST(testWriteSerialization);
+    CPPUNIT_TEST(testConcurrencyLimit);
+    CPPUNIT_TEST(testSmallRequestPriority);
+    CPPUNIT_TEST(testReadFlowCompletion);
+    CPPUNIT_TEST(testUnansweredRequestBypass);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    /** Called before each test function */
+    virtual void setUp();
+
+    /** Called after each test function */
+    virtual void tearDown();
+
+    /** Test that requests are not reordered unless ordering is enabled */
+    void testUnorderedPassThrough();
+
+    /** Test that writes to a handle are serviced one at a time */
+    void testWriteSerialization();
+
+    /** Test that the number of requests in service is limited */
+    void testConcurrencyLimit();
+
+    /** Test that metadata requests are serviced before data requests */
+    void testSmallRequestPriority();
+
+    /** Test that a read with data completes when its flow finishes */
+    void testReadFlowCompletion();
+
+    /** Test that unanswered request kinds do not occupy the server */
+    void testUnansweredRequestBypass();
+
+private:
+
+    /** Construct the scheduler under test */
+    void createScheduler(const char* schedulerType,
+                         long maxConcurrentRequests,
+                         bool orderDataRequests);
+
+    cSimpleModuleTester* moduleTester_;
+};
+
+void RequestSchedulerTest::setUp()
+{
+    moduleTester_ = 0;
+}
+
+void RequestSchedulerTest::tearDown()
+{
+    delete moduleTester_;
+    moduleTester_ = 0;
+}
+
+void RequestSchedulerTest::createScheduler(const char* schedulerType,
+                                           long maxConcurrentRequests,
+                                           bool orderDataRequests)
+{
+    moduleTester_ = new cSimpleModuleTester(schedulerType,
+                                            "src/server/request_scheduler.ned",
+                                            false);
+    moduleTester_->getModule()->par("maxConcurrentRequests").setLongValue(
+        maxConcurrentRequests);
+    moduleTester_->getModule()->par("orderDataRequests").setBoolValue(
+        orderDataRequests);
+    moduleTester_->callInitialize();
+}
+
+// Test that requests are not reordered unless ordering is enabled
+void RequestSchedulerTest::testUnorderedPassThrough()
+{
+    createScheduler("FIFORequestScheduler", 0, false);
+
+    // Both writes to handle 5 are serviced immediately
+    spfsWriteRequest* write1 = new spfsWriteRequest(0, SPFS_WRITE_REQUEST);
+    write1->setHandle(5);
+    spfsWriteRequest* write2 = new spfsWriteRequest(0, SPFS_WRITE_REQUEST);
+    write2->setHandle(5);
+    moduleTester_->deliverMessage(write1, "requestIn");
+    moduleTester_->deliverMessage(write2, "requestIn");
+    CPPUNIT_ASSERT_EQUAL((size_t)2, moduleTester_->getNumOutputMessages());
+    CPPUNIT_ASSERT(write1 == moduleTester_->getOutputMessage(0));
+    CPPUNIT_ASSERT(write2 == moduleTester_->getOutputMessage(1));
+}
+
+// Test that writes to a handle are serviced one at a time
+void RequestSchedulerTest::testWriteSerialization()
+{
+    createScheduler("FIFORequestScheduler", 0, true);
+
+    // The second write to handle 5 waits, the read to handle 6 does not
+    spfsWriteRequest* write1 = new spfsWriteRequest(0, SPFS_WRITE_REQUEST);
+    write1->setHandle(5);
+    spfsWriteRequest* write2 = new spfsWriteRequest(0, SPFS_WRITE_REQUEST);
+    write2->setHandle(5);
+    spfsReadRequest* read = new spfsReadRequest(0, SPFS_READ_REQUEST);
+    read->setHandle(6);
+    moduleTester_->deliverMessage(write1, "requestIn");
+    moduleTester_->deliverMessage(write2, "requestIn");
+    moduleTester_->deliverMessage(read, "requestIn");
+    CPPUNIT_ASSERT_EQUAL((size_t)2, moduleTester_->getNumOutputMessages());
+    CPPUNIT_ASSERT(write1 == moduleTester_->getOutputMessage(0));
+    CPPUNIT_ASSERT(read == moduleTester_->getOutputMessage(1));
+
+    // The write acknowledgement does not complete the first write
+    spfsWriteResponse* ack = new spfsWriteResponse(0, SPFS_WRITE_RESPONSE);
+    ack->setContextPointer(write1);
+    moduleTester_->deliverMessage(ack, "serverIn");
+    CPPUNIT_ASSERT_EQUAL((size_t)3, moduleTester_->getNumOutputMessages());
+
+    // The completion response releases the second write
+    spfsWriteCompletionResponse* completion =
+        new spfsWriteCompletionResponse(0, SPFS_WRITE_COMPLETION_RESPONSE);
+    completion->setContextPointer(write1);
+    moduleTester_->deliverMessage(completion, "serverIn");
+    CPPUNIT_ASSERT_EQUAL((size_t)5, moduleTester_->getNumOutputMessages());
+    CPPUNIT_ASSERT(completion == moduleTester_->getOutputMessage(3));
+    CPPUNIT_ASSERT(write2 == moduleTester_->getOutputMessage(4));
+}
+
+// Test that the number of requests in service is limited
+void RequestSchedulerTest::testConcurrencyLimit()
+{
+    createScheduler("FIFORequestScheduler", 1, false);
+
+    spfsGetAttrRequest* getAttr1 =
+        new spfsGetAttrRequest(0, SPFS_GET_ATTR_REQUEST);
+    getAttr1->setHandle(1);
+    spfsGetAttrRequest* getAttr2 =
+        new spfsGetAttrRequest(0, SPFS_GET_ATTR_REQUEST);
+    getAttr2->setHandle(2);
+    moduleTester_->deliverMessage(getAttr1, "requestIn");
+    moduleTester_->deliverMessage(getAttr2, "requestIn");
+    CPPUNIT_ASSERT_EQUAL((size_t)1, moduleTester_->getNumOutputMessages());
+
+    // Completing the first request dispatches the second
+    spfsGetAttrResponse* resp =
+        new spfsGetAttrResponse(0, SPFS_GET_ATTR_RESPONSE);
+    resp->setContextPointer(getAttr1);
+    moduleTester_->deliverMessage(resp, "serverIn");
+    CPPUNIT_ASSERT_EQUAL((size_t)3, moduleTester_->getNumOutputMessages());
+    CPPUNIT_ASSERT(getAttr2 == moduleTester_->getOutputMessage(2));
+}
+
+// Test that metadata requests are serviced before data requests
+void RequestSchedulerTest::testSmallRequestPriority()
+{
+    createScheduler("PriorityRequestScheduler", 1, false);
+
+    // Occupy the server, then queue a large write and a metadata request
+    spfsReadRequest* read = new spfsReadRequest(0, SPFS_READ_REQUEST);
+    read->setHandle(1);
+    read->setDataSize(4096);
+    spfsWriteRequest* write = new spfsWriteRequest(0, SPFS_WRITE_REQUEST);
+    write->setHandle(2);
+    write->setDataSize(1000000);
+    spfsGetAttrRequest* getAttr =
+        new spfsGetAttrRequest(0, SPFS_GET_ATTR_REQUEST);
+    getAttr->setHandle(3);
+    moduleTester_->deliverMessage(read, "requestIn");
+    moduleTester_->deliverMessage(write, "requestIn");
+    moduleTester_->deliverMessage(getAttr, "requestIn");
+    CPPUNIT_ASSERT_EQUAL((size_t)1, moduleTester_->getNumOutputMessages());
+
+    // Completing the read dispatches the metadata request first
+    spfsReadResponse* resp = new spfsReadResponse(0, SPFS_READ_RESPONSE);
+    resp->setContextPointer(read);
+    moduleTester_->deliverMessage(resp, "serverIn");
+    CPPUNIT_ASSERT_EQUAL((size_t)3, moduleTester_->getNumOutputMessages());
+    CPPUNIT_ASSERT(getAttr == moduleTester_->getOutputMessage(2));
+}
+
+// Test that a read with data completes when its flow finishes
+void RequestSchedulerTest::testReadFlowCompletion()
+{
+    createScheduler("FIFORequestScheduler", 0, true);
+
+    spfsReadRequest* read = new spfsReadRequest(0, SPFS_READ_REQUEST);
+    read->setHandle(5);
+    read->setLocalSize(4096);
+    spfsWriteRequest* write = new spfsWriteRequest(0, SPFS_WRITE_REQUEST);
+    write->setHandle(5);
+    moduleTester_->deliverMessage(read, "requestIn");
+    moduleTester_->deliverMessage(write, "requestIn");
+    CPPUNIT_ASSERT_EQUAL((size_t)1, moduleTester_->getNumOutputMessages());
+
+    // The read response precedes the flow and does not release the write
+    spfsReadResponse* resp = new spfsReadResponse(0, SPFS_READ_RESPONSE);
+    resp->setContextPointer(read);
+    moduleTester_->deliverMessage(resp, "serverIn");
+    CPPUNIT_ASSERT_EQUAL((size_t)2, moduleTester_->getNumOutputMessages());
+
+    // The flow finish releases the write
+    spfsServerDataFlowStart flowStart(0, SPFS_DATA_FLOW_START);
+    flowStart.setContextPointer(read);
+    spfsDataFlowFinish* finish =
+        new spfsDataFlowFinish(0, SPFS_DATA_FLOW_FINISH);
+    finish->setContextPointer(&flowStart);
+    moduleTester_->deliverMessage(finish, "requestIn");
+    CPPUNIT_ASSERT_EQUAL((size_t)4, moduleTester_->getNumOutputMessages());
+    CPPUNIT_ASSERT(finish == moduleTester_->getOutputMessage(2));
+    CPPUNIT_ASSERT(write == moduleTester_->getOutputMessage(3));
+}
+
+// Test that unanswered request kinds do not occupy the server
+void RequestSchedulerTest::testUnansweredRequestBypass()
+{
+    createScheduler("FIFORequestScheduler", 1, false);
+
+    spfsStatRequest* stat = new spfsStatRequest(0, SPFS_STAT_REQUEST);
+    spfsGetAttrRequest* getAttr =
+        new spfsGetAttrRequest(0, SPFS_GET_ATTR_REQUEST);
+    moduleTester_->deliverMessage(stat, "requestIn");
+    moduleTester_->deliverMessage(getAttr, "requestIn");
+    CPPUNIT_ASSERT_EQUAL((size_t)2, moduleTester_->getNumOutputMessages());
+    CPPUNIT_ASSERT(getAttr == moduleTester_->getOutputMessage(1));
+}
+
+#endif
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: nil
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
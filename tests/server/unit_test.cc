@@ -8,6 +8,7 @@
 //
 #include <cppunit/TextTestRunner.h>
 #include "fs_server_test.h"
+#include "request_scheduler_test.h"
 
 int main(int argc, char** argv)
 {
@@ -15,6 +16,7 @@ int main(int argc, char** argv)
 
     // Add all of the subsystem tests
     runner.addTest( FSServerTest::suite() );
+    runner.addTest( RequestSchedulerTest::suite() );
 
     bool success = runner.run();
     return (success ? 0 : 1);